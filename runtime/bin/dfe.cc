@@ -7,6 +7,7 @@
 #include "bin/directory.h"
 #include "bin/error_exit.h"
 #include "bin/file.h"
+#include "bin/lockers.h"
 #include "bin/platform.h"
 #include "bin/utils.h"
 
@@ -166,6 +167,88 @@ static void ReleaseFetchedBytes(uint8_t* buffer) {
   free(buffer);
 }
 
+// Kernel files mapped by TryMapKernelFile, so that ReleaseMappedKernel can
+// find the mapping of a buffer handed to the VM.
+class MappedKernelFile {
+ public:
+  MappedKernelFile(MappedMemory* mapping, MappedKernelFile* next)
+      : mapping_(mapping), next_(next) {}
+  ~MappedKernelFile() { delete mapping_; }
+
+  MappedMemory* mapping() const { return mapping_; }
+  MappedKernelFile* next() const { return next_; }
+  void set_next(MappedKernelFile* next) { next_ = next; }
+
+ private:
+  MappedMemory* mapping_;
+  MappedKernelFile* next_;
+
+  DISALLOW_COPY_AND_ASSIGN(MappedKernelFile);
+};
+
+static Mutex* mapped_kernel_files_mutex = new Mutex();
+static MappedKernelFile* mapped_kernel_files = NULL;
+
+static void ReleaseMappedKernel(uint8_t* buffer) {
+  MutexLocker ml(mapped_kernel_files_mutex);
+  MappedKernelFile* prev = NULL;
+  MappedKernelFile* current = mapped_kernel_files;
+  while (current != NULL) {
+    if (current->mapping()->address() == buffer) {
+      if (prev == NULL) {
+        mapped_kernel_files = current->next();
+      } else {
+        prev->set_next(current->next());
+      }
+      delete current;
+      return;
+    }
+    prev = current;
+    current = current->next();
+  }
+  UNREACHABLE();
+}
+
+// Maps [script_uri] read-only if it is a Kernel IR file, so that the pages
+// come straight from the file cache and are shared between processes
+// instead of being copied into a malloc'd buffer. Falls back to reading the
+// file when it cannot be mapped. Returns `true` if [script_uri] is a Kernel
+// IR file and sets [release] to the callback that frees [kernel_ir].
+static bool TryMapKernelFile(const char* script_uri,
+                             const uint8_t** kernel_ir,
+                             intptr_t* kernel_ir_size,
+                             Dart_ReleaseBufferCallback* release) {
+  *kernel_ir = NULL;
+  *kernel_ir_size = -1;
+  MappedMemory* mapping = NULL;
+  File* file = File::OpenUri(NULL, script_uri, File::kRead);
+  if (file != NULL) {
+    RefCntReleaseScope<File> rs(file);
+    const int64_t length = file->Length();
+    if ((length > 0) && (length <= kIntptrMax)) {
+      mapping = file->Map(File::kReadOnly, 0, length);
+    }
+  }
+  if (mapping == NULL) {
+    *release = ReleaseFetchedBytes;
+    return DFE::TryReadKernelFile(script_uri, kernel_ir, kernel_ir_size);
+  }
+  const uint8_t* buffer = reinterpret_cast<const uint8_t*>(mapping->address());
+  if (DartUtils::SniffForMagicNumber(buffer, mapping->size()) !=
+      DartUtils::kKernelMagicNumber) {
+    delete mapping;
+    return false;
+  }
+  {
+    MutexLocker ml(mapped_kernel_files_mutex);
+    mapped_kernel_files = new MappedKernelFile(mapping, mapped_kernel_files);
+  }
+  *kernel_ir = buffer;
+  *kernel_ir_size = mapping->size();
+  *release = ReleaseMappedKernel;
+  return true;
+}
+
 Dart_Handle DFE::ReadKernelBinary(Dart_Isolate isolate,
                                   const char* url_string) {
   ASSERT(!Dart_IsServiceIsolate(isolate) && !Dart_IsKernelIsolate(isolate));
@@ -173,7 +256,8 @@ Dart_Handle DFE::ReadKernelBinary(Dart_Isolate isolate,
   // skip the compilation step and directly reload the file.
   const uint8_t* kernel_ir = NULL;
   intptr_t kernel_ir_size = -1;
-  if (!TryReadKernelFile(url_string, &kernel_ir, &kernel_ir_size)) {
+  Dart_ReleaseBufferCallback release = ReleaseFetchedBytes;
+  if (!TryMapKernelFile(url_string, &kernel_ir, &kernel_ir_size, &release)) {
     // We have a source file, compile it into a kernel ir first.
     // TODO(asiva): We will have to change this API to pass in a list of files
     // that have changed. For now just pass in the main url_string and have it
@@ -187,9 +271,10 @@ Dart_Handle DFE::ReadKernelBinary(Dart_Isolate isolate,
     }
     kernel_ir = kresult.kernel;
     kernel_ir_size = kresult.kernel_size;
+    release = ReleaseFetchedBytes;
   }
   void* kernel_program =
-      Dart_ReadKernelBinary(kernel_ir, kernel_ir_size, ReleaseFetchedBytes);
+      Dart_ReadKernelBinary(kernel_ir, kernel_ir_size, release);
   ASSERT(kernel_program != NULL);
   return Dart_NewExternalTypedData(Dart_TypedData_kUint64, kernel_program, 1);
 }
@@ -272,9 +357,10 @@ void* DFE::CompileAndReadScript(const char* script_uri,
 void* DFE::ReadScript(const char* script_uri) const {
   const uint8_t* buffer = NULL;
   intptr_t buffer_length = -1;
-  bool result = TryReadKernelFile(script_uri, &buffer, &buffer_length);
+  Dart_ReleaseBufferCallback release = NULL;
+  bool result = TryMapKernelFile(script_uri, &buffer, &buffer_length, &release);
   if (result) {
-    return Dart_ReadKernelBinary(buffer, buffer_length, ReleaseFetchedBytes);
+    return Dart_ReadKernelBinary(buffer, buffer_length, release);
   }
   return NULL;
 }
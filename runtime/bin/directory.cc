@@ -322,7 +322,9 @@ CObject* Directory::ListNextRequest(const CObjectArray& request) {
   if (dir_listing->IsEmpty()) {
     return new CObjectArray(CObject::NewArray(0));
   }
-  const int kArraySize = 128;
+  // Each entry takes two slots. Large batches keep the number of round
+  // trips through the IO service low when listing big directory trees.
+  const int kArraySize = 1024;
   CObjectArray* response = new CObjectArray(CObject::NewArray(kArraySize));
   dir_listing->SetArray(response, kArraySize);
   Directory::List(dir_listing);
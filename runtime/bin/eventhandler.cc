@@ -19,6 +19,7 @@ void TimeoutQueue::UpdateTimeout(Dart_Port port, int64_t timeout) {
   // Find port if present.
   Timeout* last = NULL;
   Timeout* current = timeouts_;
+  bool rescan = false;
   while (current != NULL) {
     if (current->port() == port) {
       // Found.
@@ -29,10 +30,18 @@ void TimeoutQueue::UpdateTimeout(Dart_Port port, int64_t timeout) {
         } else {
           timeouts_ = current->next();
         }
+        rescan = (current == next_timeout_);
         delete current;
+      } else if (current == next_timeout_) {
+        // The next timeout only moves if it was pushed later.
+        rescan = (timeout > current->timeout());
+        current->set_timeout(timeout);
       } else {
         // Update timeout.
         current->set_timeout(timeout);
+        if (timeout < next_timeout_->timeout()) {
+          next_timeout_ = current;
+        }
       }
       break;
     }
@@ -42,6 +51,12 @@ void TimeoutQueue::UpdateTimeout(Dart_Port port, int64_t timeout) {
   if (current == NULL && timeout >= 0) {
     // Not found, create a new.
     timeouts_ = new Timeout(port, timeout, timeouts_);
+    if ((next_timeout_ == NULL) || (timeout < next_timeout_->timeout())) {
+      next_timeout_ = timeouts_;
+    }
+  }
+  if (!rescan) {
+    return;
   }
   // Clear and find next timeout.
   next_timeout_ = NULL;
@@ -54,15 +54,19 @@ static void RemoveFromEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
   VOID_NO_RETRY_EXPECTED(epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, di->fd(), NULL));
 }
 
-static void AddToEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
+// Register the file descriptor for a DescriptorInfo structure with epoll,
+// or update its events if it is already registered (op is EPOLL_CTL_ADD or
+// EPOLL_CTL_MOD).
+static void AddToEpollInstance(intptr_t epoll_fd_,
+                               DescriptorInfo* di,
+                               int op) {
   struct epoll_event event;
   event.events = EPOLLRDHUP | di->GetPollEvents();
   if (!di->IsListeningSocket()) {
     event.events |= EPOLLET;
   }
   event.data.ptr = di;
-  int status =
-      NO_RETRY_EXPECTED(epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, di->fd(), &event));
+  int status = NO_RETRY_EXPECTED(epoll_ctl(epoll_fd_, op, di->fd(), &event));
   if (status == -1) {
     // TODO(dart:io): Verify that the dart end is handling this correctly.
 
@@ -131,11 +135,10 @@ void EventHandlerImplementation::UpdateEpollInstance(intptr_t old_mask,
   if ((old_mask != 0) && (new_mask == 0)) {
     RemoveFromEpollInstance(epoll_fd_, di);
   } else if ((old_mask == 0) && (new_mask != 0)) {
-    AddToEpollInstance(epoll_fd_, di);
+    AddToEpollInstance(epoll_fd_, di, EPOLL_CTL_ADD);
   } else if ((old_mask != 0) && (new_mask != 0) && (old_mask != new_mask)) {
     ASSERT(!di->IsListeningSocket());
-    RemoveFromEpollInstance(epoll_fd_, di);
-    AddToEpollInstance(epoll_fd_, di);
+    AddToEpollInstance(epoll_fd_, di, EPOLL_CTL_MOD);
   }
 }
 
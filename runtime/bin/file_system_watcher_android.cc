@@ -104,7 +104,10 @@ static int InotifyEventToMask(struct inotify_event* e) {
 Dart_Handle FileSystemWatcher::ReadEvents(intptr_t id, intptr_t path_id) {
   USE(path_id);
   const intptr_t kEventSize = sizeof(struct inotify_event);
-  const intptr_t kBufferSize = kEventSize + NAME_MAX + 1;
+  // Room for several events with maximum-length names, so that a burst of
+  // changes is drained with few reads and native calls.
+  const intptr_t kMaxEventsPerRead = 16;
+  const intptr_t kBufferSize = kMaxEventsPerRead * (kEventSize + NAME_MAX + 1);
   uint8_t buffer[kBufferSize];
   intptr_t bytes = TEMP_FAILURE_RETRY(read(id, buffer, kBufferSize));
   if (bytes < 0) {
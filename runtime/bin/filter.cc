@@ -5,7 +5,6 @@
 #include "bin/filter.h"
 
 #include "bin/dartutils.h"
-#include "bin/io_buffer.h"
 
 #include "include/dart_api.h"
 
@@ -244,13 +243,16 @@ void FUNCTION_NAME(Filter_Processed)(Dart_NativeArguments args) {
   } else if (read == 0) {
     Dart_SetReturnValue(args, Dart_Null());
   } else {
-    uint8_t* io_buffer;
-    Dart_Handle result = IOBuffer::Allocate(read, &io_buffer);
-    if (Dart_IsNull(result)) {
-      Dart_SetReturnValue(args, DartUtils::NewDartOSError());
-      return;
+    // The output is copied out of the filter's buffer anyway, so copy it into
+    // a Dart heap buffer rather than malloc'ed storage with a finalizer.
+    Dart_Handle result = Dart_NewTypedData(Dart_TypedData_kUint8, read);
+    if (Dart_IsError(result)) {
+      Dart_PropagateError(result);
+    }
+    err = Dart_ListSetAsBytes(result, 0, filter->processed_buffer(), read);
+    if (Dart_IsError(err)) {
+      Dart_PropagateError(err);
     }
-    memmove(io_buffer, filter->processed_buffer(), read);
     Dart_SetReturnValue(args, result);
   }
 }
@@ -147,6 +147,7 @@ static const char* kSnapshotKindNames[] = {
   V(script_snapshot, script_snapshot_filename)                                 \
   V(dependencies, dependencies_filename)                                       \
   V(load_compilation_trace, load_compilation_trace_filename)                   \
+  V(load_type_feedback, load_type_feedback_filename)                           \
   V(package_root, commandline_package_root)                                    \
   V(packages, commandline_packages_file)                                       \
   V(save_obfuscation_map, obfuscation_map_filename)
@@ -1204,6 +1205,14 @@ static void CreateAndWritePrecompiledSnapshot(
   ASSERT(IsSnapshottingForPrecompilation());
   Dart_Handle result;
 
+  if (load_type_feedback_filename != NULL) {
+    uint8_t* buffer = NULL;
+    intptr_t size = 0;
+    ReadFile(load_type_feedback_filename, &buffer, &size);
+    result = Dart_LoadTypeFeedback(buffer, size);
+    CHECK_RESULT(result);
+  }
+
   // Precompile with specified embedder entry points
   result = Dart_Precompile(standalone_entry_points);
   CHECK_RESULT(result);
@@ -12,6 +12,14 @@ Dart_Handle IOBuffer::Allocate(intptr_t size, uint8_t** buffer) {
   if (data == NULL) {
     return Dart_Null();
   }
+  Dart_Handle result = Wrap(data, size);
+  if (buffer != NULL) {
+    *buffer = data;
+  }
+  return result;
+}
+
+Dart_Handle IOBuffer::Wrap(uint8_t* data, intptr_t size) {
   Dart_Handle result =
       Dart_NewExternalTypedData(Dart_TypedData_kUint8, data, size);
   Dart_NewWeakPersistentHandle(result, data, size, IOBuffer::Finalizer);
@@ -20,9 +28,6 @@ Dart_Handle IOBuffer::Allocate(intptr_t size, uint8_t** buffer) {
     Free(data);
     Dart_PropagateError(result);
   }
-  if (buffer != NULL) {
-    *buffer = data;
-  }
   return result;
 }
 
@@ -30,5 +35,9 @@ uint8_t* IOBuffer::Allocate(intptr_t size) {
   return reinterpret_cast<uint8_t*>(malloc(size));
 }
 
+uint8_t* IOBuffer::Reallocate(uint8_t* buffer, intptr_t new_size) {
+  return reinterpret_cast<uint8_t*>(realloc(buffer, new_size));
+}
+
 }  // namespace bin
 }  // namespace dart
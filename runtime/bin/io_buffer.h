@@ -20,6 +20,14 @@ class IOBuffer {
   // Allocate IO buffer storage.
   static uint8_t* Allocate(intptr_t size);
 
+  // Create an IO buffer dart object (of type Uint8List) that takes ownership
+  // of IO buffer storage of the given size.
+  static Dart_Handle Wrap(uint8_t* data, intptr_t size);
+
+  // Resize IO buffer storage. Returns NULL if the storage could not be
+  // resized, in which case the original storage is left untouched.
+  static uint8_t* Reallocate(uint8_t* buffer, intptr_t new_size);
+
   // Function for disposing of IO buffer storage. All backing storage
   // for IO buffers must be freed using this function.
   static void Free(void* buffer) { free(buffer); }
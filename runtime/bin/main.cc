@@ -957,6 +957,14 @@ bool RunMainIsolate(const char* script_name, CommandLineOptions* dart_options) {
         CHECK_RESULT(result);
         WriteFile(Options::save_compilation_trace_filename(), buffer, size);
       }
+
+      if (Options::save_type_feedback_filename() != NULL) {
+        uint8_t* buffer = NULL;
+        intptr_t size = 0;
+        result = Dart_SaveTypeFeedback(&buffer, &size);
+        CHECK_RESULT(result);
+        WriteFile(Options::save_type_feedback_filename(), buffer, size);
+      }
     }
   }
 
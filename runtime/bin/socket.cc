@@ -328,40 +328,34 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
     if (Socket::short_socket_read()) {
       length = (length + 1) / 2;
     }
-    uint8_t* buffer = NULL;
-    Dart_Handle result = IOBuffer::Allocate(length, &buffer);
-    if (Dart_IsNull(result)) {
+    // Read into plain storage first so that a short read can be trimmed in
+    // place instead of being copied into a second, smaller buffer.
+    uint8_t* buffer = IOBuffer::Allocate(length);
+    if (buffer == NULL) {
       Dart_SetReturnValue(args, DartUtils::NewDartOSError());
       return;
     }
-    if (Dart_IsError(result)) {
-      Dart_PropagateError(result);
-    }
-    ASSERT(buffer != NULL);
     intptr_t bytes_read =
         SocketBase::Read(socket->fd(), buffer, length, SocketBase::kAsync);
     if (bytes_read == length) {
-      Dart_SetReturnValue(args, result);
+      Dart_SetReturnValue(args, IOBuffer::Wrap(buffer, length));
     } else if (bytes_read > 0) {
-      uint8_t* new_buffer = NULL;
-      Dart_Handle new_result = IOBuffer::Allocate(bytes_read, &new_buffer);
-      if (Dart_IsNull(new_result)) {
-        Dart_SetReturnValue(args, DartUtils::NewDartOSError());
-        return;
-      }
-      if (Dart_IsError(new_result)) {
-        Dart_PropagateError(new_result);
+      uint8_t* new_buffer = IOBuffer::Reallocate(buffer, bytes_read);
+      if (new_buffer != NULL) {
+        buffer = new_buffer;
       }
-      ASSERT(new_buffer != NULL);
-      memmove(new_buffer, buffer, bytes_read);
-      Dart_SetReturnValue(args, new_result);
+      Dart_SetReturnValue(args, IOBuffer::Wrap(buffer, bytes_read));
     } else if (bytes_read == 0) {
       // On MacOS when reading from a tty Ctrl-D will result in reading one
       // less byte then reported as available.
+      IOBuffer::Free(buffer);
       Dart_SetReturnValue(args, Dart_Null());
     } else {
       ASSERT(bytes_read == -1);
-      Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+      // Create the error before freeing the buffer, which may clobber errno.
+      Dart_Handle error = DartUtils::NewDartOSError();
+      IOBuffer::Free(buffer);
+      Dart_SetReturnValue(args, error);
     }
   } else {
     OSError os_error(-1, "Invalid argument", OSError::kUnknown);
@@ -398,19 +392,18 @@ void FUNCTION_NAME(Socket_RecvFrom)(Dart_NativeArguments args) {
     return;
   }
 
-  // Datagram data read. Copy into buffer of the exact size,
+  // Datagram data read. Copy into a Dart heap buffer of the exact size.
+  // Datagrams are small and short-lived, so this avoids the malloc and weak
+  // persistent handle an external IOBuffer would need per datagram.
   ASSERT(bytes_read > 0);
-  uint8_t* data_buffer = NULL;
-  Dart_Handle data = IOBuffer::Allocate(bytes_read, &data_buffer);
-  if (Dart_IsNull(data)) {
-    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
-    return;
-  }
+  Dart_Handle data = Dart_NewTypedData(Dart_TypedData_kUint8, bytes_read);
   if (Dart_IsError(data)) {
     Dart_PropagateError(data);
   }
-  ASSERT(data_buffer != NULL);
-  memmove(data_buffer, recv_buffer, bytes_read);
+  Dart_Handle err = Dart_ListSetAsBytes(data, 0, recv_buffer, bytes_read);
+  if (Dart_IsError(err)) {
+    Dart_PropagateError(err);
+  }
 
   // Get the port and clear it in the sockaddr structure.
   int port = SocketAddress::GetAddrPort(addr);
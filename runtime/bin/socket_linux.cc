@@ -157,7 +157,10 @@ intptr_t ServerSocket::Accept(intptr_t fd) {
   intptr_t socket;
   struct sockaddr clientaddr;
   socklen_t addrlen = sizeof(clientaddr);
-  socket = TEMP_FAILURE_RETRY(accept(fd, &clientaddr, &addrlen));
+  // Use accept4 so the new socket is created non-blocking and close-on-exec
+  // without four extra fcntl calls per accepted connection.
+  socket = TEMP_FAILURE_RETRY(
+      accept4(fd, &clientaddr, &addrlen, SOCK_NONBLOCK | SOCK_CLOEXEC));
   if (socket == -1) {
     if (IsTemporaryAcceptError(errno)) {
       // We need to signal to the caller that this is actually not an
@@ -166,15 +169,6 @@ intptr_t ServerSocket::Accept(intptr_t fd) {
       ASSERT(kTemporaryFailure != -1);
       socket = kTemporaryFailure;
     }
-  } else {
-    if (!FDUtils::SetCloseOnExec(socket)) {
-      FDUtils::SaveErrorAndClose(socket);
-      return -1;
-    }
-    if (!FDUtils::SetNonBlocking(socket)) {
-      FDUtils::SaveErrorAndClose(socket);
-      return -1;
-    }
   }
   return socket;
 }
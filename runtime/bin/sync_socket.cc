@@ -219,28 +219,27 @@ void FUNCTION_NAME(SynchronousSocket_Read)(Dart_NativeArguments args) {
                                   "First parameter must be an integer."));
     return;
   }
-  uint8_t* buffer = NULL;
-  result = IOBuffer::Allocate(length, &buffer);
-  if (Dart_IsNull(result)) {
+  uint8_t* buffer = IOBuffer::Allocate(length);
+  if (buffer == NULL) {
     Dart_SetReturnValue(args, DartUtils::NewDartOSError());
     return;
   }
-  ASSERT(buffer != NULL);
   intptr_t bytes_read = SynchronousSocket::Read(socket->fd(), buffer, length);
   if (bytes_read == length) {
-    Dart_SetReturnValue(args, result);
+    Dart_SetReturnValue(args, IOBuffer::Wrap(buffer, length));
   } else if (bytes_read > 0) {
-    uint8_t* new_buffer = NULL;
-    Dart_Handle new_result = IOBuffer::Allocate(bytes_read, &new_buffer);
-    if (Dart_IsNull(new_result)) {
-      Dart_SetReturnValue(args, DartUtils::NewDartOSError());
-      return;
+    uint8_t* new_buffer = IOBuffer::Reallocate(buffer, bytes_read);
+    if (new_buffer != NULL) {
+      buffer = new_buffer;
     }
-    ASSERT(new_buffer != NULL);
-    memmove(new_buffer, buffer, bytes_read);
-    Dart_SetReturnValue(args, new_result);
-  } else if (bytes_read == -1) {
-    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    Dart_SetReturnValue(args, IOBuffer::Wrap(buffer, bytes_read));
+  } else if (bytes_read == 0) {
+    IOBuffer::Free(buffer);
+  } else {
+    ASSERT(bytes_read == -1);
+    Dart_Handle error = DartUtils::NewDartOSError();
+    IOBuffer::Free(buffer);
+    Dart_SetReturnValue(args, error);
   }
 }
 
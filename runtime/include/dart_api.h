@@ -955,6 +955,37 @@ DART_EXPORT void Dart_NotifyIdle(int64_t deadline);
  */
 DART_EXPORT void Dart_NotifyLowMemory();
 
+/**
+ * Sets goals for the garbage collector of the current isolate, which the VM
+ * uses to decide how far to grow each generation between collections.
+ *
+ * \param max_pause_micros The longest garbage collection pause to aim for.
+ *   Growth stops short of sizes whose collection is expected to take longer.
+ * \param max_gc_time_percent The fraction of time the isolate should spend
+ *   collecting garbage at most. The heap grows faster while this is exceeded.
+ *
+ * Zero means no goal. When the goals conflict, the pause goal wins.
+ *
+ * Requires there to be a current isolate.
+ */
+DART_EXPORT void Dart_SetGCGoals(int64_t max_pause_micros,
+                                 intptr_t max_gc_time_percent);
+
+/**
+ * Changes the maximum heap capacity of the current isolate, as initially
+ * given by the --new_gen_semi_max_size and --old_gen_heap_size flags.
+ *
+ * \param max_new_gen_semi_mb The maximum size of each new generation
+ *   semi-space, in MB. Must be positive.
+ * \param max_old_gen_mb The maximum capacity of the old generation, in MB,
+ *   or zero for no limit. Lowering it below the current capacity only
+ *   prevents further growth.
+ *
+ * Requires there to be a current isolate.
+ */
+DART_EXPORT void Dart_SetHeapCapacity(intptr_t max_new_gen_semi_mb,
+                                      intptr_t max_old_gen_mb);
+
 /**
  * Notifies the VM that the current thread should not be profiled until a
  * matching call to Dart_ThreadEnableProfiling is made.
@@ -3218,13 +3249,40 @@ DART_EXPORT Dart_Handle Dart_SaveCompilationTrace(uint8_t** buffer,
  * Compile all functions from data from Dart_SaveCompilationTrace. Unlike JIT
  * feedback, this data is fuzzy: loading does not need to happen in the exact
  * program that was saved, the saver and loader do not need to agree on checked
- * mode versus production mode or debug/release/product.
+ * mode versus production mode or debug/release/product. When it is loaded into
+ * the same program that was saved, functions that were optimized are also
+ * optimized again after a few invocations instead of after a full warm-up.
  *
  * \return Returns an error handle if a compilation error was encountered.
  */
 DART_EXPORT Dart_Handle Dart_LoadCompilationTrace(uint8_t* buffer,
                                                   intptr_t buffer_length);
 
+/**
+ * Record the receiver classes seen by the instance calls of all functions
+ * that have unoptimized code in the current isolate.
+ *
+ * \param buffer Returns a pointer to a buffer containing the feedback.
+ *   This buffer is scope allocated and is only valid  until the next call to
+ *   Dart_ExitScope.
+ * \param size Returns the size of the buffer.
+ * \return Returns an valid handle upon success.
+ */
+DART_EXPORT Dart_Handle Dart_SaveTypeFeedback(uint8_t** buffer,
+                                              intptr_t* buffer_length);
+
+/**
+ * Provide data from Dart_SaveTypeFeedback to the next call to Dart_Precompile,
+ * which uses it to devirtualize and inline the receiver classes that were
+ * common in the training run. Like a compilation trace, the data is matched
+ * by name and call site position; call sites that changed are ignored.
+ *
+ * \return Returns an error handle if precompilation is not supported or the
+ *   feedback is malformed or truncated.
+ */
+DART_EXPORT Dart_Handle Dart_LoadTypeFeedback(uint8_t* buffer,
+                                              intptr_t buffer_length);
+
 /*
  * ==============
  * Precompilation
@@ -41,6 +41,59 @@ DEFINE_NATIVE_ENTRY(List_getLength, 1) {
   return Smi::New(array.Length());
 }
 
+// Returns the backing store and length of a VM list, or false if 'list' is
+// not a _List, _ImmutableList or _GrowableList.
+static bool GetListData(const Instance& list, Array* data, intptr_t* length) {
+  if (list.IsArray()) {
+    *data ^= list.raw();
+    *length = data->Length();
+    return true;
+  }
+  if (list.IsGrowableObjectArray()) {
+    const GrowableObjectArray& growable = GrowableObjectArray::Cast(list);
+    *data = growable.data();
+    *length = growable.Length();
+    return true;
+  }
+  return false;
+}
+
+// _List or _GrowableList to, int start, int count, Iterable from,
+// int skipCount.
+// Copies count elements of 'from', starting at skipCount, into 'to' starting
+// at start. Returns false without copying anything if 'from' is not a VM list
+// or does not have enough elements, so that the caller can fall back to the
+// generic implementation and report the error.
+DEFINE_NATIVE_ENTRY(List_copyFromList, 5) {
+  const Instance& to = Instance::CheckedHandle(arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, count, arguments->NativeArgAt(2));
+  const Instance& from = Instance::CheckedHandle(arguments->NativeArgAt(3));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, skip_count, arguments->NativeArgAt(4));
+  Array& to_data = Array::Handle();
+  intptr_t to_length = 0;
+  if (!GetListData(to, &to_data, &to_length)) {
+    UNREACHABLE();
+  }
+  const intptr_t istart = start.Value();
+  const intptr_t icount = count.Value();
+  // The destination range is checked by setRange already.
+  if ((istart < 0) || (icount <= 0) || (istart > to_length - icount)) {
+    Exceptions::ThrowRangeError("start", start, 0, to_length - icount);
+  }
+  Array& from_data = Array::Handle();
+  intptr_t from_length = 0;
+  if (!GetListData(from, &from_data, &from_length)) {
+    return Bool::False().raw();
+  }
+  const intptr_t iskip_count = skip_count.Value();
+  if ((iskip_count < 0) || (iskip_count > from_length - icount)) {
+    return Bool::False().raw();
+  }
+  to_data.CopyFrom(istart, from_data, iskip_count, icount);
+  return Bool::True().raw();
+}
+
 // ObjectArray src, int start, int count, bool needTypeArgument.
 DEFINE_NATIVE_ENTRY(List_slice, 4) {
   const Array& src = Array::CheckedHandle(arguments->NativeArgAt(0));
@@ -42,6 +42,9 @@ class _List<E> extends FixedLengthListBase<E> {
     }
     int length = end - start;
     if (length == 0) return;
+    if (length > 64 && _copyFromList(start, length, iterable, skipCount)) {
+      return;
+    }
     if (identical(this, iterable)) {
       Lists.copy(this, skipCount, this, start, length);
     } else if (ClassID.getID(iterable) == ClassID.cidArray) {
@@ -62,6 +65,10 @@ class _List<E> extends FixedLengthListBase<E> {
     }
   }
 
+  // Copies with memmove if [from] is a VM list with enough elements.
+  bool _copyFromList(int start, int count, Iterable<E> from, int skipCount)
+      native "List_copyFromList";
+
   List<E> sublist(int start, [int end]) {
     end = RangeError.checkValidRange(start, end, this.length);
     int length = end - start;
@@ -1423,7 +1423,10 @@ class _BigIntImpl implements BigInt {
     final modulusUsed2p4 = 2 * modulusUsed + 4;
     final exponentBitlen = exponent.bitLength;
     if (exponentBitlen <= 0) return one;
-    _BigIntReduction z = new _BigIntClassic(modulus);
+    _BigIntReduction z = modulus.isOdd
+        ? new _BigIntMontgomery(modulus)
+        : new _BigIntClassic(modulus);
+    final exponentDigits = exponent._digits;
     var resultDigits = new Uint32List(modulusUsed2p4);
     var result2Digits = new Uint32List(modulusUsed2p4);
     var gDigits = new Uint32List(modulusUsed);
@@ -1437,7 +1440,8 @@ class _BigIntImpl implements BigInt {
     var result2Used;
     for (int i = exponentBitlen - 2; i >= 0; i--) {
       result2Used = z.sqr(resultDigits, resultUsed, result2Digits);
-      if (!(exponent & (one << i))._isZero) {
+      // Test bit i of the exponent without allocating intermediate BigInts.
+      if ((exponentDigits[i ~/ _digitBits] >> (i % _digitBits)) & 1 != 0) {
         resultUsed =
             z.mul(result2Digits, result2Used, gDigits, gUsed, resultDigits);
       } else {
@@ -2120,3 +2124,123 @@ class _BigIntClassic implements _BigIntReduction {
     return _reduce(resultDigits, resultUsed);
   }
 }
+
+// Modular reduction using Montgomery's algorithm. Only valid for odd moduli.
+//
+// Values are kept in Montgomery form x*R mod m, with R = _digitBase^n and n
+// the number of digits of the modulus, so that each reduction is n
+// multiply-adds of the modulus instead of a long division.
+class _BigIntMontgomery implements _BigIntReduction {
+  final _BigIntImpl _modulus; // Modulus.
+  final int _modulusUsed2p2; // Size of the digit arrays passed to _reduce.
+  final int _rho; // -1/_modulus mod _digitBase.
+
+  _BigIntMontgomery(_BigIntImpl modulus)
+      : _modulus = modulus,
+        _modulusUsed2p2 = 2 * modulus._used + 2,
+        _rho = _negInvDigit(modulus._digits[0]) {
+    assert(modulus.isOdd);
+  }
+
+  // Calculates -1/x mod _digitBase for an odd digit x.
+  //         xy == 1 (mod m)
+  //         xy =  1+km
+  //   xy(2-xy) = (1+km)(1-km)
+  // x(y(2-xy)) = 1-k^2 m^2
+  // x(y(2-xy)) == 1 (mod m^2)
+  // If y is 1/x mod m, then y(2-xy) is 1/x mod m^2.
+  static int _negInvDigit(int x) {
+    var y = x & 3; // y == 1/x mod 2^2
+    y = (y * (2 - (x & 0xf) * y)) & 0xf; // y == 1/x mod 2^4
+    y = (y * (2 - (x & 0xff) * y)) & 0xff; // y == 1/x mod 2^8
+    y = (y * (2 - (((x & 0xffff) * y) & 0xffff))) & 0xffff; // mod 2^16
+    y = (y * (2 - x * y % _BigIntImpl._digitBase)) % _BigIntImpl._digitBase;
+    // y == 1/x mod _digitBase.
+    y = -y & _BigIntImpl._digitMask;
+    assert(((x * y) & _BigIntImpl._digitMask) == _BigIntImpl._digitMask);
+    return y;
+  }
+
+  // Returns _rho * digit mod _digitBase, computed on half digits so that no
+  // intermediate result exceeds 33 bits.
+  int _mulMod(int digit) {
+    const int halfDigitBits = _BigIntImpl._halfDigitBits;
+    const int halfDigitMask = _BigIntImpl._halfDigitMask;
+    final rhol = _rho & halfDigitMask;
+    final rhoh = _rho >> halfDigitBits;
+    final dl = digit & halfDigitMask;
+    final dh = digit >> halfDigitBits;
+    return (dl * rhol +
+            (((dl * rhoh + dh * rhol) & halfDigitMask) << halfDigitBits)) &
+        _BigIntImpl._digitMask;
+  }
+
+  // Returns x*R mod _modulus in resultDigits.
+  int convert(_BigIntImpl x, Uint32List resultDigits) {
+    var remainder = x.abs()._dlShift(_modulus._used)._rem(_modulus);
+    if (x._isNegative && remainder._used > 0) {
+      remainder = _modulus - remainder;
+    }
+    assert(!remainder._isNegative);
+    var used = remainder._used;
+    var digits = remainder._digits;
+    var i = used; // Copy leading zero if any.
+    while (--i >= 0) {
+      resultDigits[i] = digits[i];
+    }
+    return used;
+  }
+
+  _BigIntImpl revert(Uint32List xDigits, int xUsed) {
+    var resultDigits = new Uint32List(_modulusUsed2p2);
+    for (var i = 0; i < xUsed; i++) {
+      resultDigits[i] = xDigits[i];
+    }
+    var resultUsed = _reduce(resultDigits, xUsed);
+    return new _BigIntImpl._(false, resultUsed, resultDigits);
+  }
+
+  // Replaces xDigits[0..xUsed-1] = x with x/R mod _modulus, for x < R*_modulus.
+  // xDigits must have room for 2*n+1 digits.
+  int _reduce(Uint32List xDigits, int xUsed) {
+    final modulusDigits = _modulus._digits;
+    final modulusUsed = _modulus._used;
+    assert(xUsed <= 2 * modulusUsed);
+    // The multiply-adds below accumulate into the digits above xUsed.
+    for (var i = xUsed; i <= 2 * modulusUsed; i++) {
+      xDigits[i] = 0;
+    }
+    // Add multiples of the modulus to clear the low n digits.
+    for (var i = 0; i < modulusUsed; i++) {
+      _BigIntImpl._mulAdd(
+          _mulMod(xDigits[i]), modulusDigits, 0, xDigits, i, modulusUsed);
+    }
+    // Divide by R and bring the result, which is below 2*_modulus, into range.
+    var resultUsed = modulusUsed + 1;
+    for (var i = 0; i < resultUsed; i++) {
+      xDigits[i] = xDigits[i + modulusUsed];
+    }
+    resultUsed = _BigIntImpl._normalize(resultUsed, xDigits);
+    if (_BigIntImpl._compareDigits(
+            xDigits, resultUsed, modulusDigits, modulusUsed) >=
+        0) {
+      _BigIntImpl._absSub(
+          xDigits, resultUsed, modulusDigits, modulusUsed, xDigits);
+      resultUsed = _BigIntImpl._normalize(resultUsed, xDigits);
+    }
+    return resultUsed;
+  }
+
+  int sqr(Uint32List xDigits, int xUsed, Uint32List resultDigits) {
+    var resultUsed =
+        _BigIntImpl._mulDigits(xDigits, xUsed, xDigits, xUsed, resultDigits);
+    return _reduce(resultDigits, resultUsed);
+  }
+
+  int mul(Uint32List xDigits, int xUsed, Uint32List yDigits, int yUsed,
+      Uint32List resultDigits) {
+    var resultUsed =
+        _BigIntImpl._mulDigits(xDigits, xUsed, yDigits, yUsed, resultDigits);
+    return _reduce(resultDigits, resultUsed);
+  }
+}
@@ -103,6 +103,12 @@ abstract class _HashBase implements _HashVMBase {
 
   static int _nextProbe(int i, int sizeMask) => (i + 1) & sizeMask;
 
+  // Whether a table of [indexSize] can be halved and still have room for
+  // twice [liveEntries]. Used when rehashing away deleted entries, so that
+  // tables which have shed most of their entries give the memory back.
+  static bool _canShrink(int indexSize, int liveEntries) =>
+      indexSize > _INITIAL_INDEX_SIZE && (indexSize >> 2) >= (liveEntries << 1);
+
   // A self-loop is used to mark a deleted key or value.
   static bool _isDeleted(List data, Object keyOrValue) =>
       identical(keyOrValue, data);
@@ -156,18 +162,45 @@ abstract class _LinkedHashMapMixin<K, V> implements _HashVMBase {
 
   void _rehash() {
     if ((_deletedKeys << 2) > _usedData) {
-      // TODO(koda): Consider shrinking.
       // TODO(koda): Consider in-place compaction and more costly CME check.
-      _init(_index.length, _hashMask, _data, _usedData);
+      int size = _index.length;
+      int hashMask = _hashMask;
+      while (_HashBase._canShrink(size, length)) {
+        size >>= 1;
+        hashMask = (hashMask << 1) | 1;
+      }
+      _init(size, hashMask, _data, _usedData);
     } else {
       // TODO(koda): Support 32->64 bit transition (and adjust _hashMask).
       _init(_index.length << 1, _hashMask >> 1, _data, _usedData);
     }
   }
 
+  // Grows the table up front so that [extra] more entries can be added
+  // without intermediate rehashes.
+  void _reserve(int extra) {
+    final int needed = (_usedData >> 1) + extra;
+    int size = _index.length;
+    if (needed <= (size >> 1)) return;
+    int hashMask = _hashMask;
+    while ((size >> 1) < needed) {
+      size <<= 1;
+      hashMask >>= 1;
+    }
+    _init(size, hashMask, _data, _usedData);
+  }
+
+  void addAll(Map<K, V> other) {
+    _reserve(other.length);
+    other.forEach((K key, V value) {
+      this[key] = value;
+    });
+  }
+
   void clear() {
     if (!isEmpty) {
-      _init(_data.length, _hashMask, null, 0);
+      final int size = _HashBase._INITIAL_INDEX_SIZE;
+      _init(size, _HashBase._indexSizeToHashMask(size), null, 0);
     }
   }
 
@@ -469,7 +502,13 @@ class _CompactLinkedHashSet<E> extends _HashFieldBase
 
   void _rehash() {
     if ((_deletedKeys << 1) > _usedData) {
-      _init(_index.length, _hashMask, _data, _usedData);
+      int size = _index.length;
+      int hashMask = _hashMask;
+      while (_HashBase._canShrink(size, length)) {
+        size >>= 1;
+        hashMask = (hashMask << 1) | 1;
+      }
+      _init(size, hashMask, _data, _usedData);
     } else {
       _init(_index.length << 1, _hashMask >> 1, _data, _usedData);
     }
@@ -477,7 +516,8 @@ class _CompactLinkedHashSet<E> extends _HashFieldBase
 
   void clear() {
     if (!isEmpty) {
-      _init(_index.length, _hashMask, null, 0);
+      final int size = _HashBase._INITIAL_INDEX_SIZE;
+      _init(size, _HashBase._indexSizeToHashMask(size), null, 0);
     }
   }
 
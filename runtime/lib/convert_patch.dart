@@ -48,10 +48,28 @@ class Utf8Decoder {
   @patch
   static String _convertIntercepted(
       bool allowMalformed, List<int> codeUnits, int start, int end) {
-    return null; // This call was not intercepted.
+    if (codeUnits is! Uint8List) {
+      return null; // This call was not intercepted.
+    }
+    end = RangeError.checkValidRange(start, end, codeUnits.length);
+    // A leading byte order mark is discarded, as in [_Utf8Decoder].
+    if (end - start >= 3 &&
+        codeUnits[start] == 0xEF &&
+        codeUnits[start + 1] == 0xBB &&
+        codeUnits[start + 2] == 0xBF) {
+      start += 3;
+    }
+    // Returns null for malformed input, which is then reported (or replaced,
+    // if allowMalformed is set) by the general decoder.
+    return _decodeUint8List(codeUnits, start, end);
   }
 }
 
+// Decodes well-formed UTF-8 from a Uint8List in the VM. Returns null if
+// [codeUnits] is not a VM-allocated Uint8List or contains malformed UTF-8.
+String _decodeUint8List(List<int> codeUnits, int start, int end)
+    native "Utf8Decoder_decodeUint8List";
+
 class _JsonUtf8Decoder extends Converter<List<int>, Object> {
   final _Reviver _reviver;
   final bool _allowMalformed;
@@ -1735,6 +1753,10 @@ class _JsonUtf8Parser extends _ChunkedJsonParser<List<int>> {
     if (bits <= maxAsciiChar) {
       return new String.fromCharCodes(chunk, start, end);
     }
+    if (chunk is Uint8List) {
+      String result = _decodeUint8List(chunk, start, end);
+      if (result != null) return result;
+    }
     beginString();
     if (start < end) addSliceToString(start, end);
     String result = endString();
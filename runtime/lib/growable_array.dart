@@ -70,6 +70,19 @@ class _GrowableList<T> extends ListBase<T> {
     }
   }
 
+  void setRange(int start, int end, Iterable<T> iterable, [int skipCount = 0]) {
+    RangeError.checkValidRange(start, end, this.length);
+    int length = end - start;
+    if (length > 64 && _copyFromList(start, length, iterable, skipCount)) {
+      return;
+    }
+    super.setRange(start, end, iterable, skipCount);
+  }
+
+  // Copies with memmove if [from] is a VM list with enough elements.
+  bool _copyFromList(int start, int count, Iterable<T> from, int skipCount)
+      native "List_copyFromList";
+
   void removeRange(int start, int end) {
     RangeError.checkValidRange(start, end, this.length);
     Lists.copy(this, end, this, start, this.length - end);
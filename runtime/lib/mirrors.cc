@@ -583,6 +583,22 @@ static RawInstance* ReturnResult(const Object& result) {
   return Instance::null();
 }
 
+// Returns the getter name for 'field_name', as an existing symbol if there is
+// one. Function names are symbols, so member lookup with a symbol compares
+// names by identity instead of character by character. If no such symbol
+// exists, no member can have that name and a plain string is returned for use
+// in noSuchMethod.
+static RawString* GetterNameForLookup(const String& field_name) {
+  const String& symbol = String::Handle(Field::LookupGetterSymbol(field_name));
+  return symbol.IsNull() ? Field::GetterName(field_name) : symbol.raw();
+}
+
+// Setter counterpart of GetterNameForLookup.
+static RawString* SetterNameForLookup(const String& field_name) {
+  const String& symbol = String::Handle(Field::LookupSetterSymbol(field_name));
+  return symbol.IsNull() ? Field::SetterName(field_name) : symbol.raw();
+}
+
 // Invoke the function, or noSuchMethod if it is null. Propagate any unhandled
 // exceptions. Wrap and propagate any compilation errors.
 static RawInstance* InvokeDynamicFunction(const Instance& receiver,
@@ -616,7 +632,7 @@ static RawInstance* InvokeLibraryGetter(const Library& library,
   if (field.IsNull()) {
     // No field found. Check for a getter in the lib.
     const String& internal_getter_name =
-        String::Handle(Field::GetterName(getter_name));
+        String::Handle(GetterNameForLookup(getter_name));
     getter = library.LookupLocalFunction(internal_getter_name);
     if (getter.IsNull()) {
       getter = library.LookupLocalFunction(getter_name);
@@ -635,7 +651,7 @@ static RawInstance* InvokeLibraryGetter(const Library& library,
     // owner class.
     const Class& klass = Class::Handle(field.Owner());
     const String& internal_getter_name =
-        String::Handle(Field::GetterName(getter_name));
+        String::Handle(GetterNameForLookup(getter_name));
     getter = klass.LookupStaticFunction(internal_getter_name);
   }
 
@@ -667,7 +683,7 @@ static RawInstance* InvokeClassGetter(const Class& klass,
   const Field& field = Field::Handle(klass.LookupStaticField(getter_name));
   if (field.IsNull() || field.IsUninitialized()) {
     const String& internal_getter_name =
-        String::Handle(Field::GetterName(getter_name));
+        String::Handle(GetterNameForLookup(getter_name));
     Function& getter =
         Function::Handle(klass.LookupStaticFunction(internal_getter_name));
 
@@ -1290,7 +1306,7 @@ DEFINE_NATIVE_ENTRY(InstanceMirror_invoke, 5) {
   if (function.IsNull()) {
     // Didn't find a method: try to find a getter and invoke call on its result.
     const String& getter_name =
-        String::Handle(zone, Field::GetterName(function_name));
+        String::Handle(zone, GetterNameForLookup(function_name));
     function = Resolver::ResolveDynamicAnyArgs(zone, klass, getter_name);
     if (!function.IsNull()) {
       ASSERT(function.kind() != RawFunction::kMethodExtractor);
@@ -1330,7 +1346,7 @@ DEFINE_NATIVE_ENTRY(InstanceMirror_invokeGetter, 3) {
   Class& klass = Class::Handle(reflectee.clazz());
 
   const String& internal_getter_name =
-      String::Handle(Field::GetterName(getter_name));
+      String::Handle(GetterNameForLookup(getter_name));
   Function& function = Function::Handle(
       zone, Resolver::ResolveDynamicAnyArgs(zone, klass, internal_getter_name));
 
@@ -1366,7 +1382,7 @@ DEFINE_NATIVE_ENTRY(InstanceMirror_invokeSetter, 4) {
 
   const Class& klass = Class::Handle(zone, reflectee.clazz());
   const String& internal_setter_name =
-      String::Handle(zone, Field::SetterName(setter_name));
+      String::Handle(zone, SetterNameForLookup(setter_name));
   const Function& setter = Function::Handle(
       zone, Resolver::ResolveDynamicAnyArgs(zone, klass, internal_setter_name));
 
@@ -1449,7 +1465,7 @@ DEFINE_NATIVE_ENTRY(ClassMirror_invoke, 5) {
   if (function.IsNull()) {
     // Didn't find a method: try to find a getter and invoke call on its result.
     const String& getter_name =
-        String::Handle(Field::GetterName(function_name));
+        String::Handle(GetterNameForLookup(function_name));
     function = klass.LookupStaticFunction(getter_name);
     if (!function.IsNull()) {
       // Invoke the getter.
@@ -1538,7 +1554,7 @@ DEFINE_NATIVE_ENTRY(ClassMirror_invokeSetter, 4) {
   const Field& field = Field::Handle(klass.LookupStaticField(setter_name));
   Function& setter = Function::Handle();
   const String& internal_setter_name =
-      String::Handle(Field::SetterName(setter_name));
+      String::Handle(SetterNameForLookup(setter_name));
 
   if (field.IsNull()) {
     setter = klass.LookupStaticFunction(internal_setter_name);
@@ -1821,7 +1837,7 @@ DEFINE_NATIVE_ENTRY(LibraryMirror_invokeSetter, 4) {
   const Field& field = Field::Handle(library.LookupLocalField(setter_name));
   Function& setter = Function::Handle();
   const String& internal_setter_name =
-      String::Handle(Field::SetterName(setter_name));
+      String::Handle(SetterNameForLookup(setter_name));
 
   if (field.IsNull()) {
     setter = library.LookupLocalFunction(internal_setter_name);
@@ -286,6 +286,16 @@ DEFINE_NATIVE_ENTRY(OneByteString_splitWithCharCode, 2) {
   return result.raw();
 }
 
+DEFINE_NATIVE_ENTRY(OneByteString_indexOf, 3) {
+  const String& receiver =
+      String::CheckedHandle(zone, arguments->NativeArgAt(0));
+  ASSERT(receiver.IsOneByteString());
+  GET_NON_NULL_NATIVE_ARGUMENT(String, pattern, arguments->NativeArgAt(1));
+  ASSERT(pattern.IsOneByteString());
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_obj, arguments->NativeArgAt(2));
+  return Smi::New(OneByteString::IndexOf(receiver, pattern, start_obj.Value()));
+}
+
 DEFINE_NATIVE_ENTRY(OneByteString_allocate, 1) {
   GET_NON_NULL_NATIVE_ARGUMENT(Smi, length_obj, arguments->NativeArgAt(0));
   return OneByteString::New(length_obj.Value(), Heap::kNew);
@@ -377,6 +387,46 @@ DEFINE_NATIVE_ENTRY(OneByteString_allocateFromOneByteList, 3) {
   return Object::null();
 }
 
+// Decodes the UTF-8 bytes [start, end[ of a Uint8List into a string. The
+// bytes are copied out first since the array may move while the result is
+// allocated. Returns null if the input is not valid UTF-8, leaving the Dart
+// decoder to report or replace the malformed sequences.
+template <typename ArrayType>
+static RawObject* DecodeUtf8(Zone* zone,
+                             const ArrayType& array,
+                             intptr_t start,
+                             intptr_t end) {
+  if ((start < 0) || (start > end) || (end > array.LengthInBytes())) {
+    return Object::null();
+  }
+  const intptr_t length = end - start;
+  uint8_t* utf8 = zone->Alloc<uint8_t>(length);
+  {
+    NoSafepointScope no_safepoint;
+    memmove(utf8, array.DataAddr(start), length);
+  }
+  if (!Utf8::IsValid(utf8, length)) {
+    return Object::null();
+  }
+  return String::FromUTF8(utf8, length);
+}
+
+DEFINE_NATIVE_ENTRY(Utf8Decoder_decodeUint8List, 3) {
+  const Instance& list =
+      Instance::CheckedHandle(zone, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_obj, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, end_obj, arguments->NativeArgAt(2));
+  const intptr_t start = start_obj.Value();
+  const intptr_t end = end_obj.Value();
+  const intptr_t cid = list.GetClassId();
+  if (cid == kTypedDataUint8ArrayCid) {
+    return DecodeUtf8(zone, TypedData::Cast(list), start, end);
+  } else if (cid == kExternalTypedDataUint8ArrayCid) {
+    return DecodeUtf8(zone, ExternalTypedData::Cast(list), start, end);
+  }
+  return Object::null();
+}
+
 DEFINE_NATIVE_ENTRY(OneByteString_setAt, 3) {
   GET_NON_NULL_NATIVE_ARGUMENT(String, receiver, arguments->NativeArgAt(0));
   ASSERT(receiver.IsOneByteString());
@@ -472,10 +522,14 @@ DEFINE_NATIVE_ENTRY(TwoByteString_allocateFromTwoByteList, 3) {
   return Object::null();
 }
 
-DEFINE_NATIVE_ENTRY(String_getHashCode, 1) {
-  const String& receiver =
-      String::CheckedHandle(zone, arguments->NativeArgAt(0));
-  intptr_t hash_val = receiver.Hash();
+DEFINE_LEAF_NATIVE_ENTRY(String_getHashCode, 1) {
+  RawString* receiver = static_cast<RawString*>(arguments->NativeArgAt(0));
+  ASSERT(receiver->IsStringInstance());
+  intptr_t hash_val = String::GetCachedHash(receiver);
+  if (hash_val == 0) {
+    hash_val = String::Hash(receiver);
+    String::SetCachedHash(receiver, hash_val);
+  }
   ASSERT(hash_val > 0);
   ASSERT(Smi::IsValid(hash_val));
   return Smi::New(hash_val);
@@ -521,6 +575,14 @@ DEFINE_NATIVE_ENTRY(String_concat, 2) {
   const String& receiver =
       String::CheckedHandle(zone, arguments->NativeArgAt(0));
   GET_NON_NULL_NATIVE_ARGUMENT(String, b, arguments->NativeArgAt(1));
+  // Strings are immutable, so appending an empty string can return the other
+  // operand instead of allocating and copying a new one.
+  if (b.Length() == 0) {
+    return receiver.raw();
+  }
+  if (receiver.Length() == 0) {
+    return b.raw();
+  }
   return String::Concat(receiver, b);
 }
 
@@ -944,6 +944,9 @@ class _OneByteString extends _StringBase {
   List<String> _splitWithCharCode(int charCode)
       native "OneByteString_splitWithCharCode";
 
+  int _indexOfOneByteString(_OneByteString pattern, int start)
+      native "OneByteString_indexOf";
+
   List<String> split(Pattern pattern) {
     // TODO(vegorov) investigate if this can be rewritten as `is _OneByteString`
     // check without performance penalty. Front-end would then promote
@@ -996,6 +999,11 @@ class _OneByteString extends _StringBase {
         }
         return -1;
       }
+      if ((pCid == ClassID.cidOneByteString) &&
+          (start >= 0) &&
+          (start <= len)) {
+        return _indexOfOneByteString(pattern, start);
+      }
     }
     return super.indexOf(pattern, start);
   }
@@ -1019,6 +1027,11 @@ class _OneByteString extends _StringBase {
         }
         return false;
       }
+      if ((pCid == ClassID.cidOneByteString) &&
+          (start >= 0) &&
+          (start <= len)) {
+        return _indexOfOneByteString(pattern, start) >= 0;
+      }
     }
     return super.contains(pattern, start);
   }
@@ -43,7 +43,11 @@ DEFINE_NATIVE_ENTRY(Timeline_getTraceClock, 0) {
 }
 
 DEFINE_NATIVE_ENTRY(Timeline_getThreadCpuClock, 0) {
+#if defined(PRODUCT)
   return Integer::New(OS::GetCurrentThreadCPUMicros(), Heap::kNew);
+#else
+  return Integer::New(Timeline::GetCurrentThreadCPUMicros(), Heap::kNew);
+#endif
 }
 
 DEFINE_NATIVE_ENTRY(Timeline_reportTaskEvent, 6) {
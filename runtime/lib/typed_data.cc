@@ -144,6 +144,30 @@ DEFINE_NATIVE_ENTRY(TypedData_setRange, 7) {
   return Bool::False().raw();
 }
 
+DEFINE_NATIVE_ENTRY(TypedData_fillRange, 4) {
+  const Instance& dst = Instance::CheckedHandle(arguments->NativeArgAt(0));
+  const Smi& start = Smi::CheckedHandle(arguments->NativeArgAt(1));
+  const Smi& length = Smi::CheckedHandle(arguments->NativeArgAt(2));
+  const Smi& element_size = Smi::CheckedHandle(arguments->NativeArgAt(3));
+
+  if (dst.IsTypedData()) {
+    const TypedData& array = TypedData::Cast(dst);
+    RangeCheck(start.Value(), length.Value(), array.LengthInBytes(),
+               element_size.Value());
+    TypedData::Fill<TypedData>(array, start.Value(), length.Value(),
+                               element_size.Value());
+  } else if (dst.IsExternalTypedData()) {
+    const ExternalTypedData& array = ExternalTypedData::Cast(dst);
+    RangeCheck(start.Value(), length.Value(), array.LengthInBytes(),
+               element_size.Value());
+    TypedData::Fill<ExternalTypedData>(array, start.Value(), length.Value(),
+                                       element_size.Value());
+  } else {
+    UNREACHABLE();
+  }
+  return Object::null();
+}
+
 // We check the length parameter against a possible maximum length for the
 // array based on available physical addressable memory on the system. The
 // maximum possible length is a scaled value of kSmiMax which is set up based
@@ -103,6 +103,11 @@ abstract class _TypedListBase {
   // Element size of toCid and fromCid must match (test at caller).
   bool _setRange(int startInBytes, int lengthInBytes, _TypedListBase from,
       int startFromInBytes, int toCid, int fromCid) native "TypedData_setRange";
+
+  // Replicates the element of 'elementSizeInBytes' bytes at 'startInBytes'
+  // over the 'lengthInBytes' bytes starting there.
+  void _fillRange(int startInBytes, int lengthInBytes, int elementSizeInBytes)
+      native "TypedData_fillRange";
 }
 
 abstract class _IntListMixin implements List<int> {
@@ -453,9 +458,18 @@ abstract class _IntListMixin implements List<int> {
 
   void fillRange(int start, int end, [int fillValue]) {
     RangeError.checkValidRange(start, end, this.length);
-    for (var i = start; i < end; ++i) {
-      this[i] = fillValue;
+    final count = end - start;
+    if (count < 10) {
+      for (var i = start; i < end; ++i) {
+        this[i] = fillValue;
+      }
+      return;
     }
+    // Store the first element to get the value converted to the element
+    // type, then replicate its bytes over the rest of the range.
+    this[start] = fillValue;
+    this.buffer._data._fillRange(start * elementSizeInBytes + offsetInBytes,
+        count * elementSizeInBytes, elementSizeInBytes);
   }
 }
 
@@ -810,9 +824,18 @@ abstract class _DoubleListMixin implements List<double> {
 
   void fillRange(int start, int end, [double fillValue]) {
     RangeError.checkValidRange(start, end, this.length);
-    for (var i = start; i < end; ++i) {
-      this[i] = fillValue;
+    final count = end - start;
+    if (count < 10) {
+      for (var i = start; i < end; ++i) {
+        this[i] = fillValue;
+      }
+      return;
     }
+    // Store the first element to get the value converted to the element
+    // type, then replicate its bytes over the rest of the range.
+    this[start] = fillValue;
+    this.buffer._data._fillRange(start * elementSizeInBytes + offsetInBytes,
+        count * elementSizeInBytes, elementSizeInBytes);
   }
 }
 
@@ -1171,9 +1194,18 @@ abstract class _Float32x4ListMixin implements List<Float32x4> {
 
   void fillRange(int start, int end, [Float32x4 fillValue]) {
     RangeError.checkValidRange(start, end, this.length);
-    for (var i = start; i < end; ++i) {
-      this[i] = fillValue;
+    final count = end - start;
+    if (count < 10) {
+      for (var i = start; i < end; ++i) {
+        this[i] = fillValue;
+      }
+      return;
     }
+    // Store the first element to get the value converted to the element
+    // type, then replicate its bytes over the rest of the range.
+    this[start] = fillValue;
+    this.buffer._data._fillRange(start * elementSizeInBytes + offsetInBytes,
+        count * elementSizeInBytes, elementSizeInBytes);
   }
 }
 
@@ -1531,9 +1563,18 @@ abstract class _Int32x4ListMixin implements List<Int32x4> {
 
   void fillRange(int start, int end, [Int32x4 fillValue]) {
     RangeError.checkValidRange(start, end, this.length);
-    for (var i = start; i < end; ++i) {
-      this[i] = fillValue;
+    final count = end - start;
+    if (count < 10) {
+      for (var i = start; i < end; ++i) {
+        this[i] = fillValue;
+      }
+      return;
     }
+    // Store the first element to get the value converted to the element
+    // type, then replicate its bytes over the rest of the range.
+    this[start] = fillValue;
+    this.buffer._data._fillRange(start * elementSizeInBytes + offsetInBytes,
+        count * elementSizeInBytes, elementSizeInBytes);
   }
 }
 
@@ -1892,9 +1933,18 @@ abstract class _Float64x2ListMixin implements List<Float64x2> {
 
   void fillRange(int start, int end, [Float64x2 fillValue]) {
     RangeError.checkValidRange(start, end, this.length);
-    for (var i = start; i < end; ++i) {
-      this[i] = fillValue;
+    final count = end - start;
+    if (count < 10) {
+      for (var i = start; i < end; ++i) {
+        this[i] = fillValue;
+      }
+      return;
     }
+    // Store the first element to get the value converted to the element
+    // type, then replicate its bytes over the rest of the range.
+    this[start] = fillValue;
+    this.buffer._data._fillRange(start * elementSizeInBytes + offsetInBytes,
+        count * elementSizeInBytes, elementSizeInBytes);
   }
 }
 
@@ -0,0 +1,54 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--no-background-compilation --baseline-optimization-counter-threshold=5 --optimization-counter-threshold=100
+// VMOptions=--baseline-optimization-counter-threshold=5 --optimization-counter-threshold=100
+
+// Test that functions keep computing the right results while they move from
+// unoptimized code through baseline optimized code to fully optimized code,
+// including deoptimization out of baseline code.
+
+import "package:expect/expect.dart";
+
+class Point {
+  final x;
+  final y;
+  Point(this.x, this.y);
+
+  Point operator +(Point other) => new Point(x + other.x, y + other.y);
+}
+
+sumPoints(List<Point> points) {
+  var result = new Point(0, 0);
+  for (var i = 0; i < points.length; i++) {
+    result = result + points[i];
+  }
+  return result;
+}
+
+sumElements(List list) {
+  var sum = 0;
+  for (var i = 0; i < list.length; i++) {
+    sum += list[i];
+  }
+  return sum;
+}
+
+main() {
+  final points = new List<Point>.generate(10, (i) => new Point(i, 2 * i));
+  final ints = new List<int>.generate(10, (i) => i);
+  for (var i = 0; i < 1000; i++) {
+    final p = sumPoints(points);
+    Expect.equals(45, p.x);
+    Expect.equals(90, p.y);
+    Expect.equals(45, sumElements(ints));
+  }
+
+  // Deoptimize with doubles, then warm up again.
+  final doubles = new List<double>.generate(10, (i) => i + 0.5);
+  for (var i = 0; i < 1000; i++) {
+    Expect.equals(50.0, sumElements(doubles));
+    Expect.equals(45, sumElements(ints));
+  }
+}
@@ -0,0 +1,48 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--no-background-compilation --enable-inlining-annotations --optimization-counter-threshold=10
+
+// Test that string interpolations of constant parts, including fields of
+// const instances, are folded to the right strings by the optimizer.
+
+import "package:expect/expect.dart";
+
+const NeverInline = 'NeverInline';
+
+class Level {
+  final String name;
+  final int value;
+  final bool verbose;
+  const Level(this.name, this.value, this.verbose);
+}
+
+const info = const Level("INFO", 800, false);
+const big = 0x7fffffffffffffff;
+
+@NeverInline
+String tag() => "[${info.name}:${info.value}:${info.verbose}:${null}]";
+
+@NeverInline
+String single() => "${info.value}";
+
+@NeverInline
+int tagLength() => "${info.name}/${info.value}".length;
+
+@NeverInline
+String mint() => "big=$big";
+
+@NeverInline
+String mixed(Object o) => "${info.name} $o";
+
+main() {
+  for (var i = 0; i < 100; i++) {
+    Expect.equals("[INFO:800:false:null]", tag());
+    Expect.equals("800", single());
+    Expect.equals(8, tagLength());
+    Expect.equals("big=9223372036854775807", mint());
+    Expect.equals("INFO $i", mixed(i));
+    Expect.equals("INFO 1.5", mixed(1.5));
+  }
+}
@@ -0,0 +1,44 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--no-background-compilation --optimization-counter-threshold=10
+
+// Test that loads of fields whose types are inferred by the front-end
+// (in AOT mode) still observe every value stored into them, including null.
+
+import "package:expect/expect.dart";
+
+class Node {
+  var value;
+  Node next;
+  Node(this.value);
+}
+
+Node head;
+var counter;
+
+int sum(Node node) {
+  var result = 0;
+  while (node != null) {
+    result += node.value;
+    node = node.next;
+  }
+  return result;
+}
+
+main() {
+  Expect.isNull(counter);
+  for (var i = 0; i < 100; i++) {
+    final node = new Node(i);
+    node.next = head;
+    head = node;
+    counter = i;
+  }
+  Expect.equals(99, counter);
+  Expect.equals(4950, sum(head));
+  head.next.value = 1;
+  Expect.equals(4950 - 98 + 1, sum(head));
+  head = null;
+  Expect.equals(0, sum(head));
+}
@@ -0,0 +1,53 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--no-background-compilation --optimization-counter-threshold=10 --inlining-growth-budget=1
+// VMOptions=--no-background-compilation --optimization-counter-threshold=10 --inlining-growth-budget=0
+
+// Test that functions keep computing the right results when the inlining
+// budget is spent on the hottest call sites and colder ones stay calls.
+
+import "package:expect/expect.dart";
+
+class Accumulator {
+  var total = 0;
+
+  void add(int v) {
+    if (v < 0) {
+      throw new ArgumentError(v);
+    }
+    total += v;
+    if (total > 1000000) {
+      total -= 1000000;
+    }
+  }
+
+  int scaled(int factor) {
+    var result = 0;
+    for (var i = 0; i < factor; i++) {
+      result += total;
+      if (result > 1000000) {
+        result -= 1000000;
+      }
+    }
+    return result;
+  }
+}
+
+int hotAndCold(Accumulator acc, int n) {
+  for (var i = 0; i < n; i++) {
+    acc.add(i);
+  }
+  if (n == 3) {
+    return acc.scaled(2);
+  }
+  return acc.total;
+}
+
+main() {
+  for (var i = 0; i < 100; i++) {
+    Expect.equals(45, hotAndCold(new Accumulator(), 10));
+    Expect.equals(6, hotAndCold(new Accumulator(), 3));
+  }
+}
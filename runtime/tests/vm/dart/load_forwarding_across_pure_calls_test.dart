@@ -0,0 +1,43 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--no-background-compilation --enable-inlining-annotations --optimization-counter-threshold=10
+
+// Test that loads forwarded across calls to side-effect free core library
+// methods still observe stores made before and after those calls.
+
+import "dart:math";
+import "package:expect/expect.dart";
+
+const NeverInline = 'NeverInline';
+
+class Box {
+  var value;
+  Box(this.value);
+}
+
+@NeverInline
+double lengthOf(Box x, Box y) {
+  final a = x.value * x.value;
+  final root = sqrt(a + y.value * y.value);
+  return root + x.value - y.value;
+}
+
+@NeverInline
+double updateAcross(Box box, double v) {
+  final before = box.value;
+  final floored = v.floorToDouble();
+  box.value = floored;
+  final rounded = v.roundToDouble();
+  return before + box.value + rounded;
+}
+
+main() {
+  for (var i = 0; i < 100; i++) {
+    Expect.equals(5.0 + 3.0 - 4.0, lengthOf(new Box(3.0), new Box(4.0)));
+    final box = new Box(1.0);
+    Expect.equals(1.0 + 2.0 + 3.0, updateAcross(box, 2.5));
+    Expect.equals(2.0, box.value);
+  }
+}
@@ -0,0 +1,42 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--no-background-compilation --enable-inlining-annotations --optimization-counter-threshold=10
+
+// Test that bounds checks are still performed correctly when the loop bound
+// and the bounds check load the length from different redefinitions of the
+// same list.
+
+import "dart:typed_data";
+import "package:expect/expect.dart";
+
+const NeverInline = 'NeverInline';
+
+class Reader {
+  final Uint8List bytes;
+  Reader(this.bytes);
+
+  int byteAt(int i) => bytes[i];
+}
+
+@NeverInline
+int checksum(Reader reader, int extra) {
+  int sum = 0;
+  final bytes = reader.bytes;
+  for (int i = 0; i < bytes.length + extra; i++) {
+    sum = (sum + reader.byteAt(i)) & 0xffff;
+  }
+  return sum;
+}
+
+main() {
+  final reader = new Reader(new Uint8List(100));
+  for (int i = 0; i < reader.bytes.length; i++) {
+    reader.bytes[i] = i;
+  }
+  for (int i = 0; i < 100; i++) {
+    Expect.equals(4950, checksum(reader, 0));
+  }
+  Expect.throws(() => checksum(reader, 1), (e) => e is RangeError);
+}
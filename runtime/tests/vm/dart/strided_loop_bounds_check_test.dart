@@ -0,0 +1,44 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--no-background-compilation --enable-inlining-annotations --optimization-counter-threshold=10
+
+// Test that bounds checks in loops with a stride other than one are
+// generalized correctly.
+
+import "dart:typed_data";
+import "package:expect/expect.dart";
+
+const NeverInline = 'NeverInline';
+
+@NeverInline
+int sumWords(Uint8List data, int n) {
+  int sum = 0;
+  for (int i = 0; i < n; i += 4) {
+    sum += data[i] + data[i + 1] + data[i + 2] + data[i + 3];
+  }
+  return sum;
+}
+
+@NeverInline
+int sumShifted(Uint8List data, int n) {
+  int sum = 0;
+  for (int i = 0, j = 0; i < n; i += 2, j++) {
+    sum += data[j << 1] + data[i + 1];
+  }
+  return sum;
+}
+
+main() {
+  final data = new Uint8List(64);
+  for (int i = 0; i < data.length; i++) {
+    data[i] = i;
+  }
+  for (int i = 0; i < 100; i++) {
+    Expect.equals(2016, sumWords(data, 64));
+    Expect.equals(2016, sumShifted(data, 64));
+  }
+  Expect.throws(() => sumWords(data, 65), (e) => e is RangeError);
+  Expect.throws(() => sumShifted(data, 66), (e) => e is RangeError);
+}
@@ -37,6 +37,9 @@ class AtomicOperations : public AllStatic {
                                        uint32_t old_value,
                                        uint32_t new_value);
 
+  // Issues a full memory barrier: no load or store is reordered across it.
+  static void FullMemoryBarrier();
+
   // Performs a load of a word from 'ptr', but without any guarantees about
   // memory order (i.e., no load barriers/fences).
   template <typename T>
@@ -55,6 +55,10 @@ inline uint32_t AtomicOperations::CompareAndSwapUint32(uint32_t* ptr,
   return __sync_val_compare_and_swap(ptr, old_value, new_value);
 }
 
+inline void AtomicOperations::FullMemoryBarrier() {
+  __sync_synchronize();
+}
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_ATOMIC_FUCHSIA_H_
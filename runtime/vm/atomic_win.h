@@ -129,6 +129,10 @@ inline uint32_t AtomicOperations::CompareAndSwapUint32(uint32_t* ptr,
 #endif
 }
 
+inline void AtomicOperations::FullMemoryBarrier() {
+  MemoryBarrier();
+}
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_ATOMIC_WIN_H_
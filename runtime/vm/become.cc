@@ -71,12 +71,12 @@ static void ForwardObjectTo(RawObject* before_obj, RawObject* after_obj) {
   }
 }
 
+// Also used by the helper threads of a parallel heap visit, so the thread
+// whose store buffer is rebuilt is looked up for each remembered object.
 class ForwardPointersVisitor : public ObjectPointerVisitor {
  public:
-  explicit ForwardPointersVisitor(Thread* thread)
-      : ObjectPointerVisitor(thread->isolate()),
-        thread_(thread),
-        visiting_object_(NULL) {}
+  explicit ForwardPointersVisitor(Isolate* isolate)
+      : ObjectPointerVisitor(isolate), visiting_object_(NULL) {}
 
   virtual void VisitPointers(RawObject** first, RawObject** last) {
     for (RawObject** p = first; p <= last; p++) {
@@ -97,12 +97,11 @@ class ForwardPointersVisitor : public ObjectPointerVisitor {
     if ((obj != NULL) && obj->IsRemembered()) {
       ASSERT(!obj->IsForwardingCorpse());
       ASSERT(!obj->IsFreeListElement());
-      thread_->StoreBufferAddObjectGC(obj);
+      Thread::Current()->StoreBufferAddObjectGC(obj);
     }
   }
 
  private:
-  Thread* thread_;
   RawObject* visiting_object_;
 
   DISALLOW_COPY_AND_ASSIGN(ForwardPointersVisitor);
@@ -110,16 +109,16 @@ class ForwardPointersVisitor : public ObjectPointerVisitor {
 
 class ForwardHeapPointersVisitor : public ObjectVisitor {
  public:
-  explicit ForwardHeapPointersVisitor(ForwardPointersVisitor* pointer_visitor)
-      : pointer_visitor_(pointer_visitor) {}
+  explicit ForwardHeapPointersVisitor(Isolate* isolate)
+      : pointer_visitor_(isolate) {}
 
   virtual void VisitObject(RawObject* obj) {
-    pointer_visitor_->VisitingObject(obj);
-    obj->VisitPointers(pointer_visitor_);
+    pointer_visitor_.VisitingObject(obj);
+    obj->VisitPointers(&pointer_visitor_);
   }
 
  private:
-  ForwardPointersVisitor* pointer_visitor_;
+  ForwardPointersVisitor pointer_visitor_;
 
   DISALLOW_COPY_AND_ASSIGN(ForwardHeapPointersVisitor);
 };
@@ -275,17 +274,25 @@ void Become::FollowForwardingPointers(Thread* thread) {
   isolate->PrepareForGC();  // Have all threads flush their store buffers.
   isolate->store_buffer()->Reset();  // Drop all store buffers.
 
-  ForwardPointersVisitor pointer_visitor(thread);
-
   {
-    // Heap pointers.
+    // Heap pointers. Each object is forwarded, and re-added to the store
+    // buffer, by exactly one of the visitors.
     WritableCodeLiteralsScope writable_code(heap);
-    ForwardHeapPointersVisitor object_visitor(&pointer_visitor);
-    heap->VisitObjects(&object_visitor);
-    pointer_visitor.VisitingObject(NULL);
+    const intptr_t num_visitors = FLAG_heap_iteration_tasks;
+    RELEASE_ASSERT(num_visitors >= 1);
+    ObjectVisitor** visitors = new ObjectVisitor*[num_visitors];
+    for (intptr_t i = 0; i < num_visitors; i++) {
+      visitors[i] = new ForwardHeapPointersVisitor(isolate);
+    }
+    heap->VisitObjectsParallel(visitors, num_visitors);
+    for (intptr_t i = 0; i < num_visitors; i++) {
+      delete visitors[i];
+    }
+    delete[] visitors;
   }
 
   // C++ pointers.
+  ForwardPointersVisitor pointer_visitor(isolate);
   isolate->VisitObjectPointers(&pointer_visitor, true);
 #ifndef PRODUCT
   if (FLAG_support_service) {
@@ -13,6 +13,7 @@
 #include "platform/globals.h"
 
 #include "vm/clustered_snapshot.h"
+#include "vm/compiler/jit/compiler.h"
 #include "vm/compiler_stats.h"
 #include "vm/dart_api_impl.h"
 #include "vm/stack_frame.h"
@@ -242,6 +243,22 @@ static void UseDartApi(Dart_NativeArguments args) {
   Dart_SetReturnValue(args, Dart_NewInteger(value1 * receiver_value));
 }
 
+// Creates more local handles than fit into the first handle block of the
+// native call's API scope.
+static void UseManyLocalHandles(Dart_NativeArguments args) {
+  const intptr_t kNumHandles = 100;
+  Dart_Handle param = Dart_GetNativeArgument(args, 1);
+  EXPECT_VALID(param);
+  int64_t value = 0;
+  for (intptr_t i = 0; i < kNumHandles; i++) {
+    int64_t element = 0;
+    Dart_Handle result = Dart_IntegerToInt64(Dart_NewInteger(i), &element);
+    EXPECT_VALID(result);
+    value += element;
+  }
+  Dart_SetReturnValue(args, Dart_NewInteger(value));
+}
+
 static Dart_NativeFunction bm_uda_lookup(Dart_Handle name,
                                          int argument_count,
                                          bool* auto_setup_scope) {
@@ -252,6 +269,8 @@ static Dart_NativeFunction bm_uda_lookup(Dart_Handle name,
   EXPECT_VALID(result);
   if (strcmp(cstr, "init") == 0) {
     return InitNativeFields;
+  } else if (strcmp(cstr, "manyHandles") == 0) {
+    return UseManyLocalHandles;
   } else {
     return UseDartApi;
   }
@@ -298,6 +317,49 @@ BENCHMARK(UseDartApi) {
   benchmark->set_score(elapsed_time);
 }
 
+// Same as UseDartApi, but every native call overflows the first local handle
+// block of its API scope.
+BENCHMARK(UseDartApiManyHandles) {
+  const int kNumIterations = 100000;
+  const char* kScriptChars =
+      "class Class extends NativeFieldsWrapper{\n"
+      "  int init() native 'init';\n"
+      "  int manyHandles(int param1, int param2) native 'manyHandles';\n"
+      "}\n"
+      "\n"
+      "void benchmark(int count) {\n"
+      "  Class c = new Class();\n"
+      "  c.init();\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    c.manyHandles(i,7);\n"
+      "  }\n"
+      "}\n";
+
+  Dart_Handle lib = TestCase::LoadTestScript(
+      kScriptChars, reinterpret_cast<Dart_NativeEntryResolver>(bm_uda_lookup),
+      USER_TEST_URI, false);
+
+  // Create a native wrapper class with native fields.
+  Dart_Handle result =
+      Dart_CreateNativeWrapperClass(lib, NewString("NativeFieldsWrapper"), 1);
+  EXPECT_VALID(result);
+  result = Dart_FinalizeLoading(false);
+  EXPECT_VALID(result);
+
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(kNumIterations);
+
+  // Warmup first to avoid compilation jitters.
+  Dart_Invoke(lib, NewString("benchmark"), 1, args);
+
+  Timer timer(true, "UseDartApiManyHandles benchmark");
+  timer.Start();
+  Dart_Invoke(lib, NewString("benchmark"), 1, args);
+  timer.Stop();
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
 //
 // Measure time accessing internal and external strings.
 //
@@ -678,6 +740,270 @@ BENCHMARK(LargeMap) {
   benchmark->set_score(elapsed_time);
 }
 
+BENCHMARK(LargeListOfMaps) {
+  const char* kScript =
+      "makeList() {\n"
+      "  List l = [];\n"
+      "  for (int i = 0; i < 10000; ++i) l.add({'key': 'value$i', 'n': i});\n"
+      "  return l;\n"
+      "}";
+  Dart_Handle h_lib = TestCase::LoadTestScript(kScript, NULL);
+  EXPECT_VALID(h_lib);
+  Dart_Handle h_result = Dart_Invoke(h_lib, NewString("makeList"), 0, NULL);
+  EXPECT_VALID(h_result);
+  Instance& list = Instance::Handle();
+  list ^= Api::UnwrapHandle(h_result);
+  const intptr_t kLoopCount = 100;
+  Timer timer(true, "Large List Of Maps");
+  timer.Start();
+  for (intptr_t i = 0; i < kLoopCount; i++) {
+    StackZone zone(thread);
+    MessageWriter writer(true);
+    Message* message =
+        writer.WriteMessage(list, ILLEGAL_PORT, Message::kNormalPriority);
+
+    // Read object back from the snapshot.
+    MessageSnapshotReader reader(message, thread);
+    reader.ReadObject();
+    delete message;
+  }
+  timer.Stop();
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
+//
+// Measure stores of new objects into random slots of a large array, which
+// stresses the remembered set maintained for old-to-new pointers.
+//
+BENCHMARK(LargeArrayRandomStores) {
+  const int kNumIterations = 1000000;
+  const char* kScriptChars =
+      "import 'dart:math';\n"
+      "var list;\n"
+      "void setup() {\n"
+      "  list = new List(10000000);\n"
+      "}\n"
+      "void benchmark(int count) {\n"
+      "  var random = new Random(42);\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    list[random.nextInt(list.length)] = new Object();\n"
+      "  }\n"
+      "}\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  EXPECT_VALID(Dart_Invoke(lib, NewString("setup"), 0, NULL));
+
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(kNumIterations);
+
+  // Warmup first to avoid compilation jitters.
+  EXPECT_VALID(Dart_Invoke(lib, NewString("benchmark"), 1, args));
+
+  Timer timer(true, "LargeArrayRandomStores benchmark");
+  timer.Start();
+  EXPECT_VALID(Dart_Invoke(lib, NewString("benchmark"), 1, args));
+  timer.Stop();
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
+//
+// Measure scavenge pause time with a live set of new-space objects.
+//
+BENCHMARK(ScavengeLiveSet) {
+  const int kNumIterations = 100;
+  const char* kScriptChars =
+      "class Node {\n"
+      "  var next;\n"
+      "  Node(this.next);\n"
+      "}\n"
+      "var live;\n"
+      "void setup(int count) {\n"
+      "  live = null;\n"
+      "  for (int i = 0; i < count; i++) live = new Node(live);\n"
+      "}\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(10000);
+  Heap* heap = thread->isolate()->heap();
+  Timer timer(true, "ScavengeLiveSet benchmark");
+  for (intptr_t i = 0; i < kNumIterations; i++) {
+    // Rebuild the live set so every measured scavenge copies fresh objects
+    // instead of ones already promoted by an earlier iteration.
+    EXPECT_VALID(Dart_Invoke(lib, NewString("setup"), 1, args));
+    TransitionNativeToVM transition(thread);
+    timer.Start();
+    heap->CollectGarbage(Heap::kNew);
+    timer.Stop();
+  }
+  benchmark->set_score(timer.TotalElapsedTime() / kNumIterations);
+}
+
+//
+// Measure full mark-sweep time with a large live set in old space.
+//
+BENCHMARK(MarkSweepLiveSet) {
+  const int kNumIterations = 20;
+  const char* kScriptChars =
+      "class Node {\n"
+      "  var next;\n"
+      "  Node(this.next);\n"
+      "}\n"
+      "var live;\n"
+      "void setup(int count) {\n"
+      "  for (int i = 0; i < count; i++) live = new Node(live);\n"
+      "}\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(1000000);
+  EXPECT_VALID(Dart_Invoke(lib, NewString("setup"), 1, args));
+  TransitionNativeToVM transition(thread);
+  Heap* heap = thread->isolate()->heap();
+  // Promote the live set so the measured collections only mark and sweep.
+  heap->CollectAllGarbage();
+  Timer timer(true, "MarkSweepLiveSet benchmark");
+  timer.Start();
+  for (intptr_t i = 0; i < kNumIterations; i++) {
+    heap->CollectAllGarbage();
+  }
+  timer.Stop();
+  benchmark->set_score(timer.TotalElapsedTime() / kNumIterations);
+}
+
+static int CompareInt64(const int64_t* a, const int64_t* b) {
+  return (*a < *b) ? -1 : ((*a > *b) ? 1 : 0);
+}
+
+//
+// Measure the 99th percentile scavenge pause for a steady-state workload
+// where a fraction of allocated objects survive in a fixed-size ring.
+//
+BENCHMARK(ScavengePauseP99) {
+  const intptr_t kNumPauses = 1000;
+  const char* kScriptChars =
+      "var ring = new List(50000);\n"
+      "var cursor = 0;\n"
+      "void allocate(int count) {\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    var o = new List(4);\n"
+      "    if (i % 10 == 0) {\n"
+      "      ring[cursor] = o;\n"
+      "      cursor = (cursor + 1) % ring.length;\n"
+      "    }\n"
+      "  }\n"
+      "}\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(20000);
+  // Warmup first to avoid compilation jitters.
+  EXPECT_VALID(Dart_Invoke(lib, NewString("allocate"), 1, args));
+  Heap* heap = thread->isolate()->heap();
+  MallocGrowableArray<int64_t> pauses(kNumPauses);
+  for (intptr_t i = 0; i < kNumPauses; i++) {
+    EXPECT_VALID(Dart_Invoke(lib, NewString("allocate"), 1, args));
+    TransitionNativeToVM transition(thread);
+    int64_t start = OS::GetCurrentMonotonicMicros();
+    heap->CollectGarbage(Heap::kNew);
+    pauses.Add(OS::GetCurrentMonotonicMicros() - start);
+  }
+  pauses.Sort(CompareInt64);
+  benchmark->set_score(pauses[(kNumPauses * 99) / 100]);
+}
+
+//
+// Measure JIT warm-up cost: the time spent in early iterations of a workload
+// above what the same iterations cost once the code has reached steady state.
+//
+BENCHMARK(JitWarmup) {
+  const intptr_t kNumIterations = 200;
+  const intptr_t kSteadyStateIterations = 20;
+  const char* kScriptChars =
+      "class Point {\n"
+      "  final x, y;\n"
+      "  Point(this.x, this.y);\n"
+      "  Point operator +(Point o) => new Point(x + o.x, y + o.y);\n"
+      "}\n"
+      "int work(int count) {\n"
+      "  var p = new Point(0, 0);\n"
+      "  var d = new Point(1, 2);\n"
+      "  for (int i = 0; i < count; i++) p = p + d;\n"
+      "  return p.x + p.y;\n"
+      "}\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(10000);
+  MallocGrowableArray<int64_t> times(kNumIterations);
+  for (intptr_t i = 0; i < kNumIterations; i++) {
+    int64_t start = OS::GetCurrentMonotonicMicros();
+    EXPECT_VALID(Dart_Invoke(lib, NewString("work"), 1, args));
+    times.Add(OS::GetCurrentMonotonicMicros() - start);
+  }
+  int64_t steady_state = kMaxInt64;
+  for (intptr_t i = kNumIterations - kSteadyStateIterations;
+       i < kNumIterations; i++) {
+    steady_state = Utils::Minimum(steady_state, times[i]);
+  }
+  int64_t warmup_cost = 0;
+  for (intptr_t i = 0; i < kNumIterations; i++) {
+    warmup_cost += times[i] - steady_state;
+  }
+  benchmark->set_score(warmup_cost);
+}
+
+//
+// Measure the size of optimized code generated for a representative function
+// after it has collected type feedback.
+//
+BENCHMARK_SIZE(OptimizedCodeSize) {
+  const char* kScriptChars =
+      "class Point {\n"
+      "  final x, y;\n"
+      "  Point(this.x, this.y);\n"
+      "}\n"
+      "int work(List<Point> points) {\n"
+      "  int sum = 0;\n"
+      "  for (int i = 0; i < points.length; i++) {\n"
+      "    var p = points[i];\n"
+      "    sum += (p.x * p.y) ~/ (i + 1);\n"
+      "    if (sum > 1000000) sum -= 1000000;\n"
+      "  }\n"
+      "  return sum;\n"
+      "}\n"
+      "void warmup() {\n"
+      "  var points = new List<Point>.generate(100, (i) => new Point(i, -i));\n"
+      "  for (int i = 0; i < 10; i++) work(points);\n"
+      "}\n";
+  Dart_Handle h_lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(h_lib);
+  EXPECT_VALID(Dart_Invoke(h_lib, NewString("warmup"), 0, NULL));
+
+  TransitionNativeToVM transition(thread);
+  Library& lib = Library::Handle();
+  lib ^= Api::UnwrapHandle(h_lib);
+  const Function& function = Function::Handle(
+      lib.LookupLocalFunction(String::Handle(String::New("work"))));
+  EXPECT(!function.IsNull());
+#if !defined(PRODUCT)
+  // Constant in product mode.
+  const bool old_flag = FLAG_background_compilation;
+  FLAG_background_compilation = false;
+#endif
+  const Object& result = Object::Handle(
+      Compiler::CompileOptimizedFunction(thread, function));
+#if !defined(PRODUCT)
+  FLAG_background_compilation = old_flag;
+#endif
+  EXPECT(result.IsCode());
+  if (result.IsCode()) {
+    benchmark->set_score(Code::Cast(result).Size());
+  }
+}
+
 BENCHMARK_MEMORY(InitialRSS) {
   benchmark->set_score(bin::Process::MaxRSS());
 }
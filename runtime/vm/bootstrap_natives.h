@@ -116,6 +116,7 @@ namespace dart {
   V(List_setIndexed, 3)                                                        \
   V(List_getLength, 1)                                                         \
   V(List_slice, 4)                                                             \
+  V(List_copyFromList, 5)                                                      \
   V(ImmutableList_from, 4)                                                     \
   V(StringBase_createFromCodePoints, 3)                                        \
   V(StringBase_substringUnchecked, 3)                                          \
@@ -123,10 +124,12 @@ namespace dart {
   V(StringBuffer_createStringFromUint16Array, 3)                               \
   V(OneByteString_substringUnchecked, 3)                                       \
   V(OneByteString_splitWithCharCode, 2)                                        \
+  V(OneByteString_indexOf, 3)                                                  \
   V(OneByteString_allocate, 1)                                                 \
   V(OneByteString_allocateFromOneByteList, 3)                                  \
   V(OneByteString_setAt, 3)                                                    \
   V(TwoByteString_allocateFromTwoByteList, 3)                                  \
+  V(Utf8Decoder_decodeUint8List, 3)                                            \
   V(String_getHashCode, 1)                                                     \
   V(String_getLength, 1)                                                       \
   V(String_charAt, 2)                                                          \
@@ -190,6 +193,7 @@ namespace dart {
   V(TypedData_Float64x2Array_new, 2)                                           \
   V(TypedData_length, 1)                                                       \
   V(TypedData_setRange, 7)                                                     \
+  V(TypedData_fillRange, 4)                                                    \
   V(TypedData_GetInt8, 2)                                                      \
   V(TypedData_SetInt8, 3)                                                      \
   V(TypedData_GetUint8, 2)                                                     \
@@ -16,6 +16,12 @@
 namespace dart {
 
 DEFINE_FLAG(bool, print_class_table, false, "Print initial class table.");
+DEFINE_FLAG(int,
+            pretenure_threshold,
+            0,
+            "Percentage of a class's new-space instances that must survive a "
+            "scavenge before new instances are allocated in old space "
+            "(0 disables pretenuring).");
 
 ClassTable::ClassTable()
     : top_(kNumPredefinedCids),
@@ -104,6 +110,11 @@ bool ClassTable::TraceAllocationFor(intptr_t cid) {
   ClassHeapStats* stats = PreliminaryStatsAt(cid);
   return stats->trace_allocation();
 }
+
+bool ClassTable::ShouldPretenureFor(intptr_t cid) {
+  ClassHeapStats* stats = PreliminaryStatsAt(cid);
+  return stats->pretenure();
+}
 #endif  // !PRODUCT
 
 void ClassTable::Register(const Class& cls) {
@@ -310,6 +321,9 @@ void ClassHeapStats::ResetAtOldGC() {
   last_reset.ResetOld();
   post_gc.ResetOld();
   recent.ResetOld();
+  // Revisit the pretenuring decision with fresh survival data from the
+  // scavenges following this old GC.
+  set_pretenure(false);
 }
 
 void ClassHeapStats::Verify() {
@@ -347,6 +361,20 @@ void ClassHeapStats::UpdatePromotedAfterNewGC() {
   promoted_size = recent.old_size - old_pre_new_gc_size_;
 }
 
+void ClassHeapStats::UpdatePretenureAfterNewGC() {
+  // Too few samples make for a noisy survival rate.
+  const intptr_t kMinPretenureSampleCount = 1000;
+  if ((FLAG_pretenure_threshold <= 0) || pretenure() ||
+      (pre_gc.new_count < kMinPretenureSampleCount)) {
+    return;
+  }
+  // Survivors either stayed in new space or were promoted.
+  const intptr_t survived = post_gc.new_count + promoted_count;
+  if ((survived * 100) >= (pre_gc.new_count * FLAG_pretenure_threshold)) {
+    set_pretenure(true);
+  }
+}
+
 void ClassHeapStats::PrintToJSONObject(const Class& cls,
                                        JSONObject* obj) const {
   if (!FLAG_support_service) {
@@ -393,11 +421,14 @@ void ClassTable::UpdateAllocatedNew(intptr_t cid, intptr_t size) {
   stats->recent.AddNew(size);
 }
 
-void ClassTable::UpdateAllocatedOld(intptr_t cid, intptr_t size) {
+void ClassTable::UpdateAllocatedOld(intptr_t cid,
+                                    intptr_t size,
+                                    intptr_t count) {
   ClassHeapStats* stats = PreliminaryStatsAt(cid);
   ASSERT(stats != NULL);
   ASSERT(size != 0);
-  stats->recent.AddOld(size);
+  ASSERT(count > 0);
+  stats->recent.AddOld(size, count);
 }
 
 void ClassTable::UpdateAllocatedExternalNew(intptr_t cid, intptr_t size) {
@@ -467,6 +498,9 @@ void ClassTable::UpdatePromoted() {
   }
   for (intptr_t i = kNumPredefinedCids; i < top_; i++) {
     class_heap_stats_table_[i].UpdatePromotedAfterNewGC();
+    // Only user classes are pretenured: they are always allocated through
+    // the class allocation stub or the AllocateObject runtime entry.
+    class_heap_stats_table_[i].UpdatePretenureAfterNewGC();
   }
 }
 
@@ -561,11 +595,12 @@ void ClassTable::UpdateLiveOld(intptr_t cid, intptr_t size, intptr_t count) {
   stats->post_gc.AddOld(size, count);
 }
 
-void ClassTable::UpdateLiveNew(intptr_t cid, intptr_t size) {
+void ClassTable::UpdateLiveNew(intptr_t cid, intptr_t size, intptr_t count) {
   ClassHeapStats* stats = PreliminaryStatsAt(cid);
   ASSERT(stats != NULL);
   ASSERT(size >= 0);
-  stats->post_gc.AddNew(size);
+  ASSERT(count >= 0);
+  stats->post_gc.AddNew(size, count);
 }
 
 void ClassTable::UpdateLiveOldExternal(intptr_t cid, intptr_t size) {
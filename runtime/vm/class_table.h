@@ -39,8 +39,8 @@ class AllocStats {
     new_external_size = 0;
   }
 
-  void AddNew(T size) {
-    AtomicOperations::IncrementBy(&new_count, 1);
+  void AddNew(T size, T count = 1) {
+    AtomicOperations::IncrementBy(&new_count, count);
     AtomicOperations::IncrementBy(&new_size, size);
   }
 
@@ -120,12 +120,18 @@ class ClassHeapStats {
   }
   static intptr_t state_offset() { return OFFSET_OF(ClassHeapStats, state_); }
   static intptr_t TraceAllocationMask() { return (1 << kTraceAllocationBit); }
+  static intptr_t PretenureMask() { return (1 << kPretenureBit); }
+  // Generated code takes the slow path if any of these bits are set.
+  static intptr_t SlowPathAllocationMask() {
+    return TraceAllocationMask() | PretenureMask();
+  }
 
   void Initialize();
   void ResetAtNewGC();
   void ResetAtOldGC();
   void ResetAccumulator();
   void UpdatePromotedAfterNewGC();
+  void UpdatePretenureAfterNewGC();
   void UpdateSize(intptr_t instance_size);
 #ifndef PRODUCT
   void PrintToJSONObject(const Class& cls, JSONObject* obj) const;
@@ -138,13 +144,23 @@ class ClassHeapStats {
     state_ = TraceAllocationBit::update(trace_allocation, state_);
   }
 
+  // Whether instances of this class should be allocated directly in old
+  // space because almost all of them survive scavenges.
+  bool pretenure() const { return PretenureBit::decode(state_); }
+
+  void set_pretenure(bool pretenure) {
+    state_ = PretenureBit::update(pretenure, state_);
+  }
+
  private:
   enum StateBits {
     kTraceAllocationBit = 0,
+    kPretenureBit = 1,
   };
 
   class TraceAllocationBit
       : public BitField<intptr_t, bool, kTraceAllocationBit, 1> {};
+  class PretenureBit : public BitField<intptr_t, bool, kPretenureBit, 1> {};
 
   // Recent old at start of last new GC (used to compute promoted_*).
   intptr_t old_pre_new_gc_count_;
@@ -212,7 +228,7 @@ class ClassTable {
 #ifndef PRODUCT
   // Called whenever a class is allocated in the runtime.
   void UpdateAllocatedNew(intptr_t cid, intptr_t size);
-  void UpdateAllocatedOld(intptr_t cid, intptr_t size);
+  void UpdateAllocatedOld(intptr_t cid, intptr_t size, intptr_t count = 1);
 
   void UpdateAllocatedExternalNew(intptr_t cid, intptr_t size);
   void UpdateAllocatedExternalOld(intptr_t cid, intptr_t size);
@@ -251,10 +267,12 @@ class ClassTable {
 
   void SetTraceAllocationFor(intptr_t cid, bool trace);
   bool TraceAllocationFor(intptr_t cid);
+  bool ShouldPretenureFor(intptr_t cid);
 
  private:
   friend class GCMarker;
   friend class MarkingWeakVisitor;
+  friend class ParallelScavengerVisitor;
   friend class ScavengerVisitor;
   friend class ScavengerWeakVisitor;
   friend class ClassHeapStatsTestHelper;
@@ -277,7 +295,7 @@ class ClassTable {
   // May not have updated size for variable size classes.
   ClassHeapStats* PreliminaryStatsAt(intptr_t cid);
   void UpdateLiveOld(intptr_t cid, intptr_t size, intptr_t count = 1);
-  void UpdateLiveNew(intptr_t cid, intptr_t size);
+  void UpdateLiveNew(intptr_t cid, intptr_t size, intptr_t count = 1);
   void UpdateLiveOldExternal(intptr_t cid, intptr_t size);
   void UpdateLiveNewExternal(intptr_t cid, intptr_t size);
 #endif  // !PRODUCT
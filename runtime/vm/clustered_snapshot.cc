@@ -2032,6 +2032,16 @@ class RODataSerializationCluster : public SerializationCluster {
       }
       ASSERT(String::GetCachedHash(str) != 0);
     }
+#if defined(HASH_IN_OBJECT_HEADER)
+    // Likewise the identity hash of a double lives in its header, so assign
+    // one now. Derive it from the value to keep snapshots deterministic.
+    if (cid_ == kDoubleCid && Object::GetCachedHash(object) == 0) {
+      RawDouble* dbl = static_cast<RawDouble*>(object);
+      uint64_t bits = bit_cast<uint64_t>(dbl->ptr()->value_);
+      uint32_t hash = static_cast<uint32_t>(bits ^ (bits >> 32)) & 0x3FFFFFFF;
+      Object::SetCachedHash(object, hash == 0 ? 1 : hash);
+    }
+#endif
   }
 
   void WriteAlloc(Serializer* s) {
@@ -4683,8 +4693,15 @@ SerializationCluster* Serializer::NewClusterForClass(intptr_t cid) {
       return new (Z) MintSerializationCluster();
     case kBigintCid:
       return new (Z) BigintSerializationCluster();
-    case kDoubleCid:
-      return new (Z) DoubleSerializationCluster();
+    case kDoubleCid: {
+      // Boxes of unboxed double fields are updated in place in JIT mode, so
+      // only AOT snapshots may share doubles read-only.
+      if (kind_ == Snapshot::kFullAOT) {
+        return new (Z) RODataSerializationCluster("(RO)Double", kDoubleCid);
+      } else {
+        return new (Z) DoubleSerializationCluster();
+      }
+    }
     case kGrowableObjectArrayCid:
       return new (Z) GrowableObjectArraySerializationCluster();
     case kStackTraceCid:
@@ -5231,8 +5248,15 @@ DeserializationCluster* Deserializer::ReadCluster() {
       return new (Z) MintDeserializationCluster();
     case kBigintCid:
       return new (Z) BigintDeserializationCluster();
-    case kDoubleCid:
-      return new (Z) DoubleDeserializationCluster();
+    case kDoubleCid: {
+      // Boxes of unboxed double fields are updated in place in JIT mode, so
+      // only AOT snapshots may share doubles read-only.
+      if (kind_ == Snapshot::kFullAOT) {
+        return new (Z) RODataDeserializationCluster();
+      } else {
+        return new (Z) DoubleDeserializationCluster();
+      }
+    }
     case kGrowableObjectArrayCid:
       return new (Z) GrowableObjectArrayDeserializationCluster();
     case kStackTraceCid:
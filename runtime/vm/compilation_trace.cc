@@ -6,18 +6,32 @@
 
 #include "vm/longjump.h"
 #include "vm/object_store.h"
+#include "vm/os.h"
 #include "vm/resolver.h"
 #include "vm/symbols.h"
 
 namespace dart {
 
+DEFINE_FLAG(int,
+            compilation_trace_warmup,
+            100,
+            "Number of invocations after which a function that was optimized "
+            "when the compilation trace was saved is optimized again.");
+
+DECLARE_FLAG(int, optimization_counter_threshold);
+
+static const char kOptimizedSuffix[] = ",O";
+
 CompilationTraceSaver::CompilationTraceSaver(Zone* zone)
     : buf_(zone, 4 * KB),
       func_name_(String::Handle(zone)),
       cls_(Class::Handle(zone)),
       cls_name_(String::Handle(zone)),
       lib_(Library::Handle(zone)),
-      uri_(String::Handle(zone)) {}
+      uri_(String::Handle(zone)) {
+  buf_.Printf("#%08x\n",
+              CompilationTraceLoader::ProgramHash(Thread::Current()));
+}
 
 void CompilationTraceSaver::Visit(const Function& function) {
   if (!function.HasCode()) {
@@ -36,8 +50,9 @@ void CompilationTraceSaver::Visit(const Function& function) {
   cls_name_ = String::RemovePrivateKey(cls_name_);
   lib_ = cls_.library();
   uri_ = lib_.url();
-  buf_.Printf("%s,%s,%s\n", uri_.ToCString(), cls_name_.ToCString(),
-              func_name_.ToCString());
+  buf_.Printf("%s,%s,%s%s\n", uri_.ToCString(), cls_name_.ToCString(),
+              func_name_.ToCString(),
+              function.HasOptimizedCode() ? kOptimizedSuffix : "");
 }
 
 CompilationTraceLoader::CompilationTraceLoader(Thread* thread)
@@ -52,7 +67,45 @@ CompilationTraceLoader::CompilationTraceLoader(Thread* thread)
       function_(Function::Handle(zone_)),
       function2_(Function::Handle(zone_)),
       field_(Field::Handle(zone_)),
-      error_(Object::Handle(zone_)) {}
+      error_(Object::Handle(zone_)),
+      same_program_(false) {}
+
+static uint32_t CombineHashes(uint32_t hash, uint32_t other_hash) {
+  hash += other_hash;
+  hash += hash << 10;
+  hash ^= hash >> 6;  // Logical shift, unsigned hash.
+  return hash;
+}
+
+uint32_t CompilationTraceLoader::ProgramHash(Thread* thread) {
+  Zone* zone = thread->zone();
+  const GrowableObjectArray& libraries = GrowableObjectArray::Handle(
+      zone, thread->isolate()->object_store()->libraries());
+  Library& lib = Library::Handle(zone);
+  Array& scripts = Array::Handle(zone);
+  Script& script = Script::Handle(zone);
+  String& str = String::Handle(zone);
+  uint32_t hash = 0;
+  for (intptr_t i = 0; i < libraries.Length(); i++) {
+    lib ^= libraries.At(i);
+    str = lib.url();
+    hash = CombineHashes(hash, str.Hash());
+    scripts = lib.LoadedScripts();
+    for (intptr_t j = 0; j < scripts.Length(); j++) {
+      script ^= scripts.At(j);
+      str = script.url();
+      hash = CombineHashes(hash, str.Hash());
+      str = script.Source();
+      if (!str.IsNull()) {
+        hash = CombineHashes(hash, str.Hash());
+      }
+    }
+  }
+  hash += hash << 3;
+  hash ^= hash >> 11;
+  hash += hash << 15;
+  return hash;
+}
 
 static char* FindCharacter(char* str, char goal, char* limit) {
   while (str < limit) {
@@ -66,9 +119,23 @@ static char* FindCharacter(char* str, char goal, char* limit) {
 
 RawObject* CompilationTraceLoader::CompileTrace(uint8_t* buffer,
                                                 intptr_t size) {
-  // First compile functions named in the trace.
   char* cursor = reinterpret_cast<char*>(buffer);
   char* limit = cursor + size;
+
+  // Optimization hints only apply to the program the trace was saved from.
+  if ((cursor < limit) && (*cursor == '#')) {
+    char* newline = FindCharacter(cursor, '\n', limit);
+    if (newline == NULL) {
+      return Object::null();
+    }
+    *newline = 0;
+    char* end = NULL;
+    const uint32_t hash = strtoul(cursor + 1, &end, 16);
+    same_program_ = (end == newline) && (hash == ProgramHash(thread_));
+    cursor = newline + 1;
+  }
+
+  // First compile functions named in the trace.
   while (cursor < limit) {
     char* uri = cursor;
     char* comma1 = FindCharacter(uri, ',', limit);
@@ -88,7 +155,14 @@ RawObject* CompilationTraceLoader::CompileTrace(uint8_t* buffer,
       break;
     }
     *newline = 0;
-    error_ = CompileTriple(uri, cls_name, func_name);
+    bool optimized = false;
+    const intptr_t suffix_length = strlen(kOptimizedSuffix);
+    if ((newline - func_name > suffix_length) &&
+        (strcmp(newline - suffix_length, kOptimizedSuffix) == 0)) {
+      optimized = true;
+      *(newline - suffix_length) = 0;
+    }
+    error_ = CompileTriple(uri, cls_name, func_name, optimized);
     if (error_.IsError()) {
       return error_.raw();
     }
@@ -144,7 +218,8 @@ RawObject* CompilationTraceLoader::CompileTrace(uint8_t* buffer,
 //    field.
 RawObject* CompilationTraceLoader::CompileTriple(const char* uri_cstr,
                                                  const char* cls_cstr,
-                                                 const char* func_cstr) {
+                                                 const char* func_cstr,
+                                                 bool optimized) {
   uri_ = Symbols::New(thread_, uri_cstr);
   class_name_ = Symbols::New(thread_, cls_cstr);
   function_name_ = Symbols::New(thread_, func_cstr);
@@ -221,6 +296,9 @@ RawObject* CompilationTraceLoader::CompileTriple(const char* uri_cstr,
     if (error_.IsError()) {
       return error_.raw();
     }
+    if (optimized && !add_closure) {
+      PrimeForOptimization(function_);
+    }
     if (add_closure) {
       function_ = function_.ImplicitClosureFunction();
       error_ = CompileFunction(function_);
@@ -240,6 +318,21 @@ RawObject* CompilationTraceLoader::CompileFunction(const Function& function) {
   return Compiler::CompileFunction(thread_, function);
 }
 
+// Rather than optimizing without type feedback, let the function be optimized
+// after a few invocations have filled in its ICData.
+void CompilationTraceLoader::PrimeForOptimization(const Function& function) {
+  if (!same_program_ || FLAG_precompiled_mode ||
+      (FLAG_optimization_counter_threshold < 0) || !function.HasCode() ||
+      function.HasOptimizedCode() || !function.IsOptimizable()) {
+    return;
+  }
+  const intptr_t usage_counter = Utils::Maximum(
+      0, FLAG_optimization_counter_threshold - FLAG_compilation_trace_warmup);
+  if (function.usage_counter() < usage_counter) {
+    function.set_usage_counter(usage_counter);
+  }
+}
+
 RawObject* CompilationTraceLoader::EvaluateInitializer(const Field& field) {
   LongJumpScope jump;
   if (setjmp(*jump.Set()) == 0) {
@@ -253,4 +346,161 @@ RawObject* CompilationTraceLoader::EvaluateInitializer(const Field& field) {
   return Object::null();
 }
 
+TypeFeedbackSaver::TypeFeedbackSaver(Zone* zone)
+    : buf_(zone, 4 * KB),
+      call_token_pos_(zone, 16),
+      ic_data_array_(Array::Handle(zone)),
+      ic_data_(ICData::Handle(zone)),
+      code_(Code::Handle(zone)),
+      descriptors_(PcDescriptors::Handle(zone)),
+      name_(String::Handle(zone)),
+      cls_(Class::Handle(zone)),
+      lib_(Library::Handle(zone)) {}
+
+void TypeFeedbackSaver::WriteClass(const Class& cls) {
+  lib_ = cls.library();
+  name_ = lib_.url();
+  buf_.Printf("%s,", name_.ToCString());
+  name_ = cls.Name();
+  name_ = String::RemovePrivateKey(name_);
+  buf_.Printf("%s", name_.ToCString());
+}
+
+void TypeFeedbackSaver::Visit(const Function& function) {
+  if (function.parent_function() != Function::null()) {
+    // Local functions cannot be looked up by name.
+    return;
+  }
+  // Call sites are keyed by token position, which only the unoptimized code
+  // maps from deopt ids.
+  code_ = function.unoptimized_code();
+  ic_data_array_ = function.ic_data_array();
+  if (code_.IsNull() || ic_data_array_.IsNull()) {
+    return;
+  }
+  descriptors_ = code_.pc_descriptors();
+  call_token_pos_.Clear();
+  PcDescriptors::Iterator iter(descriptors_, RawPcDescriptors::kIcCall);
+  while (iter.MoveNext()) {
+    const intptr_t deopt_id = iter.DeoptId();
+    if (deopt_id < 0) {
+      continue;
+    }
+    while (call_token_pos_.length() <= deopt_id) {
+      call_token_pos_.Add(TokenPosition::kNoSource.value());
+    }
+    call_token_pos_[deopt_id] = iter.TokenPos().value();
+  }
+
+  // Element 0 holds the edge counters.
+  for (intptr_t i = 1; i < ic_data_array_.Length(); i++) {
+    ic_data_ ^= ic_data_array_.At(i);
+    if (ic_data_.is_static_call() || (ic_data_.NumArgsTested() == 0) ||
+        (ic_data_.NumberOfUsedChecks() == 0)) {
+      continue;
+    }
+    const intptr_t deopt_id = ic_data_.deopt_id();
+    if ((deopt_id >= call_token_pos_.length()) ||
+        !TokenPosition(call_token_pos_[deopt_id]).IsReal()) {
+      continue;
+    }
+    ic_data_ = ic_data_.AsUnaryClassChecksSortedByCount();
+
+    cls_ = function.Owner();
+    WriteClass(cls_);
+    name_ = function.name();
+    name_ = String::RemovePrivateKey(name_);
+    buf_.Printf(",%s,%" Pd ",", name_.ToCString(), call_token_pos_[deopt_id]);
+    name_ = ic_data_.target_name();
+    name_ = String::RemovePrivateKey(name_);
+    buf_.Printf("%s", name_.ToCString());
+    for (intptr_t j = 0; j < ic_data_.NumberOfChecks(); j++) {
+      const intptr_t count = ic_data_.GetCountAt(j);
+      if (count == 0) {
+        continue;
+      }
+      cls_ = Isolate::Current()->class_table()->At(
+          ic_data_.GetReceiverClassIdAt(j));
+      buf_.Printf(",");
+      WriteClass(cls_);
+      buf_.Printf(",%" Pd, count);
+    }
+    buf_.Printf("\n");
+  }
+}
+
+TypeFeedbackReader::TypeFeedbackReader(Zone* zone,
+                                       const uint8_t* buffer,
+                                       intptr_t buffer_length)
+    : zone_(zone),
+      cursor_(zone->Alloc<char>(buffer_length + 1)),
+      end_(cursor_ + buffer_length),
+      line_number_(0),
+      fields_(zone, 16),
+      counts_(zone, 4),
+      call_token_pos_(0),
+      error_(NULL) {
+  // Fields are split in place.
+  memmove(cursor_, buffer, buffer_length);
+  *end_ = '\0';
+}
+
+bool TypeFeedbackReader::Fail(const char* reason) {
+  error_ = zone_->PrintToString("Type feedback line %" Pd " is %s.",
+                                line_number_, reason);
+  cursor_ = end_;
+  return false;
+}
+
+bool TypeFeedbackReader::MoveNext() {
+  fields_.Clear();
+  counts_.Clear();
+  if ((error_ != NULL) || (cursor_ == end_)) {
+    return false;
+  }
+  line_number_++;
+  char* line = cursor_;
+  char* newline = FindCharacter(line, '\n', end_);
+  if (newline == NULL) {
+    // TypeFeedbackSaver ends every line with a newline.
+    return Fail("truncated");
+  }
+  if (FindCharacter(line, '\0', newline) != NULL) {
+    return Fail("malformed");
+  }
+  *newline = '\0';
+  cursor_ = newline + 1;
+
+  char* field = line;
+  while (field != NULL) {
+    fields_.Add(field);
+    field = strchr(field, ',');
+    if (field != NULL) {
+      *field++ = '\0';
+    }
+  }
+  if ((fields_.length() < kCallSiteFields) ||
+      (((fields_.length() - kCallSiteFields) % kReceiverFields) != 0)) {
+    return Fail("malformed");
+  }
+  for (intptr_t i = 0; i < fields_.length(); i++) {
+    if (*fields_[i] == '\0') {
+      return Fail("malformed");
+    }
+  }
+  if (!OS::StringToInt64(fields_[3], &call_token_pos_) ||
+      (call_token_pos_ < 0)) {
+    return Fail("malformed");
+  }
+  for (intptr_t i = kCallSiteFields; i < fields_.length();
+       i += kReceiverFields) {
+    int64_t count = 0;
+    if (!OS::StringToInt64(fields_[i + 2], &count) || (count <= 0)) {
+      return Fail("malformed");
+    }
+    counts_.Add(count);
+  }
+  return true;
+}
+
 }  // namespace dart
@@ -13,6 +13,12 @@
 
 namespace dart {
 
+// A compilation trace starts with a hash of the program's libraries and
+// scripts, followed by one "uri,class,function" line per compiled function.
+// Functions that had optimized code when the trace was saved carry a ",O"
+// suffix. When the trace is loaded into the same program, these functions are
+// primed to be optimized again after a few invocations, once type feedback
+// has been collected; otherwise only unoptimized code is prepared.
 class CompilationTraceSaver : public FunctionVisitor {
  public:
   explicit CompilationTraceSaver(Zone* zone);
@@ -38,11 +44,16 @@ class CompilationTraceLoader : public ValueObject {
 
   RawObject* CompileTrace(uint8_t* buffer, intptr_t buffer_length);
 
+  // Hash of the loaded libraries and their scripts' sources.
+  static uint32_t ProgramHash(Thread* thread);
+
  private:
   RawObject* CompileTriple(const char* uri_cstr,
                            const char* cls_cstr,
-                           const char* func_cstr);
+                           const char* func_cstr,
+                           bool optimized);
   RawObject* CompileFunction(const Function& function);
+  void PrimeForOptimization(const Function& function);
   RawObject* EvaluateInitializer(const Field& field);
 
   Thread* thread_;
@@ -57,6 +68,79 @@ class CompilationTraceLoader : public ValueObject {
   Function& function2_;
   Field& field_;
   Object& error_;
+  bool same_program_;
+};
+
+// Records the receiver classes seen by the instance calls of unoptimized code
+// so that AOT compilation can be guided by a training run. There is one line
+// per call site:
+//   uri,class,function,call token position,selector{,uri,class,count}
+// with receiver classes in decreasing order of count. Names are recorded
+// without private keys.
+class TypeFeedbackSaver : public FunctionVisitor {
+ public:
+  explicit TypeFeedbackSaver(Zone* zone);
+  void Visit(const Function& function);
+
+  void StealBuffer(uint8_t** buffer, intptr_t* buffer_length) {
+    *buffer = reinterpret_cast<uint8_t*>(buf_.buffer());
+    *buffer_length = buf_.length();
+  }
+
+ private:
+  void WriteClass(const Class& cls);
+
+  ZoneTextBuffer buf_;
+  GrowableArray<intptr_t> call_token_pos_;
+  Array& ic_data_array_;
+  ICData& ic_data_;
+  Code& code_;
+  PcDescriptors& descriptors_;
+  String& name_;
+  Class& cls_;
+  Library& lib_;
+};
+
+// Splits the lines recorded by TypeFeedbackSaver into their fields. Names are
+// not resolved, so feedback can be checked before the program is loaded.
+class TypeFeedbackReader : public ValueObject {
+ public:
+  TypeFeedbackReader(Zone* zone, const uint8_t* buffer, intptr_t buffer_length);
+
+  // Moves to the next call site. Returns false at the end of the feedback and
+  // on a malformed or truncated line, in which case error() is not NULL.
+  bool MoveNext();
+  const char* error() const { return error_; }
+
+  const char* uri() const { return fields_[0]; }
+  const char* class_name() const { return fields_[1]; }
+  const char* function_name() const { return fields_[2]; }
+  int64_t call_token_pos() const { return call_token_pos_; }
+  const char* selector() const { return fields_[4]; }
+
+  intptr_t NumReceivers() const { return counts_.length(); }
+  const char* ReceiverUriAt(intptr_t i) const {
+    return fields_[kCallSiteFields + i * kReceiverFields];
+  }
+  const char* ReceiverClassAt(intptr_t i) const {
+    return fields_[kCallSiteFields + i * kReceiverFields + 1];
+  }
+  int64_t ReceiverCountAt(intptr_t i) const { return counts_[i]; }
+
+ private:
+  static const intptr_t kCallSiteFields = 5;
+  static const intptr_t kReceiverFields = 3;
+
+  bool Fail(const char* reason);
+
+  Zone* zone_;
+  char* cursor_;
+  char* end_;
+  intptr_t line_number_;
+  GrowableArray<char*> fields_;
+  GrowableArray<int64_t> counts_;
+  int64_t call_token_pos_;
+  const char* error_;
 };
 
 }  // namespace dart
@@ -705,6 +705,46 @@ static void EnsureICData(Zone* zone,
   }
 }
 
+// Replaces the empty ICData of 'call' with the receiver classes recorded at
+// this call site by Dart_SaveTypeFeedback, so that the call is turned into a
+// polymorphic call that the inliner can specialize for the common receivers.
+// Uncommon receivers still go through the generic call.
+void AotCallSpecializer::TryApplyTypeFeedback(InstanceCallInstr* call) {
+  if (precompiler_ == NULL) {
+    return;
+  }
+  const Function& function = flow_graph()->function();
+  const CallSiteFeedback* feedback = precompiler_->TypeFeedbackAt(
+      function, call->token_pos(), call->function_name());
+  if (feedback == NULL) {
+    return;
+  }
+  const Array& args_desc_array =
+      Array::Handle(Z, call->GetArgumentsDescriptor());
+  const ICData& ic_data = ICData::ZoneHandle(
+      Z, ICData::New(function, call->function_name(), args_desc_array,
+                     Thread::kNoDeoptId, /* args_tested = */ 1,
+                     ICData::kOptimized));
+  Class& cls = Class::Handle(Z);
+  Function& target = Function::Handle(Z);
+  const intptr_t length =
+      Utils::Minimum(feedback->length(),
+                     static_cast<intptr_t>(FLAG_max_polymorphic_checks));
+  for (intptr_t i = 0; i < length; i++) {
+    cls = isolate()->class_table()->At(feedback->CidAt(i));
+    target = call->ResolveForReceiverClass(cls);
+    // See VisitInstanceCall for why lazily injected functions are avoided.
+    if (target.IsNull() || target.IsMethodExtractor() ||
+        target.IsInvokeFieldDispatcher()) {
+      continue;
+    }
+    ic_data.AddReceiverCheck(cls.id(), target, feedback->CountAt(i));
+  }
+  if (ic_data.NumberOfUsedChecks() > 0) {
+    call->set_ic_data(&ic_data);
+  }
+}
+
 // Tries to optimize instance call by replacing it with a faster instruction
 // (e.g, binary op, field load, ..).
 // TODO(dartbug.com/30635) Evaluate how much this can be shared with
@@ -988,6 +1028,11 @@ void AotCallSpecializer::VisitInstanceCall(InstanceCallInstr* instr) {
     }
   }
 
+  // Use the receiver classes seen by a training run, if any.
+  if (instr->ic_data()->NumberOfUsedChecks() == 0) {
+    TryApplyTypeFeedback(instr);
+  }
+
   // More than one target. Generate generic polymorphic call without
   // deoptimization.
   if (instr->ic_data()->NumberOfUsedChecks() > 0) {
@@ -1144,59 +1189,7 @@ bool AotCallSpecializer::TryReplaceInstanceOfWithRangeCheck(
     return false;
   }
 
-  Definition* left = call->ArgumentAt(0);
-
-  // left.instanceof(type) =>
-  //     _classRangeCheck(left.cid, lower_limit, upper_limit)
-  LoadClassIdInstr* left_cid = new (Z) LoadClassIdInstr(new (Z) Value(left));
-  InsertBefore(call, left_cid, NULL, FlowGraph::kValue);
-  ConstantInstr* lower_cid =
-      flow_graph()->GetConstant(Smi::Handle(Z, Smi::New(lower_limit)));
-
-  if (lower_limit == upper_limit) {
-    StrictCompareInstr* check_cid = new (Z)
-        StrictCompareInstr(call->token_pos(), Token::kEQ_STRICT,
-                           new (Z) Value(left_cid), new (Z) Value(lower_cid),
-                           /* number_check = */ false, Thread::kNoDeoptId);
-    ReplaceCall(call, check_cid);
-    return true;
-  }
-
-  ConstantInstr* upper_cid =
-      flow_graph()->GetConstant(Smi::Handle(Z, Smi::New(upper_limit)));
-
-  ZoneGrowableArray<PushArgumentInstr*>* args =
-      new (Z) ZoneGrowableArray<PushArgumentInstr*>(3);
-  PushArgumentInstr* arg = new (Z) PushArgumentInstr(new (Z) Value(left_cid));
-  InsertBefore(call, arg, NULL, FlowGraph::kEffect);
-  args->Add(arg);
-  arg = new (Z) PushArgumentInstr(new (Z) Value(lower_cid));
-  InsertBefore(call, arg, NULL, FlowGraph::kEffect);
-  args->Add(arg);
-  arg = new (Z) PushArgumentInstr(new (Z) Value(upper_cid));
-  InsertBefore(call, arg, NULL, FlowGraph::kEffect);
-  args->Add(arg);
-
-  const Library& dart_internal = Library::Handle(Z, Library::InternalLibrary());
-  const String& target_name = Symbols::_classRangeCheck();
-  const Function& target = Function::ZoneHandle(
-      Z, dart_internal.LookupFunctionAllowPrivate(target_name));
-  ASSERT(!target.IsNull());
-  ASSERT(target.IsRecognized() && target.always_inline());
-
-  const intptr_t kTypeArgsLen = 0;
-  StaticCallInstr* new_call = new (Z) StaticCallInstr(
-      call->token_pos(), target, kTypeArgsLen,
-      Object::null_array(),  // argument_names
-      args, call->deopt_id(), call->CallCount(), ICData::kOptimized);
-  Environment* copy =
-      call->env()->DeepCopy(Z, call->env()->Length() - call->ArgumentCount());
-  for (intptr_t i = 0; i < args->length(); ++i) {
-    copy->PushValue(new (Z) Value((*args)[i]->value()->definition()));
-  }
-  call->RemoveEnvironment();
-  ReplaceCall(call, new_call);
-  copy->DeepCopyTo(Z, new_call);
+  ReplaceInstanceOfWithRangeCheck(call, lower_limit, upper_limit);
   return true;
 }
 
@@ -1218,62 +1211,7 @@ bool AotCallSpecializer::TryReplaceTypeCastWithRangeCheck(
     return false;
   }
 
-  Definition* left = call->ArgumentAt(0);
-
-  // left as type =>
-  //     _classRangeCheck(pos, left, type, left.cid, lower_limit, upper_limit)
-  LoadClassIdInstr* left_cid = new (Z) LoadClassIdInstr(new (Z) Value(left));
-  InsertBefore(call, left_cid, NULL, FlowGraph::kValue);
-  ConstantInstr* lower_cid =
-      flow_graph()->GetConstant(Smi::ZoneHandle(Z, Smi::New(lower_limit)));
-  ConstantInstr* upper_cid =
-      flow_graph()->GetConstant(Smi::ZoneHandle(Z, Smi::New(upper_limit)));
-  ConstantInstr* pos = flow_graph()->GetConstant(
-      Smi::ZoneHandle(Z, Smi::New(call->token_pos().Pos())));
-
-  ZoneGrowableArray<PushArgumentInstr*>* args =
-      new (Z) ZoneGrowableArray<PushArgumentInstr*>(6);
-  PushArgumentInstr* arg = new (Z) PushArgumentInstr(new (Z) Value(pos));
-  InsertBefore(call, arg, NULL, FlowGraph::kEffect);
-  args->Add(arg);
-  arg = new (Z) PushArgumentInstr(new (Z) Value(left));
-  InsertBefore(call, arg, NULL, FlowGraph::kEffect);
-  args->Add(arg);
-  arg =
-      new (Z) PushArgumentInstr(new (Z) Value(flow_graph()->GetConstant(type)));
-  InsertBefore(call, arg, NULL, FlowGraph::kEffect);
-  args->Add(arg);
-  arg = new (Z) PushArgumentInstr(new (Z) Value(left_cid));
-  InsertBefore(call, arg, NULL, FlowGraph::kEffect);
-  args->Add(arg);
-  arg = new (Z) PushArgumentInstr(new (Z) Value(lower_cid));
-  InsertBefore(call, arg, NULL, FlowGraph::kEffect);
-  args->Add(arg);
-  arg = new (Z) PushArgumentInstr(new (Z) Value(upper_cid));
-  InsertBefore(call, arg, NULL, FlowGraph::kEffect);
-  args->Add(arg);
-
-  const Library& dart_internal = Library::Handle(Z, Library::CoreLibrary());
-  const String& target_name = Symbols::_classRangeAssert();
-  const Function& target = Function::ZoneHandle(
-      Z, dart_internal.LookupFunctionAllowPrivate(target_name));
-  ASSERT(!target.IsNull());
-  ASSERT(target.IsRecognized());
-  ASSERT(target.always_inline());
-
-  const intptr_t kTypeArgsLen = 0;
-  StaticCallInstr* new_call = new (Z) StaticCallInstr(
-      call->token_pos(), target, kTypeArgsLen,
-      Object::null_array(),  // argument_names
-      args, call->deopt_id(), call->CallCount(), ICData::kOptimized);
-  Environment* copy =
-      call->env()->DeepCopy(Z, call->env()->Length() - call->ArgumentCount());
-  for (intptr_t i = 0; i < args->length(); ++i) {
-    copy->PushValue(new (Z) Value((*args)[i]->value()->definition()));
-  }
-  call->RemoveEnvironment();
-  ReplaceCall(call, new_call);
-  copy->DeepCopyTo(Z, new_call);
+  ReplaceTypeCastWithRangeCheck(call, type, lower_limit, upper_limit);
   return true;
 }
 
@@ -41,6 +41,9 @@ class AotCallSpecializer : public CallSpecializer {
 
   bool TryCreateICDataForUniqueTarget(InstanceCallInstr* call);
 
+  // Attempt to build ICData for call from the training run's type feedback.
+  void TryApplyTypeFeedback(InstanceCallInstr* call);
+
   bool RecognizeRuntimeTypeGetter(InstanceCallInstr* call);
   bool TryReplaceWithHaveSameRuntimeType(TemplateDartCall<0>* call);
 
@@ -7,9 +7,11 @@
 #include "vm/ast_printer.h"
 #include "vm/class_finalizer.h"
 #include "vm/code_patcher.h"
+#include "vm/compilation_trace.h"
 #include "vm/compiler/aot/aot_call_specializer.h"
 #include "vm/compiler/assembler/assembler.h"
 #include "vm/compiler/assembler/disassembler.h"
+#include "vm/compiler/backend/block_scheduler.h"
 #include "vm/compiler/backend/branch_optimizer.h"
 #include "vm/compiler/backend/constant_propagator.h"
 #include "vm/compiler/backend/flow_graph.h"
@@ -276,6 +278,9 @@ void Precompiler::DoCompileAll(
 
       ClassFinalizer::SortClasses();
 
+      // Class ids are stable from here on.
+      LoadTypeFeedback();
+
       // The cid-ranges of subclasses of a class are e.g. used for is/as checks
       // as well as other type checks.
       HierarchyInfo hierarchy_info(T);
@@ -439,13 +444,37 @@ void Precompiler::PrecompileStaticInitializers() {
   ProgramVisitor::VisitClasses(&visitor);
 }
 
+// Whether instances of the class have final fields whose stored types
+// PrecompileConstructors can collect.
+static bool HasFinalInstanceFields(Zone* zone, const Class& cls) {
+  Class& current = Class::Handle(zone, cls.raw());
+  Array& fields = Array::Handle(zone);
+  Field& field = Field::Handle(zone);
+  while (!current.IsNull()) {
+    fields = current.fields();
+    for (intptr_t i = 0; i < fields.Length(); i++) {
+      field ^= fields.At(i);
+      if (field.is_final() && !field.is_static()) {
+        return true;
+      }
+    }
+    current = current.SuperClass();
+  }
+  return false;
+}
+
 void Precompiler::PrecompileConstructors() {
   class ConstructorVisitor : public FunctionVisitor {
    public:
     explicit ConstructorVisitor(Precompiler* precompiler, Zone* zone)
-        : precompiler_(precompiler), zone_(zone) {}
+        : precompiler_(precompiler), zone_(zone), cls_(Class::Handle(zone)) {}
     void Visit(const Function& function) {
       if (!function.IsGenerativeConstructor()) return;
+      // Compiling the constructor only serves to collect the types stored
+      // into final fields. Stores into final fields of other classes that
+      // get inlined are also seen when compiling their own constructors.
+      cls_ = function.Owner();
+      if (!HasFinalInstanceFields(zone_, cls_)) return;
       if (function.HasCode()) {
         // Const constructors may have been visited before. Recompile them here
         // to collect type information for final fields for them as well.
@@ -461,6 +490,7 @@ void Precompiler::PrecompileConstructors() {
    private:
     Precompiler* precompiler_;
     Zone* zone_;
+    Class& cls_;
   };
 
   HANDLESCOPE(T);
@@ -2465,6 +2495,101 @@ void Precompiler::Obfuscate() {
   I->object_store()->set_obfuscation_map(Array::Handle(Z));
 }
 
+RawClass* Precompiler::LookupFeedbackClass(const char* uri, const char* name) {
+  const String& uri_str = String::Handle(Z, Symbols::New(T, uri));
+  const Library& lib =
+      Library::Handle(Z, Library::LookupLibrary(T, uri_str));
+  if (lib.IsNull()) {
+    return Class::null();
+  }
+  const String& name_str = String::Handle(Z, Symbols::New(T, name));
+  if (name_str.Equals(Symbols::TopLevel())) {
+    return lib.toplevel_class();
+  }
+  return lib.SlowLookupClassAllowMultiPartPrivate(name_str);
+}
+
+// Resolves the call sites recorded by TypeFeedbackSaver to class ids. Call
+// sites naming functions or classes that no longer exist are skipped.
+void Precompiler::LoadTypeFeedback() {
+  const TypedData& feedback =
+      TypedData::Handle(Z, I->object_store()->type_feedback());
+  if (feedback.IsNull()) {
+    return;
+  }
+  I->object_store()->set_type_feedback(TypedData::Handle(Z));
+
+  const intptr_t length = feedback.LengthInBytes();
+  uint8_t* buffer = Z->Alloc<uint8_t>(length);
+  {
+    NoSafepointScope no_safepoint;
+    memmove(buffer, feedback.DataAddr(0), length);
+  }
+
+  Class& cls = Class::Handle(Z);
+  Function& function = Function::Handle(Z);
+  String& name = String::Handle(Z);
+  intptr_t num_call_sites = 0;
+  TypeFeedbackReader reader(Z, buffer, length);
+  while (reader.MoveNext()) {
+    cls = LookupFeedbackClass(reader.uri(), reader.class_name());
+    if (cls.IsNull()) {
+      continue;
+    }
+    name = Symbols::New(T, reader.function_name());
+    function = cls.LookupFunctionAllowPrivate(name);
+    if (function.IsNull()) {
+      continue;
+    }
+    name = Symbols::New(T, reader.selector());
+    CallSiteFeedback* call_site =
+        new (Z) CallSiteFeedback(String::ZoneHandle(Z, name.raw()));
+    for (intptr_t i = 0; i < reader.NumReceivers(); i++) {
+      cls = LookupFeedbackClass(reader.ReceiverUriAt(i),
+                                reader.ReceiverClassAt(i));
+      if (!cls.IsNull()) {
+        call_site->Add(cls.id(), reader.ReceiverCountAt(i));
+      }
+    }
+    if (call_site->length() == 0) {
+      continue;
+    }
+    cls = function.Owner();
+    call_site_feedback_map_.Insert(CallSiteFeedbackPair(
+        CallSiteFeedbackKey(cls.id(), function.token_pos().value(),
+                            reader.call_token_pos()),
+        call_site));
+    num_call_sites++;
+  }
+  // Dart_LoadTypeFeedback rejects malformed feedback.
+  ASSERT(reader.error() == NULL);
+  if (FLAG_trace_precompiler) {
+    THR_Print("Loaded type feedback for %" Pd " call sites\n", num_call_sites);
+  }
+}
+
+const CallSiteFeedback* Precompiler::TypeFeedbackAt(const Function& function,
+                                                    TokenPosition call_pos,
+                                                    const String& selector) {
+  if (call_site_feedback_map_.IsEmpty() || !call_pos.IsReal()) {
+    return NULL;
+  }
+  Zone* zone = Thread::Current()->zone();
+  const Class& owner = Class::Handle(zone, function.Owner());
+  CallSiteFeedback* call_site = call_site_feedback_map_.LookupValue(
+      CallSiteFeedbackKey(owner.id(), function.token_pos().value(),
+                          call_pos.value()));
+  if (call_site == NULL) {
+    return NULL;
+  }
+  const String& name =
+      String::Handle(zone, String::RemovePrivateKey(selector));
+  if (!name.Equals(call_site->selector())) {
+    return NULL;
+  }
+  return call_site;
+}
+
 void Precompiler::FinalizeAllClasses() {
   Library& lib = Library::Handle(Z);
   Class& cls = Class::Handle(Z);
@@ -3058,6 +3183,15 @@ bool PrecompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
           allocator.AllocateRegisters();
         }
 
+        if (FlowGraph::ShouldReorderBlocks(function, optimized())) {
+#ifndef PRODUCT
+          TimelineDurationScope tds2(thread(), compiler_timeline,
+                                     "BlockScheduler::ReorderBlocks");
+#endif  // !PRODUCT
+          BlockScheduler block_scheduler(flow_graph);
+          block_scheduler.ReorderBlocks();
+        }
+
         if (print_flow_graph) {
           FlowGraphPrinter::PrintGraph("After Optimizations", flow_graph);
         }
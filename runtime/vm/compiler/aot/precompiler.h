@@ -320,6 +320,74 @@ struct FunctionFeedbackPair {
 
 typedef DirectChainedHashMap<FunctionFeedbackPair> FunctionFeedbackMap;
 
+// Receiver classes seen at an instance call site in a training run, in
+// decreasing order of count (see Dart_LoadTypeFeedback).
+class CallSiteFeedback : public ZoneAllocated {
+ public:
+  explicit CallSiteFeedback(const String& selector)
+      : selector_(selector), cids_(2), counts_(2) {}
+
+  const String& selector() const { return selector_; }
+  intptr_t length() const { return cids_.length(); }
+  intptr_t CidAt(intptr_t i) const { return cids_[i]; }
+  intptr_t CountAt(intptr_t i) const { return counts_[i]; }
+
+  void Add(intptr_t cid, intptr_t count) {
+    cids_.Add(cid);
+    counts_.Add(count);
+  }
+
+ private:
+  const String& selector_;
+  GrowableArray<intptr_t> cids_;
+  GrowableArray<intptr_t> counts_;
+};
+
+struct CallSiteFeedbackKey {
+  CallSiteFeedbackKey()
+      : owner_cid_(kIllegalCid), function_token_(0), call_token_(0) {}
+  CallSiteFeedbackKey(intptr_t owner_cid,
+                      intptr_t function_token,
+                      intptr_t call_token)
+      : owner_cid_(owner_cid),
+        function_token_(function_token),
+        call_token_(call_token) {}
+
+  intptr_t owner_cid_;
+  intptr_t function_token_;
+  intptr_t call_token_;
+};
+
+struct CallSiteFeedbackPair {
+  // Typedefs needed for the DirectChainedHashMap template.
+  typedef CallSiteFeedbackKey Key;
+  typedef CallSiteFeedback* Value;
+  typedef CallSiteFeedbackPair Pair;
+
+  static Key KeyOf(Pair kv) { return kv.key_; }
+
+  static Value ValueOf(Pair kv) { return kv.value_; }
+
+  static inline intptr_t Hashcode(Key key) {
+    return (key.call_token_ * 31 + key.function_token_) ^ key.owner_cid_;
+  }
+
+  static inline bool IsKeyEqual(Pair pair, Key key) {
+    return (pair.key_.owner_cid_ == key.owner_cid_) &&
+           (pair.key_.function_token_ == key.function_token_) &&
+           (pair.key_.call_token_ == key.call_token_);
+  }
+
+  CallSiteFeedbackPair(Key key, Value value) : key_(key), value_(value) {}
+
+  CallSiteFeedbackPair() : key_(), value_(NULL) {}
+
+  Key key_;
+  Value value_;
+};
+
+typedef DirectChainedHashMap<CallSiteFeedbackPair> CallSiteFeedbackMap;
+
 class Precompiler : public ValueObject {
  public:
   static RawError* CompileAll(
@@ -344,6 +412,12 @@ class Precompiler : public ValueObject {
 
   FieldTypeMap* field_type_map() { return &field_type_map_; }
 
+  // Returns the receiver classes seen at the instance call to 'selector' at
+  // 'call_pos' in 'function' during the training run, or NULL.
+  const CallSiteFeedback* TypeFeedbackAt(const Function& function,
+                                         TokenPosition call_pos,
+                                         const String& selector);
+
   static void PopulateWithICData(const Function& func, FlowGraph* graph);
 
  private:
@@ -398,6 +472,9 @@ class Precompiler : public ValueObject {
 
   void FinalizeAllClasses();
 
+  void LoadTypeFeedback();
+  RawClass* LookupFeedbackClass(const char* uri, const char* name);
+
   Thread* thread() const { return thread_; }
   Zone* zone() const { return zone_; }
   Isolate* isolate() const { return isolate_; }
@@ -431,6 +508,7 @@ class Precompiler : public ValueObject {
   FieldTypeMap field_type_map_;
   CidMap feedback_cid_map_;
   FunctionFeedbackMap function_feedback_map_;
+  CallSiteFeedbackMap call_site_feedback_map_;
   Error& error_;
 
   bool get_runtime_type_is_unique_;
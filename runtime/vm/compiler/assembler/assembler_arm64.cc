@@ -918,6 +918,11 @@ void Assembler::StoreIntoObject(Register object,
   } else {
     StoreIntoObjectFilterNoSmi(object, value, &done);
   }
+  // Objects already in the store buffer need no update; filter them here
+  // rather than in the stub to save the call. The append itself stays in the
+  // stub, which needs more scratch registers than are free here.
+  LoadFieldFromOffset(TMP, object, Object::tags_offset(), kWord);
+  tbnz(&done, TMP, RawObject::kRememberedBit);
   // A store buffer update is required.
   if (value != R0) {
     // Preserve R0.
@@ -1271,7 +1276,7 @@ void Assembler::MaybeTraceAllocation(intptr_t cid,
   ldr(temp_reg, Address(temp_reg, table_offset));
   AddImmediate(temp_reg, state_offset);
   ldr(temp_reg, Address(temp_reg, 0));
-  tsti(temp_reg, Immediate(ClassHeapStats::TraceAllocationMask()));
+  tsti(temp_reg, Immediate(ClassHeapStats::SlowPathAllocationMask()));
   b(trace, NE);
 }
 
@@ -1012,7 +1012,10 @@ class Assembler : public ValueObject {
     const Register crd = ConcreteRegister(rd);
     EmitFPIntCvtOp(FCVTZDS, crd, static_cast<Register>(vn));
   }
-  void fmovdd(VRegister vd, VRegister vn) { EmitFPOneSourceOp(FMOVDD, vd, vn); }
+  void fmovdd(VRegister vd, VRegister vn) {
+    if (vd == vn) return;
+    EmitFPOneSourceOp(FMOVDD, vd, vn);
+  }
   void fabsd(VRegister vd, VRegister vn) { EmitFPOneSourceOp(FABSD, vd, vn); }
   void fnegd(VRegister vd, VRegister vn) { EmitFPOneSourceOp(FNEGD, vd, vn); }
   void fsqrtd(VRegister vd, VRegister vn) { EmitFPOneSourceOp(FSQRTD, vd, vn); }
@@ -1190,14 +1193,19 @@ class Assembler : public ValueObject {
   }
 
   // Aliases.
+  // Moves of a register to itself are dropped: they have no effect.
   void mov(Register rd, Register rn) {
+    if (rd == rn) return;
     if ((rd == CSP) || (rn == CSP)) {
       add(rd, rn, Operand(0));
     } else {
       orr(rd, ZR, Operand(rn));
     }
   }
-  void vmov(VRegister vd, VRegister vn) { vorr(vd, vn, vn); }
+  void vmov(VRegister vd, VRegister vn) {
+    if (vd == vn) return;
+    vorr(vd, vn, vn);
+  }
   void mvn(Register rd, Register rm) { orn(rd, ZR, Operand(rm)); }
   void neg(Register rd, Register rm) { sub(rd, ZR, Operand(rm)); }
   void negs(Register rd, Register rm) { subs(rd, ZR, Operand(rm)); }
@@ -1443,8 +1451,9 @@ class Assembler : public ValueObject {
                                      Register size_reg,
                                      Heap::Space space);
 
-  // If allocation tracing for |cid| is enabled, will jump to |trace| label,
-  // which will allocate in the runtime where tracing occurs.
+  // If allocation tracing or pretenuring for |cid| is enabled, will jump to
+  // |trace| label, which will allocate in the runtime where tracing and
+  // pretenuring occur.
   void MaybeTraceAllocation(intptr_t cid, Register temp_reg, Label* trace);
 
   // Inlined allocation of an instance of class 'cls', code has no runtime
@@ -2159,9 +2159,9 @@ void Assembler::MaybeTraceAllocation(intptr_t cid,
       Isolate::class_table_offset() + ClassTable::TableOffsetFor(cid);
   movl(temp_reg, Address(temp_reg, table_offset));
   state_address = Address(temp_reg, state_offset);
-  testb(state_address, Immediate(ClassHeapStats::TraceAllocationMask()));
-  // We are tracing for this class, jump to the trace label which will use
-  // the allocation stub.
+  testb(state_address, Immediate(ClassHeapStats::SlowPathAllocationMask()));
+  // We are tracing or pretenuring this class, jump to the trace label which
+  // will use the allocation stub.
   j(NOT_ZERO, trace, near_jump);
 }
 
@@ -773,8 +773,9 @@ class Assembler : public ValueObject {
     return kEntryPointToPcMarkerOffset;
   }
 
-  // If allocation tracing for |cid| is enabled, will jump to |trace| label,
-  // which will allocate in the runtime where tracing occurs.
+  // If allocation tracing or pretenuring for |cid| is enabled, will jump to
+  // |trace| label, which will allocate in the runtime where tracing and
+  // pretenuring occur.
   void MaybeTraceAllocation(intptr_t cid,
                             Register temp_reg,
                             Label* trace,
@@ -766,6 +766,16 @@ void Assembler::btq(Register base, int bit) {
   EmitUint8(bit);
 }
 
+void Assembler::btsl(const Address& address, int bit) {
+  ASSERT(bit >= 0 && bit < 32);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitOperandREX(5, address, REX_NONE);
+  EmitUint8(0x0F);
+  EmitUint8(0xBA);
+  EmitOperand(5, address);
+  EmitUint8(bit);
+}
+
 void Assembler::enter(const Immediate& imm) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitUint8(0xC8);
@@ -1221,6 +1231,72 @@ void Assembler::StoreIntoObject(Register object,
     StoreIntoObjectFilterNoSmi(object, value, &done);
   }
   // A store buffer update is required.
+  UpdateStoreBuffer(object, value);
+  Bind(&done);
+}
+
+void Assembler::StoreIntoArray(Register object,
+                               const Address& dest,
+                               Register value,
+                               bool can_value_be_smi) {
+  ASSERT(object != value);
+  movq(dest, value);
+  Label done, remember_object;
+  if (can_value_be_smi) {
+    StoreIntoObjectFilter(object, value, &done);
+  } else {
+    StoreIntoObjectFilterNoSmi(object, value, &done);
+  }
+  // Card remembered arrays dirty the card of the slot instead of being added
+  // to the store buffer.
+  testb(FieldAddress(object, Object::tags_offset()),
+        Immediate(1 << RawObject::kCardRememberedBit));
+  j(ZERO, &remember_object, Assembler::kNearJump);
+  movq(TMP, object);
+  andq(TMP, Immediate(kPageMask));
+  leaq(value, dest);
+  subq(value, TMP);
+  shrq(value, Immediate(HeapPage::kBytesPerCardLog2));
+  movq(TMP, Address(TMP, HeapPage::card_table_offset()));
+  movb(Address(TMP, value, TIMES_1, 0), Immediate(1));
+  jmp(&done, Assembler::kNearJump);
+
+  Bind(&remember_object);
+  UpdateStoreBuffer(object, value);
+  Bind(&done);
+}
+
+void Assembler::UpdateStoreBuffer(Register object, Register value) {
+  Label done, fills_block;
+  // Objects already in the store buffer need no update.
+  testb(FieldAddress(object, Object::tags_offset()),
+        Immediate(1 << RawObject::kRememberedBit));
+  j(NOT_ZERO, &done, Assembler::kNearJump);
+  // The store that fills the block goes through the stub, which processes
+  // the full block.
+  movq(TMP, Address(THR, Thread::store_buffer_block_offset()));
+  movl(value, Address(TMP, StoreBufferBlock::top_offset()));
+  cmpl(value, Immediate(StoreBufferBlock::kSize - 1));
+  j(EQUAL, &fills_block, Assembler::kNearJump);
+  // Atomically set the remembered bit; if another thread set it first, the
+  // object is already in a store buffer. Note that we use a 32 bit operation
+  // here to match the size of the background sweeper which is also
+  // manipulating this 32 bit word.
+  LockBtsl(FieldAddress(object, Object::tags_offset()),
+           RawObject::kRememberedBit);
+  j(CARRY, &done, Assembler::kNearJump);
+  movq(Address(TMP, value, TIMES_8, StoreBufferBlock::pointers_offset()),
+       object);
+  incl(value);
+  movl(Address(TMP, StoreBufferBlock::top_offset()), value);
+  jmp(&done, Assembler::kNearJump);
+
+  Bind(&fills_block);
+  CallUpdateStoreBuffer(object, value);
+  Bind(&done);
+}
+
+void Assembler::CallUpdateStoreBuffer(Register object, Register value) {
   if (value != RDX) pushq(RDX);
   if (object != RDX) {
     movq(RDX, object);
@@ -1232,7 +1308,6 @@ void Assembler::StoreIntoObject(Register object,
 
   popq(CODE_REG);
   if (value != RDX) popq(RDX);
-  Bind(&done);
 }
 
 void Assembler::StoreIntoObjectNoBarrier(Register object,
@@ -1597,9 +1672,9 @@ void Assembler::MaybeTraceAllocation(intptr_t cid,
       Isolate::class_table_offset() + ClassTable::TableOffsetFor(cid);
   movq(temp_reg, Address(temp_reg, table_offset));
   testb(Address(temp_reg, state_offset),
-        Immediate(ClassHeapStats::TraceAllocationMask()));
-  // We are tracing for this class, jump to the trace label which will use
-  // the allocation stub.
+        Immediate(ClassHeapStats::SlowPathAllocationMask()));
+  // We are tracing or pretenuring this class, jump to the trace label which
+  // will use the allocation stub.
   j(NOT_ZERO, trace, near_jump);
 }
 
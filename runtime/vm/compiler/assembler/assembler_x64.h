@@ -399,7 +399,6 @@ class Assembler : public ValueObject {
   XX(L, unpckhps, 0x15, 0x0F)
   XX(L, unpckhpd, 0x15, 0x0F, 0x66)
   XX(L, movlhps, 0x16, 0x0F)
-  XX(L, movaps, 0x28, 0x0F)
   XX(L, comisd, 0x2F, 0x0F, 0x66)
 #define DECLARE_XMM(name, code)                                                \
   XX(L, name##ps, 0x50 + code, 0x0F)                                           \
@@ -463,14 +462,23 @@ class Assembler : public ValueObject {
     EmitL(src, dst, 0x11, 0x0F, 0xF3);
   }
   void movsd(XmmRegister dst, XmmRegister src) {
+    if (dst == src) return;
     EmitL(src, dst, 0x11, 0x0F, 0xF2);
   }
+  void movaps(XmmRegister dst, XmmRegister src) {
+    if (dst == src) return;
+    EmitL(dst, src, 0x28, 0x0F);
+  }
 
   // Use the reversed operand order and the 0x89 bytecode instead of the
   // obvious 0x88 encoding for this some, because it is expected by gdb64 older
   // than 7.3.1-gg5 when disassembling a function's prologue (movq rbp, rsp)
   // for proper unwinding of Dart frames (use --generate_gdb_symbols and -O0).
-  void movq(Register dst, Register src) { EmitQ(src, dst, 0x89); }
+  // Moves of a register to itself are dropped: they have no effect.
+  void movq(Register dst, Register src) {
+    if (dst == src) return;
+    EmitQ(src, dst, 0x89);
+  }
 
   void movd(XmmRegister dst, Register src) {
     EmitL(dst, src, 0x6E, 0x0F, 0x66);
@@ -601,6 +609,7 @@ class Assembler : public ValueObject {
   void shldq(Register dst, Register src, const Immediate& imm);
 
   void btq(Register base, int bit);
+  void btsl(const Address& address, int bit);
 
   void enter(const Immediate& imm);
 
@@ -697,6 +706,13 @@ class Assembler : public ValueObject {
                        Register value,       // Value we are storing.
                        bool can_value_be_smi = true);
 
+  // Like StoreIntoObject, but dirties the card of |dest| in place of adding
+  // card remembered arrays to the store buffer. Destroys value.
+  void StoreIntoArray(Register object,
+                      const Address& dest,
+                      Register value,
+                      bool can_value_be_smi = true);
+
   void StoreIntoObjectNoBarrier(Register object,
                                 const Address& dest,
                                 Register value);
@@ -723,6 +739,12 @@ class Assembler : public ValueObject {
     cmpxchgl(address, reg);
   }
 
+  // Sets the bit and leaves its previous value in the carry flag.
+  void LockBtsl(const Address& address, int bit) {
+    lock();
+    btsl(address, bit);
+  }
+
   void PushRegisters(intptr_t cpu_register_set, intptr_t xmm_register_set);
   void PopRegisters(intptr_t cpu_register_set, intptr_t xmm_register_set);
 
@@ -868,8 +890,9 @@ class Assembler : public ValueObject {
                                      intptr_t instance_size,
                                      Heap::Space space);
 
-  // If allocation tracing for |cid| is enabled, will jump to |trace| label,
-  // which will allocate in the runtime where tracing occurs.
+  // If allocation tracing or pretenuring for |cid| is enabled, will jump to
+  // |trace| label, which will allocate in the runtime where tracing and
+  // pretenuring occur.
   void MaybeTraceAllocation(intptr_t cid, Label* trace, bool near_jump);
 
   // Inlined allocation of an instance of class 'cls', code has no runtime
@@ -1030,6 +1053,14 @@ class Assembler : public ValueObject {
   void StoreIntoObjectFilterNoSmi(Register object,
                                   Register value,
                                   Label* no_update);
+
+  // Adds object to the thread's store buffer block unless it is already
+  // remembered, calling the stub only for the store that fills the block.
+  // Destroys the value register.
+  void UpdateStoreBuffer(Register object, Register value);
+
+  // Adds object to the store buffer through the UpdateStoreBuffer stub.
+  void CallUpdateStoreBuffer(Register object, Register value);
   // Unaware of write barrier (use StoreInto* methods for storing to objects).
   void MoveImmediate(const Address& dst, const Immediate& imm);
 
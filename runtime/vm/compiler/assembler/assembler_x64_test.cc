@@ -1103,6 +1103,26 @@ ASSEMBLER_TEST_RUN(MoveExtend, test) {
       "ret\n");
 }
 
+ASSEMBLER_TEST_GENERATE(SelfMoveDropped, assembler) {
+  __ movq(RAX, Immediate(42));
+  __ movq(RAX, RAX);
+  __ movaps(XMM0, XMM0);
+  __ movsd(XMM1, XMM1);
+  __ movq(RCX, RAX);
+  __ movq(RAX, RCX);
+  __ ret();
+}
+
+ASSEMBLER_TEST_RUN(SelfMoveDropped, test) {
+  typedef int (*SelfMoveDropped)();
+  EXPECT_EQ(42, reinterpret_cast<SelfMoveDropped>(test->entry())());
+  EXPECT_DISASSEMBLY(
+      "movl rax,0x2a\n"
+      "movq rcx,rax\n"
+      "movq rax,rcx\n"
+      "ret\n");
+}
+
 ASSEMBLER_TEST_GENERATE(MoveExtend32, assembler) {
   __ movq(RDX, Immediate(0xffffffff));
   __ movsxd(RDX, RDX);
@@ -5385,6 +5405,40 @@ ASSEMBLER_TEST_RUN(BitTestImmediate, test) {
       "ret\n");
 }
 
+ASSEMBLER_TEST_GENERATE(LockBitTestAndSet, assembler) {
+  __ movq(RAX, Immediate(0));
+  __ pushq(RAX);
+  __ LockBtsl(Address(RSP, 0), 5);
+  Label set;
+  __ j(NOT_CARRY, &set);
+  __ int3();
+  __ Bind(&set);
+  // The second time around the bit is already set.
+  __ LockBtsl(Address(RSP, 0), 5);
+  Label was_set;
+  __ j(CARRY, &was_set);
+  __ int3();
+  __ Bind(&was_set);
+  __ popq(RAX);
+  __ ret();
+}
+
+ASSEMBLER_TEST_RUN(LockBitTestAndSet, test) {
+  typedef int (*LockBitTestAndSet)();
+  EXPECT_EQ(32, reinterpret_cast<LockBitTestAndSet>(test->entry())());
+  EXPECT_DISASSEMBLY(
+      "movl rax,0\n"
+      "push rax\n"
+      "lock bts [rsp],5\n"
+      "jnc 0x................\n"
+      "int3\n"
+      "lock bts [rsp],5\n"
+      "jc 0x................\n"
+      "int3\n"
+      "pop rax\n"
+      "ret\n");
+}
+
 // Return 1 if equal, 0 if not equal.
 ASSEMBLER_TEST_GENERATE(ConditionalMovesEqual, assembler) {
   __ movq(RDX, CallingConventions::kArg1Reg);
@@ -150,6 +150,14 @@ static void Union(GrowableArray<Chain*>* chains,
 }
 
 void BlockScheduler::ReorderBlocks() const {
+  if (FLAG_precompiled_mode) {
+    ReorderBlocksAOT();
+  } else {
+    ReorderBlocksJIT();
+  }
+}
+
+void BlockScheduler::ReorderBlocksJIT() const {
   // Add every block to a chain of length 1 and compute a list of edges
   // sorted by weight.
   intptr_t block_count = flow_graph()->preorder().length();
@@ -210,6 +218,68 @@ void BlockScheduler::ReorderBlocks() const {
   }
 }
 
+void BlockScheduler::ReorderBlocksAOT() const {
+  const GrowableArray<BlockEntryInstr*>& postorder = flow_graph()->postorder();
+  const intptr_t block_count = postorder.length();
+  GrowableArray<bool> is_cold(block_count);
+  is_cold.SetLength(block_count);
+
+  // A block is cold if it ends in a throw or if all its successors are cold.
+  // Successors come first in postorder except along back edges, so a loop
+  // header is never considered cold.
+  for (intptr_t i = 0; i < block_count; ++i) {
+    BlockEntryInstr* block = postorder[i];
+    Instruction* last = block->last_instruction();
+    bool cold = last->IsThrow() || last->IsReThrow() || last->IsStop();
+    if (!cold && (last->SuccessorCount() > 0) && !block->IsGraphEntry() &&
+        (block != flow_graph()->graph_entry()->normal_entry())) {
+      cold = true;
+      for (intptr_t j = 0; j < last->SuccessorCount(); ++j) {
+        const intptr_t succ = last->SuccessorAt(j)->postorder_number();
+        if ((succ >= i) || !is_cold[succ]) {
+          cold = false;
+          break;
+        }
+      }
+    }
+    is_cold[i] = cold;
+  }
+
+  // Exception handlers are cold, and so is everything only reachable from
+  // cold blocks. Predecessors come first in reverse postorder except along
+  // back edges.
+  for (intptr_t i = block_count - 1; i >= 0; --i) {
+    BlockEntryInstr* block = postorder[i];
+    if (block->IsCatchBlockEntry()) {
+      is_cold[i] = true;
+    } else if (!is_cold[i] && (block->PredecessorCount() > 0)) {
+      bool cold = true;
+      for (intptr_t j = 0; j < block->PredecessorCount(); ++j) {
+        const intptr_t pred = block->PredecessorAt(j)->postorder_number();
+        if ((pred <= i) || !is_cold[pred]) {
+          cold = false;
+          break;
+        }
+      }
+      is_cold[i] = cold;
+    }
+  }
+
+  GrowableArray<BlockEntryInstr*>* order =
+      flow_graph()->CodegenBlockOrder(true);
+  ASSERT(order->is_empty());
+  for (intptr_t i = block_count - 1; i >= 0; --i) {
+    if (!is_cold[i]) {
+      order->Add(postorder[i]);
+    }
+  }
+  for (intptr_t i = block_count - 1; i >= 0; --i) {
+    if (is_cold[i]) {
+      order->Add(postorder[i]);
+    }
+  }
+}
+
 }  // namespace dart
 
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
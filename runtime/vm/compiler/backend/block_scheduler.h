@@ -22,6 +22,12 @@ class BlockScheduler : public ValueObject {
   void ReorderBlocks() const;
 
  private:
+  // Chains blocks along the heaviest edges measured by the edge counters.
+  void ReorderBlocksJIT() const;
+  // Keeps the reverse postorder but moves blocks that always throw, and
+  // exception handlers, after all other blocks.
+  void ReorderBlocksAOT() const;
+
   FlowGraph* const flow_graph_;
 };
 
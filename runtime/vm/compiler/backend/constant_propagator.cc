@@ -603,7 +603,64 @@ void ConstantPropagator::VisitStringToCharCode(StringToCharCodeInstr* instr) {
 }
 
 void ConstantPropagator::VisitStringInterpolate(StringInterpolateInstr* instr) {
-  SetValue(instr, non_constant_);
+  // Fold interpolations of parts that are constant in the lattice, e.g.
+  // loads from const instances, into a symbol. See also
+  // StringInterpolateInstr::Canonicalize.
+  CreateArrayInstr* create_array =
+      instr->value()->definition()->AsCreateArray();
+  if ((create_array == NULL) ||
+      (graph_->function().raw() == instr->CallFunction().raw())) {
+    SetValue(instr, non_constant_);
+    return;
+  }
+  Value* num_elements = create_array->num_elements();
+  if (!num_elements->BindsToConstant() ||
+      !num_elements->BoundConstant().IsSmi()) {
+    SetValue(instr, non_constant_);
+    return;
+  }
+  const intptr_t length = Smi::Cast(num_elements->BoundConstant()).Value();
+  GrowableHandlePtrArray<const String> pieces(Z, length);
+  for (intptr_t i = 0; i < length; i++) {
+    pieces.Add(Object::null_string());
+  }
+  intptr_t num_pieces = 0;
+  for (Value::Iterator it(create_array->input_use_list()); !it.Done();
+       it.Advance()) {
+    Instruction* use = it.Current()->instruction();
+    if (use == instr) continue;
+    StoreIndexedInstr* store = use->AsStoreIndexed();
+    if ((store == NULL) || !store->index()->BindsToConstant() ||
+        !store->index()->BoundConstant().IsSmi()) {
+      SetValue(instr, non_constant_);
+      return;
+    }
+    const intptr_t index = Smi::Cast(store->index()->BoundConstant()).Value();
+    const Object& value = store->value()->definition()->constant_value();
+    if (IsNonConstant(value) || (index < 0) || (index >= length) ||
+        !pieces[index].IsNull()) {
+      SetValue(instr, non_constant_);
+      return;
+    }
+    if (!IsConstant(value)) {
+      // Not yet known, wait for the part to be visited.
+      return;
+    }
+    const String& piece =
+        String::Handle(Z, StringInterpolateInstr::ConstantToString(value));
+    if (piece.IsNull()) {
+      SetValue(instr, non_constant_);
+      return;
+    }
+    pieces.SetAt(index, piece);
+    num_pieces++;
+  }
+  if (num_pieces != length) {
+    SetValue(instr, non_constant_);
+    return;
+  }
+  SetValue(instr, String::ZoneHandle(
+                      Z, Symbols::FromConcatAll(Thread::Current(), pieces)));
 }
 
 void ConstantPropagator::VisitLoadIndexed(LoadIndexedInstr* instr) {
@@ -658,6 +715,19 @@ void ConstantPropagator::VisitStoreIndexedUnsafe(
 
 void ConstantPropagator::VisitStoreIndexed(StoreIndexedInstr* instr) {
   SetValue(instr, instr->value()->definition()->constant_value());
+  // The parts of a string interpolation are stored into the array passed to
+  // it. Revisit the interpolation when the value of a part changes.
+  CreateArrayInstr* array = instr->array()->definition()->AsCreateArray();
+  if (array != NULL) {
+    for (Value* use = array->input_use_list(); use != NULL;
+         use = use->next_use()) {
+      Instruction* interpolate = use->instruction();
+      if (interpolate->IsStringInterpolate() &&
+          reachable_->Contains(interpolate->GetBlock()->preorder_number())) {
+        interpolate->Accept(this);
+      }
+    }
+  }
 }
 
 void ConstantPropagator::VisitStoreInstanceField(
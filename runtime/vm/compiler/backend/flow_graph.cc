@@ -114,7 +114,11 @@ void FlowGraph::AddToDeferredPrefixes(
 
 bool FlowGraph::ShouldReorderBlocks(const Function& function,
                                     bool is_optimized) {
-  return is_optimized && FLAG_reorder_basic_blocks && !function.is_intrinsic();
+  // There are no edge counters in AOT mode, but cold blocks can still be moved
+  // out of the way.
+  const bool reorder = FLAG_precompiled_mode ? FLAG_place_cold_blocks_last
+                                             : FLAG_reorder_basic_blocks;
+  return is_optimized && reorder && !function.is_intrinsic();
 }
 
 GrowableArray<BlockEntryInstr*>* FlowGraph::CodegenBlockOrder(
@@ -902,17 +906,55 @@ void FlowGraph::InsertPhis(const GrowableArray<BlockEntryInstr*>& preorder,
     work.Add(-1);
   }
 
+  // Invert assigned_vars so that the blocks assigning each variable can be
+  // enumerated directly instead of testing every block for every variable.
+  // The blocks assigning variable i are
+  // assigning_blocks[assigning_start[i] .. assigning_start[i + 1] - 1],
+  // in increasing preorder.
+  const intptr_t var_count = variable_count();
+  GrowableArray<intptr_t> assigning_start(var_count + 1);
+  for (intptr_t var_index = 0; var_index <= var_count; ++var_index) {
+    assigning_start.Add(0);
+  }
+  for (intptr_t block_index = 0; block_index < block_count; ++block_index) {
+    for (BitVector::Iterator it(assigned_vars[block_index]); !it.Done();
+         it.Advance()) {
+      // Blocks inside try have all bits of their kill set set, including
+      // the unused bits past the last variable.
+      if (it.Current() >= var_count) break;
+      assigning_start[it.Current() + 1]++;
+    }
+  }
+  for (intptr_t var_index = 0; var_index < var_count; ++var_index) {
+    assigning_start[var_index + 1] += assigning_start[var_index];
+  }
+  GrowableArray<intptr_t> assigning_blocks(assigning_start[var_count]);
+  assigning_blocks.SetLength(assigning_start[var_count]);
+  {
+    GrowableArray<intptr_t> fill(var_count);
+    for (intptr_t var_index = 0; var_index < var_count; ++var_index) {
+      fill.Add(assigning_start[var_index]);
+    }
+    for (intptr_t block_index = 0; block_index < block_count; ++block_index) {
+      for (BitVector::Iterator it(assigned_vars[block_index]); !it.Done();
+           it.Advance()) {
+        if (it.Current() >= var_count) break;
+        assigning_blocks[fill[it.Current()]++] = block_index;
+      }
+    }
+  }
+
   // Insert phis for each variable in turn.
   GrowableArray<BlockEntryInstr*> worklist;
-  for (intptr_t var_index = 0; var_index < variable_count(); ++var_index) {
+  for (intptr_t var_index = 0; var_index < var_count; ++var_index) {
     const bool always_live =
         !FLAG_prune_dead_locals || (var_index == CurrentContextEnvIndex());
     // Add to the worklist each block containing an assignment.
-    for (intptr_t block_index = 0; block_index < block_count; ++block_index) {
-      if (assigned_vars[block_index]->Contains(var_index)) {
-        work[block_index] = var_index;
-        worklist.Add(preorder[block_index]);
-      }
+    for (intptr_t i = assigning_start[var_index];
+         i < assigning_start[var_index + 1]; ++i) {
+      const intptr_t block_index = assigning_blocks[i];
+      work[block_index] = var_index;
+      worklist.Add(preorder[block_index]);
     }
 
     while (!worklist.is_empty()) {
@@ -925,7 +967,7 @@ void FlowGraph::InsertPhis(const GrowableArray<BlockEntryInstr*>& preorder,
           BlockEntryInstr* block = preorder[index];
           ASSERT(block->IsJoinEntry());
           PhiInstr* phi =
-              block->AsJoinEntry()->InsertPhi(var_index, variable_count());
+              block->AsJoinEntry()->InsertPhi(var_index, var_count);
           if (always_live) {
             phi->mark_alive();
             live_phis->Add(phi);
@@ -117,6 +117,7 @@ FlowGraphCompiler::FlowGraphCompiler(
       deopt_infos_(),
       static_calls_target_table_(),
       is_optimizing_(is_optimizing),
+      is_baseline_(false),
       speculative_policy_(speculative_policy),
       may_reoptimize_(false),
       intrinsic_mode_(false),
@@ -191,6 +192,8 @@ void FlowGraphCompiler::InitCompiler() {
   // Initialize block info and search optimized (non-OSR) code for calls
   // indicating a non-leaf routine and calls without IC data indicating
   // possible reoptimization.
+  // Baseline code is always reoptimized once it gets hot enough.
+  may_reoptimize_ = is_baseline();
 
   for (int i = 0; i < block_order_.length(); ++i) {
     block_info_.Add(new (zone()) BlockInfo());
@@ -857,6 +860,15 @@ void FlowGraphCompiler::FinalizePcDescriptors(const Code& code) {
   code.set_pc_descriptors(descriptors);
 }
 
+static int CompareDeoptInfoPcOffsets(CompilerDeoptInfo* const* a,
+                                     CompilerDeoptInfo* const* b) {
+  const intptr_t a_offset = (*a)->pc_offset();
+  const intptr_t b_offset = (*b)->pc_offset();
+  if (a_offset < b_offset) return -1;
+  if (a_offset > b_offset) return 1;
+  return 0;
+}
+
 RawArray* FlowGraphCompiler::CreateDeoptInfo(Assembler* assembler) {
   // No deopt information if we precompile (no deoptimization allowed).
   if (FLAG_precompiled_mode) {
@@ -878,6 +890,10 @@ RawArray* FlowGraphCompiler::CreateDeoptInfo(Assembler* assembler) {
     Smi& offset = Smi::Handle();
     TypedData& info = TypedData::Handle();
     Smi& reason_and_flags = Smi::Handle();
+    // Order the table by PC offset so that Code::GetDeoptInfoAtPc can use a
+    // binary search. Suffixes shared by the builder refer to entries by their
+    // position, so the entries must be created in their final order.
+    deopt_infos_.Sort(CompareDeoptInfoPcOffsets);
     for (intptr_t i = 0; i < deopt_infos_.length(); i++) {
       offset = Smi::New(deopt_infos_[i]->pc_offset());
       info = deopt_infos_[i]->CreateDeoptInfo(this, &builder, array);
@@ -1609,7 +1625,9 @@ const ICData* FlowGraphCompiler::GetOrAddStaticCallICData(
 
 intptr_t FlowGraphCompiler::GetOptimizationThreshold() const {
   intptr_t threshold;
-  if (is_optimizing()) {
+  if (is_baseline()) {
+    threshold = FLAG_optimization_counter_threshold;
+  } else if (is_optimizing()) {
     threshold = FLAG_reoptimization_counter_threshold;
   } else if (parsed_function_.function().IsIrregexpFunction()) {
     threshold = FLAG_regexp_optimization_counter_threshold;
@@ -1621,6 +1639,10 @@ intptr_t FlowGraphCompiler::GetOptimizationThreshold() const {
     if (threshold > FLAG_optimization_counter_threshold) {
       threshold = FLAG_optimization_counter_threshold;
     }
+    if ((FLAG_baseline_optimization_counter_threshold >= 0) &&
+        (threshold > FLAG_baseline_optimization_counter_threshold)) {
+      threshold = FLAG_baseline_optimization_counter_threshold;
+    }
   }
   return threshold;
 }
@@ -300,6 +300,16 @@ class FlowGraphCompiler : public ValueObject {
   bool CanOSRFunction() const;
   bool is_optimizing() const { return is_optimizing_; }
 
+  // Baseline optimized code was compiled with only the cheap optimization
+  // passes. It keeps counting invocations so that the function is fully
+  // optimized once it reaches optimization_counter_threshold.
+  // Must be set before CompileGraph.
+  bool is_baseline() const { return is_baseline_; }
+  void set_is_baseline(bool value) {
+    ASSERT(is_optimizing() || !value);
+    is_baseline_ = value;
+  }
+
   void EnterIntrinsicMode();
   void ExitIntrinsicMode();
   bool intrinsic_mode() const { return intrinsic_mode_; }
@@ -818,6 +828,7 @@ class FlowGraphCompiler : public ValueObject {
   // separate table?
   GrowableArray<StaticCallsStruct*> static_calls_target_table_;
   const bool is_optimizing_;
+  bool is_baseline_;
   SpeculativeInliningPolicy* speculative_policy_;
   // Set to true if optimized code has IC calls.
   bool may_reoptimize_;
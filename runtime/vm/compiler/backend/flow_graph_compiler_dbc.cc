@@ -312,7 +312,7 @@ void FlowGraphCompiler::EmitFrameEntry() {
 
   if (CanOptimizeFunction() && function.IsOptimizable() &&
       (!is_optimizing() || may_reoptimize())) {
-    __ HotCheck(!is_optimizing(), GetOptimizationThreshold());
+    __ HotCheck(!is_optimizing() || is_baseline(), GetOptimizationThreshold());
   }
 
   if (is_optimizing()) {
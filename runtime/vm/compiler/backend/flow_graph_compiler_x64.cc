@@ -735,8 +735,9 @@ void FlowGraphCompiler::EmitFrameEntry() {
       __ LoadFunctionFromCalleePool(function_reg, function, new_pp);
 
       // Reoptimization of an optimized function is triggered by counting in
-      // IC stubs, but not at the entry of the function.
-      if (!is_optimizing()) {
+      // IC stubs, but not at the entry of the function. Baseline code also
+      // counts at the entry.
+      if (!is_optimizing() || is_baseline()) {
         __ incl(FieldAddress(function_reg, Function::usage_counter_offset()));
       }
       __ cmpl(FieldAddress(function_reg, Function::usage_counter_offset()),
@@ -3595,7 +3595,33 @@ bool PolymorphicInstanceCallInstr::IsSureToCallSingleRecognizedTarget() const {
   return targets_.HasSingleRecognizedTarget();
 }
 
+// Returns true if 'function' is _StringBase._interpolateSingle, which the
+// kernel flow graph builder calls for interpolations with a single part.
+static bool IsStringInterpolateSingle(const Function& function) {
+  if (!function.is_static()) {
+    return false;
+  }
+  const Class& owner = Class::Handle(function.Owner());
+  if (owner.library() != Library::CoreLibrary()) {
+    return false;
+  }
+  return function.name() ==
+         Library::PrivateCoreLibName(Symbols::InterpolateSingle()).raw();
+}
+
 Definition* StaticCallInstr::Canonicalize(FlowGraph* flow_graph) {
+  if ((ArgumentCount() == 1) &&
+      PushArgumentAt(0)->value()->BindsToConstant() &&
+      IsStringInterpolateSingle(function())) {
+    const Object& argument = PushArgumentAt(0)->value()->BoundConstant();
+    const String& result =
+        String::Handle(StringInterpolateInstr::ConstantToString(argument));
+    if (!result.IsNull()) {
+      return flow_graph->GetConstant(
+          String::ZoneHandle(Symbols::New(Thread::Current(), result)));
+    }
+  }
+
   if (!FLAG_precompiled_mode) {
     return this;
   }
@@ -3611,6 +3637,37 @@ Definition* StaticCallInstr::Canonicalize(FlowGraph* flow_graph) {
   return this;
 }
 
+bool StaticCallInstr::HasUnknownSideEffects() const {
+  switch (function().recognized_kind()) {
+    case MethodRecognizer::kObjectIdentical:
+    case MethodRecognizer::kClassIDgetID:
+    case MethodRecognizer::kStringBaseLength:
+    case MethodRecognizer::kStringBaseIsEmpty:
+    case MethodRecognizer::kIntegerToDouble:
+    case MethodRecognizer::kDoubleToInteger:
+    case MethodRecognizer::kDoubleTruncate:
+    case MethodRecognizer::kDoubleRound:
+    case MethodRecognizer::kDoubleFloor:
+    case MethodRecognizer::kDoubleCeil:
+    case MethodRecognizer::kDoubleMod:
+    case MethodRecognizer::kDouble_getIsNaN:
+    case MethodRecognizer::kDouble_getIsInfinite:
+    case MethodRecognizer::kDouble_getIsNegative:
+    case MethodRecognizer::kMathSqrt:
+    case MethodRecognizer::kMathDoublePow:
+    case MethodRecognizer::kMathSin:
+    case MethodRecognizer::kMathCos:
+    case MethodRecognizer::kMathTan:
+    case MethodRecognizer::kMathAsin:
+    case MethodRecognizer::kMathAcos:
+    case MethodRecognizer::kMathAtan:
+    case MethodRecognizer::kMathAtan2:
+      return false;
+    default:
+      return true;
+  }
+}
+
 LocationSummary* StaticCallInstr::MakeLocationSummary(Zone* zone,
                                                       bool optimizing) const {
   return MakeCallSummary(zone);
@@ -4183,6 +4240,22 @@ const Function& StringInterpolateInstr::CallFunction() const {
   return function_;
 }
 
+// Returns the compile-time string value of a constant, or the null string.
+RawString* StringInterpolateInstr::ConstantToString(const Object& value) {
+  // TODO(srdjan): Verify if any other types should be converted as well.
+  if (value.IsString()) {
+    return String::Cast(value).raw();
+  } else if (value.IsInteger()) {
+    return Symbols::New(Thread::Current(), value.ToCString());
+  } else if (value.IsBool()) {
+    return Bool::Cast(value).value() ? Symbols::True().raw()
+                                     : Symbols::False().raw();
+  } else if (value.IsNull()) {
+    return Symbols::null().raw();
+  }
+  return String::null();
+}
+
 // Replace StringInterpolateInstr with a constant string if all inputs are
 // constant of [string, number, boolean, null].
 // Leave the CreateArrayInstr and StoreIndexedInstr in the stream in case
@@ -4231,21 +4304,11 @@ Definition* StringInterpolateInstr::Canonicalize(FlowGraph* flow_graph) {
     if (store->value()->definition()->IsConstant()) {
       ASSERT(store->index()->BindsToConstant());
       const Object& obj = store->value()->definition()->AsConstant()->value();
-      // TODO(srdjan): Verify if any other types should be converted as well.
-      if (obj.IsString()) {
-        pieces.SetAt(store_index, String::Cast(obj));
-      } else if (obj.IsSmi()) {
-        const char* cstr = obj.ToCString();
-        pieces.SetAt(store_index,
-                     String::Handle(zone, String::New(cstr, Heap::kOld)));
-      } else if (obj.IsBool()) {
-        pieces.SetAt(store_index, Bool::Cast(obj).value() ? Symbols::True()
-                                                          : Symbols::False());
-      } else if (obj.IsNull()) {
-        pieces.SetAt(store_index, Symbols::null());
-      } else {
+      const String& piece = String::Handle(zone, ConstantToString(obj));
+      if (piece.IsNull()) {
         return this;
       }
+      pieces.SetAt(store_index, piece);
     } else {
       return this;
     }
@@ -3702,7 +3702,9 @@ class StaticCallInstr : public TemplateDartCall<0> {
     return true;
   }
 
-  virtual bool HasUnknownSideEffects() const { return true; }
+  // Calls to recognized core library methods that neither write to memory
+  // visible to Dart code nor call back into user code do not kill loads.
+  virtual bool HasUnknownSideEffects() const;
 
   void SetResultType(Zone* zone, CompileType new_type) {
     result_type_ = new (zone) CompileType(new_type);
@@ -4099,7 +4101,7 @@ class GuardFieldLengthInstr : public GuardFieldInstr {
 class LoadStaticFieldInstr : public TemplateDefinition<1, NoThrow> {
  public:
   LoadStaticFieldInstr(Value* field_value, TokenPosition token_pos)
-      : token_pos_(token_pos) {
+      : inferred_type_(NULL), token_pos_(token_pos) {
     ASSERT(field_value->BindsToConstant());
     SetInputAt(0, field_value);
   }
@@ -4111,6 +4113,12 @@ class LoadStaticFieldInstr : public TemplateDefinition<1, NoThrow> {
 
   Value* field_value() const { return inputs_[0]; }
 
+  // Type of the field inferred by the front-end, if any.
+  void SetInferredType(Zone* zone, CompileType new_type) {
+    inferred_type_ = new (zone) CompileType(new_type);
+  }
+  CompileType* inferred_type() const { return inferred_type_; }
+
   virtual bool ComputeCanDeoptimize() const { return false; }
 
   virtual bool AllowsCSE() const {
@@ -4125,6 +4133,7 @@ class LoadStaticFieldInstr : public TemplateDefinition<1, NoThrow> {
   PRINT_OPERANDS_TO_SUPPORT
 
  private:
+  CompileType* inferred_type_;  // Inferred field type.
   const TokenPosition token_pos_;
 
   DISALLOW_COPY_AND_ASSIGN(LoadStaticFieldInstr);
@@ -4362,6 +4371,10 @@ class StringInterpolateInstr : public TemplateDefinition<1, Throws> {
 
   const Function& CallFunction() const;
 
+  // Returns the string an interpolated constant 'value' is converted to, or
+  // the null string if it can't be computed at compile time.
+  static RawString* ConstantToString(const Object& value);
+
   virtual Definition* Canonicalize(FlowGraph* flow_graph);
 
   DECLARE_INSTRUCTION(StringInterpolate)
@@ -4770,6 +4783,7 @@ class LoadFieldInstr : public TemplateDefinition<1, NoThrow> {
       : offset_in_bytes_(offset_in_bytes),
         type_(type),
         result_cid_(kDynamicCid),
+        inferred_type_(NULL),
         immutable_(false),
         recognized_kind_(MethodRecognizer::kUnknown),
         field_(NULL),
@@ -4788,6 +4802,7 @@ class LoadFieldInstr : public TemplateDefinition<1, NoThrow> {
       : offset_in_bytes_(field->Offset()),
         type_(type),
         result_cid_(kDynamicCid),
+        inferred_type_(NULL),
         immutable_(false),
         recognized_kind_(MethodRecognizer::kUnknown),
         field_(field),
@@ -4814,6 +4829,13 @@ class LoadFieldInstr : public TemplateDefinition<1, NoThrow> {
   intptr_t result_cid() const { return result_cid_; }
   virtual TokenPosition token_pos() const { return token_pos_; }
 
+  // Type of the field inferred by the front-end, if any. Used when the
+  // field guard does not know better.
+  void SetInferredType(Zone* zone, CompileType new_type) {
+    inferred_type_ = new (zone) CompileType(new_type);
+  }
+  CompileType* inferred_type() const { return inferred_type_; }
+
   const Field* field() const { return field_; }
 
   virtual Representation representation() const;
@@ -4861,6 +4883,7 @@ class LoadFieldInstr : public TemplateDefinition<1, NoThrow> {
   const intptr_t offset_in_bytes_;
   const AbstractType& type_;
   intptr_t result_cid_;
+  CompileType* inferred_type_;  // Inferred field type.
   bool immutable_;
 
   MethodRecognizer::Kind recognized_kind_;
@@ -59,6 +59,12 @@ DEFINE_FLAG(int,
             inlining_caller_size_threshold,
             50000,
             "Stop inlining once caller reaches the threshold.");
+DEFINE_FLAG(int,
+            inlining_growth_budget,
+            10,
+            "Only inline callees larger than --inlining-size-threshold while "
+            "the caller has grown less than threshold times its size. Hotter "
+            "call sites are considered first.");
 DEFINE_FLAG(int,
             inlining_constant_arguments_count,
             1,
@@ -74,6 +80,11 @@ DEFINE_FLAG(int,
             60,
             "Inline function calls with sufficient constant arguments "
             "and up to the increased threshold on instructions");
+DEFINE_FLAG(int,
+            inlining_unboxed_values_size_threshold,
+            60,
+            "Inline function calls that pass doubles or SIMD values and are "
+            "below the threshold, so that these values are not boxed.");
 DEFINE_FLAG(int,
             inlining_hotness,
             10,
@@ -447,7 +458,37 @@ class CallSites : public ValueObject {
     ComputeCallSiteRatio(static_call_start_ix, instance_call_start_ix);
   }
 
+  // Orders the call sites hottest first, so that the inlining budget of the
+  // caller is spent where it matters most.
+  void SortByRatio() {
+    static_calls_.Sort(CompareStaticCallRatios);
+    instance_calls_.Sort(CompareInstanceCallRatios);
+  }
+
  private:
+  static int CompareRatios(double a_ratio,
+                           intptr_t a_deopt_id,
+                           double b_ratio,
+                           intptr_t b_deopt_id) {
+    if (a_ratio != b_ratio) {
+      return (a_ratio > b_ratio) ? -1 : 1;
+    }
+    // Keep the order deterministic for call sites that are equally hot.
+    return (a_deopt_id < b_deopt_id) ? -1 : (a_deopt_id > b_deopt_id) ? 1 : 0;
+  }
+
+  static int CompareStaticCallRatios(const StaticCallInfo* a,
+                                     const StaticCallInfo* b) {
+    return CompareRatios(a->ratio, a->call->deopt_id(), b->ratio,
+                         b->call->deopt_id());
+  }
+
+  static int CompareInstanceCallRatios(const InstanceCallInfo* a,
+                                       const InstanceCallInfo* b) {
+    return CompareRatios(a->ratio, a->call->deopt_id(), b->ratio,
+                         b->call->deopt_id());
+  }
+
   intptr_t inlining_depth_threshold_;
   GrowableArray<StaticCallInfo> static_calls_;
   GrowableArray<ClosureCallInfo> closure_calls_;
@@ -688,7 +729,8 @@ class CallSiteInliner : public ValueObject {
   InliningDecision ShouldWeInline(const Function& callee,
                                   intptr_t instr_count,
                                   intptr_t call_site_count,
-                                  intptr_t const_arg_count) {
+                                  intptr_t const_arg_count,
+                                  intptr_t unboxed_value_count) {
     if (inliner_->AlwaysInline(callee)) {
       return InliningDecision::Yes("AlwaysInline");
     }
@@ -696,6 +738,12 @@ class CallSiteInliner : public ValueObject {
       // Prevent methods becoming humongous and thus slow to compile.
       return InliningDecision::No("--inlining-caller-size-threshold");
     }
+    // Call sites are visited hottest first, so once the budget is spent only
+    // callees that are about as small as the call itself are inlined.
+    if ((instr_count > FLAG_inlining_size_threshold) &&
+        (inlined_size_ + instr_count > SizeBudget())) {
+      return InliningDecision::No("--inlining-growth-budget");
+    }
     if (const_arg_count > 0) {
       if (instr_count > FLAG_inlining_constant_arguments_max_size_threshold) {
         return InliningDecision(
@@ -722,6 +770,12 @@ class CallSiteInliner : public ValueObject {
                               "--inlining-constant-arguments-count and "
                               "inlining-constant-arguments-min-size-threshold");
     }
+    // Calls between optimized functions pass doubles and SIMD values boxed.
+    // Inlining slightly larger callees removes those allocations.
+    if ((unboxed_value_count > 0) && (instr_count != 0) &&
+        (instr_count <= FLAG_inlining_unboxed_values_size_threshold)) {
+      return InliningDecision::Yes("--inlining-unboxed-values-size-threshold");
+    }
     return InliningDecision::No("default");
   }
 
@@ -756,11 +810,11 @@ class CallSiteInliner : public ValueObject {
       collected_call_sites_ = inlining_call_sites_;
       inlining_call_sites_ = call_sites_temp;
       collected_call_sites_->Clear();
+      inlining_call_sites_->SortByRatio();
       // Inline call sites at the current depth.
-      bool inlined_instance = InlineInstanceCalls();
-      bool inlined_statics = InlineStaticCalls();
+      bool inlined_calls = InlineInstanceAndStaticCalls();
       bool inlined_closures = InlineClosureCalls();
-      if (inlined_instance || inlined_statics || inlined_closures) {
+      if (inlined_calls || inlined_closures) {
         // Increment the inlining depths. Checked before subsequent inlining.
         ++inlining_depth_;
         if (inlined_recursive_call_) {
@@ -777,6 +831,14 @@ class CallSiteInliner : public ValueObject {
 
   bool inlined() const { return inlined_; }
 
+  // The number of instructions the inlined callees may add to the caller.
+  intptr_t SizeBudget() const {
+    const intptr_t base_size = Utils::Maximum(
+        initial_size_,
+        static_cast<intptr_t>(FLAG_inlining_callee_size_threshold));
+    return base_size * FLAG_inlining_growth_budget;
+  }
+
   double GrowthFactor() const {
     return static_cast<double>(inlined_size_) /
            static_cast<double>(initial_size_);
@@ -860,9 +922,11 @@ class CallSiteInliner : public ValueObject {
 
     GrowableArray<Value*>* arguments = call_data->arguments;
     const intptr_t constant_arguments = CountConstants(*arguments);
+    const intptr_t unboxed_values = CountUnboxedValues(function, *arguments);
     InliningDecision decision = ShouldWeInline(
         function, function.optimized_instruction_count(),
-        function.optimized_call_site_count(), constant_arguments);
+        function.optimized_call_site_count(), constant_arguments,
+        unboxed_values);
     if (!decision.value) {
       TRACE_INLINING(
           THR_Print("     Bailout: early heuristics (%s) with "
@@ -1117,7 +1181,8 @@ class CallSiteInliner : public ValueObject {
 
         // Use heuristics do decide if this call should be inlined.
         InliningDecision decision =
-            ShouldWeInline(function, size, call_site_count, constants_count);
+            ShouldWeInline(function, size, call_site_count, constants_count,
+                           CountUnboxedValues(function, *arguments));
         if (!decision.value) {
           // If size is larger than all thresholds, don't consider it again.
           if ((size > FLAG_inlining_size_threshold) &&
@@ -1312,6 +1377,30 @@ class CallSiteInliner : public ValueObject {
     return count;
   }
 
+  static bool IsUnboxable(intptr_t cid) {
+    return (cid == kDoubleCid) || (cid == kFloat32x4Cid) ||
+           (cid == kFloat64x2Cid) || (cid == kInt32x4Cid);
+  }
+
+  // Count the values that would be boxed to cross the call boundary: the
+  // arguments known to be doubles or SIMD values and the result if the
+  // callee is declared to return one.
+  static intptr_t CountUnboxedValues(const Function& callee,
+                                     const GrowableArray<Value*>& arguments) {
+    intptr_t count = 0;
+    for (intptr_t i = 0; i < arguments.length(); i++) {
+      if (IsUnboxable(arguments[i]->Type()->ToCid())) count++;
+    }
+    const AbstractType& result_type =
+        AbstractType::Handle(callee.result_type());
+    if (!result_type.IsNull() &&
+        (result_type.IsDoubleType() || result_type.IsFloat32x4Type() ||
+         result_type.IsFloat64x2Type() || result_type.IsInt32x4Type())) {
+      count++;
+    }
+    return count;
+  }
+
   // Parse a function reusing the cache if possible.
   ParsedFunction* GetParsedFunction(const Function& function, bool* in_cache) {
     // TODO(zerny): Use a hash map for the cache.
@@ -1332,49 +1421,69 @@ class CallSiteInliner : public ValueObject {
     return parsed_function;
   }
 
-  bool InlineStaticCalls() {
+  // Visits instance and static call sites together, hottest first. Both
+  // lists are sorted by CallSites::SortByRatio.
+  bool InlineInstanceAndStaticCalls() {
     bool inlined = false;
-    const GrowableArray<CallSites::StaticCallInfo>& call_info =
+    const GrowableArray<CallSites::InstanceCallInfo>& instance_info =
+        inlining_call_sites_->instance_calls();
+    const GrowableArray<CallSites::StaticCallInfo>& static_info =
         inlining_call_sites_->static_calls();
-    TRACE_INLINING(THR_Print("  Static Calls (%" Pd ")\n", call_info.length()));
-    for (intptr_t call_idx = 0; call_idx < call_info.length(); ++call_idx) {
-      StaticCallInstr* call = call_info[call_idx].call;
-
-      if (FlowGraphInliner::TryReplaceStaticCallWithInline(
-              inliner_->flow_graph(), NULL, call,
-              inliner_->speculative_policy_)) {
-        inlined = true;
-        continue;
+    TRACE_INLINING(THR_Print("  Polymorphic Instance Calls (%" Pd
+                             "), Static Calls (%" Pd ")\n",
+                             instance_info.length(), static_info.length()));
+    intptr_t instance_idx = 0;
+    intptr_t static_idx = 0;
+    while ((instance_idx < instance_info.length()) ||
+           (static_idx < static_info.length())) {
+      if ((static_idx == static_info.length()) ||
+          ((instance_idx < instance_info.length()) &&
+           (instance_info[instance_idx].ratio >=
+            static_info[static_idx].ratio))) {
+        if (InlineInstanceCall(instance_info[instance_idx++])) inlined = true;
+      } else {
+        if (InlineStaticCall(static_info[static_idx++])) inlined = true;
       }
+    }
+    return inlined;
+  }
 
-      const Function& target = call->function();
-      if (!inliner_->AlwaysInline(target) &&
-          (call_info[call_idx].ratio * 100) < FLAG_inlining_hotness) {
-        if (trace_inlining()) {
-          String& name = String::Handle(target.QualifiedUserVisibleName());
-          THR_Print("  => %s (deopt count %d)\n     Bailout: cold %f\n",
-                    name.ToCString(), target.deoptimization_counter(),
-                    call_info[call_idx].ratio);
-        }
-        PRINT_INLINING_TREE("Too cold", &call_info[call_idx].caller(),
-                            &call->function(), call);
-        continue;
-      }
+  bool InlineStaticCall(const CallSites::StaticCallInfo& call_info) {
+    StaticCallInstr* call = call_info.call;
 
-      GrowableArray<Value*> arguments(call->ArgumentCount());
-      for (int i = 0; i < call->ArgumentCount(); ++i) {
-        arguments.Add(call->PushArgumentAt(i)->value());
-      }
-      InlinedCallData call_data(
-          call, Array::ZoneHandle(Z, call->GetArgumentsDescriptor()),
-          call->FirstArgIndex(), &arguments, call_info[call_idx].caller(),
-          call_info[call_idx].caller_graph->inlining_id());
-      if (TryInlining(call->function(), call->argument_names(), &call_data)) {
-        InlineCall(&call_data);
-        inlined = true;
+    if (FlowGraphInliner::TryReplaceStaticCallWithInline(
+            inliner_->flow_graph(), NULL, call,
+            inliner_->speculative_policy_)) {
+      return true;
+    }
+
+    const Function& target = call->function();
+    if (!inliner_->AlwaysInline(target) &&
+        (call_info.ratio * 100) < FLAG_inlining_hotness) {
+      if (trace_inlining()) {
+        String& name = String::Handle(target.QualifiedUserVisibleName());
+        THR_Print("  => %s (deopt count %d)\n     Bailout: cold %f\n",
+                  name.ToCString(), target.deoptimization_counter(),
+                  call_info.ratio);
       }
+      PRINT_INLINING_TREE("Too cold", &call_info.caller(), &call->function(),
+                          call);
+      return false;
     }
-    return inlined;
+
+    GrowableArray<Value*> arguments(call->ArgumentCount());
+    for (int i = 0; i < call->ArgumentCount(); ++i) {
+      arguments.Add(call->PushArgumentAt(i)->value());
+    }
+    InlinedCallData call_data(
+        call, Array::ZoneHandle(Z, call->GetArgumentsDescriptor()),
+        call->FirstArgIndex(), &arguments, call_info.caller(),
+        call_info.caller_graph->inlining_id());
+    if (TryInlining(call->function(), call->argument_names(), &call_data)) {
+      InlineCall(&call_data);
+      return true;
+    }
+    return false;
   }
 
   bool InlineClosureCalls() {
@@ -1429,28 +1538,19 @@ class CallSiteInliner : public ValueObject {
     return inlined;
   }
 
-  bool InlineInstanceCalls() {
-    bool inlined = false;
-    const GrowableArray<CallSites::InstanceCallInfo>& call_info =
-        inlining_call_sites_->instance_calls();
-    TRACE_INLINING(THR_Print("  Polymorphic Instance Calls (%" Pd ")\n",
-                             call_info.length()));
-    for (intptr_t call_idx = 0; call_idx < call_info.length(); ++call_idx) {
-      PolymorphicInstanceCallInstr* call = call_info[call_idx].call;
-      // PolymorphicInliner introduces deoptimization paths.
-      if (!call->complete() && !FLAG_polymorphic_with_deopt) {
-        TRACE_INLINING(
-            THR_Print("  => %s\n     Bailout: call with checks\n",
-                      call->instance_call()->function_name().ToCString()));
-        continue;
-      }
-      const Function& cl = call_info[call_idx].caller();
-      intptr_t caller_inlining_id =
-          call_info[call_idx].caller_graph->inlining_id();
-      PolymorphicInliner inliner(this, call, cl, caller_inlining_id);
-      if (inliner.Inline()) inlined = true;
+  bool InlineInstanceCall(const CallSites::InstanceCallInfo& call_info) {
+    PolymorphicInstanceCallInstr* call = call_info.call;
+    // PolymorphicInliner introduces deoptimization paths.
+    if (!call->complete() && !FLAG_polymorphic_with_deopt) {
+      TRACE_INLINING(
+          THR_Print("  => %s\n     Bailout: call with checks\n",
+                    call->instance_call()->function_name().ToCString()));
+      return false;
     }
-    return inlined;
+    const Function& cl = call_info.caller();
+    intptr_t caller_inlining_id = call_info.caller_graph->inlining_id();
+    PolymorphicInliner inliner(this, call, cl, caller_inlining_id);
+    return inliner.Inline();
   }
 
   bool AdjustForOptionalParameters(const ParsedFunction& parsed_function,
@@ -1877,6 +1877,7 @@ void FlowGraphAllocator::SpillBetween(LiveRange* range,
   TRACE_ALLOC(THR_Print("spill v%" Pd " [%" Pd ", %" Pd ") "
                         "between [%" Pd ", %" Pd ")\n",
                         range->vreg(), range->Start(), range->End(), from, to));
+  from = HoistSpillPosition(range, from);
   LiveRange* tail = range->SplitAt(from);
 
   if (tail->Start() < to) {
@@ -1894,26 +1895,32 @@ void FlowGraphAllocator::SpillAfter(LiveRange* range, intptr_t from) {
   TRACE_ALLOC(THR_Print("spill v%" Pd " [%" Pd ", %" Pd ") after %" Pd "\n",
                         range->vreg(), range->Start(), range->End(), from));
 
-  // When spilling the value inside the loop check if this spill can
-  // be moved outside.
-  BlockInfo* block_info = BlockInfoAt(from);
-  if (block_info->is_loop_header() || (block_info->loop() != NULL)) {
-    BlockInfo* loop_header =
-        block_info->is_loop_header() ? block_info : block_info->loop();
-
-    if ((range->Start() <= loop_header->entry()->start_pos()) &&
-        RangeHasOnlyUnconstrainedUsesInLoop(range, loop_header->loop_id())) {
-      ASSERT(loop_header->entry()->start_pos() <= from);
-      from = loop_header->entry()->start_pos();
-      TRACE_ALLOC(
-          THR_Print("  moved spill position to loop header %" Pd "\n", from));
-    }
-  }
-
+  from = HoistSpillPosition(range, from);
   LiveRange* tail = range->SplitAt(from);
   Spill(tail);
 }
 
+intptr_t FlowGraphAllocator::HoistSpillPosition(LiveRange* range,
+                                                intptr_t from) {
+  // When spilling the value inside the loop check if this spill can
+  // be moved outside. Keep moving it outwards while the enclosing loop
+  // has no register uses of the value either: the spill store then
+  // executes once instead of on every iteration of the loop nest.
+  BlockInfo* block_info = BlockInfoAt(from);
+  BlockInfo* loop_header =
+      block_info->is_loop_header() ? block_info : block_info->loop();
+  while ((loop_header != NULL) &&
+         (range->Start() <= loop_header->entry()->start_pos()) &&
+         RangeHasOnlyUnconstrainedUsesInLoop(range, loop_header->loop_id())) {
+    ASSERT(loop_header->entry()->start_pos() <= from);
+    from = loop_header->entry()->start_pos();
+    TRACE_ALLOC(
+        THR_Print("  moved spill position to loop header %" Pd "\n", from));
+    loop_header = loop_header->loop();
+  }
+  return from;
+}
+
 void FlowGraphAllocator::AllocateSpillSlotFor(LiveRange* range) {
 #if defined(TARGET_ARCH_DBC)
   // There is no need to support spilling on DBC because we have a lot of
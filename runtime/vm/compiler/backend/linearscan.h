@@ -232,6 +232,11 @@ class FlowGraphAllocator : public ValueObject {
   // position preceding the to position.
   void SpillBetween(LiveRange* range, intptr_t from, intptr_t to);
 
+  // If the given spill position is inside loops that the range enters live
+  // and has no register uses in, return the start of the outermost such
+  // loop, so that the spill store executes once outside of the loops.
+  intptr_t HoistSpillPosition(LiveRange* range, intptr_t from);
+
   // Mark the live range as a live object pointer at all safepoints
   // contained in the range.
   void MarkAsObjectAtSafepoints(LiveRange* range);
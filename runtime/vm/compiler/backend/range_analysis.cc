@@ -51,27 +51,29 @@ static Definition* UnwrapConstraint(Definition* defn) {
 
 // Simple induction variable is a variable that satisfies the following pattern:
 //
-//                         v1 <- phi(v0, v1 + 1)
+//                         v1 <- phi(v0, v1 + C)
 //
-// If there are two simple induction variables in the same block and one of
-// them is constrained - then another one is constrained as well, e.g.
-// from
+// where C is a positive Smi constant (the step).
+//
+// If there are two simple induction variables with the same step in the same
+// block and one of them is constrained - then another one is constrained as
+// well, e.g. from
 //
 //                        B1:
-//                         v3 <- phi(v0, v3 + 1)
-//                         v4 <- phi(v2, v4 + 1)
+//                         v3 <- phi(v0, v3 + C)
+//                         v4 <- phi(v2, v4 + C)
 //                        Bx:
 //                         v3 is constrained to [v0, v1]
 //
 // it follows that
 //
 //                        Bx:
-//                         v4 is constrained to [v2, v2 + (v0 - v1)]
+//                         v4 is constrained to [v2, v2 + (v1 - v0)]
 //
 // This pass essentially pattern matches induction variables introduced
 // like this:
 //
-//                  for (var i = i0, j = j0; i < L; i++, j++) {
+//                  for (var i = i0, j = j0; i < L; i += C, j += C) {
 //                      j is known to be within [j0, j0 + (L - i0 - 1)]
 //                  }
 //
@@ -91,11 +93,17 @@ class InductionVariableInfo : public ZoneAllocated {
   Definition* initial_value() const { return initial_value_; }
   BinarySmiOpInstr* increment() const { return increment_; }
 
+  // Positive constant added to the induction variable on every iteration.
+  intptr_t step() const {
+    return Smi::Cast(increment_->right()->BoundConstant()).Value();
+  }
+
   // Outermost constraint that constrains this induction variable into
   // [-inf, X] range.
   ConstraintInstr* limit() const { return limit_; }
 
-  // Induction variable from the same join block that has limiting constraint.
+  // Induction variable with the same step from the same join block that has
+  // limiting constraint.
   PhiInstr* bound() const { return bound_; }
   void set_bound(PhiInstr* bound) { bound_ = bound; }
 
@@ -154,7 +162,7 @@ static InductionVariableInfo* DetectSimpleInductionVariable(PhiInstr* phi) {
       (UnwrapConstraint(increment->left()->definition()) == phi) &&
       increment->right()->BindsToConstant() &&
       increment->right()->BoundConstant().IsSmi() &&
-      (Smi::Cast(increment->right()->BoundConstant()).Value() == 1)) {
+      (Smi::Cast(increment->right()->BoundConstant()).Value() > 0)) {
     return new InductionVariableInfo(
         phi, initial_value, increment,
         FindBoundingConstraint(phi, increment->left()->definition()));
@@ -190,17 +198,21 @@ void RangeAnalysis::DiscoverSimpleInductionVariables() {
       }
     }
 
-    InductionVariableInfo* bound = NULL;
+    // Induction variables advance in lockstep only if their steps are equal,
+    // so each variable is bounded by the first constrained variable with the
+    // same step.
     for (intptr_t i = 0; i < loop_variables.length(); i++) {
-      if (loop_variables[i]->limit() != NULL) {
-        bound = loop_variables[i];
-        break;
+      InductionVariableInfo* info = loop_variables[i];
+      InductionVariableInfo* bound = NULL;
+      for (intptr_t j = 0; j < loop_variables.length(); j++) {
+        if ((loop_variables[j]->limit() != NULL) &&
+            (loop_variables[j]->step() == info->step())) {
+          bound = loop_variables[j];
+          break;
+        }
       }
-    }
 
-    if (bound != NULL) {
-      for (intptr_t i = 0; i < loop_variables.length(); i++) {
-        InductionVariableInfo* info = loop_variables[i];
+      if (bound != NULL) {
         info->set_bound(bound->phi());
         info->phi()->set_induction_variable_info(info);
       }
@@ -472,10 +484,43 @@ const Range* RangeAnalysis::GetIntRange(Value* value) const {
   return range;
 }
 
+// Strip constraints and redefinitions to get to the value they refine.
+static Definition* UnwrapRedefinitions(Definition* defn) {
+  while (true) {
+    if (defn->IsConstraint()) {
+      defn = defn->AsConstraint()->value()->definition();
+    } else if (defn->IsRedefinition()) {
+      defn = defn->AsRedefinition()->value()->definition();
+    } else if (defn->IsAssertAssignable()) {
+      defn = defn->AsAssertAssignable()->value()->definition();
+    } else {
+      return defn;
+    }
+  }
+}
+
 static bool AreEqualDefinitions(Definition* a, Definition* b) {
   a = UnwrapConstraint(a);
   b = UnwrapConstraint(b);
-  return (a == b) || (a->AllowsCSE() && b->AllowsCSE() && a->Equals(b));
+  if (a == b) return true;
+  if (!a->AllowsCSE() || !b->AllowsCSE()) return false;
+  if (a->Equals(b)) return true;
+
+  // Pure computations over the same values are equal even if their inputs
+  // are different redefinitions of these values. This is common for the
+  // length of an array: the loop condition loads it from the array while
+  // the bounds check inside an inlined body loads it from a redefinition
+  // produced by a check of the receiver.
+  if ((a->tag() != b->tag()) || (a->InputCount() != b->InputCount())) {
+    return false;
+  }
+  for (intptr_t i = 0; i < a->InputCount(); i++) {
+    if (UnwrapRedefinitions(a->InputAt(i)->definition()) !=
+        UnwrapRedefinitions(b->InputAt(i)->definition())) {
+      return false;
+    }
+  }
+  return a->AttributesEqual(b);
 }
 
 static bool DependOnSameSymbol(const RangeBoundary& a, const RangeBoundary& b) {
@@ -1094,7 +1139,9 @@ class BoundsCheckGeneralizer {
   //   3. if value is a substraction then construct bound for the left hand
   //      side and use substraction of the right hand side from the left hand
   //      side bound as a bound for an expression (substraction is monotone for
-  //      the left hand side operand).
+  //      the left hand side operand);
+  //   4. if value is a left shift by a constant C then treat it as
+  //      multiplication by 2^C.
   //
   Definition* ConstructBound(PhiBoundFunc phi_bound_func,
                              Definition* value,
@@ -1122,6 +1169,19 @@ class BoundsCheckGeneralizer {
             (new_right != UnwrapConstraint(bin_op->right()->definition()))) {
           return MakeBinaryOp(bin_op->op_kind(), new_left, new_right);
         }
+      } else if ((bin_op->op_kind() == Token::kSHL) &&
+                 bin_op->right()->BindsToConstant() &&
+                 bin_op->right()->BoundConstant().IsSmi()) {
+        const intptr_t shift =
+            Smi::Cast(bin_op->right()->BoundConstant()).Value();
+        if ((shift >= 0) && (shift < kSmiBits)) {
+          Definition* new_left = ConstructBound(
+              phi_bound_func, bin_op->left()->definition(), point);
+          if (new_left != UnwrapConstraint(bin_op->left()->definition())) {
+            return MakeBinaryOp(Token::kMUL, new_left,
+                                static_cast<intptr_t>(1) << shift);
+          }
+        }
       }
     }
 
@@ -1134,7 +1194,7 @@ class BoundsCheckGeneralizer {
       if (point->IsDominatedBy(info.limit())) {
         // Given induction variable
         //
-        //          x <- phi(x0, x + 1)
+        //          x <- phi(x0, x + C)
         //
         // and a constraint x <= M that dominates the given
         // point we conclude that M is an upper bound for x.
@@ -1144,10 +1204,10 @@ class BoundsCheckGeneralizer {
       const InductionVariableInfo& bound_info =
           *info.bound()->induction_variable_info();
       if (point->IsDominatedBy(bound_info.limit())) {
-        // Given two induction variables
+        // Given two induction variables with the same step
         //
-        //          x <- phi(x0, x + 1)
-        //          y <- phi(y0, y + 1)
+        //          x <- phi(x0, x + C)
+        //          y <- phi(y0, y + C)
         //
         // and a constraint x <= M that dominates the given
         // point we can conclude that
@@ -1171,9 +1231,9 @@ class BoundsCheckGeneralizer {
   Definition* InductionVariableLowerBound(PhiInstr* phi, Instruction* point) {
     // Given induction variable
     //
-    //          x <- phi(x0, x + 1)
+    //          x <- phi(x0, x + C)
     //
-    // we can conclude that LowerBound(x) == x0.
+    // with a positive C we can conclude that LowerBound(x) == x0.
     const InductionVariableInfo& info = *phi->induction_variable_info();
     return ConstructLowerBound(info.initial_value(), point);
   }
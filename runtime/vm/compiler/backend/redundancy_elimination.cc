@@ -2581,7 +2581,8 @@ enum SafeUseCheck { kOptimisticCheck, kStrictCheck };
 //     - any store into the allocation candidate itself is unconditionally safe
 //       as it just changes the rematerialization state of this candidate;
 //     - store into another object is only safe if another object is allocation
-//       candidate.
+//       candidate. This covers objects captured by closures, which are stored
+//       into the closure's context.
 //
 // We use a simple fix-point algorithm to discover the set of valid candidates
 // (see CollectCandidates method), that's why this IsSafeUse can operate in two
@@ -2604,7 +2605,8 @@ static bool IsSafeUse(Value* use, SafeUseCheck check_type) {
   if (store != NULL) {
     if (use == store->value()) {
       Definition* instance = store->instance()->definition();
-      return instance->IsAllocateObject() &&
+      return (instance->IsAllocateObject() ||
+              instance->IsAllocateUninitializedContext()) &&
              ((check_type == kOptimisticCheck) ||
               instance->Identity().IsAllocationSinkingCandidate());
     }
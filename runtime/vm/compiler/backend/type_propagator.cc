@@ -1219,6 +1219,12 @@ CompileType LoadStaticFieldInstr::ComputeType() const {
       if (!IsNullableCid(cid)) is_nullable = CompileType::kNonNullable;
     }
   }
+  if (((cid == kDynamicCid) || (cid == kIllegalCid)) &&
+      (inferred_type_ != NULL) &&
+      (inferred_type_->ToNullableCid() != kDynamicCid)) {
+    TraceStrongModeType(this, inferred_type_);
+    return *inferred_type_;
+  }
   return CompileType(is_nullable, cid, abstract_type);
 }
 
@@ -1262,6 +1268,19 @@ CompileType LoadFieldInstr::ComputeType() const {
     TraceStrongModeType(this, *abstract_type);
   }
 
+  if ((field_ != NULL) && (field_->guarded_cid() != kIllegalCid) &&
+      (field_->guarded_cid() != kDynamicCid)) {
+    bool is_nullable = field_->is_nullable();
+    intptr_t field_cid = field_->guarded_cid();
+    return CompileType(is_nullable, field_cid, abstract_type);
+  }
+
+  if ((inferred_type_ != NULL) &&
+      (inferred_type_->ToNullableCid() != kDynamicCid)) {
+    TraceStrongModeType(this, inferred_type_);
+    return *inferred_type_;
+  }
+
   if ((field_ != NULL) && (field_->guarded_cid() != kIllegalCid)) {
     bool is_nullable = field_->is_nullable();
     intptr_t field_cid = field_->guarded_cid();
@@ -890,6 +890,17 @@ void CallSpecializer::InlineImplicitInstanceGetter(Definition* call,
       isolate()->use_field_guards() ? &flow_graph()->parsed_function() : NULL);
   load->set_is_immutable(field.is_final());
 
+  // Keep the result type inferred by the front-end for the call site.
+  CompileType* inferred_type = NULL;
+  if (call->IsInstanceCall()) {
+    inferred_type = call->AsInstanceCall()->result_type();
+  } else if (call->IsStaticCall()) {
+    inferred_type = call->AsStaticCall()->result_type();
+  }
+  if (inferred_type != NULL) {
+    load->SetInferredType(Z, *inferred_type);
+  }
+
   // Discard the environment from the original instruction because the load
   // can't deoptimize.
   call->RemoveEnvironment();
@@ -1241,11 +1252,96 @@ bool CallSpecializer::TypeCheckAsClassEquality(const AbstractType& type) {
   return true;
 }
 
+bool CallSpecializer::TypeCheckAsClassRange(const AbstractType& type,
+                                            intptr_t* lower_limit,
+                                            intptr_t* upper_limit) {
+  ASSERT(type.IsFinalized() && !type.IsMalformedOrMalbounded());
+  // In AOT mode we can't use CHA deoptimizations; the precompiler computes
+  // class id ranges from the closed world instead.
+  if (FLAG_precompiled_mode || !FLAG_use_cha_deopt) return false;
+  if (!type.IsInstantiated()) return false;
+  if (type.IsFunctionType() || type.IsDartFunctionType()) return false;
+  const Class& type_class = Class::Handle(Z, type.type_class());
+  // Only raw class types can be checked by class id alone.
+  if (type_class.NumTypeArguments() > 0) return false;
+  if (!thread()->cha()->ConcreteSubclassRange(type_class, lower_limit,
+                                              upper_limit)) {
+    return false;
+  }
+  if (FLAG_trace_cha) {
+    THR_Print("  **(CHA) Typecheck as class range [%" Pd ", %" Pd "]: %s\n",
+              *lower_limit, *upper_limit, type_class.ToCString());
+  }
+  return true;
+}
+
 bool CallSpecializer::TryReplaceInstanceOfWithRangeCheck(
     InstanceCallInstr* call,
     const AbstractType& type) {
-  // TODO(dartbug.com/30632) does this optimization make sense in JIT?
-  return false;
+  intptr_t lower_limit, upper_limit;
+  if (!TypeCheckAsClassRange(type, &lower_limit, &upper_limit)) {
+    return false;
+  }
+  ReplaceInstanceOfWithRangeCheck(call, lower_limit, upper_limit);
+  return true;
+}
+
+void CallSpecializer::ReplaceInstanceOfWithRangeCheck(InstanceCallInstr* call,
+                                                      intptr_t lower_limit,
+                                                      intptr_t upper_limit) {
+  Definition* left = call->ArgumentAt(0);
+
+  // left.instanceof(type) =>
+  //     _classRangeCheck(left.cid, lower_limit, upper_limit)
+  LoadClassIdInstr* left_cid = new (Z) LoadClassIdInstr(new (Z) Value(left));
+  InsertBefore(call, left_cid, NULL, FlowGraph::kValue);
+  ConstantInstr* lower_cid =
+      flow_graph()->GetConstant(Smi::Handle(Z, Smi::New(lower_limit)));
+
+  if (lower_limit == upper_limit) {
+    StrictCompareInstr* check_cid = new (Z)
+        StrictCompareInstr(call->token_pos(), Token::kEQ_STRICT,
+                           new (Z) Value(left_cid), new (Z) Value(lower_cid),
+                           /* number_check = */ false, Thread::kNoDeoptId);
+    ReplaceCall(call, check_cid);
+    return;
+  }
+
+  ConstantInstr* upper_cid =
+      flow_graph()->GetConstant(Smi::Handle(Z, Smi::New(upper_limit)));
+
+  ZoneGrowableArray<PushArgumentInstr*>* args =
+      new (Z) ZoneGrowableArray<PushArgumentInstr*>(3);
+  PushArgumentInstr* arg = new (Z) PushArgumentInstr(new (Z) Value(left_cid));
+  InsertBefore(call, arg, NULL, FlowGraph::kEffect);
+  args->Add(arg);
+  arg = new (Z) PushArgumentInstr(new (Z) Value(lower_cid));
+  InsertBefore(call, arg, NULL, FlowGraph::kEffect);
+  args->Add(arg);
+  arg = new (Z) PushArgumentInstr(new (Z) Value(upper_cid));
+  InsertBefore(call, arg, NULL, FlowGraph::kEffect);
+  args->Add(arg);
+
+  const Library& dart_internal = Library::Handle(Z, Library::InternalLibrary());
+  const String& target_name = Symbols::_classRangeCheck();
+  const Function& target = Function::ZoneHandle(
+      Z, dart_internal.LookupFunctionAllowPrivate(target_name));
+  ASSERT(!target.IsNull());
+  ASSERT(target.IsRecognized() && target.always_inline());
+
+  const intptr_t kTypeArgsLen = 0;
+  StaticCallInstr* new_call = new (Z) StaticCallInstr(
+      call->token_pos(), target, kTypeArgsLen,
+      Object::null_array(),  // argument_names
+      args, call->deopt_id(), call->CallCount(), ICData::kOptimized);
+  Environment* copy =
+      call->env()->DeepCopy(Z, call->env()->Length() - call->ArgumentCount());
+  for (intptr_t i = 0; i < args->length(); ++i) {
+    copy->PushValue(new (Z) Value((*args)[i]->value()->definition()));
+  }
+  call->RemoveEnvironment();
+  ReplaceCall(call, new_call);
+  copy->DeepCopyTo(Z, new_call);
 }
 
 bool CallSpecializer::TryOptimizeInstanceOfUsingStaticTypes(
@@ -1371,8 +1467,74 @@ void CallSpecializer::ReplaceWithInstanceOf(InstanceCallInstr* call) {
 bool CallSpecializer::TryReplaceTypeCastWithRangeCheck(
     InstanceCallInstr* call,
     const AbstractType& type) {
-  // TODO(dartbug.com/30632) does this optimization make sense in JIT?
-  return false;
+  intptr_t lower_limit, upper_limit;
+  if (!TypeCheckAsClassRange(type, &lower_limit, &upper_limit)) {
+    return false;
+  }
+  ReplaceTypeCastWithRangeCheck(call, type, lower_limit, upper_limit);
+  return true;
+}
+
+void CallSpecializer::ReplaceTypeCastWithRangeCheck(InstanceCallInstr* call,
+                                                    const AbstractType& type,
+                                                    intptr_t lower_limit,
+                                                    intptr_t upper_limit) {
+  Definition* left = call->ArgumentAt(0);
+
+  // left as type =>
+  //     _classRangeCheck(pos, left, type, left.cid, lower_limit, upper_limit)
+  LoadClassIdInstr* left_cid = new (Z) LoadClassIdInstr(new (Z) Value(left));
+  InsertBefore(call, left_cid, NULL, FlowGraph::kValue);
+  ConstantInstr* lower_cid =
+      flow_graph()->GetConstant(Smi::ZoneHandle(Z, Smi::New(lower_limit)));
+  ConstantInstr* upper_cid =
+      flow_graph()->GetConstant(Smi::ZoneHandle(Z, Smi::New(upper_limit)));
+  ConstantInstr* pos = flow_graph()->GetConstant(
+      Smi::ZoneHandle(Z, Smi::New(call->token_pos().Pos())));
+
+  ZoneGrowableArray<PushArgumentInstr*>* args =
+      new (Z) ZoneGrowableArray<PushArgumentInstr*>(6);
+  PushArgumentInstr* arg = new (Z) PushArgumentInstr(new (Z) Value(pos));
+  InsertBefore(call, arg, NULL, FlowGraph::kEffect);
+  args->Add(arg);
+  arg = new (Z) PushArgumentInstr(new (Z) Value(left));
+  InsertBefore(call, arg, NULL, FlowGraph::kEffect);
+  args->Add(arg);
+  arg =
+      new (Z) PushArgumentInstr(new (Z) Value(flow_graph()->GetConstant(type)));
+  InsertBefore(call, arg, NULL, FlowGraph::kEffect);
+  args->Add(arg);
+  arg = new (Z) PushArgumentInstr(new (Z) Value(left_cid));
+  InsertBefore(call, arg, NULL, FlowGraph::kEffect);
+  args->Add(arg);
+  arg = new (Z) PushArgumentInstr(new (Z) Value(lower_cid));
+  InsertBefore(call, arg, NULL, FlowGraph::kEffect);
+  args->Add(arg);
+  arg = new (Z) PushArgumentInstr(new (Z) Value(upper_cid));
+  InsertBefore(call, arg, NULL, FlowGraph::kEffect);
+  args->Add(arg);
+
+  const Library& dart_internal = Library::Handle(Z, Library::CoreLibrary());
+  const String& target_name = Symbols::_classRangeAssert();
+  const Function& target = Function::ZoneHandle(
+      Z, dart_internal.LookupFunctionAllowPrivate(target_name));
+  ASSERT(!target.IsNull());
+  ASSERT(target.IsRecognized());
+  ASSERT(target.always_inline());
+
+  const intptr_t kTypeArgsLen = 0;
+  StaticCallInstr* new_call = new (Z) StaticCallInstr(
+      call->token_pos(), target, kTypeArgsLen,
+      Object::null_array(),  // argument_names
+      args, call->deopt_id(), call->CallCount(), ICData::kOptimized);
+  Environment* copy =
+      call->env()->DeepCopy(Z, call->env()->Length() - call->ArgumentCount());
+  for (intptr_t i = 0; i < args->length(); ++i) {
+    copy->PushValue(new (Z) Value((*args)[i]->value()->definition()));
+  }
+  call->RemoveEnvironment();
+  ReplaceCall(call, new_call);
+  copy->DeepCopyTo(Z, new_call);
 }
 
 void CallSpecializer::ReplaceWithTypeCast(InstanceCallInstr* call) {
@@ -108,6 +108,16 @@ class CallSpecializer : public FlowGraphVisitor {
   virtual bool TryReplaceTypeCastWithRangeCheck(InstanceCallInstr* call,
                                                 const AbstractType& type);
 
+  // Replace the type test or type cast 'call' with a check that the class
+  // id of the tested value is in [lower_limit, upper_limit].
+  void ReplaceInstanceOfWithRangeCheck(InstanceCallInstr* call,
+                                       intptr_t lower_limit,
+                                       intptr_t upper_limit);
+  void ReplaceTypeCastWithRangeCheck(InstanceCallInstr* call,
+                                     const AbstractType& type,
+                                     intptr_t lower_limit,
+                                     intptr_t upper_limit);
+
   virtual bool TryOptimizeStaticCallUsingStaticTypes(StaticCallInstr* call) = 0;
 
  protected:
@@ -119,6 +129,12 @@ class CallSpecializer : public FlowGraphVisitor {
  private:
   bool TypeCheckAsClassEquality(const AbstractType& type);
 
+  // Returns true if CHA shows that the instances of 'type' have class ids
+  // in [lower_limit, upper_limit].
+  bool TypeCheckAsClassRange(const AbstractType& type,
+                             intptr_t* lower_limit,
+                             intptr_t* upper_limit);
+
   // Insert a check of 'to_check' determined by 'unary_checks'.  If the
   // check fails it will deoptimize to 'deopt_id' using the deoptimization
   // environment 'deopt_environment'.  The check is inserted immediately
@@ -112,6 +112,71 @@ static intptr_t CountFinalizedSubclasses(Thread* thread, const Class& cls) {
   return count;
 }
 
+// Collects 'cls' and its finalized subclasses into 'classes'. Returns false
+// if any of them is implemented by another class.
+static bool CollectUnimplementedSubclasses(
+    Thread* thread,
+    const Class& cls,
+    GrowableArray<const Class*>* classes) {
+  if (CHA::IsImplemented(cls)) {
+    return false;
+  }
+  classes->Add(&Class::ZoneHandle(thread->zone(), cls.raw()));
+  const GrowableObjectArray& cls_direct_subclasses =
+      GrowableObjectArray::Handle(thread->zone(), cls.direct_subclasses());
+  if (cls_direct_subclasses.IsNull()) return true;
+  Class& direct_subclass = Class::Handle(thread->zone());
+  for (intptr_t i = 0; i < cls_direct_subclasses.Length(); i++) {
+    direct_subclass ^= cls_direct_subclasses.At(i);
+    // Unfinalized classes are treated as non-existent for CHA purposes,
+    // as that means that no instance of that class exists at runtime.
+    if (!direct_subclass.is_finalized()) {
+      continue;
+    }
+    if (!CollectUnimplementedSubclasses(thread, direct_subclass, classes)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CHA::ConcreteSubclassRange(const Class& cls,
+                                intptr_t* lower_limit,
+                                intptr_t* upper_limit) {
+  if (cls.InVMHeap()) return false;
+  if (cls.IsObjectClass()) return false;
+
+  GrowableArray<const Class*> classes;
+  if (!CollectUnimplementedSubclasses(thread_, cls, &classes)) {
+    return false;
+  }
+
+  // The concrete classes are a contiguous range if their number matches the
+  // distance between the smallest and the largest class id.
+  intptr_t lower = kIllegalCid;
+  intptr_t upper = kIllegalCid;
+  intptr_t concrete_count = 0;
+  for (intptr_t i = 0; i < classes.length(); i++) {
+    const Class& subclass = *classes[i];
+    if (subclass.is_abstract()) continue;
+    const intptr_t cid = subclass.id();
+    if ((concrete_count == 0) || (cid < lower)) lower = cid;
+    if ((concrete_count == 0) || (cid > upper)) upper = cid;
+    concrete_count++;
+  }
+  if ((concrete_count == 0) || ((upper - lower + 1) != concrete_count)) {
+    return false;
+  }
+
+  for (intptr_t i = 0; i < classes.length(); i++) {
+    AddToGuardedClasses(*classes[i],
+                        CountFinalizedSubclasses(thread_, *classes[i]));
+  }
+  *lower_limit = lower;
+  *upper_limit = upper;
+  return true;
+}
+
 bool CHA::IsConsistentWithCurrentHierarchy() const {
   for (intptr_t i = 0; i < guarded_classes_.length(); i++) {
     const intptr_t subclass_count =
@@ -44,6 +44,16 @@ class CHA : public StackResource {
   // Return true if the class is implemented by some other class.
   static bool IsImplemented(const Class& cls);
 
+  // Returns true if neither 'cls' nor any of its subclasses is implemented by
+  // another class and the class ids of the finalized concrete subclasses of
+  // 'cls' (including 'cls' itself) form the range [lower_limit, upper_limit].
+  // Then every instance of a subtype of 'cls' has a class id in that range.
+  // On success 'cls' and its subclasses are added to the guarded classes,
+  // so that loading a new subtype discards the code relying on the range.
+  bool ConcreteSubclassRange(const Class& cls,
+                             intptr_t* lower_limit,
+                             intptr_t* upper_limit);
+
   // Returns true if any subclass of 'cls' contains the function.
   // If no override was found subclass_count would contain total count of
   // finalized subclasses that CHA looked at.
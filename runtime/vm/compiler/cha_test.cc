@@ -95,4 +95,46 @@ TEST_CASE(ClassHierarchyAnalysis) {
   EXPECT(!cha.HasSubclasses(closure_class.id()));
 }
 
+TEST_CASE(ClassHierarchyAnalysisSubclassRange) {
+  const char* kScriptChars =
+      "class A {}\n"
+      "abstract class B extends A {}\n"
+      "class C extends B {}\n"
+      "class D {}\n"
+      "class E implements D {}\n";
+
+  TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  const String& name = String::Handle(String::New(TestCase::url()));
+  const Library& lib = Library::Handle(Library::LookupLibrary(thread, name));
+  EXPECT(!lib.IsNull());
+
+  const Class& class_b =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "B"))));
+  EXPECT(!class_b.IsNull());
+
+  const Class& class_c =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "C"))));
+  EXPECT(!class_c.IsNull());
+
+  const Class& class_d =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "D"))));
+  EXPECT(!class_d.IsNull());
+
+  CHA cha(Thread::Current());
+
+  // The only concrete subtype of the abstract class B is C.
+  intptr_t lower_limit = kIllegalCid;
+  intptr_t upper_limit = kIllegalCid;
+  EXPECT(cha.ConcreteSubclassRange(class_b, &lower_limit, &upper_limit));
+  EXPECT_EQ(class_c.id(), lower_limit);
+  EXPECT_EQ(class_c.id(), upper_limit);
+  EXPECT(cha.IsGuardedClass(class_b.id()));
+  EXPECT(cha.IsGuardedClass(class_c.id()));
+
+  // D is implemented by E, so its subtypes are not only its subclasses.
+  EXPECT(!cha.ConcreteSubclassRange(class_d, &lower_limit, &upper_limit));
+  EXPECT(!cha.IsGuardedClass(class_d.id()));
+}
+
 }  // namespace dart
@@ -3770,6 +3770,10 @@ FlowGraph* StreamingFlowGraphBuilder::BuildGraphOfStaticFieldInitializer() {
 
 FlowGraph* StreamingFlowGraphBuilder::BuildGraphOfFieldAccessor(
     LocalVariable* setter_value) {
+  // Type flow analysis annotates the field with the types stored into it.
+  const InferredTypeMetadata field_type =
+      inferred_type_metadata_helper_.GetInferredType(ReaderOffset());
+
   FieldHelper field_helper(this);
   field_helper.ReadUntilIncluding(FieldHelper::kCanonicalName);
 
@@ -3801,7 +3805,7 @@ FlowGraph* StreamingFlowGraphBuilder::BuildGraphOfFieldAccessor(
     body += NullConstant();
   } else if (is_method) {
     body += LoadLocal(scopes()->this_variable);
-    body += flow_graph_builder_->LoadField(field);
+    body += flow_graph_builder_->LoadField(field, &field_type);
   } else if (field.is_const()) {
     field_helper.ReadUntilExcluding(FieldHelper::kInitializer);
     Tag initializer_tag = ReadTag();  // read first part of initializer.
@@ -3821,7 +3825,7 @@ FlowGraph* StreamingFlowGraphBuilder::BuildGraphOfFieldAccessor(
     body += Constant(field);
     body += flow_graph_builder_->InitStaticField(field);
     body += Constant(field);
-    body += LoadStaticField();
+    body += LoadStaticField(&field_type);
   }
   body += Return(TokenPosition::kNoSource);
 
@@ -5922,8 +5926,9 @@ Fragment StreamingFlowGraphBuilder::IntConstant(int64_t value) {
   return flow_graph_builder_->IntConstant(value);
 }
 
-Fragment StreamingFlowGraphBuilder::LoadStaticField() {
-  return flow_graph_builder_->LoadStaticField();
+Fragment StreamingFlowGraphBuilder::LoadStaticField(
+    const InferredTypeMetadata* field_type) {
+  return flow_graph_builder_->LoadStaticField(field_type);
 }
 
 Fragment StreamingFlowGraphBuilder::CheckNull(TokenPosition position,
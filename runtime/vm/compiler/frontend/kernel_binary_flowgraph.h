@@ -1149,7 +1149,7 @@ class StreamingFlowGraphBuilder {
   Fragment ThrowNoSuchMethodError();
   Fragment Constant(const Object& value);
   Fragment IntConstant(int64_t value);
-  Fragment LoadStaticField();
+  Fragment LoadStaticField(const InferredTypeMetadata* field_type = NULL);
   Fragment CheckNull(TokenPosition position, LocalVariable* receiver);
   Fragment StaticCall(TokenPosition position,
                       const Function& target,
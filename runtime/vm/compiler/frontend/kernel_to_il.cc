@@ -156,7 +156,8 @@ TranslationHelper::TranslationHelper(Thread* thread)
       canonical_names_(TypedData::Handle(Z)),
       metadata_payloads_(TypedData::Handle(Z)),
       metadata_mappings_(TypedData::Handle(Z)),
-      constants_(Array::Handle(Z)) {}
+      constants_(Array::Handle(Z)),
+      name_lookup_cache_(Array::Handle(Z)) {}
 
 void TranslationHelper::Reset() {
   string_offsets_ = TypedData::null();
@@ -165,6 +166,7 @@ void TranslationHelper::Reset() {
   metadata_payloads_ = TypedData::null();
   metadata_mappings_ = TypedData::null();
   constants_ = Array::null();
+  name_lookup_cache_ = Array::null();
 }
 
 void TranslationHelper::InitFromScript(const Script& script) {
@@ -188,6 +190,7 @@ void TranslationHelper::InitFromKernelProgramInfo(
   SetMetadataPayloads(TypedData::Handle(Z, info.metadata_payloads()));
   SetMetadataMappings(TypedData::Handle(Z, info.metadata_mappings()));
   SetConstants(Array::Handle(Z, info.constants()));
+  SetNameLookupCache(Array::Handle(Z, info.name_lookup_cache()));
 }
 
 void TranslationHelper::SetStringOffsets(const TypedData& string_offsets) {
@@ -222,6 +225,11 @@ void TranslationHelper::SetConstants(const Array& constants) {
   constants_ = constants.raw();
 }
 
+void TranslationHelper::SetNameLookupCache(const Array& name_lookup_cache) {
+  ASSERT(name_lookup_cache_.IsNull());
+  name_lookup_cache_ = name_lookup_cache.raw();
+}
+
 intptr_t TranslationHelper::StringOffset(StringIndex index) const {
   return string_offsets_.GetUint32(index << 2);
 }
@@ -556,15 +564,24 @@ RawLibrary* TranslationHelper::LookupLibraryByKernelLibrary(
   // This ASSERT is just a sanity check.
   ASSERT(IsLibrary(kernel_library) ||
          IsAdministrative(CanonicalNameParent(kernel_library)));
+  RawObject* cached = LookupCachedName(kernel_library);
+  if (cached != Object::null()) {
+    return Library::RawCast(cached);
+  }
   const String& library_name = DartSymbol(CanonicalNameString(kernel_library));
   ASSERT(!library_name.IsNull());
   RawLibrary* library = Library::LookupLibrary(thread_, library_name);
   ASSERT(library != Object::null());
+  CacheName(kernel_library, Library::Handle(Z, library));
   return library;
 }
 
 RawClass* TranslationHelper::LookupClassByKernelClass(NameIndex kernel_class) {
   ASSERT(IsClass(kernel_class));
+  RawObject* cached = LookupCachedName(kernel_class);
+  if (cached != Object::null()) {
+    return Class::RawCast(cached);
+  }
   const String& class_name = DartClassName(kernel_class);
   NameIndex kernel_library = CanonicalNameParent(kernel_class);
   Library& library =
@@ -572,9 +589,35 @@ RawClass* TranslationHelper::LookupClassByKernelClass(NameIndex kernel_class) {
   RawClass* klass = library.LookupClassAllowPrivate(class_name);
 
   ASSERT(klass != Object::null());
+  CacheName(kernel_class, Class::Handle(Z, klass));
   return klass;
 }
 
+bool TranslationHelper::CanCacheNames() const {
+#if defined(PRODUCT)
+  return !name_lookup_cache_.IsNull();
+#else
+  // Hot reload can replace the library or class a canonical name resolves
+  // to.
+  return !name_lookup_cache_.IsNull() && !isolate_->HasAttemptedReload();
+#endif  // !defined(PRODUCT)
+}
+
+RawObject* TranslationHelper::LookupCachedName(NameIndex name) const {
+  if (!CanCacheNames() || (name >= name_lookup_cache_.Length())) {
+    return Object::null();
+  }
+  return name_lookup_cache_.At(name);
+}
+
+void TranslationHelper::CacheName(NameIndex name, const Object& value) const {
+  if (CanCacheNames() && (name < name_lookup_cache_.Length())) {
+    // Races between the mutator and background compilers only store the
+    // same object.
+    name_lookup_cache_.SetAt(name, value);
+  }
+}
+
 RawField* TranslationHelper::LookupFieldByKernelField(NameIndex kernel_field) {
   ASSERT(IsField(kernel_field));
   NameIndex enclosing = EnclosingName(kernel_field);
@@ -1318,11 +1361,16 @@ const Field& MayCloneField(Zone* zone, const Field& field) {
   }
 }
 
-Fragment FlowGraphBuilder::LoadField(const Field& field) {
+Fragment FlowGraphBuilder::LoadField(const Field& field,
+                                     const InferredTypeMetadata* field_type) {
   LoadFieldInstr* load =
       new (Z) LoadFieldInstr(Pop(), &MayCloneField(Z, field),
                              AbstractType::ZoneHandle(Z, field.type()),
                              TokenPosition::kNoSource, parsed_function_);
+  if ((field_type != NULL) && !field_type->IsTrivial()) {
+    load->SetInferredType(Z, CompileType::CreateNullable(field_type->nullable,
+                                                         field_type->cid));
+  }
   Push(load);
   return Fragment(load);
 }
@@ -1387,9 +1435,14 @@ Fragment FlowGraphBuilder::InitStaticField(const Field& field) {
   return Fragment(init);
 }
 
-Fragment FlowGraphBuilder::LoadStaticField() {
+Fragment FlowGraphBuilder::LoadStaticField(
+    const InferredTypeMetadata* field_type) {
   LoadStaticFieldInstr* load =
       new (Z) LoadStaticFieldInstr(Pop(), TokenPosition::kNoSource);
+  if ((field_type != NULL) && !field_type->IsTrivial()) {
+    load->SetInferredType(Z, CompileType::CreateNullable(field_type->nullable,
+                                                         field_type->cid));
+  }
   Push(load);
   return Fragment(load);
 }
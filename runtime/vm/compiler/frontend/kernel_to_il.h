@@ -331,6 +331,8 @@ class TranslationHelper {
   const Array& constants() { return constants_; }
   void SetConstants(const Array& constants);
 
+  void SetNameLookupCache(const Array& name_lookup_cache);
+
   intptr_t StringOffset(StringIndex index) const;
   intptr_t StringSize(StringIndex index) const;
 
@@ -443,6 +445,10 @@ class TranslationHelper {
                             String* name_to_modify,
                             bool symbolize = true);
 
+  bool CanCacheNames() const;
+  RawObject* LookupCachedName(NameIndex name) const;
+  void CacheName(NameIndex name, const Object& value) const;
+
   Thread* thread_;
   Zone* zone_;
   Isolate* isolate_;
@@ -454,6 +460,7 @@ class TranslationHelper {
   TypedData& metadata_payloads_;
   TypedData& metadata_mappings_;
   Array& constants_;
+  Array& name_lookup_cache_;
 };
 
 struct FunctionScope {
@@ -711,7 +718,8 @@ class FlowGraphBuilder : public BaseFlowGraphBuilder {
   Fragment RethrowException(TokenPosition position, int catch_try_index);
   Fragment LoadClassId();
   Fragment LoadField(intptr_t offset, intptr_t class_id = kDynamicCid);
-  Fragment LoadField(const Field& field);
+  Fragment LoadField(const Field& field,
+                     const InferredTypeMetadata* field_type = NULL);
   Fragment LoadNativeField(MethodRecognizer::Kind kind,
                            intptr_t offset,
                            const Type& type,
@@ -719,7 +727,7 @@ class FlowGraphBuilder : public BaseFlowGraphBuilder {
                            bool is_immutable = false);
   Fragment LoadLocal(LocalVariable* variable);
   Fragment InitStaticField(const Field& field);
-  Fragment LoadStaticField();
+  Fragment LoadStaticField(const InferredTypeMetadata* field_type = NULL);
   Fragment NativeCall(const String* name, const Function* function);
   Fragment Return(TokenPosition position);
   Fragment CheckNull(TokenPosition position, LocalVariable* receiver);
@@ -66,8 +66,8 @@ void Intrinsifier::ObjectArraySetIndexedUnchecked(Assembler* assembler) {
   // Note that RBX is Smi, i.e, times 2.
   ASSERT(kSmiTagShift == 1);
   // Destroy RCX (ic data) as we will not continue in the function.
-  __ StoreIntoObject(RAX, FieldAddress(RAX, RCX, TIMES_4, Array::data_offset()),
-                     RDX);
+  __ StoreIntoArray(RAX, FieldAddress(RAX, RCX, TIMES_4, Array::data_offset()),
+                    RDX);
   // Caller is responsible of preserving the value if necessary.
   __ ret();
   __ Bind(&fall_through);
@@ -128,8 +128,8 @@ void Intrinsifier::GrowableArray_add(Assembler* assembler) {
                        1);
   __ movq(RAX, Address(RSP, +1 * kWordSize));  // Value
   ASSERT(kSmiTagShift == 1);
-  __ StoreIntoObject(RDX, FieldAddress(RDX, RCX, TIMES_4, Array::data_offset()),
-                     RAX);
+  __ StoreIntoArray(RDX, FieldAddress(RDX, RCX, TIMES_4, Array::data_offset()),
+                    RAX);
   __ LoadObject(RAX, Object::null_object());
   __ ret();
   __ Bind(&fall_through);
@@ -51,6 +51,10 @@ DEFINE_FLAG(bool,
             allocation_sinking,
             true,
             "Attempt to sink temporary allocations to side exits");
+DEFINE_FLAG(int,
+            background_compiler_threads,
+            1,
+            "Number of background optimizing compiler threads per isolate.");
 DEFINE_FLAG(bool,
             common_subexpression_elimination,
             true,
@@ -347,7 +351,7 @@ RawError* Compiler::Compile(const Library& library, const Script& script) {
   LongJumpScope jump;
   if (setjmp(*jump.Set()) == 0) {
     Thread* const thread = Thread::Current();
-    StackZone zone(thread);
+    StackZone zone(thread, Zone::kCompilerOwner);
     if (FLAG_trace_compiler) {
       const String& script_url = String::Handle(script.url());
       // TODO(iposva): Extract script kind.
@@ -543,6 +547,21 @@ RawError* Compiler::CompileClass(const Class& cls) {
   return Error::null();
 }
 
+// Whether an optimizing compilation of 'function' should use the baseline
+// tier, which runs only the cheap optimization passes. Only the first
+// optimization of a function that has never deoptimized is baseline; once
+// baseline code gets hot or deoptimizes the function is fully optimized.
+static bool UseBaselineTier(const Function& function,
+                            bool optimized,
+                            intptr_t osr_id) {
+  return optimized && (osr_id == Compiler::kNoOSRDeoptId) &&
+         (FLAG_baseline_optimization_counter_threshold >= 0) &&
+         (FLAG_baseline_optimization_counter_threshold <
+          FLAG_optimization_counter_threshold) &&
+         !function.IsIrregexpFunction() && !function.HasOptimizedCode() &&
+         (function.deoptimization_counter() == 0);
+}
+
 class CompileParsedFunctionHelper : public ValueObject {
  public:
   CompileParsedFunctionHelper(ParsedFunction* parsed_function,
@@ -550,6 +569,8 @@ class CompileParsedFunctionHelper : public ValueObject {
                               intptr_t osr_id)
       : parsed_function_(parsed_function),
         optimized_(optimized),
+        baseline_(
+            UseBaselineTier(parsed_function->function(), optimized, osr_id)),
         osr_id_(osr_id),
         thread_(Thread::Current()),
         loading_invalidation_gen_at_start_(
@@ -560,6 +581,7 @@ class CompileParsedFunctionHelper : public ValueObject {
  private:
   ParsedFunction* parsed_function() const { return parsed_function_; }
   bool optimized() const { return optimized_; }
+  bool baseline() const { return baseline_; }
   intptr_t osr_id() const { return osr_id_; }
   Thread* thread() const { return thread_; }
   Isolate* isolate() const { return thread_->isolate(); }
@@ -573,6 +595,7 @@ class CompileParsedFunctionHelper : public ValueObject {
 
   ParsedFunction* parsed_function_;
   const bool optimized_;
+  const bool baseline_;
   const intptr_t osr_id_;
   Thread* const thread_;
   const intptr_t loading_invalidation_gen_at_start_;
@@ -910,8 +933,16 @@ RawCode* CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
 
         int inlining_depth = 0;
 
+        // Baseline code skips inlining, loop optimizations, redundancy
+        // elimination, range analysis and allocation sinking.
+        if (baseline() && (FLAG_trace_compiler ||
+                           FLAG_trace_optimizing_compiler)) {
+          THR_Print("Baseline tier for '%s'\n",
+                    function.ToFullyQualifiedCString());
+        }
+
         // Inlining (mutates the flow graph)
-        if (FLAG_use_inlining) {
+        if (FLAG_use_inlining && !baseline()) {
           NOT_IN_PRODUCT(TimelineDurationScope tds2(thread(), compiler_timeline,
                                                     "Inlining"));
           CSTAT_TIMER_SCOPE(thread(), graphinliner_timer);
@@ -978,14 +1009,16 @@ RawCode* CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
           DEBUG_ASSERT(flow_graph->VerifyUseLists());
           // Canonicalization introduced more opportunities for constant
           // propagation.
-          ConstantPropagator::Optimize(flow_graph);
-          DEBUG_ASSERT(flow_graph->VerifyUseLists());
+          if (!baseline()) {
+            ConstantPropagator::Optimize(flow_graph);
+            DEBUG_ASSERT(flow_graph->VerifyUseLists());
+          }
           thread()->CheckForSafepoint();
         }
 
         // Optimistically convert loop phis that have a single non-smi input
         // coming from the loop pre-header into smi-phis.
-        if (FLAG_loop_invariant_code_motion) {
+        if (FLAG_loop_invariant_code_motion && !baseline()) {
           LICM licm(flow_graph);
           licm.OptimisticallySpecializeSmiPhis();
           DEBUG_ASSERT(flow_graph->VerifyUseLists());
@@ -1013,9 +1046,9 @@ RawCode* CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
 
         {
           NOT_IN_PRODUCT(TimelineDurationScope tds2(
-              thread(), compiler_timeline, "CommonSubexpressionElinination"));
+              thread(), compiler_timeline, "CommonSubexpressionElimination"));
 
-          if (FLAG_common_subexpression_elimination) {
+          if (FLAG_common_subexpression_elimination && !baseline()) {
             if (DominatorBasedCSE::Optimize(flow_graph)) {
               DEBUG_ASSERT(flow_graph->VerifyUseLists());
               flow_graph->Canonicalize();
@@ -1032,7 +1065,7 @@ RawCode* CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
           // Run loop-invariant code motion right after load elimination since
           // it depends on the numbering of loads from the previous
           // load-elimination.
-          if (FLAG_loop_invariant_code_motion) {
+          if (FLAG_loop_invariant_code_motion && !baseline()) {
             flow_graph->RenameUsesDominatedByRedefinitions();
             DEBUG_ASSERT(flow_graph->VerifyRedefinitions());
             LICM licm(flow_graph);
@@ -1049,13 +1082,13 @@ RawCode* CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
         flow_graph->TryOptimizePatterns();
         DEBUG_ASSERT(flow_graph->VerifyUseLists());
 
-        {
+        if (!baseline()) {
           NOT_IN_PRODUCT(TimelineDurationScope tds2(thread(), compiler_timeline,
                                                     "DeadStoreElimination"));
           DeadStoreElimination::Optimize(flow_graph);
         }
 
-        if (FLAG_range_analysis) {
+        if (FLAG_range_analysis && !baseline()) {
           NOT_IN_PRODUCT(TimelineDurationScope tds2(thread(), compiler_timeline,
                                                     "RangeAnalysis"));
           // Propagate types after store-load-forwarding. Some phis may have
@@ -1071,7 +1104,7 @@ RawCode* CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
           DEBUG_ASSERT(flow_graph->VerifyUseLists());
         }
 
-        if (FLAG_constant_propagation) {
+        if (FLAG_constant_propagation && !baseline()) {
           NOT_IN_PRODUCT(TimelineDurationScope tds2(
               thread(), compiler_timeline,
               "ConstantPropagator::OptimizeBranches"));
@@ -1113,7 +1146,7 @@ RawCode* CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
         // Attempt to sink allocations of temporary non-escaping objects to
         // the deoptimization path.
         AllocationSinking* sinking = NULL;
-        if (FLAG_allocation_sinking &&
+        if (FLAG_allocation_sinking && !baseline() &&
             (flow_graph->graph_entry()->SuccessorCount() == 1)) {
           NOT_IN_PRODUCT(TimelineDurationScope tds2(
               thread(), compiler_timeline, "AllocationSinking::Optimize"));
@@ -1205,12 +1238,19 @@ RawCode* CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
           &assembler, flow_graph, *parsed_function(), optimized(),
           &speculative_policy, inline_id_to_function, inline_id_to_token_pos,
           caller_inline_id);
+      graph_compiler.set_is_baseline(baseline());
       {
         CSTAT_TIMER_SCOPE(thread(), graphcompiler_timer);
         NOT_IN_PRODUCT(TimelineDurationScope tds(thread(), compiler_timeline,
                                                  "CompileGraph"));
         graph_compiler.CompileGraph();
         pipeline->FinalizeCompilation(flow_graph);
+#if !defined(PRODUCT)
+        if (tds.enabled()) {
+          tds.SetNumArguments(1);
+          tds.FormatArgument(0, "codeSize", "%" Pd, assembler.CodeSize());
+        }
+#endif  // !defined(PRODUCT)
       }
       {
         NOT_IN_PRODUCT(TimelineDurationScope tds(thread(), compiler_timeline,
@@ -1292,7 +1332,7 @@ static RawObject* CompileFunctionHelper(CompilationPipeline* pipeline,
   if (setjmp(*jump.Set()) == 0) {
     Thread* const thread = Thread::Current();
     Isolate* const isolate = thread->isolate();
-    StackZone stack_zone(thread);
+    StackZone stack_zone(thread, Zone::kCompilerOwner);
     Zone* const zone = stack_zone.GetZone();
     const bool trace_compiler =
         FLAG_trace_compiler || (FLAG_trace_optimizing_compiler && optimized);
@@ -1779,7 +1819,7 @@ RawObject* Compiler::EvaluateStaticInitializer(const Field& field) {
       }
 #endif  // !defined(PRODUCT)
 
-      StackZone stack_zone(thread);
+      StackZone stack_zone(thread, Zone::kCompilerOwner);
       Zone* zone = stack_zone.GetZone();
       ParsedFunction* parsed_function;
 
@@ -1906,112 +1946,124 @@ void Compiler::AbortBackgroundCompilation(intptr_t deopt_id, const char* msg) {
       deopt_id, Object::background_compilation_error());
 }
 
-// C-heap allocated background compilation queue element.
-class QueueElement {
- public:
-  explicit QueueElement(const Function& function)
-      : next_(NULL), function_(function.raw()) {}
-
-  virtual ~QueueElement() {
-    next_ = NULL;
-    function_ = Function::null();
-  }
+QueueElement::QueueElement(const dart::Function& function)
+    : next_(NULL),
+      function_(function.raw()),
+      priority_(function.usage_counter()),
+      enqueue_micros_(OS::GetCurrentMonotonicMicros()),
+      in_progress_(false) {}
 
-  RawFunction* Function() const { return function_; }
+QueueElement::~QueueElement() {
+  next_ = NULL;
+  function_ = dart::Function::null();
+}
 
-  void set_next(QueueElement* elem) { next_ = elem; }
-  QueueElement* next() const { return next_; }
+BackgroundCompilationQueue::~BackgroundCompilationQueue() {
+  Clear();
+  ASSERT(first_ == NULL);
+}
 
-  RawObject* function() const { return function_; }
-  RawObject** function_ptr() {
-    return reinterpret_cast<RawObject**>(&function_);
+void BackgroundCompilationQueue::VisitObjectPointers(
+    ObjectPointerVisitor* visitor) {
+  ASSERT(visitor != NULL);
+  QueueElement* p = first_;
+  while (p != NULL) {
+    visitor->VisitPointer(p->function_ptr());
+    p = p->next();
   }
+}
 
- private:
-  QueueElement* next_;
-  RawFunction* function_;
-
-  DISALLOW_COPY_AND_ASSIGN(QueueElement);
-};
-
-// Allocated in C-heap. Handles both input and output of background compilation.
-// It implements a FIFO queue, using Peek, Add, Remove operations.
-class BackgroundCompilationQueue {
- public:
-  BackgroundCompilationQueue() : first_(NULL), last_(NULL) {}
-  virtual ~BackgroundCompilationQueue() { Clear(); }
-
-  void VisitObjectPointers(ObjectPointerVisitor* visitor) {
-    ASSERT(visitor != NULL);
-    QueueElement* p = first_;
-    while (p != NULL) {
-      visitor->VisitPointer(p->function_ptr());
-      p = p->next();
+bool BackgroundCompilationQueue::HasPending() const {
+  QueueElement* p = first_;
+  while (p != NULL) {
+    if (!p->in_progress()) {
+      return true;
     }
+    p = p->next();
   }
+  return false;
+}
 
-  bool IsEmpty() const { return first_ == NULL; }
+void BackgroundCompilationQueue::Add(QueueElement* value) {
+  ASSERT(value != NULL);
+  ASSERT(value->next() == NULL);
+  QueueElement* previous = NULL;
+  QueueElement* p = first_;
+  while ((p != NULL) && (p->priority() >= value->priority())) {
+    previous = p;
+    p = p->next();
+  }
+  value->set_next(p);
+  if (previous == NULL) {
+    first_ = value;
+  } else {
+    previous->set_next(value);
+  }
+}
 
-  void Add(QueueElement* value) {
-    ASSERT(value != NULL);
-    ASSERT(value->next() == NULL);
-    if (first_ == NULL) {
-      first_ = value;
-      ASSERT(last_ == NULL);
-    } else {
-      ASSERT(last_ != NULL);
-      last_->set_next(value);
+QueueElement* BackgroundCompilationQueue::TakeNext() {
+  QueueElement* p = first_;
+  while (p != NULL) {
+    if (!p->in_progress()) {
+      p->set_in_progress(true);
+      return p;
     }
-    last_ = value;
-    ASSERT(first_ != NULL && last_ != NULL);
+    p = p->next();
   }
+  return NULL;
+}
 
-  QueueElement* Peek() const { return first_; }
+void BackgroundCompilationQueue::Release(QueueElement* value) {
+  ASSERT(value->in_progress());
+  value->set_in_progress(false);
+}
 
-  RawFunction* PeekFunction() const {
-    QueueElement* e = Peek();
-    if (e == NULL) {
-      return Function::null();
-    } else {
-      return e->Function();
-    }
+void BackgroundCompilationQueue::Remove(QueueElement* value) {
+  ASSERT(value != NULL);
+  QueueElement* previous = NULL;
+  QueueElement* p = first_;
+  while (p != value) {
+    ASSERT(p != NULL);
+    previous = p;
+    p = p->next();
   }
-
-  QueueElement* Remove() {
-    ASSERT(first_ != NULL);
-    QueueElement* result = first_;
-    first_ = first_->next();
-    if (first_ == NULL) {
-      last_ = NULL;
-    }
-    return result;
+  if (previous == NULL) {
+    first_ = value->next();
+  } else {
+    previous->set_next(value->next());
   }
+  value->set_next(NULL);
+}
 
-  bool ContainsObj(const Object& obj) const {
-    QueueElement* p = first_;
-    while (p != NULL) {
-      if (p->function() == obj.raw()) {
-        return true;
-      }
-      p = p->next();
+bool BackgroundCompilationQueue::ContainsObj(const Object& obj) const {
+  QueueElement* p = first_;
+  while (p != NULL) {
+    if (p->function() == obj.raw()) {
+      return true;
     }
-    return false;
+    p = p->next();
   }
+  return false;
+}
 
-  void Clear() {
-    while (!IsEmpty()) {
-      QueueElement* e = Remove();
-      delete e;
+void BackgroundCompilationQueue::Clear() {
+  QueueElement* previous = NULL;
+  QueueElement* p = first_;
+  while (p != NULL) {
+    QueueElement* next = p->next();
+    if (p->in_progress()) {
+      previous = p;
+    } else {
+      if (previous == NULL) {
+        first_ = next;
+      } else {
+        previous->set_next(next);
+      }
+      delete p;
     }
-    ASSERT((first_ == NULL) && (last_ == NULL));
+    p = next;
   }
-
- private:
-  QueueElement* first_;
-  QueueElement* last_;
-
-  DISALLOW_COPY_AND_ASSIGN(BackgroundCompilationQueue);
-};
+}
 
 BackgroundCompiler::BackgroundCompiler(Isolate* isolate)
     : isolate_(isolate),
@@ -2019,7 +2071,7 @@ BackgroundCompiler::BackgroundCompiler(Isolate* isolate)
       function_queue_(new BackgroundCompilationQueue()),
       done_monitor_(new Monitor()),
       running_(false),
-      done_(true),
+      running_threads_(0),
       disabled_depth_(0) {}
 
 // Fields all deleted in ::Stop; here clear them.
@@ -2029,6 +2081,25 @@ BackgroundCompiler::~BackgroundCompiler() {
   delete done_monitor_;
 }
 
+#if !defined(PRODUCT)
+// Reports how long the function of 'qelem' waited in the queue.
+static void ReportQueueWait(Thread* thread,
+                            const Function& function,
+                            QueueElement* qelem) {
+  TimelineStream* stream = Timeline::GetCompilerStream();
+  ASSERT(stream != NULL);
+  TimelineEvent* event = stream->StartEvent();
+  if (event != NULL) {
+    event->Duration("BackgroundCompilationQueueWait", qelem->enqueue_micros(),
+                    OS::GetCurrentMonotonicMicros());
+    event->SetNumArguments(2);
+    event->CopyArgument(0, "function", function.ToQualifiedCString());
+    event->FormatArgument(1, "priority", "%" Pd, qelem->priority());
+    event->Complete();
+  }
+}
+#endif  // !defined(PRODUCT)
+
 void BackgroundCompiler::Run() {
   while (running_) {
     // Maybe something is already in the queue, check first before waiting
@@ -2037,46 +2108,52 @@ void BackgroundCompiler::Run() {
     ASSERT(result);
     {
       Thread* thread = Thread::Current();
-      StackZone stack_zone(thread);
+      StackZone stack_zone(thread, Zone::kCompilerOwner);
       Zone* zone = stack_zone.GetZone();
       HANDLESCOPE(thread);
       Function& function = Function::Handle(zone);
+      QueueElement* qelem = NULL;
       {
         MonitorLocker ml(queue_monitor_);
-        function = function_queue()->PeekFunction();
+        qelem = function_queue()->TakeNext();
+        if (qelem != NULL) {
+          function = qelem->Function();
+        }
       }
-      while (running_ && !function.IsNull() && !isolate_->IsTopLevelParsing()) {
+      while (running_ && (qelem != NULL) && !isolate_->IsTopLevelParsing()) {
+        NOT_IN_PRODUCT(ReportQueueWait(thread, function, qelem));
         // Check that we have aggregated and cleared the stats.
         ASSERT(thread->compiler_stats()->IsCleared());
         Compiler::CompileOptimizedFunction(thread, function,
                                            Compiler::kNoOSRDeoptId);
+
+        MonitorLocker ml(queue_monitor_);
 #ifndef PRODUCT
         Isolate* isolate = thread->isolate();
         isolate->aggregate_compiler_stats()->Add(*thread->compiler_stats());
         thread->compiler_stats()->Clear();
 #endif  // PRODUCT
-
-        QueueElement* qelem = NULL;
-        {
-          MonitorLocker ml(queue_monitor_);
-          if (function_queue()->IsEmpty()) {
-            // We are shutting down, queue was cleared.
-            function = Function::null();
-          } else {
-            qelem = function_queue()->Remove();
-            const Function& old = Function::Handle(qelem->Function());
-            if ((!old.HasOptimizedCode() && old.IsOptimizable()) ||
-                FLAG_stress_test_background_compilation) {
-              if (Compiler::CanOptimizeFunction(thread, old)) {
-                QueueElement* repeat_qelem = new QueueElement(old);
-                function_queue()->Add(repeat_qelem);
-              }
+        function_queue()->Remove(qelem);
+        delete qelem;
+        if (running_) {
+          if ((!function.HasOptimizedCode() && function.IsOptimizable()) ||
+              FLAG_stress_test_background_compilation) {
+            if (Compiler::CanOptimizeFunction(thread, function)) {
+              QueueElement* repeat_qelem = new QueueElement(function);
+              function_queue()->Add(repeat_qelem);
             }
-            function = function_queue()->PeekFunction();
           }
         }
-        if (qelem != NULL) {
-          delete qelem;
+        // The queue was cleared if we are shutting down.
+        qelem = function_queue()->TakeNext();
+        function = (qelem != NULL) ? qelem->Function() : Function::null();
+      }
+      if (qelem != NULL) {
+        // Stopped or top level parsing started before compiling it.
+        MonitorLocker ml(queue_monitor_);
+        function_queue()->Release(qelem);
+        if (!running_) {
+          function_queue()->Clear();
         }
       }
     }
@@ -2084,7 +2161,8 @@ void BackgroundCompiler::Run() {
     {
       // Wait to be notified when the work queue is not empty.
       MonitorLocker ml(queue_monitor_);
-      while ((function_queue()->IsEmpty() || isolate_->IsTopLevelParsing()) &&
+      while ((!function_queue()->HasPending() ||
+              isolate_->IsTopLevelParsing()) &&
              running_) {
         ml.Wait();
       }
@@ -2094,8 +2172,11 @@ void BackgroundCompiler::Run() {
   {
     // Notify that the thread is done.
     MonitorLocker ml_done(done_monitor_);
-    done_ = true;
-    ml_done.Notify();
+    running_threads_--;
+    ASSERT(running_threads_ >= 0);
+    if (running_threads_ == 0) {
+      ml_done.Notify();
+    }
   }
 }
 
@@ -2154,14 +2235,21 @@ void BackgroundCompiler::Start() {
   ASSERT(error.IsNull());
 
   MonitorLocker ml(done_monitor_);
-  if (running_ || !done_) return;
+  if (running_ || (running_threads_ > 0)) return;
   running_ = true;
-  done_ = false;
-  bool task_started =
-      Dart::thread_pool()->Run(new BackgroundCompilerTask(this));
-  if (!task_started) {
+  const intptr_t num_threads =
+      Utils::Maximum(FLAG_background_compiler_threads, 1);
+  for (intptr_t i = 0; i < num_threads; i++) {
+    running_threads_++;
+    bool task_started =
+        Dart::thread_pool()->Run(new BackgroundCompilerTask(this));
+    if (!task_started) {
+      running_threads_--;
+      break;
+    }
+  }
+  if (running_threads_ == 0) {
     running_ = false;
-    done_ = true;
   }
 }
 
@@ -2174,12 +2262,12 @@ void BackgroundCompiler::Stop() {
     MonitorLocker ml(queue_monitor_);
     running_ = false;
     function_queue_->Clear();
-    ml.Notify();  // Stop waiting for the queue.
+    ml.NotifyAll();  // Stop waiting for the queue.
   }
 
   {
     MonitorLocker ml_done(done_monitor_);
-    while (!done_) {
+    while (running_threads_ > 0) {
       ml_done.WaitWithSafepointCheck(thread);
     }
   }
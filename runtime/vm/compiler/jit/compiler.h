@@ -13,7 +13,6 @@
 namespace dart {
 
 // Forward declarations.
-class BackgroundCompilationQueue;
 class Class;
 class Code;
 class CompilationWorkQueue;
@@ -21,9 +20,12 @@ class FlowGraph;
 class Function;
 class IndirectGotoInstr;
 class Library;
+class Object;
+class ObjectPointerVisitor;
 class ParsedFunction;
-class QueueElement;
+class RawFunction;
 class RawInstance;
+class RawObject;
 class Script;
 class SequenceNode;
 
@@ -157,9 +159,86 @@ class Compiler : public AllStatic {
   static void AbortBackgroundCompilation(intptr_t deopt_id, const char* msg);
 };
 
-// Class to run optimizing compilation in a background thread.
-// Current implementation: one task per isolate, it dies with the owning
-// isolate.
+// C-heap allocated background compilation queue element.
+class QueueElement {
+ public:
+  explicit QueueElement(const Function& function);
+  virtual ~QueueElement();
+
+  RawFunction* Function() const { return function_; }
+
+  void set_next(QueueElement* elem) { next_ = elem; }
+  QueueElement* next() const { return next_; }
+
+  RawObject* function() const {
+    return reinterpret_cast<RawObject*>(function_);
+  }
+  RawObject** function_ptr() {
+    return reinterpret_cast<RawObject**>(&function_);
+  }
+
+  // Usage counter of the function when it was enqueued.
+  intptr_t priority() const { return priority_; }
+  int64_t enqueue_micros() const { return enqueue_micros_; }
+
+  // True while a background compiler thread is compiling the function.
+  bool in_progress() const { return in_progress_; }
+  void set_in_progress(bool value) { in_progress_ = value; }
+
+ private:
+  QueueElement* next_;
+  RawFunction* function_;
+  intptr_t priority_;
+  int64_t enqueue_micros_;
+  bool in_progress_;
+
+  DISALLOW_COPY_AND_ASSIGN(QueueElement);
+};
+
+// Allocated in C-heap. Handles both input and output of background compilation.
+// It implements a priority queue, using Add, TakeNext, Release and Remove
+// operations. Elements are ordered by decreasing usage counter at the time they
+// were added, elements of equal priority in FIFO order. Elements being
+// compiled stay in the queue, marked in progress, so that a function is never
+// compiled by two threads at once.
+class BackgroundCompilationQueue {
+ public:
+  BackgroundCompilationQueue() : first_(NULL) {}
+  virtual ~BackgroundCompilationQueue();
+
+  void VisitObjectPointers(ObjectPointerVisitor* visitor);
+
+  bool IsEmpty() const { return first_ == NULL; }
+
+  // True if some element is waiting to be compiled.
+  bool HasPending() const;
+
+  void Add(QueueElement* value);
+
+  // Returns the pending element with the highest priority, marked in
+  // progress, or NULL if there is none.
+  QueueElement* TakeNext();
+
+  // Makes an element returned by TakeNext pending again.
+  void Release(QueueElement* value);
+
+  void Remove(QueueElement* value);
+
+  bool ContainsObj(const Object& obj) const;
+
+  // Deletes all pending elements. Elements in progress are removed by the
+  // threads compiling them.
+  void Clear();
+
+ private:
+  QueueElement* first_;
+
+  DISALLOW_COPY_AND_ASSIGN(BackgroundCompilationQueue);
+};
+
+// Class to run optimizing compilation in background threads.
+// Current implementation: FLAG_background_compiler_threads tasks per isolate
+// share one queue ordered by usage counter; they die with the owning isolate.
 // No OSR compilation in the background compiler.
 class BackgroundCompiler {
  public:
@@ -222,16 +301,16 @@ class BackgroundCompiler {
   void Enable();
   void Disable();
   bool IsDisabled();
-  bool IsRunning() { return !done_; }
+  bool IsRunning() { return running_threads_ > 0; }
 
   Isolate* isolate_;
 
   Monitor* queue_monitor_;  // Controls access to the queue.
   BackgroundCompilationQueue* function_queue_;
 
-  Monitor* done_monitor_;   // Notify/wait that the thread is done.
-  bool running_;            // While true, will try to read queue and compile.
-  bool done_;               // True if the thread is done.
+  Monitor* done_monitor_;     // Notify/wait that the threads are done.
+  bool running_;              // While true, will try to read queue and compile.
+  intptr_t running_threads_;  // Number of threads not yet done.
 
   int16_t disabled_depth_;
 
@@ -174,10 +174,16 @@ void JitCallSpecializer::VisitStoreInstanceField(
     StoreInstanceFieldInstr* instr) {
   if (instr->IsUnboxedStore()) {
     // Determine if this field should be unboxed based on the usage of getter
-    // and setter functions: The heuristic requires that the setter has a
+    // and setter functions: The heuristic requires that the stores have a
     // usage count of at least 1/kGetterSetterRatio of the getter usage count.
     // This is to avoid unboxing fields where the setter is never or rarely
     // executed.
+    // Stores from methods of the class, like the ones updating the fields of
+    // vector and matrix types, do not go through the setter. The store being
+    // optimized runs about as often as the function containing it, so that
+    // function's entry count from its edge counters is counted as well. Its
+    // usage counter cannot be used: it is reset or set to INT_MIN while the
+    // function is being optimized.
     const Field& field = instr->field();
     const String& field_name = String::Handle(Z, field.name());
     const Class& owner = Class::Handle(Z, field.Owner());
@@ -187,10 +193,12 @@ void JitCallSpecializer::VisitStoreInstanceField(
         Function::Handle(Z, owner.LookupSetterFunction(field_name));
     bool unboxed_field = false;
     if (!getter.IsNull() && !setter.IsNull()) {
+      const intptr_t store_count =
+          setter.usage_counter() + flow_graph()->graph_entry()->entry_count();
       if (field.is_double_initialized()) {
         unboxed_field = true;
-      } else if ((setter.usage_counter() > 0) &&
-                 ((FLAG_getter_setter_ratio * setter.usage_counter()) >=
+      } else if ((store_count > 0) &&
+                 ((FLAG_getter_setter_ratio * store_count) >=
                   getter.usage_counter())) {
         unboxed_field = true;
       }
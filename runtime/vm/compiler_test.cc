@@ -15,6 +15,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, background_compiler_threads);
+
 ISOLATE_UNIT_TEST_CASE(CompileScript) {
   const char* kScriptChars =
       "class A {\n"
@@ -109,6 +111,218 @@ ISOLATE_UNIT_TEST_CASE(CompileFunctionOnHelperThread) {
   BackgroundCompiler::Stop(isolate);
 }
 
+ISOLATE_UNIT_TEST_CASE(CompileFunctionsOnHelperThreads) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  static foo() { return 42; }\n"
+      "  static bar() { return 87; }\n"
+      "}\n";
+  String& url =
+      String::Handle(String::New("dart-test:CompileFunctionsOnHelperThreads"));
+  String& source = String::Handle(String::New(kScriptChars));
+  Script& script =
+      Script::Handle(Script::New(url, source, RawScript::kScriptTag));
+  Library& lib = Library::Handle(Library::CoreLibrary());
+  EXPECT(CompilerTest::TestCompileScript(lib, script));
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(!cls.IsNull());
+  Function& foo = Function::Handle(
+      cls.LookupStaticFunction(String::Handle(String::New("foo"))));
+  Function& bar = Function::Handle(
+      cls.LookupStaticFunction(String::Handle(String::New("bar"))));
+  CompilerTest::TestCompileFunction(foo);
+  CompilerTest::TestCompileFunction(bar);
+  EXPECT(!foo.HasOptimizedCode());
+  EXPECT(!bar.HasOptimizedCode());
+  // Give bar the higher usage counter so that it is queued ahead of foo.
+  // With two compiler threads the dequeue order is not observable here, so
+  // this only checks that both functions get optimized.
+  foo.set_usage_counter(10);
+  bar.set_usage_counter(20);
+#if !defined(PRODUCT)
+  // Constant in product mode.
+  FLAG_background_compilation = true;
+#endif
+  const intptr_t saved_threads = FLAG_background_compiler_threads;
+  FLAG_background_compiler_threads = 2;
+  Isolate* isolate = thread->isolate();
+  BackgroundCompiler::Start(isolate);
+  isolate->background_compiler()->CompileOptimized(foo);
+  isolate->background_compiler()->CompileOptimized(bar);
+  Monitor* m = new Monitor();
+  {
+    MonitorLocker ml(m);
+    while (!foo.HasOptimizedCode() || !bar.HasOptimizedCode()) {
+      ml.WaitWithSafepointCheck(thread, 1);
+    }
+  }
+  delete m;
+  BackgroundCompiler::Stop(isolate);
+  EXPECT(!BackgroundCompiler::IsRunning(isolate));
+  FLAG_background_compiler_threads = saved_threads;
+}
+
+ISOLATE_UNIT_TEST_CASE(BackgroundCompilationQueueOrder) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  static foo() { return 1; }\n"
+      "  static bar() { return 2; }\n"
+      "  static baz() { return 3; }\n"
+      "  static qux() { return 4; }\n"
+      "}\n";
+  String& url =
+      String::Handle(String::New("dart-test:BackgroundCompilationQueueOrder"));
+  String& source = String::Handle(String::New(kScriptChars));
+  Script& script =
+      Script::Handle(Script::New(url, source, RawScript::kScriptTag));
+  Library& lib = Library::Handle(Library::CoreLibrary());
+  EXPECT(CompilerTest::TestCompileScript(lib, script));
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(!cls.IsNull());
+  Function& foo = Function::Handle(
+      cls.LookupStaticFunction(String::Handle(String::New("foo"))));
+  Function& bar = Function::Handle(
+      cls.LookupStaticFunction(String::Handle(String::New("bar"))));
+  Function& baz = Function::Handle(
+      cls.LookupStaticFunction(String::Handle(String::New("baz"))));
+  Function& qux = Function::Handle(
+      cls.LookupStaticFunction(String::Handle(String::New("qux"))));
+  foo.set_usage_counter(10);
+  bar.set_usage_counter(30);
+  baz.set_usage_counter(20);
+  qux.set_usage_counter(20);
+
+  BackgroundCompilationQueue queue;
+  EXPECT(queue.TakeNext() == NULL);
+  queue.Add(new QueueElement(foo));
+  queue.Add(new QueueElement(baz));
+  queue.Add(new QueueElement(bar));
+  queue.Add(new QueueElement(qux));
+  EXPECT(queue.ContainsObj(baz));
+
+  // Decreasing usage counter; baz and qux were added in that order.
+  QueueElement* first = queue.TakeNext();
+  EXPECT(first->Function() == bar.raw());
+  QueueElement* second = queue.TakeNext();
+  EXPECT(second->Function() == baz.raw());
+
+  // A released element is handed out again ahead of lower priorities.
+  queue.Release(second);
+  EXPECT(queue.TakeNext() == second);
+  QueueElement* third = queue.TakeNext();
+  EXPECT(third->Function() == qux.raw());
+  QueueElement* fourth = queue.TakeNext();
+  EXPECT(fourth->Function() == foo.raw());
+
+  // Elements in progress are not handed out twice.
+  EXPECT(queue.TakeNext() == NULL);
+  EXPECT(!queue.HasPending());
+  EXPECT(!queue.IsEmpty());
+
+  queue.Remove(first);
+  delete first;
+  queue.Remove(second);
+  delete second;
+  queue.Remove(third);
+  delete third;
+  queue.Remove(fourth);
+  delete fourth;
+  EXPECT(queue.IsEmpty());
+}
+
+TEST_CASE(CompileOptimizedFunctionWithTry) {
+  // Blocks inside a try assign every variable, which must not make phi
+  // insertion look at variables past the end of the function's locals.
+  const char* kScriptChars =
+      "int work(List<int> list) {\n"
+      "  int sum = 0;\n"
+      "  for (int i = 0; i < list.length; i++) {\n"
+      "    try {\n"
+      "      sum += list[i] ~/ (i & 3);\n"
+      "    } catch (e) {\n"
+      "      sum -= 1;\n"
+      "    }\n"
+      "  }\n"
+      "  return sum;\n"
+      "}\n"
+      "void warmup() {\n"
+      "  var list = new List<int>.generate(100, (i) => i);\n"
+      "  for (int i = 0; i < 10; i++) work(list);\n"
+      "}\n";
+  Dart_Handle h_lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(h_lib);
+  EXPECT_VALID(Dart_Invoke(h_lib, NewString("warmup"), 0, NULL));
+
+  TransitionNativeToVM transition(thread);
+  Library& lib = Library::Handle();
+  lib ^= Api::UnwrapHandle(h_lib);
+  const Function& function = Function::Handle(
+      lib.LookupLocalFunction(String::Handle(String::New("work"))));
+  EXPECT(!function.IsNull());
+#if !defined(PRODUCT)
+  // Constant in product mode.
+  const bool old_flag = FLAG_background_compilation;
+  FLAG_background_compilation = false;
+#endif
+  const Object& result =
+      Object::Handle(Compiler::CompileOptimizedFunction(thread, function));
+#if !defined(PRODUCT)
+  FLAG_background_compilation = old_flag;
+#endif
+  EXPECT(result.IsCode());
+}
+
+TEST_CASE(CompileOptimizedKeepsHotSetterFieldUnboxed) {
+  const char* kScriptChars =
+      "class V {\n"
+      "  var x;\n"
+      "  V(this.x);\n"
+      "}\n"
+      "void bump(V v) {\n"
+      "  v.x = v.x + 1.0;\n"
+      "}\n"
+      "void warmup() {\n"
+      "  var v = new V(0.0);\n"
+      "  for (int i = 0; i < 100; i++) bump(v);\n"
+      "}\n";
+  Dart_Handle h_lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(h_lib);
+  EXPECT_VALID(Dart_Invoke(h_lib, NewString("warmup"), 0, NULL));
+
+  TransitionNativeToVM transition(thread);
+  Library& lib = Library::Handle();
+  lib ^= Api::UnwrapHandle(h_lib);
+  const Class& cls =
+      Class::Handle(lib.LookupLocalClass(String::Handle(String::New("V"))));
+  EXPECT(!cls.IsNull());
+  const Field& field = Field::Handle(
+      cls.LookupInstanceField(String::Handle(String::New("x"))));
+  EXPECT(!field.IsNull());
+  EXPECT(field.is_unboxing_candidate());
+  const Function& function = Function::Handle(
+      lib.LookupLocalFunction(String::Handle(String::New("bump"))));
+  EXPECT(!function.IsNull());
+  // A function queued for background optimization has its usage counter set
+  // to INT_MIN, which must not make its stores look cold.
+  function.SetUsageCounter(INT_MIN);
+#if !defined(PRODUCT)
+  // Constant in product mode.
+  const bool old_flag = FLAG_background_compilation;
+  FLAG_background_compilation = false;
+#endif
+  const Object& result =
+      Object::Handle(Compiler::CompileOptimizedFunction(thread, function));
+#if !defined(PRODUCT)
+  FLAG_background_compilation = old_flag;
+#endif
+  EXPECT(result.IsCode());
+  EXPECT(field.is_unboxing_candidate());
+}
+
 TEST_CASE(RegenerateAllocStubs) {
   const char* kScriptChars =
       "class A {\n"
@@ -25,6 +25,7 @@
 #include "vm/object_store.h"
 #include "vm/port.h"
 #include "vm/profiler.h"
+#include "vm/regexp_assembler_bytecode.h"
 #include "vm/service_isolate.h"
 #include "vm/simulator.h"
 #include "vm/snapshot.h"
@@ -148,6 +149,7 @@ char* Dart::InitOnce(const uint8_t* vm_isolate_snapshot,
       TimelineDurationScope tds(Timeline::GetVMStream(), "Dart::InitOnce"));
   Isolate::InitOnce();
   IdleNotifier::InitOnce();
+  RegExpBytecodeCache::InitOnce();
   PortMap::InitOnce();
   FreeListElement::InitOnce();
   ForwardingCorpse::InitOnce();
@@ -449,9 +451,11 @@ const char* Dart::Cleanup() {
   vm_isolate_ = NULL;
   ASSERT(Isolate::IsolateListLength() == 0);
   IdleNotifier::Cleanup();
+  RegExpBytecodeCache::Cleanup();
 
   TargetCPUFeatures::Cleanup();
   StoreBuffer::ShutDown();
+  MarkingStack::ShutDown();
 
   // Delete the current thread's TLS and set it's TLS to null.
   // If it is the last thread then the destructor would call
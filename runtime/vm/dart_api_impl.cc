@@ -724,6 +724,20 @@ void FinalizablePersistentHandle::Finalize(
   state->weak_persistent_handles().FreeHandle(handle);
 }
 
+void FinalizablePersistentHandle::FinalizeInBackground(
+    Isolate* isolate,
+    FinalizablePersistentHandle* handle) {
+  if (!handle->raw()->IsHeapObject()) {
+    return;  // Free handle.
+  }
+  ASSERT(handle->callback() != NULL);
+  isolate->heap()->pending_finalizers()->Add(
+      handle->callback(), handle->apiHandle(), handle->peer());
+  ApiState* state = isolate->api_state();
+  ASSERT(state != NULL);
+  state->weak_persistent_handles().FreeHandle(handle);
+}
+
 // --- Handles ---
 
 DART_EXPORT bool Dart_IsError(Dart_Handle handle) {
@@ -1423,6 +1437,31 @@ DART_EXPORT void Dart_NotifyLowMemory() {
   Isolate::NotifyLowMemory();
 }
 
+DART_EXPORT void Dart_SetGCGoals(int64_t max_pause_micros,
+                                 intptr_t max_gc_time_percent) {
+  Thread* T = Thread::Current();
+  CHECK_ISOLATE(T->isolate());
+  if ((max_pause_micros < 0) || (max_gc_time_percent < 0) ||
+      (max_gc_time_percent > 100)) {
+    FATAL1("%s expects non-negative goals and a percentage of at most 100.",
+           CURRENT_FUNC);
+  }
+  T->isolate()->heap()->SetGCGoals(max_pause_micros, max_gc_time_percent);
+}
+
+DART_EXPORT void Dart_SetHeapCapacity(intptr_t max_new_gen_semi_mb,
+                                      intptr_t max_old_gen_mb) {
+  Thread* T = Thread::Current();
+  CHECK_ISOLATE(T->isolate());
+  if ((max_new_gen_semi_mb <= 0) || (max_old_gen_mb < 0)) {
+    FATAL1("%s expects a positive new generation and a non-negative old "
+           "generation capacity.",
+           CURRENT_FUNC);
+  }
+  T->isolate()->heap()->SetMaxCapacity(max_new_gen_semi_mb * MBInWords,
+                                       max_old_gen_mb * MBInWords);
+}
+
 DART_EXPORT void Dart_ExitIsolate() {
   Thread* T = Thread::Current();
   CHECK_ISOLATE(T->isolate());
@@ -2724,14 +2763,14 @@ DART_EXPORT Dart_Handle Dart_ListGetRange(Dart_Handle list,
       ArgumentsDescriptor args_desc(
           Array::Handle(ArgumentsDescriptor::New(kTypeArgsLen, kNumArgs)));
       const Function& function = Function::Handle(
-          Z, Resolver::ResolveDynamic(instance, Symbols::AssignIndexToken(),
+          Z, Resolver::ResolveDynamic(instance, Symbols::IndexToken(),
                                       args_desc));
       if (!function.IsNull()) {
         const Array& args = Array::Handle(Array::New(kNumArgs));
         args.SetAt(0, instance);
         Instance& index = Instance::Handle(Z);
         for (intptr_t i = 0; i < length; ++i) {
-          index = Integer::New(i);
+          index = Integer::New(i + offset);
           args.SetAt(1, index);
           Dart_Handle value =
               Api::NewHandle(T, DartEntry::InvokeFunction(function, args));
@@ -6425,6 +6464,54 @@ Dart_Handle Dart_LoadCompilationTrace(uint8_t* buffer, intptr_t buffer_length) {
 #endif  // defined(DART_PRECOMPILED_RUNTIME)
 }
 
+DART_EXPORT
+Dart_Handle Dart_SaveTypeFeedback(uint8_t** buffer, intptr_t* buffer_length) {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  return Api::NewError("%s: Cannot compile on an AOT runtime.", CURRENT_FUNC);
+#else
+  Thread* thread = Thread::Current();
+  API_TIMELINE_DURATION(thread);
+  DARTSCOPE(thread);
+  CHECK_NULL(buffer);
+  CHECK_NULL(buffer_length);
+  TypeFeedbackSaver saver(thread->zone());
+  ProgramVisitor::VisitFunctions(&saver);
+  saver.StealBuffer(buffer, buffer_length);
+  return Api::Success();
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+}
+
+DART_EXPORT
+Dart_Handle Dart_LoadTypeFeedback(uint8_t* buffer, intptr_t buffer_length) {
+#if !defined(DART_PRECOMPILER)
+  return Api::NewError(
+      "This VM was built without support for AOT compilation.");
+#else
+  Thread* thread = Thread::Current();
+  API_TIMELINE_DURATION(thread);
+  DARTSCOPE(thread);
+  CHECK_NULL(buffer);
+  if (buffer_length < 0) {
+    return Api::NewError("%s expects argument 'buffer_length' to be >= 0.",
+                         CURRENT_FUNC);
+  }
+  TypeFeedbackReader reader(Z, buffer, buffer_length);
+  while (reader.MoveNext()) {
+  }
+  if (reader.error() != NULL) {
+    return Api::NewError("%s: %s", CURRENT_FUNC, reader.error());
+  }
+  const TypedData& feedback = TypedData::Handle(
+      Z, TypedData::New(kTypedDataUint8ArrayCid, buffer_length, Heap::kOld));
+  {
+    NoSafepointScope no_safepoint;
+    memmove(feedback.DataAddr(0), buffer, buffer_length);
+  }
+  T->isolate()->object_store()->set_type_feedback(feedback);
+  return Api::Success();
+#endif  // !defined(DART_PRECOMPILER)
+}
+
 DART_EXPORT Dart_Handle Dart_SortClasses() {
 #if defined(DART_PRECOMPILED_RUNTIME)
   return Api::NewError("%s: Cannot compile on an AOT runtime.", CURRENT_FUNC);
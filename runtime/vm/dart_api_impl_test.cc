@@ -12,6 +12,7 @@
 #include "platform/text_buffer.h"
 #include "platform/utils.h"
 #include "vm/class_finalizer.h"
+#include "vm/compilation_trace.h"
 #include "vm/compiler/jit/compiler.h"
 #include "vm/dart_api_state.h"
 #include "vm/debugger_api_impl_test.h"
@@ -1501,6 +1502,34 @@ TEST_CASE(DartAPI_ListAccess) {
   EXPECT(Dart_IsUnhandledExceptionError(result));
 }
 
+TEST_CASE(DartAPI_ListGetRangeUserDefinedList) {
+  const char* kScriptChars =
+      "import 'dart:collection';\n"
+      "class MyList extends ListBase<int> {\n"
+      "  int get length => 5;\n"
+      "  set length(int value) => throw new UnsupportedError('');\n"
+      "  int operator [](int index) => index * 10;\n"
+      "  void operator []=(int index, int value) {}\n"
+      "}\n"
+      "testMain() => new MyList();\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  Dart_Handle list = Dart_Invoke(lib, NewString("testMain"), 0, NULL);
+  EXPECT_VALID(list);
+  EXPECT(Dart_IsList(list));
+
+  const int kRangeOffset = 2;
+  const int kRangeLength = 3;
+  Dart_Handle values[kRangeLength];
+  Dart_Handle result =
+      Dart_ListGetRange(list, kRangeOffset, kRangeLength, values);
+  EXPECT_VALID(result);
+  for (intptr_t i = 0; i < kRangeLength; i++) {
+    int64_t value;
+    EXPECT_VALID(Dart_IntegerToInt64(values[i], &value));
+    EXPECT_EQ((i + kRangeOffset) * 10, value);
+  }
+}
+
 TEST_CASE(DartAPI_MapAccess) {
   EXPECT(!Dart_IsMap(Dart_Null()));
   const char* kScriptChars =
@@ -2813,6 +2842,31 @@ TEST_CASE(DartAPI_WeakPersistentHandleCallback) {
   }
 }
 
+TEST_CASE(DartAPI_WeakPersistentHandleBackgroundCallback) {
+  const bool saved_background_finalizers = FLAG_background_finalizers;
+  FLAG_background_finalizers = true;
+  Dart_WeakPersistentHandle weak_ref = NULL;
+  int peer = 0;
+  {
+    Dart_EnterScope();
+    Dart_Handle obj = NewString("new string");
+    EXPECT_VALID(obj);
+    weak_ref = Dart_NewWeakPersistentHandle(obj, &peer, 0,
+                                            WeakPersistentHandlePeerFinalizer);
+    EXPECT_VALID(AsHandle(weak_ref));
+    Dart_ExitScope();
+  }
+  {
+    TransitionNativeToVM transition(thread);
+    Heap* heap = Isolate::Current()->heap();
+    heap->CollectGarbage(Heap::kNew);
+    // The finalizer runs on a helper thread once the scavenge is over.
+    heap->WaitForBackgroundFinalizers();
+    EXPECT(peer == 42);
+  }
+  FLAG_background_finalizers = saved_background_finalizers;
+}
+
 TEST_CASE(DartAPI_WeakPersistentHandleNoCallback) {
   Dart_WeakPersistentHandle weak_ref = NULL;
   int peer = 0;
@@ -8290,6 +8344,118 @@ TEST_CASE(DartAPI_StringFromExternalTypedData) {
   }
 }
 
+TEST_CASE(DartAPI_SaveTypeFeedback) {
+  const char* kScriptChars =
+      "class A { foo() => 1; }\n"
+      "class B extends A { foo() => 2; }\n"
+      "callFoo(a) => a.foo();\n"
+      "main() {\n"
+      "  var a = new A();\n"
+      "  var b = new B();\n"
+      "  for (var i = 0; i < 10; i++) {\n"
+      "    callFoo(b);\n"
+      "  }\n"
+      "  callFoo(a);\n"
+      "}\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  Dart_Handle result = Dart_Invoke(lib, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+
+  uint8_t* buffer = NULL;
+  intptr_t buffer_length = 0;
+  result = Dart_SaveTypeFeedback(&buffer, &buffer_length);
+  EXPECT_VALID(result);
+  EXPECT(buffer_length > 0);
+
+  {
+    TransitionNativeToVM transition(thread);
+    StackZone zone(thread);
+    TypeFeedbackReader reader(zone.GetZone(), buffer, buffer_length);
+    intptr_t num_call_sites = 0;
+    while (reader.MoveNext()) {
+      if ((strcmp(reader.function_name(), "callFoo") != 0) ||
+          (strcmp(reader.selector(), "foo") != 0)) {
+        continue;
+      }
+      num_call_sites++;
+      EXPECT(reader.call_token_pos() >= 0);
+      // Receivers are recorded in decreasing order of count.
+      EXPECT_EQ(2, reader.NumReceivers());
+      EXPECT_STREQ("B", reader.ReceiverClassAt(0));
+      EXPECT_EQ(10, reader.ReceiverCountAt(0));
+      EXPECT_STREQ("A", reader.ReceiverClassAt(1));
+      EXPECT_EQ(1, reader.ReceiverCountAt(1));
+    }
+    EXPECT(reader.error() == NULL);
+    EXPECT_EQ(1, num_call_sites);
+  }
+
+  // The feedback is only consumed by Dart_Precompile.
+  result = Dart_LoadTypeFeedback(buffer, buffer_length);
+#if defined(DART_PRECOMPILER)
+  EXPECT_VALID(result);
+#else
+  EXPECT_ERROR(result, "without support for AOT compilation");
+#endif
+}
+
+TEST_CASE(DartAPI_LoadMalformedTypeFeedback) {
+  const char* kValid = "test-lib,A,callFoo,12,foo,test-lib,B,10\n";
+  const char* kMalformed[] = {
+      // Truncated in the middle of a line.
+      "test-lib,A,callFoo,12,foo,test-lib,B,10",
+      "test-lib,A,callFoo,12,foo,test-lib,B,10\ntest-lib,A,ca",
+      // Missing or incomplete fields.
+      "\n",
+      "test-lib,A,callFoo,12\n",
+      "test-lib,A,callFoo,12,foo,test-lib,B\n",
+      "test-lib,A,callFoo,12,foo,test-lib,,10\n",
+      // Bad numbers.
+      "test-lib,A,callFoo,x,foo,test-lib,B,10\n",
+      "test-lib,A,callFoo,-1,foo,test-lib,B,10\n",
+      "test-lib,A,callFoo,12,foo,test-lib,B,0\n",
+      "test-lib,A,callFoo,12,foo,test-lib,B,10x\n",
+  };
+
+  {
+    TransitionNativeToVM transition(thread);
+    StackZone zone(thread);
+    TypeFeedbackReader valid(zone.GetZone(),
+                             reinterpret_cast<const uint8_t*>(kValid),
+                             strlen(kValid));
+    EXPECT(valid.MoveNext());
+    EXPECT(!valid.MoveNext());
+    EXPECT(valid.error() == NULL);
+
+    for (intptr_t i = 0; i < ARRAY_SIZE(kMalformed); i++) {
+      TypeFeedbackReader reader(zone.GetZone(),
+                                reinterpret_cast<const uint8_t*>(kMalformed[i]),
+                                strlen(kMalformed[i]));
+      while (reader.MoveNext()) {
+      }
+      EXPECT(reader.error() != NULL);
+    }
+
+    // An embedded NUL is not mistaken for the end of the feedback.
+    const uint8_t kEmbeddedNul[] = {'a', ',', 'b', '\0', '\n'};
+    TypeFeedbackReader reader(zone.GetZone(), kEmbeddedNul,
+                              ARRAY_SIZE(kEmbeddedNul));
+    EXPECT(!reader.MoveNext());
+    EXPECT(reader.error() != NULL);
+  }
+
+  for (intptr_t i = 0; i < ARRAY_SIZE(kMalformed); i++) {
+    uint8_t* buffer =
+        reinterpret_cast<uint8_t*>(const_cast<char*>(kMalformed[i]));
+    Dart_Handle result = Dart_LoadTypeFeedback(buffer, strlen(kMalformed[i]));
+#if defined(DART_PRECOMPILER)
+    EXPECT_ERROR(result, "Type feedback line");
+#else
+    EXPECT(Dart_IsError(result));
+#endif
+  }
+}
+
 #ifndef PRODUCT
 
 TEST_CASE(DartAPI_TimelineDuration) {
@@ -12,7 +12,7 @@ namespace dart {
 
 static const int kNumInitialReferences = 4;
 
-ApiMessageReader::ApiMessageReader(Message* msg)
+ApiMessageReader::ApiMessageReader(Message* msg, bool borrow_message_data)
     : BaseReader(msg->IsRaw() ? reinterpret_cast<uint8_t*>(msg->raw_obj())
                               : msg->snapshot(),
                  msg->snapshot_length()),
@@ -20,7 +20,8 @@ ApiMessageReader::ApiMessageReader(Message* msg)
       backward_references_(kNumInitialReferences),
       vm_isolate_references_(kNumInitialReferences),
       vm_symbol_references_(NULL),
-      finalizable_data_(msg->finalizable_data()) {}
+      finalizable_data_(msg->finalizable_data()),
+      borrow_message_data_(borrow_message_data) {}
 
 ApiMessageReader::~ApiMessageReader() {}
 
@@ -256,6 +257,52 @@ ApiMessageReader::BackRefNode* ApiMessageReader::AllocateBackRefNode(
   return value;
 }
 
+Dart_CObject* ApiMessageReader::ReadLatin1String(intptr_t object_id,
+                                                 const uint8_t* latin1,
+                                                 intptr_t len) {
+  intptr_t utf8_len = 0;
+  for (intptr_t i = 0; i < len; i++) {
+    utf8_len += Utf8::Length(latin1[i]);
+  }
+  Dart_CObject* object = AllocateDartCObjectString(utf8_len);
+  AddBackRef(object_id, object, kIsDeserialized);
+  char* p = object->value.as_string;
+  for (intptr_t i = 0; i < len; i++) {
+    p += Utf8::Encode(latin1[i], p);
+  }
+  *p = '\0';
+  ASSERT(p == (object->value.as_string + utf8_len));
+  return object;
+}
+
+Dart_CObject* ApiMessageReader::ReadUTF16String(intptr_t object_id,
+                                                const uint16_t* utf16,
+                                                intptr_t len) {
+  // Calculate the UTF-8 length and check if the string can be
+  // UTF-8 encoded.
+  intptr_t utf8_len = 0;
+  bool valid = true;
+  intptr_t i = 0;
+  while (i < len && valid) {
+    int32_t ch = Utf16::Next(utf16, &i, len);
+    utf8_len += Utf8::Length(ch);
+    valid = !Utf16::IsSurrogate(ch);
+  }
+  if (!valid) {
+    return AllocateDartCObjectUnsupported();
+  }
+  Dart_CObject* object = AllocateDartCObjectString(utf8_len);
+  AddBackRef(object_id, object, kIsDeserialized);
+  char* p = object->value.as_string;
+  i = 0;
+  while (i < len) {
+    p += Utf8::Encode(Utf16::Next(utf16, &i, len), p);
+  }
+  *p = '\0';
+  ASSERT(p == (object->value.as_string + utf8_len));
+  return object;
+}
+
 static Dart_TypedData_Type GetTypedDataTypeFromView(
     Dart_CObject_Internal* object,
     char* class_name) {
@@ -602,51 +649,30 @@ Dart_CObject* ApiMessageReader::ReadInternalVMObject(intptr_t class_id,
       intptr_t len = ReadSmiValue();
       uint8_t* latin1 =
           reinterpret_cast<uint8_t*>(allocator(len * sizeof(uint8_t)));
-      intptr_t utf8_len = 0;
-      for (intptr_t i = 0; i < len; i++) {
-        latin1[i] = Read<uint8_t>();
-        utf8_len += Utf8::Length(latin1[i]);
-      }
-      Dart_CObject* object = AllocateDartCObjectString(utf8_len);
-      AddBackRef(object_id, object, kIsDeserialized);
-      char* p = object->value.as_string;
-      for (intptr_t i = 0; i < len; i++) {
-        p += Utf8::Encode(latin1[i], p);
-      }
-      *p = '\0';
-      ASSERT(p == (object->value.as_string + utf8_len));
+      ReadBytes(latin1, len * sizeof(uint8_t));
+      return ReadLatin1String(object_id, latin1, len);
+    }
+    case kExternalOneByteStringCid: {
+      intptr_t len = ReadSmiValue();
+      FinalizableData finalizable_data = finalizable_data_->Take();
+      Dart_CObject* object = ReadLatin1String(
+          object_id, reinterpret_cast<uint8_t*>(finalizable_data.data), len);
+      finalizable_data.callback(NULL, NULL, finalizable_data.peer);
       return object;
     }
     case kTwoByteStringCid: {
       intptr_t len = ReadSmiValue();
       uint16_t* utf16 =
           reinterpret_cast<uint16_t*>(allocator(len * sizeof(uint16_t)));
-      intptr_t utf8_len = 0;
-      // Read all the UTF-16 code units.
-      for (intptr_t i = 0; i < len; i++) {
-        utf16[i] = Read<uint16_t>();
-      }
-      // Calculate the UTF-8 length and check if the string can be
-      // UTF-8 encoded.
-      bool valid = true;
-      intptr_t i = 0;
-      while (i < len && valid) {
-        int32_t ch = Utf16::Next(utf16, &i, len);
-        utf8_len += Utf8::Length(ch);
-        valid = !Utf16::IsSurrogate(ch);
-      }
-      if (!valid) {
-        return AllocateDartCObjectUnsupported();
-      }
-      Dart_CObject* object = AllocateDartCObjectString(utf8_len);
-      AddBackRef(object_id, object, kIsDeserialized);
-      char* p = object->value.as_string;
-      i = 0;
-      while (i < len) {
-        p += Utf8::Encode(Utf16::Next(utf16, &i, len), p);
-      }
-      *p = '\0';
-      ASSERT(p == (object->value.as_string + utf8_len));
+      ReadBytes(reinterpret_cast<uint8_t*>(utf16), len * sizeof(uint16_t));
+      return ReadUTF16String(object_id, utf16, len);
+    }
+    case kExternalTwoByteStringCid: {
+      intptr_t len = ReadSmiValue();
+      FinalizableData finalizable_data = finalizable_data_->Take();
+      Dart_CObject* object = ReadUTF16String(
+          object_id, reinterpret_cast<uint16_t*>(finalizable_data.data), len);
+      finalizable_data.callback(NULL, NULL, finalizable_data.peer);
       return object;
     }
     case kSendPortCid: {
@@ -674,7 +700,22 @@ Dart_CObject* ApiMessageReader::ReadInternalVMObject(intptr_t class_id,
 
 #define READ_TYPED_DATA(type, ctype)                                           \
   {                                                                            \
-    READ_TYPED_DATA_HEADER(type);                                              \
+    intptr_t len = ReadSmiValue();                                             \
+    if (borrow_message_data_ && (sizeof(ctype) == 1) && (len > 0)) {           \
+      /* Byte-sized elements have no alignment requirement, so the */          \
+      /* contents can be used in place in the message buffer. */               \
+      Dart_CObject* object =                                                   \
+          AllocateDartCObjectTypedData(Dart_TypedData_k##type, 0);             \
+      AddBackRef(object_id, object, kIsDeserialized);                          \
+      object->value.as_typed_data.length = len;                                \
+      object->value.as_typed_data.values =                                     \
+          const_cast<uint8_t*>(CurrentBufferAddress());                        \
+      Advance(len);                                                            \
+      return object;                                                           \
+    }                                                                          \
+    Dart_CObject* object =                                                     \
+        AllocateDartCObjectTypedData(Dart_TypedData_k##type, len);             \
+    AddBackRef(object_id, object, kIsDeserialized);                            \
     uint8_t* p =                                                               \
         reinterpret_cast<uint8_t*>(object->value.as_typed_data.values);        \
     ReadBytes(p, len * sizeof(ctype));                                         \
@@ -871,7 +912,7 @@ ApiMessageWriter::ApiMessageWriter()
       forward_list_(NULL),
       forward_list_length_(0),
       forward_id_(0),
-      finalizable_data_(new MessageFinalizableData()) {
+      finalizable_data_(NULL) {
   ASSERT(kDartCObjectTypeMask >= Dart_CObject_kNumberOfTypes - 1);
 }
 
@@ -1142,18 +1183,15 @@ bool ApiMessageWriter::WriteCObjectInlined(Dart_CObject* object,
         bool success =
             Utf8::DecodeToLatin1(utf8_str, utf8_len, latin1_str, len);
         ASSERT(success);
-        for (intptr_t i = 0; i < len; i++) {
-          Write<uint8_t>(latin1_str[i]);
-        }
+        WriteBytes(latin1_str, len * sizeof(uint8_t));
         ::free(latin1_str);
       } else {
         uint16_t* utf16_str =
             reinterpret_cast<uint16_t*>(::malloc(len * sizeof(uint16_t)));
         bool success = Utf8::DecodeToUTF16(utf8_str, utf8_len, utf16_str, len);
         ASSERT(success);
-        for (intptr_t i = 0; i < len; i++) {
-          Write<uint16_t>(utf16_str[i]);
-        }
+        WriteBytes(reinterpret_cast<uint8_t*>(utf16_str),
+                   len * sizeof(uint16_t));
         ::free(utf16_str);
       }
       break;
@@ -1224,6 +1262,10 @@ bool ApiMessageWriter::WriteCObjectInlined(Dart_CObject* object,
       Dart_WeakPersistentHandleFinalizer callback =
           object->value.as_external_typed_data.callback;
       WriteSmi(length);
+      if (finalizable_data_ == NULL) {
+        // Allocated on first use, as most messages carry no external data.
+        finalizable_data_ = new MessageFinalizableData();
+      }
       finalizable_data_->Put(length, reinterpret_cast<void*>(data), peer,
                              callback);
       break;
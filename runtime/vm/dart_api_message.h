@@ -47,7 +47,10 @@ class ApiMessageReader : public BaseReader {
   // The ApiMessageReader object must be enclosed by an ApiNativeScope.
   // Allocation of all C Heap objects is done in the zone associated with
   // the enclosing ApiNativeScope.
-  explicit ApiMessageReader(Message* message);
+  // If borrow_message_data is true, the contents of byte-sized typed data
+  // are not copied and point directly into the message, which then has to
+  // outlive the decoded Dart_CObject structures.
+  explicit ApiMessageReader(Message* message, bool borrow_message_data = false);
   ~ApiMessageReader();
 
   Dart_CObject* ReadMessage();
@@ -111,6 +114,12 @@ class ApiMessageReader : public BaseReader {
   Dart_CObject* ReadVMIsolateObject(intptr_t value);
   Dart_CObject* ReadInternalVMObject(intptr_t class_id, intptr_t object_id);
   Dart_CObject* ReadInlinedObject(intptr_t object_id);
+  Dart_CObject* ReadLatin1String(intptr_t object_id,
+                                 const uint8_t* latin1,
+                                 intptr_t len);
+  Dart_CObject* ReadUTF16String(intptr_t object_id,
+                                const uint16_t* utf16,
+                                intptr_t len);
   Dart_CObject* ReadObjectImpl();
   Dart_CObject* ReadIndexedObject(intptr_t object_id);
   Dart_CObject* ReadPredefinedSymbol(intptr_t object_id);
@@ -150,6 +159,7 @@ class ApiMessageReader : public BaseReader {
   Dart_CObject dynamic_type_marker;
 
   MessageFinalizableData* finalizable_data_;
+  const bool borrow_message_data_;
 
   static _Dart_CObject* singleton_uint32_typed_data_;
 };
@@ -32,7 +32,7 @@ namespace dart {
 class ApiZone {
  public:
   // Create an empty zone.
-  ApiZone() : zone_() {
+  ApiZone() : zone_(Zone::kApiScopeOwner) {
     Thread* thread = Thread::Current();
     Zone* zone = thread != NULL ? thread->zone() : NULL;
     zone_.Link(zone);
@@ -184,6 +184,52 @@ class PersistentHandle {
   DISALLOW_COPY_AND_ASSIGN(PersistentHandle);
 };
 
+// A batch of finalizers of weak persistent handles whose referents have been
+// collected. With --background_finalizers, the GC adds the finalizers to a
+// batch instead of running them during the pause, and the batch is run by a
+// helper thread once the collection is over.
+class FinalizerBatch {
+ public:
+  FinalizerBatch() : entries_() {}
+  ~FinalizerBatch() {}
+
+  bool IsEmpty() const { return entries_.is_empty(); }
+  intptr_t length() const { return entries_.length(); }
+
+  void Add(Dart_WeakPersistentHandleFinalizer callback,
+           Dart_WeakPersistentHandle handle,
+           void* peer) {
+    Entry entry = {callback, handle, peer};
+    entries_.Add(entry);
+  }
+
+  // Moves all finalizers of 'other' to the end of this batch.
+  void TakeAll(FinalizerBatch* other) {
+    entries_.AddArray(other->entries_);
+    other->entries_.Clear();
+  }
+
+  // Runs the finalizers in the order they were added.
+  void Run(void* isolate_callback_data) {
+    for (intptr_t i = 0; i < entries_.length(); i++) {
+      const Entry& entry = entries_[i];
+      (*entry.callback)(isolate_callback_data, entry.handle, entry.peer);
+    }
+    entries_.Clear();
+  }
+
+ private:
+  struct Entry {
+    Dart_WeakPersistentHandleFinalizer callback;
+    Dart_WeakPersistentHandle handle;
+    void* peer;
+  };
+
+  MallocGrowableArray<Entry> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(FinalizerBatch);
+};
+
 // Implementation of persistent handles which are handed out through the
 // dart API.
 class FinalizablePersistentHandle {
@@ -227,6 +273,14 @@ class FinalizablePersistentHandle {
     Finalize(isolate, this);
   }
 
+  // Called by the GC instead of UpdateUnreachable with
+  // --background_finalizers. The handle is freed right away and its
+  // finalizer is added to the heap's pending batch.
+  void UpdateUnreachableInBackground(Isolate* isolate) {
+    EnsureFreeExternal(isolate);
+    FinalizeInBackground(isolate, this);
+  }
+
   // Called when the referent has moved, potentially between generations.
   void UpdateRelocated(Isolate* isolate) {
     if (IsSetNewSpaceBit() && (SpaceForExternal() == Heap::kOld)) {
@@ -269,6 +323,8 @@ class FinalizablePersistentHandle {
   ~FinalizablePersistentHandle() {}
 
   static void Finalize(Isolate* isolate, FinalizablePersistentHandle* handle);
+  static void FinalizeInBackground(Isolate* isolate,
+                                   FinalizablePersistentHandle* handle);
 
   // Overload the raw_ field as a next pointer when adding freed
   // handles to the free list.
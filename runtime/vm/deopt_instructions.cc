@@ -172,10 +172,12 @@ DeoptContext::~DeoptContext() {
       if (timeline_event != NULL) {
         timeline_event->Duration("Deoptimize", deopt_start_micros_,
                                  OS::GetCurrentMonotonicMicros());
-        timeline_event->SetNumArguments(3);
+        timeline_event->SetNumArguments(4);
         timeline_event->CopyArgument(0, "function", function_name.ToCString());
         timeline_event->CopyArgument(1, "reason", reason);
         timeline_event->FormatArgument(2, "deoptimizationCount", "%d", counter);
+        timeline_event->CopyArgument(3, "lazy",
+                                     is_lazy_deopt_ ? "true" : "false");
         timeline_event->Complete();
       }
     }
@@ -16,6 +16,34 @@ static const char kDoubleToStringCommonExponentChar = 'e';
 static const char* kDoubleToStringCommonInfinitySymbol = "Infinity";
 static const char* kDoubleToStringCommonNaNSymbol = "NaN";
 
+// Doubles with magnitude below 2^53 are exactly representable integers with
+// unit or finer spacing, so their shortest round-trip representation is just
+// their integer digits.
+static const double kMaxExactInteger = 9007199254740992.0;  // 2^53.
+
+// Formats an integral double whose magnitude is below kMaxExactInteger as
+// "<digits>.0", matching the shortest-mode output of DoubleToCString.
+static void IntegralDoubleToCString(double d, char* buffer) {
+  int64_t value = static_cast<int64_t>(d);
+  char* p = buffer;
+  if (value < 0) {
+    *p++ = '-';
+    value = -value;
+  }
+  char digits[20];
+  int n = 0;
+  do {
+    digits[n++] = '0' + static_cast<char>(value % 10);
+    value /= 10;
+  } while (value != 0);
+  while (n > 0) {
+    *p++ = digits[--n];
+  }
+  *p++ = '.';
+  *p++ = '0';
+  *p = '\0';
+}
+
 void DoubleToCString(double d, char* buffer, int buffer_size) {
   static const int kDecimalLow = -6;
   static const int kDecimalHigh = 21;
@@ -31,6 +59,15 @@ void DoubleToCString(double d, char* buffer, int buffer_size) {
   // sign, at most three exponent digits, plus the \0.
   ASSERT(buffer_size >= 1 + 17 + 1 + 1 + 1 + 3 + 1);
 
+  // Integral values, common in serialized data, skip the digit generation.
+  // Negative zero is left to the general path so that it prints as "-0.0".
+  if ((-kMaxExactInteger < d) && (d < kMaxExactInteger) &&
+      (static_cast<double>(static_cast<int64_t>(d)) == d) &&
+      !((d == 0.0) && signbit(d))) {
+    IntegralDoubleToCString(d, buffer);
+    return;
+  }
+
   static const int kConversionFlags =
       double_conversion::DoubleToStringConverter::EMIT_POSITIVE_EXPONENT_SIGN |
       double_conversion::DoubleToStringConverter::EMIT_TRAILING_DECIMAL_POINT |
@@ -156,10 +193,67 @@ RawString* DoubleToStringAsPrecision(double d, int precision) {
   return String::New(builder.Finalize());
 }
 
+// Parses the common form [+-]digits[.digits] with at most 15 significant
+// digits and at most 22 fraction digits. The digits then fit exactly in a
+// double, as does the power of ten, so a single division yields the
+// correctly rounded result. Returns false for anything else.
+static bool SimpleCStringToDouble(const char* str,
+                                  intptr_t length,
+                                  double* result) {
+  static const double kPowersOfTen[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  static const intptr_t kMaxSignificantDigits = 15;
+  static const intptr_t kMaxFractionDigits = ARRAY_SIZE(kPowersOfTen) - 1;
+
+  intptr_t i = 0;
+  bool negative = false;
+  if ((str[0] == '-') || (str[0] == '+')) {
+    negative = (str[0] == '-');
+    i++;
+  }
+  int64_t mantissa = 0;
+  intptr_t significant_digits = 0;
+  intptr_t integer_digits = 0;
+  for (; (i < length) && ('0' <= str[i]) && (str[i] <= '9'); i++) {
+    mantissa = mantissa * 10 + (str[i] - '0');
+    if ((mantissa != 0) && (++significant_digits > kMaxSignificantDigits)) {
+      return false;
+    }
+    integer_digits++;
+  }
+  if (integer_digits == 0) {
+    return false;
+  }
+  intptr_t fraction_digits = 0;
+  if ((i < length) && (str[i] == '.')) {
+    i++;
+    for (; (i < length) && ('0' <= str[i]) && (str[i] <= '9'); i++) {
+      mantissa = mantissa * 10 + (str[i] - '0');
+      if ((mantissa != 0) && (++significant_digits > kMaxSignificantDigits)) {
+        return false;
+      }
+      fraction_digits++;
+    }
+    if (fraction_digits == 0) {
+      return false;
+    }
+  }
+  if ((i != length) || (fraction_digits > kMaxFractionDigits)) {
+    return false;
+  }
+  double value = static_cast<double>(mantissa) / kPowersOfTen[fraction_digits];
+  *result = negative ? -value : value;
+  return true;
+}
+
 bool CStringToDouble(const char* str, intptr_t length, double* result) {
   if (length == 0) {
     return false;
   }
+  if (SimpleCStringToDouble(str, length, result)) {
+    return true;
+  }
 
   double_conversion::StringToDoubleConverter converter(
       double_conversion::StringToDoubleConverter::NO_FLAGS, 0.0, 0.0,
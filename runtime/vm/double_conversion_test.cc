@@ -0,0 +1,57 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/double_conversion.h"
+#include "platform/assert.h"
+#include "vm/globals.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+VM_UNIT_TEST_CASE(DoubleToCString) {
+  const int kBufferSize = 128;
+  char buffer[kBufferSize];
+  // Integral values take the fast path.
+  DoubleToCString(0.0, buffer, kBufferSize);
+  EXPECT_STREQ("0.0", buffer);
+  DoubleToCString(-0.0, buffer, kBufferSize);
+  EXPECT_STREQ("-0.0", buffer);
+  DoubleToCString(42.0, buffer, kBufferSize);
+  EXPECT_STREQ("42.0", buffer);
+  DoubleToCString(-9007199254740991.0, buffer, kBufferSize);
+  EXPECT_STREQ("-9007199254740991.0", buffer);
+  // Everything else goes through the shortest-digits conversion.
+  DoubleToCString(9007199254740992.0, buffer, kBufferSize);
+  EXPECT_STREQ("9007199254740992.0", buffer);
+  DoubleToCString(0.1, buffer, kBufferSize);
+  EXPECT_STREQ("0.1", buffer);
+  DoubleToCString(1e21, buffer, kBufferSize);
+  EXPECT_STREQ("1e+21", buffer);
+}
+
+VM_UNIT_TEST_CASE(CStringToDouble) {
+  double value;
+  // Short decimals take the fast path.
+  EXPECT(CStringToDouble("12.5", 4, &value));
+  EXPECT_EQ(12.5, value);
+  EXPECT(CStringToDouble("-0", 2, &value));
+  EXPECT(value == 0.0 && signbit(value));
+  EXPECT(CStringToDouble("+0.001", 6, &value));
+  EXPECT_EQ(0.001, value);
+  EXPECT(CStringToDouble("123456789012345", 15, &value));
+  EXPECT_EQ(123456789012345.0, value);
+  // Longer or exponent forms go through the general converter.
+  EXPECT(CStringToDouble("1234567890123456789", 19, &value));
+  EXPECT_EQ(1234567890123456789.0, value);
+  EXPECT(CStringToDouble("1.5e3", 5, &value));
+  EXPECT_EQ(1500.0, value);
+  EXPECT(CStringToDouble("1.", 2, &value));
+  EXPECT_EQ(1.0, value);
+  // Malformed input is rejected by both.
+  EXPECT(!CStringToDouble("1.2.3", 5, &value));
+  EXPECT(!CStringToDouble("-", 1, &value));
+  EXPECT(!CStringToDouble("12x", 3, &value));
+}
+
+}  // namespace dart
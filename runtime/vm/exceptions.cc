@@ -581,17 +581,22 @@ static void ThrowExceptionHelper(Thread* thread,
       stacktrace = existing_stacktrace.raw();
     } else {
       // Get stacktrace field of class Error to determine whether we have a
-      // subclass of Error which carries around its stack trace.
+      // subclass of Error which carries around its stack trace. An Error that
+      // already carries one does not need a new trace unless the handler
+      // asks for it.
       const Field& stacktrace_field =
           Field::Handle(zone, LookupStackTraceField(exception));
-      if (!stacktrace_field.IsNull() || handler_needs_stacktrace) {
+      const bool error_needs_stacktrace =
+          !stacktrace_field.IsNull() &&
+          (exception.GetField(stacktrace_field) == Object::null());
+      if (error_needs_stacktrace || handler_needs_stacktrace ||
+          FLAG_print_stacktrace_at_throw) {
         // Collect the stacktrace if needed.
         ASSERT(existing_stacktrace.IsNull());
         stacktrace = Exceptions::CurrentStackTrace();
         // If we have an Error object, then set its stackTrace field only if it
         // not yet initialized.
-        if (!stacktrace_field.IsNull() &&
-            (exception.GetField(stacktrace_field) == Object::null())) {
+        if (error_needs_stacktrace) {
           exception.SetField(stacktrace_field, stacktrace);
         }
       }
@@ -50,8 +50,19 @@
     "Run optimizing compilation in background")                                \
   R(background_compilation_stop_alot, false, bool, false,                      \
     "Stress test system: stop background compiler often.")                     \
+  P(background_finalizers, bool, false,                                        \
+    "Run the finalizers of collected weak persistent handles in batches on a " \
+    "helper thread after the GC pause. Finalizers must not call into the VM "  \
+    "and may see their handle already reused.")                                \
   R(break_at_isolate_spawn, false, bool, false,                                \
     "Insert a one-time breakpoint at the entrypoint for all spawned isolates") \
+  P(background_idle_gc, bool, USING_MULTICORE,                                 \
+    "Run idle mark-sweeps that cannot finish before the idle deadline on a "   \
+    "helper thread.")                                                          \
+  P(baseline_optimization_counter_threshold, int, -1,                          \
+    "Function's usage-counter value before it is compiled by the baseline "    \
+    "optimizing tier (cheap passes only) ahead of full optimization at "       \
+    "optimization_counter_threshold, -1 means never")                          \
   P(causal_async_stacks, bool, !USING_PRODUCT, "Improved async stacks")        \
   P(collect_code, bool, true, "Attempt to GC infrequently used code.")         \
   P(collect_dynamic_function_names, bool, true,                                \
@@ -95,6 +106,8 @@
     "Ratio of getter/setter usage used for double field unboxing heuristics")  \
   P(guess_icdata_cid, bool, true,                                              \
     "Artificially create type feedback for arithmetic etc. operations")        \
+  P(heap_iteration_tasks, int, 2,                                              \
+    "The number of tasks to use when visiting all heap objects in parallel.")  \
   P(huge_method_cutoff_in_tokens, int, 20000,                                  \
     "Huge method cutoff in tokens: Disables optimizations for huge methods.")  \
   P(idle_timeout_micros, int, 1000 * kMicrosecondsPerMillisecond,              \
@@ -117,7 +130,8 @@
   P(max_equality_polymorphic_checks, int, 32,                                  \
     "Maximum number of polymorphic checks in equality operator,")              \
   P(new_gen_ext_limit, int, 64,                                                \
-    "maximum total external size (MB) in new gen before triggering GC")        \
+    "External size (MB) allocated in new gen since the last scavenge that "    \
+    "triggers the next one")                                                   \
   P(new_gen_semi_max_size, int, (kWordSize <= 4) ? 16 : 32,                    \
     "Max size of new gen semi space in MB")                                    \
   P(optimization_counter_threshold, int, 30000,                                \
@@ -130,6 +144,9 @@
   R(pause_isolates_on_exit, false, bool, false, "Pause isolates exiting.")     \
   R(pause_isolates_on_unhandled_exceptions, false, bool, false,                \
     "Pause isolates on unhandled exceptions.")                                 \
+  P(place_cold_blocks_last, bool, true,                                        \
+    "Emit blocks that always throw after the rest of an AOT compiled "         \
+    "function.")                                                               \
   P(polymorphic_with_deopt, bool, true,                                        \
     "Polymorphic calls with deoptimization / megamorphic call")                \
   P(precompiled_mode, bool, false, "Precompilation compiler mode")             \
@@ -154,6 +171,9 @@
   P(reify_generic_functions, bool, false,                                      \
     "Enable reification of generic functions (not yet supported).")            \
   P(reorder_basic_blocks, bool, true, "Reorder basic blocks")                  \
+  P(scavenger_tasks, int, 0,                                                   \
+    "The number of tasks to spawn during new gen GC scavenging (0 means "      \
+    "perform all scavenging on main thread).")                                 \
   C(stress_async_stacks, false, false, bool, false,                            \
     "Stress test async stack traces")                                          \
   P(strong, bool, false, "Enable strong mode.")                                \
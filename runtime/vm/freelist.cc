@@ -8,8 +8,10 @@
 #include "vm/hash_map.h"
 #include "vm/lockers.h"
 #include "vm/object.h"
+#include "vm/os.h"
 #include "vm/os_thread.h"
 #include "vm/raw_object.h"
+#include "vm/virtual_memory.h"
 
 namespace dart {
 
@@ -106,71 +108,112 @@ uword FreeList::TryAllocateLocked(intptr_t size, bool is_protected) {
     }
   }
 
+  FreeListElement* element = TryDequeueLargeElement(size, is_protected);
+  if (element != NULL) {
+    SplitElementAfterAndEnqueue(element, size, is_protected);
+  }
+  return reinterpret_cast<uword>(element);
+}
+
+FreeListElement* FreeList::TryDequeueLargeElement(intptr_t size,
+                                                  bool is_protected) {
+  intptr_t index = -1;
+  if (size >= kMinLargeSize) {
+    // Elements in the request's own size class might be too small.
+    index = LargeIndexForSize(size);
+    FreeListElement* element =
+        TryDequeueFromLargeList(index, size, is_protected);
+    if (element != NULL) {
+      return element;
+    }
+  }
+  // Every element in a higher size class fits; take from the smallest one.
+  if ((index + 1) < kNumLargeLists) {
+    intptr_t next_index = large_map_.Next(index + 1);
+    if (next_index != -1) {
+      FreeListElement* element = large_lists_[next_index];
+      UnlinkLargeElement(next_index, NULL, element, size, is_protected);
+      return element;
+    }
+  }
+  return NULL;
+}
+
+FreeListElement* FreeList::TryDequeueFromLargeList(intptr_t index,
+                                                   intptr_t size,
+                                                   bool is_protected) {
   FreeListElement* previous = NULL;
-  FreeListElement* current = free_lists_[kNumLists];
-  // We are willing to search the freelist further for a big block.
-  // For each successful free-list search we:
+  FreeListElement* current = large_lists_[index];
+  // We are willing to search the size class further for a big block.
+  // For each successful search we:
   //   * increase the search budget by #allocated-words
   //   * decrease the search budget by #free-list-entries-traversed
   //     which guarantees us to not waste more than around 1 search step per
   //     word of allocation
   //
-  // If we run out of search budget we fall back to allocating a new page and
-  // reset the search budget.
+  // If we run out of search budget we give up on this size class and reset
+  // the search budget.
   intptr_t tries_left = freelist_search_budget_ + (size >> kWordSizeLog2);
   while (current != NULL) {
     if (current->Size() >= size) {
-      // Found an element large enough to hold the requested size. Dequeue,
-      // split and enqueue the remainder.
-      intptr_t remainder_size = current->Size() - size;
-      intptr_t region_size =
-          size + FreeListElement::HeaderSizeFor(remainder_size);
-      if (is_protected) {
-        // Make the allocated block and the header of the remainder element
-        // writable.  The remainder will be non-writable if necessary after
-        // the call to SplitElementAfterAndEnqueue.
-        VirtualMemory::Protect(reinterpret_cast<void*>(current), region_size,
-                               VirtualMemory::kReadWrite);
-      }
-
-      if (previous == NULL) {
-        free_lists_[kNumLists] = current->next();
-      } else {
-        // If the previous free list element's next field is protected, it
-        // needs to be unprotected before storing to it and reprotected
-        // after.
-        bool target_is_protected = false;
-        uword target_address = 0L;
-        if (is_protected) {
-          uword writable_start = reinterpret_cast<uword>(current);
-          uword writable_end = writable_start + region_size - 1;
-          target_address = previous->next_address();
-          target_is_protected =
-              !VirtualMemory::InSamePage(target_address, writable_start) &&
-              !VirtualMemory::InSamePage(target_address, writable_end);
-        }
-        if (target_is_protected) {
-          VirtualMemory::Protect(reinterpret_cast<void*>(target_address),
-                                 kWordSize, VirtualMemory::kReadWrite);
-        }
-        previous->set_next(current->next());
-        if (target_is_protected) {
-          VirtualMemory::Protect(reinterpret_cast<void*>(target_address),
-                                 kWordSize, VirtualMemory::kReadExecute);
-        }
-      }
-      SplitElementAfterAndEnqueue(current, size, is_protected);
+      UnlinkLargeElement(index, previous, current, size, is_protected);
       freelist_search_budget_ =
           Utils::Minimum(tries_left, kInitialFreeListSearchBudget);
-      return reinterpret_cast<uword>(current);
+      return current;
     } else if (tries_left-- < 0) {
       freelist_search_budget_ = kInitialFreeListSearchBudget;
-      return 0;  // Trigger allocation of new page.
+      return NULL;
     }
     previous = current;
     current = current->next();
   }
-  return 0;
+  return NULL;
+}
+
+void FreeList::UnlinkLargeElement(intptr_t index,
+                                  FreeListElement* previous,
+                                  FreeListElement* element,
+                                  intptr_t size,
+                                  bool is_protected) {
+  intptr_t remainder_size = element->Size() - size;
+  intptr_t region_size = size + FreeListElement::HeaderSizeFor(remainder_size);
+  if (is_protected) {
+    // Make the allocated block and the header of the remainder element
+    // writable.  The remainder will be non-writable if necessary after
+    // the call to SplitElementAfterAndEnqueue.
+    VirtualMemory::Protect(reinterpret_cast<void*>(element), region_size,
+                           VirtualMemory::kReadWrite);
+  }
+
+  if (previous == NULL) {
+    large_lists_[index] = element->next();
+    if (large_lists_[index] == NULL) {
+      large_map_.Set(index, false);
+    }
+  } else {
+    // If the previous free list element's next field is protected, it
+    // needs to be unprotected before storing to it and reprotected
+    // after.
+    bool target_is_protected = false;
+    uword target_address = 0L;
+    if (is_protected) {
+      uword writable_start = reinterpret_cast<uword>(element);
+      uword writable_end = writable_start + region_size - 1;
+      target_address = previous->next_address();
+      target_is_protected =
+          !VirtualMemory::InSamePage(target_address, writable_start) &&
+          !VirtualMemory::InSamePage(target_address, writable_end);
+    }
+    if (target_is_protected) {
+      VirtualMemory::Protect(reinterpret_cast<void*>(target_address),
+                             kWordSize, VirtualMemory::kReadWrite);
+    }
+    previous->set_next(element->next());
+    if (target_is_protected) {
+      VirtualMemory::Protect(reinterpret_cast<void*>(target_address),
+                             kWordSize, VirtualMemory::kReadExecute);
+    }
+  }
 }
 
 void FreeList::Free(uword addr, intptr_t size) {
@@ -195,9 +238,14 @@ void FreeList::Reset() {
   MutexLocker ml(mutex_);
   free_map_.Reset();
   last_free_small_size_ = -1;
-  for (int i = 0; i < (kNumLists + 1); i++) {
+  for (int i = 0; i < kNumLists; i++) {
     free_lists_[i] = NULL;
   }
+  large_map_.Reset();
+  for (int i = 0; i < kNumLargeLists; i++) {
+    large_lists_[i] = NULL;
+  }
+  next_release_index_ = 0;
 }
 
 intptr_t FreeList::IndexForSize(intptr_t size) {
@@ -211,9 +259,30 @@ intptr_t FreeList::IndexForSize(intptr_t size) {
   return index;
 }
 
+intptr_t FreeList::LargeIndexForSize(intptr_t size) {
+  ASSERT(size >= kMinLargeSize);
+  intptr_t level = Utils::HighestBit(size);
+  if (level >= (kMinLargeSizeLog2 + kNumLargeLevels)) {
+    return kNumLargeLists - 1;
+  }
+  intptr_t sub_list =
+      (size >> (level - kLargeSubListsLog2)) & (kLargeSubLists - 1);
+  return ((level - kMinLargeSizeLog2) << kLargeSubListsLog2) + sub_list;
+}
+
 void FreeList::EnqueueElement(FreeListElement* element, intptr_t index) {
+  if (index == kNumLists) {
+    index = LargeIndexForSize(element->Size());
+    FreeListElement* next = large_lists_[index];
+    if (next == NULL) {
+      large_map_.Set(index, true);
+    }
+    element->set_next(next);
+    large_lists_[index] = element;
+    return;
+  }
   FreeListElement* next = free_lists_[index];
-  if (next == NULL && index != kNumLists) {
+  if (next == NULL) {
     free_map_.Set(index, true);
     last_free_small_size_ =
         Utils::Maximum(last_free_small_size_, index << kObjectAlignmentLog2);
@@ -223,9 +292,10 @@ void FreeList::EnqueueElement(FreeListElement* element, intptr_t index) {
 }
 
 FreeListElement* FreeList::DequeueElement(intptr_t index) {
+  ASSERT(index < kNumLists);
   FreeListElement* result = free_lists_[index];
   FreeListElement* next = result->next();
-  if (next == NULL && index != kNumLists) {
+  if (next == NULL) {
     intptr_t size = index << kObjectAlignmentLog2;
     if (size == last_free_small_size_) {
       // Note: This is -1 * kObjectAlignment if no other small sizes remain.
@@ -302,16 +372,18 @@ void FreeList::PrintLarge() const {
   int large_objects = 0;
   intptr_t large_bytes = 0;
   MallocDirectChainedHashMap<NumbersKeyValueTrait<IntptrPair> > map;
-  FreeListElement* node;
-  for (node = free_lists_[kNumLists]; node != NULL; node = node->next()) {
-    IntptrPair* pair = map.Lookup(node->Size());
-    if (pair == NULL) {
-      large_sizes += 1;
-      map.Insert(IntptrPair(node->Size(), 1));
-    } else {
-      pair->set_second(pair->second() + 1);
+  for (int i = 0; i < kNumLargeLists; ++i) {
+    FreeListElement* node;
+    for (node = large_lists_[i]; node != NULL; node = node->next()) {
+      IntptrPair* pair = map.Lookup(node->Size());
+      if (pair == NULL) {
+        large_sizes += 1;
+        map.Insert(IntptrPair(node->Size(), 1));
+      } else {
+        pair->set_second(pair->second() + 1);
+      }
+      large_objects += 1;
     }
-    large_objects += 1;
   }
 
   MallocDirectChainedHashMap<NumbersKeyValueTrait<IntptrPair> >::Iterator it =
@@ -369,31 +441,14 @@ FreeListElement* FreeList::TryAllocateLarge(intptr_t minimum_size) {
 
 FreeListElement* FreeList::TryAllocateLargeLocked(intptr_t minimum_size) {
   DEBUG_ASSERT(mutex_->IsOwnedByCurrentThread());
-  FreeListElement* previous = NULL;
-  FreeListElement* current = free_lists_[kNumLists];
-  // TODO(koda): Find largest.
-  // We are willing to search the freelist further for a big block.
-  intptr_t tries_left =
-      freelist_search_budget_ + (minimum_size >> kWordSizeLog2);
-  while (current != NULL) {
-    FreeListElement* next = current->next();
-    if (current->Size() >= minimum_size) {
-      if (previous == NULL) {
-        free_lists_[kNumLists] = next;
-      } else {
-        previous->set_next(next);
-      }
-      freelist_search_budget_ =
-          Utils::Minimum(tries_left, kInitialFreeListSearchBudget);
-      return current;
-    } else if (tries_left-- < 0) {
-      freelist_search_budget_ = kInitialFreeListSearchBudget;
-      return 0;  // Trigger allocation of new page.
-    }
-    previous = current;
-    current = next;
+  // Bump allocation benefits from the largest available block, so look at
+  // the highest size class first.  If nothing there is big enough, no lower
+  // size class can help either.
+  intptr_t index = large_map_.Last();
+  if (index == -1) {
+    return NULL;
   }
-  return NULL;
+  return TryDequeueFromLargeList(index, minimum_size, false);
 }
 
 uword FreeList::TryAllocateSmallLocked(intptr_t size) {
@@ -416,4 +471,39 @@ uword FreeList::TryAllocateSmallLocked(intptr_t size) {
   return 0;
 }
 
+bool FreeList::ReleaseUnusedMemory(int64_t deadline,
+                                   intptr_t* released_in_bytes) {
+  MutexLocker ml(mutex_);
+  const intptr_t page_size = VirtualMemory::PageSize();
+  // Start with the largest elements, which release the most per call. At
+  // least one non-empty list is handled per call, so that progress is made
+  // even when the deadline has already passed.
+  while (next_release_index_ < kNumLargeLists) {
+    const intptr_t i = kNumLargeLists - 1 - next_release_index_;
+    next_release_index_++;
+    FreeListElement* element = large_lists_[i];
+    if (element == NULL) {
+      continue;
+    }
+    for (; element != NULL; element = element->next()) {
+      // Keep the header, which chains the element into its list.
+      uword element_start = reinterpret_cast<uword>(element);
+      intptr_t element_size = element->Size();
+      uword start = Utils::RoundUp(
+          element_start + FreeListElement::HeaderSizeFor(element_size),
+          page_size);
+      uword end = Utils::RoundDown(element_start + element_size, page_size);
+      if (start < end) {
+        VirtualMemory::DontNeed(reinterpret_cast<void*>(start), end - start);
+        *released_in_bytes += end - start;
+      }
+    }
+    if ((next_release_index_ < kNumLargeLists) &&
+        (OS::GetCurrentMonotonicMicros() >= deadline)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace dart
@@ -74,6 +74,13 @@ class FreeListElement {
   DISALLOW_IMPLICIT_CONSTRUCTORS(FreeListElement);
 };
 
+// FreeList keeps one list per object size for small elements; the presence
+// of elements of each size is tracked in a bitmap so that the smallest
+// sufficient size can be found with a few bit scans.  Larger elements are
+// kept in segregated lists covering a quarter of a power of two each (with a
+// final list for everything larger), tracked by a second bitmap.  Any element
+// in a list above the one a request maps to is large enough to satisfy it,
+// so good fits for large requests are found without walking long lists.
 class FreeList {
  public:
   FreeList();
@@ -91,6 +98,7 @@ class FreeList {
   void FreeLocked(uword addr, intptr_t size);
 
   // Returns a large element, at least 'minimum_size', or NULL if none exists.
+  // Prefers elements from the largest available size class.
   FreeListElement* TryAllocateLarge(intptr_t minimum_size);
   FreeListElement* TryAllocateLargeLocked(intptr_t minimum_size);
 
@@ -98,17 +106,49 @@ class FreeList {
   // (i.e., fixed size lists).
   uword TryAllocateSmallLocked(intptr_t size);
 
+  // Tells the OS that the whole pages inside large elements are not needed
+  // until they are allocated again. Stops at 'deadline' (in monotonic micros)
+  // and resumes with the next size class at the next call. Returns true when
+  // all large elements have been handled since the last Reset; the number of
+  // bytes released by this call is added to 'released_in_bytes'.
+  bool ReleaseUnusedMemory(int64_t deadline, intptr_t* released_in_bytes);
+
  private:
-  static const int kNumLists = 128;
+  static const int kNumListsLog2 = 7;
+  static const int kNumLists = 1 << kNumListsLog2;
   static const intptr_t kInitialFreeListSearchBudget = 1000;
 
+  // Large elements start at the first size not covered by the small lists.
+  static const int kMinLargeSizeLog2 = kNumListsLog2 + kObjectAlignmentLog2;
+  static const intptr_t kMinLargeSize = 1 << kMinLargeSizeLog2;
+  static const int kNumLargeLevels = 8;
+  static const int kLargeSubListsLog2 = 2;
+  static const int kLargeSubLists = 1 << kLargeSubListsLog2;
+  // The last large list holds all elements of at least
+  // kMinLargeSize << kNumLargeLevels bytes.
+  static const int kNumLargeLists = (kNumLargeLevels * kLargeSubLists) + 1;
+
   static intptr_t IndexForSize(intptr_t size);
+  static intptr_t LargeIndexForSize(intptr_t size);
 
   intptr_t LengthLocked(int index) const;
 
   void EnqueueElement(FreeListElement* element, intptr_t index);
   FreeListElement* DequeueElement(intptr_t index);
 
+  // Unlinks and returns a large element of at least 'size' bytes, or NULL.
+  // When is_protected, the first 'size' bytes of the element and the header
+  // of its remainder are made writable.
+  FreeListElement* TryDequeueLargeElement(intptr_t size, bool is_protected);
+  FreeListElement* TryDequeueFromLargeList(intptr_t index,
+                                           intptr_t size,
+                                           bool is_protected);
+  void UnlinkLargeElement(intptr_t index,
+                          FreeListElement* previous,
+                          FreeListElement* element,
+                          intptr_t size,
+                          bool is_protected);
+
   void SplitElementAfterAndEnqueue(FreeListElement* element,
                                    intptr_t size,
                                    bool is_protected);
@@ -121,13 +161,20 @@ class FreeList {
 
   BitSet<kNumLists> free_map_;
 
-  FreeListElement* free_lists_[kNumLists + 1];
+  FreeListElement* free_lists_[kNumLists];
+
+  BitSet<kNumLargeLists> large_map_;
+
+  FreeListElement* large_lists_[kNumLargeLists];
 
   intptr_t freelist_search_budget_;
 
   // The largest available small size in bytes, or negative if there is none.
   intptr_t last_free_small_size_;
 
+  // The next large list ReleaseUnusedMemory handles.
+  intptr_t next_release_index_;
+
   DISALLOW_COPY_AND_ASSIGN(FreeList);
 };
 
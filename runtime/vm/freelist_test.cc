@@ -182,4 +182,64 @@ TEST_CASE(FreeListProtectedVariableSizeObjects) {
   delete[] objects;
 }
 
+TEST_CASE(FreeListLargeBestFit) {
+  FreeList* free_list = new FreeList();
+  VirtualMemory* region =
+      VirtualMemory::Allocate(1 * MB, /* is_executable = */ false, NULL);
+  region->Protect(VirtualMemory::kReadWrite);
+  uword blob = region->start();
+
+  // Free large blocks of assorted sizes, out of size order.
+  free_list->Free(blob, 16 * KB);
+  free_list->Free(blob + 32 * KB, 4 * KB);
+  free_list->Free(blob + 64 * KB, 6 * KB);
+  free_list->Free(blob + 128 * KB, 512 * KB);
+
+  // The smallest block that fits is chosen over earlier, larger ones.
+  EXPECT_EQ(blob + 64 * KB, free_list->TryAllocate(5 * KB, false));
+  EXPECT_EQ(blob + 32 * KB, free_list->TryAllocate(4 * KB, false));
+  // The 1KB remainder of the 6KB block went to the small lists.
+  EXPECT_EQ(blob + 69 * KB, free_list->TryAllocate(1 * KB, false));
+  EXPECT_EQ(blob, free_list->TryAllocate(1 * KB, false));
+
+  // Bump allocation areas come from the largest block.
+  FreeListElement* element = free_list->TryAllocateLarge(8 * KB);
+  EXPECT_EQ(blob + 128 * KB, reinterpret_cast<uword>(element));
+  EXPECT_EQ(512 * KB, element->Size());
+  EXPECT(free_list->TryAllocateLarge(64 * KB) == NULL);
+  EXPECT_EQ(blob + 1 * KB, free_list->TryAllocate(15 * KB, false));
+  EXPECT_EQ(0, free_list->TryAllocate(1 * KB, false));
+
+  delete region;
+  delete free_list;
+}
+
+TEST_CASE(FreeListReleaseUnusedMemory) {
+  FreeList* free_list = new FreeList();
+  VirtualMemory* region =
+      VirtualMemory::Allocate(1 * MB, /* is_executable = */ false, NULL);
+  region->Protect(VirtualMemory::kReadWrite);
+  uword blob = region->start();
+
+  // Two blocks in different size classes.
+  free_list->Free(blob, 256 * KB);
+  free_list->Free(blob + 512 * KB, 64 * KB);
+
+  // A passed deadline still makes progress, one size class at a time.
+  intptr_t released_in_bytes = 0;
+  EXPECT(!free_list->ReleaseUnusedMemory(0, &released_in_bytes));
+  EXPECT_LT(0, released_in_bytes);
+  EXPECT_GT(256 * KB, released_in_bytes);
+  EXPECT(free_list->ReleaseUnusedMemory(kMaxInt64, &released_in_bytes));
+  EXPECT_GT(256 * KB + 64 * KB, released_in_bytes);
+  EXPECT(free_list->ReleaseUnusedMemory(0, &released_in_bytes));
+
+  // Released memory is still usable.
+  EXPECT_EQ(blob + 512 * KB, free_list->TryAllocate(64 * KB, false));
+  *reinterpret_cast<intptr_t*>(blob + 512 * KB + 32 * KB) = 42;
+
+  delete region;
+  delete free_list;
+}
+
 }  // namespace dart
@@ -127,6 +127,9 @@ class CompactorTask : public ThreadPool::Task {
                 GCCompactor* compactor,
                 ThreadBarrier* barrier,
                 intptr_t* next_forwarding_task,
+                HeapPage** unmoved_pages,
+                intptr_t num_unmoved_pages,
+                intptr_t* next_unmoved_page,
                 HeapPage* head,
                 HeapPage** tail,
                 FreeList* freelist)
@@ -134,6 +137,9 @@ class CompactorTask : public ThreadPool::Task {
         compactor_(compactor),
         barrier_(barrier),
         next_forwarding_task_(next_forwarding_task),
+        unmoved_pages_(unmoved_pages),
+        num_unmoved_pages_(num_unmoved_pages),
+        next_unmoved_page_(next_unmoved_page),
         head_(head),
         tail_(tail),
         freelist_(freelist),
@@ -150,11 +156,15 @@ class CompactorTask : public ThreadPool::Task {
   void PlanMoveToExactAddress(uword addr);
   void PlanMoveToContiguousSize(intptr_t size);
   void SlideFreeUpTo(uword addr);
+  void ForwardUnmovedPage(HeapPage* page);
 
   Isolate* isolate_;
   GCCompactor* compactor_;
   ThreadBarrier* barrier_;
   intptr_t* next_forwarding_task_;
+  HeapPage** unmoved_pages_;
+  const intptr_t num_unmoved_pages_;
+  intptr_t* next_unmoved_page_;
   HeapPage* head_;
   HeapPage** tail_;
   FreeList* freelist_;
@@ -174,6 +184,16 @@ class CompactorTask : public ThreadPool::Task {
 void GCCompactor::Compact(HeapPage* pages,
                           FreeList* freelist,
                           Mutex* pages_lock) {
+  HeapPage* tail = CompactPages(pages, NULL, 0, freelist, pages_lock);
+  MutexLocker ml(pages_lock);
+  heap_->old_space()->pages_tail_ = tail;
+}
+
+HeapPage* GCCompactor::CompactPages(HeapPage* pages,
+                                    HeapPage** unmoved_pages,
+                                    intptr_t num_unmoved_pages,
+                                    FreeList* freelist,
+                                    Mutex* pages_lock) {
   SetupImagePageBoundaries();
 
   // Divide the heap.
@@ -218,10 +238,12 @@ void GCCompactor::Compact(HeapPage* pages,
     ThreadBarrier barrier(num_tasks + 1, heap_->barrier(),
                           heap_->barrier_done());
     intptr_t next_forwarding_task = 0;
+    intptr_t next_unmoved_page = 0;
 
     for (intptr_t task_index = 0; task_index < num_tasks; task_index++) {
       Dart::thread_pool()->Run(new CompactorTask(
           thread()->isolate(), this, &barrier, &next_forwarding_task,
+          unmoved_pages, num_unmoved_pages, &next_unmoved_page,
           heads[task_index], &tails[task_index], freelist));
     }
 
@@ -241,6 +263,7 @@ void GCCompactor::Compact(HeapPage* pages,
     ForwardStackPointers();
   }
 
+  HeapPage* tail = NULL;
   {
     MutexLocker ml(pages_lock);
 
@@ -262,7 +285,7 @@ void GCCompactor::Compact(HeapPage* pages,
       tails[task_index]->set_next(heads[task_index + 1]);
     }
     tails[num_tasks - 1]->set_next(NULL);
-    heap_->old_space()->pages_tail_ = tails[num_tasks - 1];
+    tail = tails[num_tasks - 1];
 
     delete[] heads;
     delete[] tails;
@@ -272,6 +295,7 @@ void GCCompactor::Compact(HeapPage* pages,
   for (HeapPage* page = pages; page != NULL; page = page->next()) {
     page->FreeForwardingPage();
   }
+  return tail;
 }
 
 void CompactorTask::Run() {
@@ -365,6 +389,15 @@ void CompactorTask::Run() {
       }
     }
 
+    if (num_unmoved_pages_ > 0) {
+      TIMELINE_FUNCTION_GC_DURATION(thread, "ForwardUnmovedPages");
+      intptr_t index = AtomicOperations::FetchAndIncrement(next_unmoved_page_);
+      while (index < num_unmoved_pages_) {
+        ForwardUnmovedPage(unmoved_pages_[index]);
+        index = AtomicOperations::FetchAndIncrement(next_unmoved_page_);
+      }
+    }
+
     barrier_->Sync();
   }
   Thread::ExitIsolateAsHelper(true);
@@ -373,6 +406,21 @@ void CompactorTask::Run() {
   barrier_->Exit();
 }
 
+void CompactorTask::ForwardUnmovedPage(HeapPage* page) {
+  // Only marked objects: the targets of pointers in dead objects may already
+  // have been freed.
+  uword current = page->object_start();
+  uword end = page->object_end();
+  while (current < end) {
+    RawObject* obj = RawObject::FromAddr(current);
+    if (obj->IsMarked()) {
+      current += obj->VisitPointers(compactor_);
+    } else {
+      current += obj->Size();
+    }
+  }
+}
+
 void CompactorTask::PlanPage(HeapPage* page) {
   uword current = page->object_start();
   uword end = page->object_end();
@@ -31,6 +31,16 @@ class GCCompactor : public ValueObject,
 
   void Compact(HeapPage* pages, FreeList* freelist, Mutex* mutex);
 
+  // Compacts only 'pages', a chain of data pages detached from the page list.
+  // Pointers into them are also forwarded in the marked objects of
+  // 'unmoved_pages', which keep their mark bits for the sweeper. Returns the
+  // last surviving page of the chain.
+  HeapPage* CompactPages(HeapPage* pages,
+                         HeapPage** unmoved_pages,
+                         intptr_t num_unmoved_pages,
+                         FreeList* freelist,
+                         Mutex* mutex);
+
  private:
   void SetupImagePageBoundaries();
   void ForwardStackPointers();
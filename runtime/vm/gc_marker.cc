@@ -87,8 +87,8 @@ class SkippedCodeFunctions : public ZoneAllocated {
 
 class MarkerWorkList : public ValueObject {
  public:
-  explicit MarkerWorkList(MarkingStack* marking_stack)
-      : marking_stack_(marking_stack) {
+  MarkerWorkList(MarkingStack* marking_stack, intptr_t stash)
+      : marking_stack_(marking_stack), stash_(stash) {
     work_ = marking_stack_->PopEmptyBlock();
   }
 
@@ -103,11 +103,12 @@ class MarkerWorkList : public ValueObject {
     if (work_->IsEmpty()) {
       // TODO(koda): Track over/underflow events and use in heuristics to
       // distribute work and prevent degenerate flip-flopping.
-      MarkingStack::Block* new_work = marking_stack_->PopNonEmptyBlock();
+      MarkingStack::Block* new_work =
+          marking_stack_->PopNonEmptyBlock(stash_);
       if (new_work == NULL) {
         return NULL;
       }
-      marking_stack_->PushBlock(work_);
+      marking_stack_->PushBlock(work_, stash_);
       work_ = new_work;
     }
     return work_->Pop();
@@ -117,7 +118,7 @@ class MarkerWorkList : public ValueObject {
     if (work_->IsFull()) {
       // TODO(koda): Track over/underflow events and use in heuristics to
       // distribute work and prevent degenerate flip-flopping.
-      marking_stack_->PushBlock(work_);
+      marking_stack_->PushBlock(work_, stash_);
       work_ = marking_stack_->PopEmptyBlock();
     }
     work_->Push(raw_obj);
@@ -134,6 +135,8 @@ class MarkerWorkList : public ValueObject {
  private:
   MarkingStack::Block* work_;
   MarkingStack* marking_stack_;
+  // The stash of marking_stack_ used by this work list's task.
+  const intptr_t stash_;
 };
 
 template <bool sync>
@@ -142,7 +145,8 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
   MarkingVisitorBase(Isolate* isolate,
                      PageSpace* page_space,
                      MarkingStack* marking_stack,
-                     SkippedCodeFunctions* skipped_code_functions)
+                     SkippedCodeFunctions* skipped_code_functions,
+                     intptr_t stash = MarkingStack::kNoStash)
       : ObjectPointerVisitor(isolate),
         thread_(Thread::Current()),
 #ifndef PRODUCT
@@ -150,7 +154,7 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
         class_stats_size_(isolate->class_table()->NumCids()),
 #endif  // !PRODUCT
         page_space_(page_space),
-        work_list_(marking_stack),
+        work_list_(marking_stack, stash),
         delayed_weak_properties_(NULL),
         visiting_old_object_(NULL),
         skipped_code_functions_(skipped_code_functions),
@@ -193,6 +197,10 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
         // originating from this weak property.
         VisitingOldObject(cur_weak);
         cur_weak->VisitPointersNonvirtual(this);
+        // Mark everything reachable from the value now, so that weak
+        // properties further down this list whose keys it reaches are
+        // resolved in this pass instead of requiring another one.
+        DrainWorkList();
       } else {
         // Requeue this weak property to be handled later.
         EnqueueWeakProperty(cur_weak);
@@ -206,36 +214,22 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
 
   void DrainMarkingStack() {
     RawObject* raw_obj = work_list_.Pop();
-    if ((raw_obj == NULL) && ProcessPendingWeakProperties()) {
-      raw_obj = work_list_.Pop();
-    }
-
-    if (raw_obj == NULL) {
-      ASSERT(visiting_old_object_ == NULL);
-      return;
-    }
+    bool marked;
     do {
-      do {
-        // First drain the marking stacks.
-        VisitingOldObject(raw_obj);
-        const intptr_t class_id = raw_obj->GetClassId();
-        if (class_id != kWeakPropertyCid) {
-          marked_bytes_ += raw_obj->VisitPointersNonvirtual(this);
-        } else {
-          RawWeakProperty* raw_weak =
-              reinterpret_cast<RawWeakProperty*>(raw_obj);
-          marked_bytes_ += ProcessWeakProperty(raw_weak);
-        }
-        raw_obj = work_list_.Pop();
-      } while (raw_obj != NULL);
+      // First drain the marking stacks.
+      if (raw_obj != NULL) {
+        VisitObject(raw_obj);
+        DrainWorkList();
+      }
 
-      // Marking stack is empty.
-      ProcessPendingWeakProperties();
+      // Marking stack is empty. Resolving weak properties may mark the keys
+      // of weak properties that were requeued earlier in the same pass, so
+      // repeat until a pass marks nothing new.
+      marked = ProcessPendingWeakProperties();
 
-      // Check whether any further work was pushed either by other markers or
-      // by the handling of weak properties.
+      // Check whether any further work was pushed by other markers.
       raw_obj = work_list_.Pop();
-    } while (raw_obj != NULL);
+    } while (marked || (raw_obj != NULL));
     VisitingOldObject(NULL);
   }
 
@@ -245,6 +239,25 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
     }
   }
 
+  void VisitObject(RawObject* raw_obj) {
+    VisitingOldObject(raw_obj);
+    const intptr_t class_id = raw_obj->GetClassId();
+    if (class_id != kWeakPropertyCid) {
+      marked_bytes_ += raw_obj->VisitPointersNonvirtual(this);
+    } else {
+      RawWeakProperty* raw_weak = reinterpret_cast<RawWeakProperty*>(raw_obj);
+      marked_bytes_ += ProcessWeakProperty(raw_weak);
+    }
+  }
+
+  void DrainWorkList() {
+    RawObject* raw_obj = work_list_.Pop();
+    while (raw_obj != NULL) {
+      VisitObject(raw_obj);
+      raw_obj = work_list_.Pop();
+    }
+  }
+
   bool visit_function_code() const { return skipped_code_functions_ == NULL; }
 
   virtual void add_skipped_code_function(RawFunction* func) {
@@ -376,6 +389,12 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
 
   void ProcessNewSpaceObject(RawObject* raw_obj, RawObject** p) {
     // TODO(iposva): Add consistency check.
+    if ((visiting_old_object_ != NULL) &&
+        visiting_old_object_->IsCardRemembered()) {
+      // Racing markers only ever set the byte.
+      visiting_old_object_->RememberCard(p);
+      return;
+    }
     if ((visiting_old_object_ != NULL) &&
         TryAcquireRememberedBit(visiting_old_object_)) {
       // NOTE: We pass in the pointer to the address we are visiting
@@ -440,7 +459,11 @@ class MarkingWeakVisitor : public HandleVisitor {
         reinterpret_cast<FinalizablePersistentHandle*>(addr);
     RawObject* raw_obj = handle->raw();
     if (IsUnreachable(raw_obj)) {
-      handle->UpdateUnreachable(thread()->isolate());
+      if (FLAG_background_finalizers) {
+        handle->UpdateUnreachableInBackground(thread()->isolate());
+      } else {
+        handle->UpdateUnreachable(thread()->isolate());
+      }
     } else {
 #ifndef PRODUCT
       intptr_t cid = raw_obj->GetClassIdMayBeSmi();
@@ -491,20 +514,31 @@ void GCMarker::IterateWeakRoots(Isolate* isolate, HandleVisitor* visitor) {
   isolate->VisitWeakPersistentHandles(visitor);
 }
 
-void GCMarker::ProcessWeakTables(PageSpace* page_space) {
+void GCMarker::ProcessWeakTables(PageSpace* page_space,
+                                 intptr_t slice_index,
+                                 intptr_t num_slices) {
+  ASSERT(0 <= slice_index && slice_index < num_slices);
   for (int sel = 0; sel < Heap::kNumWeakSelectors; sel++) {
     WeakTable* table =
         heap_->GetWeakTable(Heap::kOld, static_cast<Heap::WeakSelector>(sel));
+    // Each slice takes a contiguous range of the table.
     intptr_t size = table->size();
-    for (intptr_t i = 0; i < size; i++) {
+    intptr_t start = (size * slice_index) / num_slices;
+    intptr_t end = (size * (slice_index + 1)) / num_slices;
+    intptr_t invalidated = 0;
+    for (intptr_t i = start; i < end; i++) {
       if (table->IsValidEntryAt(i)) {
         RawObject* raw_obj = table->ObjectAt(i);
         ASSERT(raw_obj->IsHeapObject());
         if (!raw_obj->IsMarked()) {
-          table->InvalidateAt(i);
+          table->InvalidateAtConcurrently(i);
+          invalidated++;
         }
       }
     }
+    if (invalidated > 0) {
+      table->DecrementCount(invalidated);
+    }
   }
 }
 
@@ -572,7 +606,7 @@ class MarkTask : public ThreadPool::Task {
       SkippedCodeFunctions* skipped_code_functions =
           collect_code_ ? new (zone) SkippedCodeFunctions() : NULL;
       SyncMarkingVisitor visitor(isolate_, page_space_, marking_stack_,
-                                 skipped_code_functions);
+                                 skipped_code_functions, task_index_);
       // Phase 1: Iterate over roots and drain marking stack in tasks.
       marker_->IterateRoots(isolate_, &visitor, task_index_, num_tasks_);
 
@@ -629,10 +663,14 @@ class MarkTask : public ThreadPool::Task {
         barrier_->Sync();
       } while (more_to_mark);
 
-      // Phase 2: Weak processing and follow-up marking on main thread.
+      // Phase 2: Weak handle processing on main thread.
       barrier_->Sync();
 
-      // Phase 3: Finalize results from all markers (detach code, etc.).
+      // Phase 3: Weak tables are partitioned among the tasks and the main
+      // thread, which takes the last slice.
+      marker_->ProcessWeakTables(page_space_, task_index_, num_tasks_ + 1);
+
+      // Phase 4: Finalize results from all markers (detach code, etc.).
       if (FLAG_log_marker_tasks) {
         THR_Print("Task %" Pd " marked %" Pd " bytes.\n", task_index_,
                   visitor.marked_bytes());
@@ -691,9 +729,9 @@ void GCMarker::MarkObjects(Isolate* isolate,
     Thread* thread = Thread::Current();
     StackZone stack_zone(thread);
     Zone* zone = stack_zone.GetZone();
-    MarkingStack marking_stack;
-    marked_bytes_ = 0;
     const int num_tasks = FLAG_marker_tasks;
+    MarkingStack marking_stack(num_tasks);
+    marked_bytes_ = 0;
     if (num_tasks == 0) {
       // Mark everything on main thread.
       SkippedCodeFunctions* skipped_code_functions =
@@ -707,6 +745,8 @@ void GCMarker::MarkObjects(Isolate* isolate,
         MarkingWeakVisitor mark_weak(thread);
         IterateWeakRoots(isolate, &mark_weak);
       }
+      ProcessWeakTables(page_space, 0, 1);
+      ProcessObjectIdTable(isolate);
       // All marking done; detach code, etc.
       FinalizeResultsFrom(&mark);
     } else {
@@ -743,7 +783,7 @@ void GCMarker::MarkObjects(Isolate* isolate,
         barrier.Sync();
       } while (more_to_mark);
 
-      // Phase 2: Weak processing on main thread.
+      // Phase 2: Weak handle processing on main thread.
       {
         TIMELINE_FUNCTION_GC_DURATION(thread, "WeakHandleProcessing");
         MarkingWeakVisitor mark_weak(thread);
@@ -751,11 +791,17 @@ void GCMarker::MarkObjects(Isolate* isolate,
       }
       barrier.Sync();
 
-      // Phase 3: Finalize results from all markers (detach code, etc.).
+      // Phase 3: Process the last slice of the weak tables and the object id
+      // ring while the tasks process the other slices.
+      {
+        TIMELINE_FUNCTION_GC_DURATION(thread, "WeakTableProcessing");
+        ProcessWeakTables(page_space, num_tasks, num_tasks + 1);
+        ProcessObjectIdTable(isolate);
+      }
+
+      // Phase 4: Finalize results from all markers (detach code, etc.).
       barrier.Exit();
     }
-    ProcessWeakTables(page_space);
-    ProcessObjectIdTable(isolate);
   }
   Epilogue(isolate);
 }
@@ -41,7 +41,9 @@ class GCMarker : public ValueObject {
   void IterateWeakRoots(Isolate* isolate, HandleVisitor* visitor);
   template <class MarkingVisitorType>
   void IterateWeakReferences(Isolate* isolate, MarkingVisitorType* visitor);
-  void ProcessWeakTables(PageSpace* page_space);
+  void ProcessWeakTables(PageSpace* page_space,
+                         intptr_t slice_index,
+                         intptr_t num_slices);
   void ProcessObjectIdTable(Isolate* isolate);
 
   // Called by anyone: finalize and accumulate stats from 'visitor'.
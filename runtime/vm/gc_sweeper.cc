@@ -103,17 +103,20 @@ class SweeperTask : public ThreadPool::Task {
               PageSpace* old_space,
               HeapPage* first,
               HeapPage* last,
-              FreeList* freelist)
+              HeapPage* exec_first,
+              HeapPage* exec_last,
+              HeapPage* dead_large_pages)
       : task_isolate_(isolate),
         old_space_(old_space),
         first_(first),
         last_(last),
-        freelist_(freelist) {
+        exec_first_(exec_first),
+        exec_last_(exec_last),
+        dead_large_pages_(dead_large_pages) {
     ASSERT(task_isolate_ != NULL);
-    ASSERT(first_ != NULL);
     ASSERT(old_space_ != NULL);
-    ASSERT(last_ != NULL);
-    ASSERT(freelist_ != NULL);
+    ASSERT((first_ == NULL) == (last_ == NULL));
+    ASSERT((exec_first_ == NULL) == (exec_last_ == NULL));
     MonitorLocker ml(old_space_->tasks_lock());
     old_space_->set_tasks(old_space_->tasks() + 1);
   }
@@ -125,30 +128,12 @@ class SweeperTask : public ThreadPool::Task {
     {
       Thread* thread = Thread::Current();
       TIMELINE_FUNCTION_GC_DURATION(thread, "SweeperTask");
-      GCSweeper sweeper;
-
-      HeapPage* page = first_;
-      HeapPage* prev_page = NULL;
-
-      while (page != NULL) {
-        thread->CheckForSafepoint();
-        HeapPage* next_page = page->next();
-        ASSERT(page->type() == HeapPage::kData);
-        bool page_in_use = sweeper.SweepPage(page, freelist_, false);
-        if (page_in_use) {
-          prev_page = page;
-        } else {
-          old_space_->FreePage(page, prev_page);
-        }
-        {
-          // Notify the mutator thread that we have added elements to the free
-          // list or that more capacity is available.
-          MonitorLocker ml(old_space_->tasks_lock());
-          ml.Notify();
-        }
-        if (page == last_) break;
-        page = next_page;
-      }
+      SweepPages(thread, first_, last_);
+      SweepPages(thread, exec_first_, exec_last_);
+
+      // The large pages were already unlinked and uncounted while the
+      // mutator was stopped; only their memory remains to be returned.
+      old_space_->FreePages(dead_large_pages_);
     }
     // Exit isolate cleanly *before* notifying it, to avoid shutdown race.
     Thread::ExitIsolateAsHelper();
@@ -161,19 +146,51 @@ class SweeperTask : public ThreadPool::Task {
   }
 
  private:
+  void SweepPages(Thread* thread, HeapPage* first, HeapPage* last) {
+    GCSweeper sweeper;
+
+    HeapPage* page = first;
+    HeapPage* prev_page = NULL;
+
+    while (page != NULL) {
+      thread->CheckForSafepoint();
+      HeapPage* next_page = page->next();
+      FreeList* freelist = &old_space_->freelist_[page->type()];
+      bool page_in_use = sweeper.SweepPage(page, freelist, false);
+      if (page_in_use) {
+        prev_page = page;
+      } else {
+        old_space_->FreePage(page, prev_page);
+      }
+      {
+        // Notify the mutator thread that we have added elements to the free
+        // list or that more capacity is available.
+        MonitorLocker ml(old_space_->tasks_lock());
+        ml.Notify();
+      }
+      if (page == last) break;
+      page = next_page;
+    }
+  }
+
   Isolate* task_isolate_;
   PageSpace* old_space_;
   HeapPage* first_;
   HeapPage* last_;
-  FreeList* freelist_;
+  HeapPage* exec_first_;
+  HeapPage* exec_last_;
+  HeapPage* dead_large_pages_;
 };
 
 void GCSweeper::SweepConcurrent(Isolate* isolate,
                                 HeapPage* first,
                                 HeapPage* last,
-                                FreeList* freelist) {
-  SweeperTask* task = new SweeperTask(isolate, isolate->heap()->old_space(),
-                                      first, last, freelist);
+                                HeapPage* exec_first,
+                                HeapPage* exec_last,
+                                HeapPage* dead_large_pages) {
+  SweeperTask* task =
+      new SweeperTask(isolate, isolate->heap()->old_space(), first, last,
+                      exec_first, exec_last, dead_large_pages);
   ThreadPool* pool = Dart::thread_pool();
   pool->Run(task);
 }
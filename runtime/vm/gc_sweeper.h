@@ -34,11 +34,16 @@ class GCSweeper {
   // last marked object.
   intptr_t SweepLargePage(HeapPage* page);
 
-  // Sweep the regular sized data pages between first and last inclusive.
+  // Sweep the regular sized data pages between first and last inclusive and
+  // the executable pages between exec_first and exec_last inclusive, then
+  // release the unreachable large pages chained from dead_large_pages. Each
+  // of these may be NULL if there is nothing to do.
   static void SweepConcurrent(Isolate* isolate,
                               HeapPage* first,
                               HeapPage* last,
-                              FreeList* freelist);
+                              HeapPage* exec_first,
+                              HeapPage* exec_last,
+                              HeapPage* dead_large_pages);
 };
 
 }  // namespace dart
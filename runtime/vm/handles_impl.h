@@ -66,10 +66,18 @@ void Handles<kHandleSizeInWords, kHandlesPerChunk, kOffsetOfRawPtr>::Reset() {
     zone_blocks_->ReInit();
   }
 
-  // Delete all the extra scoped handle blocks allocated and reinit the first
-  // scoped block.
-  DeleteHandleBlocks(first_scoped_block_.next_block());
+  // Delete all but one of the extra scoped handle blocks allocated and reinit
+  // the first scoped block. The spare block is kept so that a reused scope
+  // which regularly overflows the first block (e.g. an API scope of a native
+  // call creating many local handles) does not allocate and free a block
+  // every time. SetupNextScopeBlock picks it up again.
+  HandlesBlock* spare_block = first_scoped_block_.next_block();
+  if (spare_block != NULL) {
+    DeleteHandleBlocks(spare_block->next_block());
+    spare_block->ReInit();
+  }
   first_scoped_block_.ReInit();
+  first_scoped_block_.set_next_block(spare_block);
   scoped_blocks_ = &first_scoped_block_;
 }
 
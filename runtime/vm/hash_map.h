@@ -10,26 +10,23 @@
 
 namespace dart {
 
+// An open-addressed hash map using linear probing. Pairs are stored directly
+// in a single power-of-two sized array, so lookups touch consecutive memory
+// instead of following collision chains. A slot is empty when the value of
+// the pair stored in it equals the value of a default constructed pair.
 template <typename KeyValueTrait, typename B, typename Allocator = Zone>
 class BaseDirectChainedHashMap : public B {
  public:
   explicit BaseDirectChainedHashMap(Allocator* allocator)
-      : array_size_(0),
-        lists_size_(0),
-        count_(0),
-        array_(NULL),
-        lists_(NULL),
-        free_list_head_(kNil),
-        allocator_(allocator) {
-    ResizeLists(kInitialSize);
+      : array_size_(0), count_(0), array_(NULL), allocator_(allocator) {
     Resize(kInitialSize);
   }
 
   BaseDirectChainedHashMap(const BaseDirectChainedHashMap& other);
 
   virtual ~BaseDirectChainedHashMap() {
-    allocator_->template Free<HashMapListElement>(array_, array_size_);
-    allocator_->template Free<HashMapListElement>(lists_, lists_size_);
+    allocator_->template Free<typename KeyValueTrait::Pair>(array_,
+                                                            array_size_);
   }
 
   void Insert(typename KeyValueTrait::Pair kv);
@@ -49,12 +46,6 @@ class BaseDirectChainedHashMap : public B {
     if (!IsEmpty()) {
       count_ = 0;
       InitArray(array_, array_size_);
-      InitArray(lists_, lists_size_);
-      lists_[0].next = kNil;
-      for (intptr_t i = 1; i < lists_size_; ++i) {
-        lists_[i].next = i - 1;
-      }
-      free_list_head_ = lists_size_ - 1;
     }
   }
 
@@ -62,18 +53,14 @@ class BaseDirectChainedHashMap : public B {
    public:
     typename KeyValueTrait::Pair* Next();
 
-    void Reset() {
-      array_index_ = 0;
-      list_index_ = kNil;
-    }
+    void Reset() { array_index_ = 0; }
 
    private:
     explicit Iterator(const BaseDirectChainedHashMap& map)
-        : map_(map), array_index_(0), list_index_(kNil) {}
+        : map_(map), array_index_(0) {}
 
     const BaseDirectChainedHashMap& map_;
     intptr_t array_index_;
-    intptr_t list_index_;
 
     template <typename T, typename Bs, typename A>
     friend class BaseDirectChainedHashMap;
@@ -82,34 +69,40 @@ class BaseDirectChainedHashMap : public B {
   Iterator GetIterator() const { return Iterator(*this); }
 
  protected:
-  // A linked list of T values.  Stored in arrays.
-  struct HashMapListElement {
-    HashMapListElement() : kv(), next(kNil) {}
-    typename KeyValueTrait::Pair kv;
-    intptr_t next;  // Index in the array of the next list element.
-  };
-  static const intptr_t kNil = -1;  // The end of a linked list
-
-  static void InitArray(HashMapListElement* array, intptr_t size) {
+  static void InitArray(typename KeyValueTrait::Pair* array, intptr_t size) {
     for (intptr_t i = 0; i < size; ++i) {
-      array[i] = HashMapListElement();
+      array[i] = typename KeyValueTrait::Pair();
     }
   }
 
+  static bool IsEmptySlot(const typename KeyValueTrait::Pair& kv) {
+    return KeyValueTrait::ValueOf(kv) ==
+           KeyValueTrait::ValueOf(typename KeyValueTrait::Pair());
+  }
+
   // Must be a power of 2.
   static const intptr_t kInitialSize = 16;
 
   void Resize(intptr_t new_size);
-  void ResizeLists(intptr_t new_size);
-  uword Bound(uword value) const { return value & (array_size_ - 1); }
+
+  // Mixes the hash before masking it so that keys which only differ in their
+  // high bits (e.g. aligned pointers) do not form long probe sequences.
+  uword Bound(uword value) const {
+    value ^= value >> 16;
+    value *= 0x45d9f3b;
+    value ^= value >> 16;
+    return value & (array_size_ - 1);
+  }
+  uword Next(uword pos) const { return (pos + 1) & (array_size_ - 1); }
+
+  uword HomeOf(const typename KeyValueTrait::Pair& kv) const {
+    return Bound(
+        static_cast<uword>(KeyValueTrait::Hashcode(KeyValueTrait::KeyOf(kv))));
+  }
 
   intptr_t array_size_;
-  intptr_t lists_size_;
-  intptr_t count_;             // The number of values stored in the HashMap.
-  HashMapListElement* array_;  // Primary store - contains the first value
-  // with a given hash.  Colliding elements are stored in linked lists.
-  HashMapListElement* lists_;  // The linked lists containing hash collisions.
-  intptr_t free_list_head_;  // Unused elements in lists_ are on the free list.
+  intptr_t count_;  // The number of values stored in the HashMap.
+  typename KeyValueTrait::Pair* array_;
   Allocator* allocator_;
 };
 
@@ -118,38 +111,22 @@ BaseDirectChainedHashMap<KeyValueTrait, B, Allocator>::BaseDirectChainedHashMap(
     const BaseDirectChainedHashMap& other)
     : B(),
       array_size_(other.array_size_),
-      lists_size_(other.lists_size_),
       count_(other.count_),
-      array_(other.allocator_->template Alloc<HashMapListElement>(
+      array_(other.allocator_->template Alloc<typename KeyValueTrait::Pair>(
           other.array_size_)),
-      lists_(other.allocator_->template Alloc<HashMapListElement>(
-          other.lists_size_)),
-      free_list_head_(other.free_list_head_),
       allocator_(other.allocator_) {
-  memmove(array_, other.array_, array_size_ * sizeof(HashMapListElement));
-  memmove(lists_, other.lists_, lists_size_ * sizeof(HashMapListElement));
+  memmove(array_, other.array_,
+          array_size_ * sizeof(typename KeyValueTrait::Pair));
 }
 
 template <typename KeyValueTrait, typename B, typename Allocator>
 typename KeyValueTrait::Pair*
 BaseDirectChainedHashMap<KeyValueTrait, B, Allocator>::Lookup(
     typename KeyValueTrait::Key key) const {
-  const typename KeyValueTrait::Value kNoValue =
-      KeyValueTrait::ValueOf(typename KeyValueTrait::Pair());
-
   uword hash = static_cast<uword>(KeyValueTrait::Hashcode(key));
-  uword pos = Bound(hash);
-  if (KeyValueTrait::ValueOf(array_[pos].kv) != kNoValue) {
-    if (KeyValueTrait::IsKeyEqual(array_[pos].kv, key)) {
-      return &array_[pos].kv;
-    }
-
-    intptr_t next = array_[pos].next;
-    while (next != kNil) {
-      if (KeyValueTrait::IsKeyEqual(lists_[next].kv, key)) {
-        return &lists_[next].kv;
-      }
-      next = lists_[next].next;
+  for (uword pos = Bound(hash); !IsEmptySlot(array_[pos]); pos = Next(pos)) {
+    if (KeyValueTrait::IsKeyEqual(array_[pos], key)) {
+      return &array_[pos];
     }
   }
   return NULL;
@@ -168,57 +145,26 @@ BaseDirectChainedHashMap<KeyValueTrait, B, Allocator>::LookupValue(
 template <typename KeyValueTrait, typename B, typename Allocator>
 typename KeyValueTrait::Pair*
 BaseDirectChainedHashMap<KeyValueTrait, B, Allocator>::Iterator::Next() {
-  const typename KeyValueTrait::Value kNoValue =
-      KeyValueTrait::ValueOf(typename KeyValueTrait::Pair());
-
-  if (array_index_ < map_.array_size_) {
-    // If we're not in the middle of a list, find the next array slot.
-    if (list_index_ == kNil) {
-      while ((array_index_ < map_.array_size_) &&
-             KeyValueTrait::ValueOf(map_.array_[array_index_].kv) == kNoValue) {
-        array_index_++;
-      }
-      if (array_index_ < map_.array_size_) {
-        // When we're done with the list, we'll continue with the next array
-        // slot.
-        const intptr_t old_array_index = array_index_;
-        array_index_++;
-        list_index_ = map_.array_[old_array_index].next;
-        return &map_.array_[old_array_index].kv;
-      } else {
-        return NULL;
-      }
+  while (array_index_ < map_.array_size_) {
+    const intptr_t current = array_index_++;
+    if (!IsEmptySlot(map_.array_[current])) {
+      return &map_.array_[current];
     }
-
-    // Otherwise, return the current lists_ entry, advancing list_index_.
-    intptr_t current = list_index_;
-    list_index_ = map_.lists_[current].next;
-    return &map_.lists_[current].kv;
   }
-
   return NULL;
 }
 
 template <typename KeyValueTrait, typename B, typename Allocator>
 void BaseDirectChainedHashMap<KeyValueTrait, B, Allocator>::Resize(
     intptr_t new_size) {
-  const typename KeyValueTrait::Value kNoValue =
-      KeyValueTrait::ValueOf(typename KeyValueTrait::Pair());
-
   ASSERT(new_size > count_);
-  // Hashing the values into the new array has no more collisions than in the
-  // old hash map, so we can use the existing lists_ array, if we are careful.
+  ASSERT(Utils::IsPowerOfTwo(new_size));
 
-  // Make sure we have at least one free element.
-  if (free_list_head_ == kNil) {
-    ResizeLists(lists_size_ << 1);
-  }
-
-  HashMapListElement* new_array =
-      allocator_->template Alloc<HashMapListElement>(new_size);
+  typename KeyValueTrait::Pair* new_array =
+      allocator_->template Alloc<typename KeyValueTrait::Pair>(new_size);
   InitArray(new_array, new_size);
 
-  HashMapListElement* old_array = array_;
+  typename KeyValueTrait::Pair* old_array = array_;
   intptr_t old_size = array_size_;
 
   intptr_t old_count = count_;
@@ -227,140 +173,63 @@ void BaseDirectChainedHashMap<KeyValueTrait, B, Allocator>::Resize(
   array_ = new_array;
 
   if (old_array != NULL) {
-    // Iterate over all the elements in lists, rehashing them.
     for (intptr_t i = 0; i < old_size; ++i) {
-      if (KeyValueTrait::ValueOf(old_array[i].kv) != kNoValue) {
-        intptr_t current = old_array[i].next;
-        while (current != kNil) {
-          Insert(lists_[current].kv);
-          intptr_t next = lists_[current].next;
-          lists_[current].next = free_list_head_;
-          free_list_head_ = current;
-          current = next;
-        }
-        // Rehash the directly stored value.
-        Insert(old_array[i].kv);
+      if (!IsEmptySlot(old_array[i])) {
+        Insert(old_array[i]);
       }
     }
   }
   USE(old_count);
   ASSERT(count_ == old_count);
-  allocator_->template Free<HashMapListElement>(old_array, old_size);
-}
-
-template <typename KeyValueTrait, typename B, typename Allocator>
-void BaseDirectChainedHashMap<KeyValueTrait, B, Allocator>::ResizeLists(
-    intptr_t new_size) {
-  ASSERT(new_size > lists_size_);
-
-  HashMapListElement* new_lists =
-      allocator_->template Alloc<HashMapListElement>(new_size);
-  InitArray(new_lists, new_size);
-
-  HashMapListElement* old_lists = lists_;
-  intptr_t old_size = lists_size_;
-
-  lists_size_ = new_size;
-  lists_ = new_lists;
-
-  if (old_lists != NULL) {
-    memmove(lists_, old_lists, old_size * sizeof(HashMapListElement));
-  }
-  for (intptr_t i = old_size; i < lists_size_; ++i) {
-    lists_[i].next = free_list_head_;
-    free_list_head_ = i;
-  }
-  allocator_->template Free<HashMapListElement>(old_lists, old_size);
+  allocator_->template Free<typename KeyValueTrait::Pair>(old_array, old_size);
 }
 
 template <typename KeyValueTrait, typename B, typename Allocator>
 void BaseDirectChainedHashMap<KeyValueTrait, B, Allocator>::Insert(
     typename KeyValueTrait::Pair kv) {
-  const typename KeyValueTrait::Value kNoValue =
-      KeyValueTrait::ValueOf(typename KeyValueTrait::Pair());
-
-  ASSERT(KeyValueTrait::ValueOf(kv) != kNoValue);
+  ASSERT(!IsEmptySlot(kv));
   // Resizing when half of the hashtable is filled up.
   if (count_ >= array_size_ >> 1) Resize(array_size_ << 1);
   ASSERT(count_ < array_size_);
   count_++;
-  uword pos = Bound(
-      static_cast<uword>(KeyValueTrait::Hashcode(KeyValueTrait::KeyOf(kv))));
-  if (KeyValueTrait::ValueOf(array_[pos].kv) == kNoValue) {
-    array_[pos].kv = kv;
-    array_[pos].next = kNil;
-  } else {
-    if (free_list_head_ == kNil) {
-      ResizeLists(lists_size_ << 1);
-    }
-    intptr_t new_element_pos = free_list_head_;
-    ASSERT(new_element_pos != kNil);
-    free_list_head_ = lists_[free_list_head_].next;
-    lists_[new_element_pos].kv = kv;
-    lists_[new_element_pos].next = array_[pos].next;
-    ASSERT(array_[pos].next == kNil ||
-           KeyValueTrait::ValueOf(lists_[array_[pos].next].kv) != kNoValue);
-    array_[pos].next = new_element_pos;
+  uword pos = HomeOf(kv);
+  while (!IsEmptySlot(array_[pos])) {
+    pos = Next(pos);
   }
+  array_[pos] = kv;
 }
 
 template <typename KeyValueTrait, typename B, typename Allocator>
 bool BaseDirectChainedHashMap<KeyValueTrait, B, Allocator>::Remove(
     typename KeyValueTrait::Key key) {
   uword pos = Bound(static_cast<uword>(KeyValueTrait::Hashcode(key)));
-
-  // Check to see if the first element in the bucket is the one we want to
-  // remove.
-  if (KeyValueTrait::KeyOf(array_[pos].kv) == key) {
-    if (array_[pos].next == kNil) {
-      array_[pos] = HashMapListElement();
-    } else {
-      intptr_t next = array_[pos].next;
-      array_[pos] = lists_[next];
-      lists_[next] = HashMapListElement();
-      lists_[next].next = free_list_head_;
-      free_list_head_ = next;
+  while (KeyValueTrait::KeyOf(array_[pos]) != key) {
+    if (IsEmptySlot(array_[pos])) {
+      // Could not find entry with provided key to remove.
+      return false;
     }
-    count_--;
-    return true;
+    pos = Next(pos);
   }
-
-  intptr_t current = array_[pos].next;
-
-  // If there's only the single element in the bucket and it does not match the
-  // key to be removed, just return.
-  if (current == kNil) {
+  if (IsEmptySlot(array_[pos])) {
     return false;
   }
 
-  // Check the case where the second element in the bucket is the one to be
-  // removed.
-  if (KeyValueTrait::KeyOf(lists_[current].kv) == key) {
-    array_[pos].next = lists_[current].next;
-    lists_[current] = HashMapListElement();
-    lists_[current].next = free_list_head_;
-    free_list_head_ = current;
-    count_--;
-    return true;
-  }
-
-  // Finally, iterate through the rest of the bucket to see if we can find the
-  // entry that matches our key.
-  intptr_t previous;
-  while (KeyValueTrait::KeyOf(lists_[current].kv) != key) {
-    previous = current;
-    current = lists_[current].next;
-
-    if (current == kNil) {
-      // Could not find entry with provided key to remove.
-      return false;
+  // Shift later entries of the probe sequence back into the hole so that
+  // lookups never need tombstones: an entry may move into the hole only if
+  // its home slot does not lie cyclically in (hole, current].
+  uword hole = pos;
+  for (uword current = Next(pos); !IsEmptySlot(array_[current]);
+       current = Next(current)) {
+    const uword home = HomeOf(array_[current]);
+    const bool home_in_range = (hole <= current)
+                                   ? ((hole < home) && (home <= current))
+                                   : ((hole < home) || (home <= current));
+    if (!home_in_range) {
+      array_[hole] = array_[current];
+      hole = current;
     }
   }
-
-  lists_[previous].next = lists_[current].next;
-  lists_[current] = HashMapListElement();
-  lists_[current].next = free_list_head_;
-  free_list_head_ = current;
+  array_[hole] = typename KeyValueTrait::Pair();
   count_--;
   return true;
 }
@@ -96,6 +96,33 @@ TEST_CASE(DirectChainedHashMapInsertRemove) {
   EXPECT(map.IsEmpty());
 }
 
+TEST_CASE(DirectChainedHashMapRemoveColliding) {
+  DirectChainedHashMap<PointerKeyValueTrait<TestValue> > map;
+  const intptr_t kCount = 64;
+  TestValue* values[kCount];
+  for (intptr_t i = 0; i < kCount; i++) {
+    values[i] = new TestValue(i);  // Only two distinct hash codes.
+    map.Insert(values[i]);
+  }
+  // Remove every third value and check that the remaining ones, which share
+  // their probe sequences with the removed ones, can still be found.
+  for (intptr_t i = 0; i < kCount; i += 3) {
+    EXPECT(map.Remove(values[i]));
+  }
+  for (intptr_t i = 0; i < kCount; i++) {
+    if ((i % 3) == 0) {
+      EXPECT(map.Lookup(values[i]) == NULL);
+    } else {
+      EXPECT(map.LookupValue(values[i]) == values[i]);
+    }
+  }
+  for (intptr_t i = 0; i < kCount; i++) {
+    EXPECT(map.Remove(values[i]) == ((i % 3) != 0));
+    delete values[i];
+  }
+  EXPECT(map.IsEmpty());
+}
+
 TEST_CASE(MallocDirectChainedHashMap) {
   MallocDirectChainedHashMap<PointerKeyValueTrait<TestValue> > map;
   EXPECT(map.IsEmpty());
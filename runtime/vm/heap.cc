@@ -6,6 +6,8 @@
 
 #include "platform/assert.h"
 #include "platform/utils.h"
+#include "vm/dart.h"
+#include "vm/dart_api_state.h"
 #include "vm/flags.h"
 #include "vm/isolate.h"
 #include "vm/lockers.h"
@@ -21,6 +23,7 @@
 #include "vm/service_isolate.h"
 #include "vm/stack_frame.h"
 #include "vm/tags.h"
+#include "vm/thread_barrier.h"
 #include "vm/thread_pool.h"
 #include "vm/timeline.h"
 #include "vm/verifier.h"
@@ -40,7 +43,11 @@ Heap::Heap(Isolate* isolate,
       barrier_done_(new Monitor()),
       read_only_(false),
       gc_new_space_in_progress_(false),
-      gc_old_space_in_progress_(false) {
+      gc_old_space_in_progress_(false),
+      background_idle_gc_in_progress_(false),
+      pending_finalizers_(NULL),
+      scheduled_finalizers_(NULL),
+      background_finalizers_running_(false) {
   UpdateGlobalMaxUsed();
   for (int sel = 0; sel < kNumWeakSelectors; sel++) {
     new_weak_tables_[sel] = new WeakTable();
@@ -50,6 +57,16 @@ Heap::Heap(Isolate* isolate,
 }
 
 Heap::~Heap() {
+  {
+    // The background idle GC task touches the heap after leaving the isolate,
+    // and the finalizer task never enters it.
+    MonitorLocker ml(&gc_in_progress_monitor_);
+    while (background_idle_gc_in_progress_ || background_finalizers_running_) {
+      ml.Wait();
+    }
+  }
+  delete pending_finalizers_;
+  delete scheduled_finalizers_;
   delete barrier_;
   delete barrier_done_;
 
@@ -80,13 +97,20 @@ uword Heap::AllocateNew(intptr_t size) {
 
 uword Heap::AllocateOld(intptr_t size, HeapPage::PageType type) {
   ASSERT(Thread::Current()->no_safepoint_scope_depth() == 0);
-  uword addr = old_space_.TryAllocate(size, type);
+  Thread* thread = Thread::Current();
+  uword addr = 0;
+  if ((type == HeapPage::kData) && (thread->heap() == this)) {
+    addr = old_space_.TryAllocateInTLAB(thread, size);
+    if (addr != 0) {
+      return addr;
+    }
+  }
+  addr = old_space_.TryAllocate(size, type);
   if (addr != 0) {
     return addr;
   }
   // If we are in the process of running a sweep, wait for the sweeper to free
   // memory.
-  Thread* thread = Thread::Current();
   if (thread->CanCollectGarbage()) {
     // Wait for any GC tasks that are in progress.
     WaitForSweeperTasks(thread);
@@ -130,9 +154,8 @@ void Heap::AllocateExternal(intptr_t cid, intptr_t size, Space space) {
   if (space == kNew) {
     isolate()->AssertCurrentThreadIsMutator();
     new_space_.AllocateExternal(cid, size);
-    if (new_space_.ExternalInWords() > (FLAG_new_gen_ext_limit * MBInWords)) {
-      // Attempt to free some external allocation by a scavenge. (If the total
-      // remains above the limit, next external alloc will trigger another.)
+    if (new_space_.NeedsExternalGC()) {
+      // Attempt to free some external allocation by a scavenge.
       CollectGarbage(kNew);
     }
   } else {
@@ -192,6 +215,89 @@ void Heap::VisitObjectsImagePages(ObjectVisitor* visitor) const {
   old_space_.VisitObjectsImagePages(visitor);
 }
 
+// Visits the pages claimed through 'next_page' until there are none left.
+static void VisitClaimedPages(HeapPage* const* pages,
+                              intptr_t num_pages,
+                              intptr_t* next_page,
+                              ObjectVisitor* visitor) {
+  intptr_t index = AtomicOperations::FetchAndIncrement(next_page);
+  while (index < num_pages) {
+    pages[index]->VisitObjects(visitor);
+    index = AtomicOperations::FetchAndIncrement(next_page);
+  }
+}
+
+class ParallelVisitTask : public ThreadPool::Task {
+ public:
+  ParallelVisitTask(Isolate* isolate,
+                    ThreadBarrier* barrier,
+                    HeapPage* const* pages,
+                    intptr_t num_pages,
+                    intptr_t* next_page,
+                    ObjectVisitor* visitor)
+      : isolate_(isolate),
+        barrier_(barrier),
+        pages_(pages),
+        num_pages_(num_pages),
+        next_page_(next_page),
+        visitor_(visitor) {}
+
+  virtual void Run() {
+    bool result = Thread::EnterIsolateAsHelper(
+        isolate_, Thread::kHeapIterationTask, true);
+    ASSERT(result);
+    {
+      Thread* thread = Thread::Current();
+      TIMELINE_FUNCTION_GC_DURATION(thread, "ParallelVisitTask");
+      VisitClaimedPages(pages_, num_pages_, next_page_, visitor_);
+    }
+    Thread::ExitIsolateAsHelper(true);
+    barrier_->Exit();
+  }
+
+ private:
+  Isolate* isolate_;
+  ThreadBarrier* barrier_;
+  HeapPage* const* pages_;
+  const intptr_t num_pages_;
+  intptr_t* next_page_;
+  ObjectVisitor* visitor_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelVisitTask);
+};
+
+void Heap::VisitObjectsParallel(ObjectVisitor** visitors,
+                                intptr_t num_visitors) const {
+  VisitPagesParallel(visitors, num_visitors, true);
+}
+
+void Heap::VisitObjectsNoImagePagesParallel(ObjectVisitor** visitors,
+                                            intptr_t num_visitors) const {
+  VisitPagesParallel(visitors, num_visitors, false);
+}
+
+void Heap::VisitPagesParallel(ObjectVisitor** visitors,
+                              intptr_t num_visitors,
+                              bool include_image_pages) const {
+  RELEASE_ASSERT(num_visitors >= 1);
+  MallocGrowableArray<HeapPage*> pages;
+  old_space_.CollectPages(&pages, include_image_pages);
+  if (num_visitors > pages.length()) {
+    num_visitors = Utils::Maximum<intptr_t>(pages.length(), 1);
+  }
+  intptr_t next_page = 0;
+  ThreadBarrier barrier(num_visitors, barrier_, barrier_done_);
+  for (intptr_t i = 1; i < num_visitors; i++) {
+    Dart::thread_pool()->Run(
+        new ParallelVisitTask(isolate(), &barrier, pages.data(),
+                              pages.length(), &next_page, visitors[i]));
+  }
+  // The new space is a single region; visit it here while the tasks start.
+  new_space_.VisitObjects(visitors[0]);
+  VisitClaimedPages(pages.data(), pages.length(), &next_page, visitors[0]);
+  barrier.Exit();
+}
+
 HeapIterationScope::HeapIterationScope(Thread* thread, bool writable)
     : StackResource(thread),
       heap_(isolate()->heap()),
@@ -258,6 +364,11 @@ void HeapIterationScope::IterateOldObjectsNoImagePages(
   old_space_->VisitObjectsNoImagePages(visitor);
 }
 
+void HeapIterationScope::IterateObjectsParallel(ObjectVisitor** visitors,
+                                                intptr_t num_visitors) const {
+  heap_->VisitObjectsParallel(visitors, num_visitors);
+}
+
 void HeapIterationScope::IterateVMIsolateObjects(ObjectVisitor* visitor) const {
   Dart::vm_isolate()->heap()->VisitObjects(visitor);
 }
@@ -323,10 +434,17 @@ bool Heap::BeginNewSpaceGC(Thread* thread) {
 }
 
 void Heap::EndNewSpaceGC() {
-  MonitorLocker ml(&gc_in_progress_monitor_);
-  ASSERT(gc_new_space_in_progress_);
-  gc_new_space_in_progress_ = false;
-  ml.NotifyAll();
+  bool start_finalizers = false;
+  {
+    MonitorLocker ml(&gc_in_progress_monitor_);
+    ASSERT(gc_new_space_in_progress_);
+    gc_new_space_in_progress_ = false;
+    start_finalizers = ScheduleFinalizersLocked();
+    ml.NotifyAll();
+  }
+  if (start_finalizers) {
+    StartBackgroundFinalizers();
+  }
 }
 
 bool Heap::BeginOldSpaceGC(Thread* thread) {
@@ -344,9 +462,131 @@ bool Heap::BeginOldSpaceGC(Thread* thread) {
 }
 
 void Heap::EndOldSpaceGC() {
+  bool start_finalizers = false;
+  {
+    MonitorLocker ml(&gc_in_progress_monitor_);
+    ASSERT(gc_old_space_in_progress_);
+    gc_old_space_in_progress_ = false;
+    start_finalizers = ScheduleFinalizersLocked();
+    ml.NotifyAll();
+  }
+  if (start_finalizers) {
+    StartBackgroundFinalizers();
+  }
+}
+
+FinalizerBatch* Heap::pending_finalizers() {
+  if (pending_finalizers_ == NULL) {
+    pending_finalizers_ = new FinalizerBatch();
+  }
+  return pending_finalizers_;
+}
+
+bool Heap::ScheduleFinalizersLocked() {
+  if ((pending_finalizers_ == NULL) || pending_finalizers_->IsEmpty()) {
+    return false;
+  }
+  if (scheduled_finalizers_ == NULL) {
+    scheduled_finalizers_ = pending_finalizers_;
+    pending_finalizers_ = NULL;
+  } else {
+    scheduled_finalizers_->TakeAll(pending_finalizers_);
+  }
+  if (background_finalizers_running_) {
+    // The running task picks up the new batch when it is done.
+    return false;
+  }
+  background_finalizers_running_ = true;
+  return true;
+}
+
+class BackgroundFinalizerTask : public ThreadPool::Task {
+ public:
+  explicit BackgroundFinalizerTask(Heap* heap) : heap_(heap) {}
+
+  virtual void Run() { heap_->RunBackgroundFinalizers(); }
+
+ private:
+  Heap* heap_;
+
+  DISALLOW_COPY_AND_ASSIGN(BackgroundFinalizerTask);
+};
+
+void Heap::StartBackgroundFinalizers() {
+  Dart::thread_pool()->Run(new BackgroundFinalizerTask(this));
+}
+
+void Heap::RunBackgroundFinalizers() {
+  // The isolate outlives this task: shutdown waits for it before running the
+  // cleanup callback, so the callback data stays valid.
+  void* isolate_callback_data = isolate()->init_callback_data();
+  while (true) {
+    FinalizerBatch* batch = NULL;
+    {
+      MonitorLocker ml(&gc_in_progress_monitor_);
+      batch = scheduled_finalizers_;
+      scheduled_finalizers_ = NULL;
+      if (batch == NULL) {
+        background_finalizers_running_ = false;
+        ml.NotifyAll();
+        return;
+      }
+    }
+    batch->Run(isolate_callback_data);
+    delete batch;
+  }
+}
+
+void Heap::WaitForBackgroundFinalizers() {
+  MonitorLocker ml(&gc_in_progress_monitor_);
+  while (background_finalizers_running_) {
+    ml.Wait();
+  }
+}
+
+class BackgroundIdleGCTask : public ThreadPool::Task {
+ public:
+  explicit BackgroundIdleGCTask(Isolate* isolate) : isolate_(isolate) {}
+
+  virtual void Run() {
+    Heap* heap = isolate_->heap();
+    bool result = Thread::EnterIsolateAsHelper(isolate_, Thread::kMarkerTask);
+    ASSERT(result);
+    {
+      Thread* thread = Thread::Current();
+      // Nothing to gain if the isolate got busy again before we started: the
+      // mutator would have to stop for the whole collection.
+      if (!isolate_->IsMutatorThreadScheduled()) {
+        TIMELINE_FUNCTION_GC_DURATION(thread, "BackgroundIdleGC");
+        heap->CollectOldSpaceGarbage(thread, Heap::kIdle);
+      }
+    }
+    // Exit isolate cleanly *before* notifying it, to avoid shutdown race.
+    Thread::ExitIsolateAsHelper();
+    heap->EndBackgroundIdleGC();
+  }
+
+ private:
+  Isolate* isolate_;
+
+  DISALLOW_COPY_AND_ASSIGN(BackgroundIdleGCTask);
+};
+
+void Heap::StartBackgroundIdleGC() {
+  {
+    MonitorLocker ml(&gc_in_progress_monitor_);
+    if (background_idle_gc_in_progress_ || gc_old_space_in_progress_) {
+      return;
+    }
+    background_idle_gc_in_progress_ = true;
+  }
+  Dart::thread_pool()->Run(new BackgroundIdleGCTask(isolate()));
+}
+
+void Heap::EndBackgroundIdleGC() {
   MonitorLocker ml(&gc_in_progress_monitor_);
-  ASSERT(gc_old_space_in_progress_);
-  gc_old_space_in_progress_ = false;
+  ASSERT(background_idle_gc_in_progress_);
+  background_idle_gc_in_progress_ = false;
   ml.NotifyAll();
 }
 
@@ -365,11 +605,22 @@ void Heap::NotifyIdle(int64_t deadline) {
   } else if (old_space_.ShouldPerformIdleMarkSweep(deadline)) {
     TIMELINE_FUNCTION_GC_DURATION(thread, "IdleGC");
     CollectOldSpaceGarbage(thread, kIdle);
+  } else if (FLAG_background_idle_gc &&
+             old_space_.ShouldPerformBackgroundIdleMarkSweep()) {
+    // The mark-sweep would overrun the deadline. The idle isolate is about to
+    // deschedule its mutator, so run the collection on a helper thread
+    // instead; the mutator only pauses if it is needed again before the
+    // collection is done.
+    StartBackgroundIdleGC();
   }
+  // Spend what is left of the idle time returning free memory to the OS. A
+  // long release is spread over several idle notifications.
+  old_space_.ReleaseIdleMemory(false, deadline);
 }
 
 void Heap::NotifyLowMemory() {
   CollectAllGarbage(kLowMemory);
+  old_space_.ReleaseIdleMemory(true);
 }
 
 void Heap::EvacuateNewSpace(Thread* thread, GCReason reason) {
@@ -493,6 +744,17 @@ bool Heap::GrowthControlState() {
   return old_space_.GrowthControlState();
 }
 
+void Heap::SetGCGoals(int64_t max_pause_micros, intptr_t max_gc_time_percent) {
+  new_space_.SetGoals(max_pause_micros, max_gc_time_percent);
+  old_space_.SetGoals(max_pause_micros, static_cast<int>(max_gc_time_percent));
+}
+
+void Heap::SetMaxCapacity(intptr_t max_new_gen_semi_words,
+                          intptr_t max_old_gen_words) {
+  new_space_.SetMaxSemiCapacityInWords(max_new_gen_semi_words);
+  old_space_.SetMaxCapacityInWords(max_old_gen_words);
+}
+
 void Heap::WriteProtect(bool read_only) {
   read_only_ = read_only;
   new_space_.WriteProtect(read_only);
@@ -543,9 +805,20 @@ ObjectSet* Heap::CreateAllocatedObjectSet(
 
   this->AddRegionsToObjectSet(allocated_set);
   {
-    VerifyObjectVisitor object_visitor(isolate(), allocated_set,
-                                       mark_expectation);
-    this->VisitObjectsNoImagePages(&object_visitor);
+    // Each page has its own region in the set, so the visitors never add to
+    // the same bit vector.
+    const intptr_t num_visitors = FLAG_heap_iteration_tasks;
+    RELEASE_ASSERT(num_visitors >= 1);
+    ObjectVisitor** visitors = new ObjectVisitor*[num_visitors];
+    for (intptr_t i = 0; i < num_visitors; i++) {
+      visitors[i] =
+          new VerifyObjectVisitor(isolate(), allocated_set, mark_expectation);
+    }
+    this->VisitObjectsNoImagePagesParallel(visitors, num_visitors);
+    for (intptr_t i = 0; i < num_visitors; i++) {
+      delete visitors[i];
+    }
+    delete[] visitors;
   }
   {
     VerifyObjectVisitor object_visitor(isolate(), allocated_set,
@@ -578,8 +851,17 @@ bool Heap::VerifyGC(MarkExpectation mark_expectation) const {
 
   ObjectSet* allocated_set =
       CreateAllocatedObjectSet(stack_zone.GetZone(), mark_expectation);
-  VerifyPointersVisitor visitor(isolate(), allocated_set);
-  VisitObjectPointers(&visitor);
+  const intptr_t num_visitors = FLAG_heap_iteration_tasks;
+  RELEASE_ASSERT(num_visitors >= 1);
+  ObjectVisitor** visitors = new ObjectVisitor*[num_visitors];
+  for (intptr_t i = 0; i < num_visitors; i++) {
+    visitors[i] = new VerifyObjectPointersVisitor(isolate(), allocated_set);
+  }
+  VisitObjectsParallel(visitors, num_visitors);
+  for (intptr_t i = 0; i < num_visitors; i++) {
+    delete visitors[i];
+  }
+  delete[] visitors;
 
   // Only returning a value so that Heap::Validate can be called from an ASSERT.
   return true;
@@ -741,9 +1023,11 @@ void Heap::RecordAfterGC(Space space) {
   if (stats_.space_ == kNew) {
     new_space_.AddGCTime(delta);
     new_space_.IncrementCollections();
+    NOT_IN_PRODUCT(isolate_->GetGCNewPauseMaxMetric()->SetValue(delta));
   } else {
     old_space_.AddGCTime(delta);
     old_space_.IncrementCollections();
+    NOT_IN_PRODUCT(isolate_->GetGCOldPauseMaxMetric()->SetValue(delta));
   }
   stats_.after_.new_ = new_space_.GetCurrentUsage();
   stats_.after_.old_ = old_space_.GetCurrentUsage();
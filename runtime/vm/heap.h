@@ -17,6 +17,7 @@
 namespace dart {
 
 // Forward declarations.
+class FinalizerBatch;
 class Isolate;
 class ObjectPointerVisitor;
 class ObjectSet;
@@ -118,6 +119,13 @@ class Heap {
 
   void WaitForSweeperTasks(Thread* thread);
 
+  // Finalizers collected by the GC in progress with --background_finalizers.
+  // They are handed to a helper thread when the collection ends.
+  FinalizerBatch* pending_finalizers();
+
+  // Waits until the helper thread has run all handed over finalizers.
+  void WaitForBackgroundFinalizers();
+
   // Enables growth control on the page space heaps.  This should be
   // called before any user code is executed.
   void InitGrowthControl();
@@ -126,6 +134,15 @@ class Heap {
   void SetGrowthControlState(bool state);
   bool GrowthControlState();
 
+  // Goals for the growth policy of both generations; zero means no goal.
+  // The policy aims for pauses of at most 'max_pause_micros' and for at most
+  // 'max_gc_time_percent' of the time spent collecting garbage.
+  void SetGCGoals(int64_t max_pause_micros, intptr_t max_gc_time_percent);
+  // Changes the limits given to Heap::Init. The new generation adopts its
+  // limit at the next scavenge.
+  void SetMaxCapacity(intptr_t max_new_gen_semi_words,
+                      intptr_t max_old_gen_words);
+
   // Protect access to the heap. Note: Code pages are made
   // executable/non-executable when 'read_only' is true/false, respectively.
   void WriteProtect(bool read_only);
@@ -308,10 +325,24 @@ class Heap {
   void VisitObjectsNoImagePages(ObjectVisitor* visitor) const;
   void VisitObjectsImagePages(ObjectVisitor* visitor) const;
 
+  // Like VisitObjects, but shares the pages out among 'num_visitors' tasks,
+  // each applying its own visitor; the new space and every page are visited
+  // by exactly one of them. visitors[0] runs on the current thread, the others
+  // on helper threads, so visitors must get thread state from
+  // Thread::Current(). Same requirements as VisitObjects otherwise.
+  void VisitObjectsParallel(ObjectVisitor** visitors,
+                            intptr_t num_visitors) const;
+  void VisitObjectsNoImagePagesParallel(ObjectVisitor** visitors,
+                                        intptr_t num_visitors) const;
+
   // Like Verify, but does not wait for concurrent sweeper, so caller must
   // ensure thread-safety.
   bool VerifyGC(MarkExpectation mark_expectation = kForbidMarked) const;
 
+  void VisitPagesParallel(ObjectVisitor** visitors,
+                          intptr_t num_visitors,
+                          bool include_image_pages) const;
+
   // Helper functions for garbage collection.
   void CollectNewSpaceGarbage(Thread* thread,
                               GCReason reason);
@@ -331,6 +362,19 @@ class Heap {
   bool BeginOldSpaceGC(Thread* thread);
   void EndOldSpaceGC();
 
+  // Hands an idle mark-sweep that would overrun the idle deadline to a helper
+  // thread. If the mutator is scheduled again before the collection is done,
+  // it waits for the collection's safepoint operation to end.
+  void StartBackgroundIdleGC();
+  void EndBackgroundIdleGC();
+
+  // Called with gc_in_progress_monitor_ held at the end of a collection.
+  // Returns true if a finalizer task needs to be started for the pending
+  // finalizers.
+  bool ScheduleFinalizersLocked();
+  void StartBackgroundFinalizers();
+  void RunBackgroundFinalizers();
+
   void AddRegionsToObjectSet(ObjectSet* set) const;
 
   Isolate* isolate_;
@@ -355,7 +399,17 @@ class Heap {
   Monitor gc_in_progress_monitor_;
   bool gc_new_space_in_progress_;
   bool gc_old_space_in_progress_;
+  // Protected by gc_in_progress_monitor_.
+  bool background_idle_gc_in_progress_;
 
+  // Only touched by the thread doing the collection.
+  FinalizerBatch* pending_finalizers_;
+  // Protected by gc_in_progress_monitor_.
+  FinalizerBatch* scheduled_finalizers_;
+  bool background_finalizers_running_;
+
+  friend class BackgroundFinalizerTask;
+  friend class BackgroundIdleGCTask;
   friend class Become;       // VisitObjectPointers
   friend class GCCompactor;  // VisitObjectPointers
   friend class Precompiler;  // VisitObjects
@@ -381,6 +435,10 @@ class HeapIterationScope : public StackResource {
   void IterateOldObjects(ObjectVisitor* visitor) const;
   void IterateOldObjectsNoImagePages(ObjectVisitor* visitor) const;
 
+  // See Heap::VisitObjectsParallel.
+  void IterateObjectsParallel(ObjectVisitor** visitors,
+                              intptr_t num_visitors) const;
+
   void IterateVMIsolateObjects(ObjectVisitor* visitor) const;
 
   void IterateObjectPointers(ObjectPointerVisitor* visitor,
@@ -9,10 +9,14 @@
 #include "vm/dart_api_impl.h"
 #include "vm/globals.h"
 #include "vm/heap.h"
+#include "vm/store_buffer.h"
 #include "vm/unit_test.h"
 
 namespace dart {
 
+DECLARE_FLAG(int, evacuation_budget_kb);
+DECLARE_FLAG(int, pretenure_threshold);
+
 TEST_CASE(OldGC) {
   const char* kScriptChars =
       "main() {\n"
@@ -52,6 +56,41 @@ TEST_CASE(OldGC_Unsync) {
 }
 #endif  // !defined(PRODUCT)
 
+TEST_CASE(NewGC_Parallel) {
+  const intptr_t saved_scavenger_tasks = FLAG_scavenger_tasks;
+  FLAG_scavenger_tasks = 2;
+  const char* kScriptChars =
+      "var list;\n"
+      "main() {\n"
+      "  list = new List.generate(10000, (i) => [i, '$i']);\n"
+      "  return list;\n"
+      "}\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  Dart_EnterScope();
+  Dart_Handle result = Dart_Invoke(lib, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+  EXPECT(Dart_IsList(result));
+  {
+    TransitionNativeToVM transition(thread);
+    Heap* heap = Isolate::Current()->heap();
+    // Twice, so that the survivors of the first scavenge are promoted.
+    heap->CollectGarbage(Heap::kNew);
+    heap->CollectGarbage(Heap::kNew);
+  }
+  intptr_t length = 0;
+  EXPECT_VALID(Dart_ListLength(result, &length));
+  EXPECT_EQ(10000, length);
+  Dart_Handle element = Dart_ListGetAt(result, 9999);
+  EXPECT_VALID(element);
+  Dart_Handle last = Dart_ListGetAt(element, 1);
+  EXPECT_VALID(last);
+  const char* str = NULL;
+  EXPECT_VALID(Dart_StringToCString(last, &str));
+  EXPECT_STREQ("9999", str);
+  Dart_ExitScope();
+  FLAG_scavenger_tasks = saved_scavenger_tasks;
+}
+
 TEST_CASE(LargeSweep) {
   const char* kScriptChars =
       "main() {\n"
@@ -229,6 +268,39 @@ TEST_CASE(ArrayHeapStats) {
   EXPECT_GT(expected_size + kTolerance, after - before);
   Dart_ExitScope();
 }
+
+TEST_CASE(PretenureSurvivingClass) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  var a;\n"
+      "}\n"
+      "var cache;\n"
+      "fill() {\n"
+      "  cache = new List(10000);\n"
+      "  for (var i = 0; i < cache.length; i++) cache[i] = new A();\n"
+      "}\n"
+      "alloc() => new A();\n";
+  intptr_t saved_threshold = FLAG_pretenure_threshold;
+  FLAG_pretenure_threshold = 90;
+  Dart_Handle h_lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(Dart_Invoke(h_lib, NewString("fill"), 0, NULL));
+  {
+    TransitionNativeToVM transition(thread);
+    Library& lib = Library::Handle();
+    lib ^= Api::UnwrapHandle(h_lib);
+    const Class& cls = Class::Handle(GetClass(lib, "A"));
+    // All instances in the cache survive.
+    thread->isolate()->heap()->CollectGarbage(Heap::kNew);
+    EXPECT(thread->isolate()->class_table()->ShouldPretenureFor(cls.id()));
+  }
+  Dart_Handle result = Dart_Invoke(h_lib, NewString("alloc"), 0, NULL);
+  EXPECT_VALID(result);
+  {
+    TransitionNativeToVM transition(thread);
+    EXPECT(Api::UnwrapHandle(result)->IsOldObject());
+  }
+  FLAG_pretenure_threshold = saved_threshold;
+}
 #endif  // !PRODUCT
 
 class FindOnly : public FindObjectVisitor {
@@ -377,6 +449,65 @@ ISOLATE_UNIT_TEST_CASE(BecomeForwardRememberedObject) {
   EXPECT(before_obj.raw() == after_obj.raw());
 }
 
+ISOLATE_UNIT_TEST_CASE(EvacuateFragmentedPages) {
+  const intptr_t saved_evacuation_budget_kb = FLAG_evacuation_budget_kb;
+  FLAG_evacuation_budget_kb = 1024;
+  Isolate* isolate = Isolate::Current();
+  Heap* heap = isolate->heap();
+
+  const intptr_t kNumArrays = 16 * 1024;
+  const intptr_t kSurvivorInterval = 16;
+  const Array& survivors =
+      Array::Handle(Array::New(kNumArrays / kSurvivorInterval, Heap::kOld));
+  Array& array = Array::Handle();
+  for (intptr_t i = 0; i < kNumArrays; i++) {
+    array = Array::New(8, Heap::kOld);
+    array.SetAt(0, Smi::Handle(Smi::New(i)));
+    if ((i % kSurvivorInterval) == 0) {
+      survivors.SetAt(i / kSurvivorInterval, array);
+    }
+  }
+  array = Array::null();
+
+  // The pages holding the arrays are mostly garbage, so they are compacted
+  // and the emptied ones released.
+  intptr_t capacity_before = heap->old_space()->CapacityInWords();
+  heap->CollectAllGarbage();
+  EXPECT_LT(heap->old_space()->CapacityInWords(), capacity_before);
+
+  for (intptr_t i = 0; i < survivors.Length(); i++) {
+    array ^= survivors.At(i);
+    EXPECT_EQ(i * kSurvivorInterval, Smi::Value(Smi::RawCast(array.At(0))));
+  }
+  FLAG_evacuation_budget_kb = saved_evacuation_budget_kb;
+}
+
+ISOLATE_UNIT_TEST_CASE(CardRememberedArray) {
+  Isolate* isolate = Isolate::Current();
+  Heap* heap = isolate->heap();
+
+  const intptr_t kLength = 100000;
+  const intptr_t kIndex = 76543;
+  const Array& array = Array::Handle(Array::New(kLength, Heap::kOld));
+  EXPECT(array.raw()->IsCardRemembered());
+  String& str = String::Handle(String::New("card", Heap::kNew));
+  array.SetAt(kIndex, str);
+  // The store dirtied a card rather than remembering the whole array.
+  EXPECT(!array.raw()->IsRemembered());
+
+  // The first scavenge keeps the string in new space, so the card must stay
+  // dirty for the second one to find it again.
+  heap->CollectGarbage(Heap::kNew);
+  str ^= array.At(kIndex);
+  EXPECT(str.raw()->IsNewObject());
+  EXPECT(str.Equals("card"));
+  heap->CollectGarbage(Heap::kNew);
+  str ^= array.At(kIndex);
+  EXPECT(str.raw()->IsOldObject());
+  EXPECT(str.Equals("card"));
+  EXPECT(!array.raw()->IsRemembered());
+}
+
 ISOLATE_UNIT_TEST_CASE(CollectAllGarbage_DeadOldToNew) {
   Isolate* isolate = Isolate::Current();
   Heap* heap = isolate->heap();
@@ -576,4 +707,116 @@ ISOLATE_UNIT_TEST_CASE(CollectAllGarbage_LiveOldToNewChain) {
   EXPECT(size_before < size_after);
 }
 
+static void ScavengeWithSurvivors(Heap* heap, const Array& roots) {
+  for (intptr_t i = 0; i < roots.Length(); i++) {
+    roots.SetAt(i, Array::Handle(Array::New(100, Heap::kNew)));
+  }
+  heap->CollectGarbage(Heap::kNew);
+}
+
+ISOLATE_UNIT_TEST_CASE(NewSpacePauseGoal) {
+  Heap* heap = Isolate::Current()->heap();
+  heap->CollectAllGarbage();
+  const int64_t initial_capacity = heap->CapacityInWords(Heap::kNew);
+  // Survivors make up too much of new space for it to stay this small...
+  const Array& roots = Array::Handle(Array::New(1000, Heap::kOld));
+  // ...but no scavenge can meet this pause goal, so it does not grow.
+  heap->SetGCGoals(1, 0);
+  for (intptr_t i = 0; i < 3; i++) {
+    ScavengeWithSurvivors(heap, roots);
+  }
+  EXPECT(heap->CapacityInWords(Heap::kNew) <= initial_capacity);
+
+  heap->SetGCGoals(0, 0);
+  ScavengeWithSurvivors(heap, roots);
+  ScavengeWithSurvivors(heap, roots);
+  EXPECT_LT(initial_capacity, heap->CapacityInWords(Heap::kNew));
+}
+
+ISOLATE_UNIT_TEST_CASE(NewSpaceExternalHysteresis) {
+  Heap* heap = Isolate::Current()->heap();
+  Scavenger* new_space = heap->new_space();
+  heap->CollectAllGarbage();
+  const intptr_t limit = FLAG_new_gen_ext_limit * MB;
+  const intptr_t collections = new_space->collections();
+  // Nothing frees this external size, so it survives the scavenge it
+  // triggers...
+  heap->AllocateExternal(kExternalTypedDataUint8ArrayCid, limit + MB,
+                         Heap::kNew);
+  EXPECT_EQ(collections + 1, new_space->collections());
+  // ...and only new external allocation counts towards the next one.
+  heap->AllocateExternal(kExternalTypedDataUint8ArrayCid, MB, Heap::kNew);
+  EXPECT_EQ(collections + 1, new_space->collections());
+  heap->AllocateExternal(kExternalTypedDataUint8ArrayCid, limit, Heap::kNew);
+  EXPECT_EQ(collections + 2, new_space->collections());
+  heap->FreeExternal(2 * (limit + MB), Heap::kNew);
+}
+
+class CountObjectsVisitor : public ObjectVisitor {
+ public:
+  CountObjectsVisitor() : count_(0), size_(0) {}
+
+  virtual void VisitObject(RawObject* obj) {
+    count_++;
+    size_ += obj->Size();
+  }
+
+  intptr_t count() const { return count_; }
+  intptr_t size() const { return size_; }
+
+ private:
+  intptr_t count_;
+  intptr_t size_;
+
+  DISALLOW_COPY_AND_ASSIGN(CountObjectsVisitor);
+};
+
+ISOLATE_UNIT_TEST_CASE(IterateObjectsParallel) {
+  // Make sure there are objects in both spaces.
+  Array::Handle(Array::New(100, Heap::kOld));
+  Array::Handle(Array::New(100, Heap::kNew));
+  const intptr_t kNumVisitors = 4;
+  CountObjectsVisitor serial;
+  CountObjectsVisitor parallel[kNumVisitors];
+  ObjectVisitor* visitors[kNumVisitors];
+  for (intptr_t i = 0; i < kNumVisitors; i++) {
+    visitors[i] = &parallel[i];
+  }
+  {
+    HeapIterationScope iteration(thread);
+    iteration.IterateObjects(&serial);
+    iteration.IterateObjectsParallel(visitors, kNumVisitors);
+  }
+  intptr_t count = 0;
+  intptr_t size = 0;
+  for (intptr_t i = 0; i < kNumVisitors; i++) {
+    count += parallel[i].count();
+    size += parallel[i].size();
+  }
+  EXPECT_EQ(serial.count(), count);
+  EXPECT_EQ(serial.size(), size);
+}
+
+ISOLATE_UNIT_TEST_CASE(MarkingStackStashes) {
+  const intptr_t kNumStashes = 3;
+  MarkingStack stack(kNumStashes);
+  EXPECT(stack.IsEmpty());
+  MarkingStack::Block* block = stack.PopEmptyBlock();
+  EXPECT(block->IsEmpty());
+  block->Push(Object::null());
+  stack.PushBlock(block, 1);
+  EXPECT(!stack.IsEmpty());
+  // Another task steals the block from stash 1.
+  MarkingStack::Block* stolen = stack.PopNonEmptyBlock(0);
+  EXPECT(stolen == block);
+  EXPECT(stack.IsEmpty());
+  EXPECT(stack.PopNonEmptyBlock(2) == NULL);
+  EXPECT(stolen->Pop() == Object::null());
+  // Empty blocks are cached for reuse instead of being stashed.
+  stack.PushBlock(stolen, 0);
+  EXPECT(stack.IsEmpty());
+  EXPECT(stack.PopEmptyBlock() == stolen);
+  stack.PushBlock(stolen);
+}
+
 }  // namespace dart
@@ -405,6 +405,7 @@ RawError* IsolateMessageHandler::HandleLibMessage(const Array& message) {
     }
     case Isolate::kLowMemoryMsg: {
       I->heap()->NotifyLowMemory();
+      Zone::ReleaseSegmentCache(T);
       break;
     }
 
@@ -1835,10 +1836,14 @@ void Isolate::Shutdown() {
     // Wait for any concurrent GC tasks to finish before shutting down.
     // TODO(koda): Support faster sweeper shutdown (e.g., after current page).
     PageSpace* old_space = heap_->old_space();
-    MonitorLocker ml(old_space->tasks_lock());
-    while (old_space->tasks() > 0) {
-      ml.Wait();
+    {
+      MonitorLocker ml(old_space->tasks_lock());
+      while (old_space->tasks() > 0) {
+        ml.Wait();
+      }
     }
+    // Finalizers handed to a helper thread may not outlive the isolate.
+    heap_->WaitForBackgroundFinalizers();
   }
 
 #if !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
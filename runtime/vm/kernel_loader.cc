@@ -17,6 +17,7 @@
 #include "vm/reusable_handles.h"
 #include "vm/service_isolate.h"
 #include "vm/symbols.h"
+#include "vm/timeline.h"
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
 namespace dart {
@@ -29,6 +30,12 @@ namespace kernel {
 
 static const char* const kVMServiceIOLibraryUri = "dart:vmservice_io";
 
+DEFINE_FLAG(bool,
+            load_unreachable_libraries,
+            false,
+            "Load kernel libraries that the main library does not reach "
+            "through imports and exports.");
+
 class SimpleExpressionConverter {
  public:
   SimpleExpressionConverter(TranslationHelper* helper,
@@ -553,11 +560,35 @@ Object& KernelLoader::LoadProgram(bool process_pending_classes) {
         "not allowed");
   }
 
+  NOT_IN_PRODUCT(TimelineDurationScope tds(
+      thread_, Timeline::GetIsolateStream(), "KernelLoader::LoadProgram"));
+#if !defined(PRODUCT)
+  if (tds.enabled()) {
+    tds.SetNumArguments(1);
+    tds.FormatArgument(0, "libraryCount", "%" Pd, program_->library_count());
+  }
+#endif  // !defined(PRODUCT)
+
   LongJumpScope jump;
   if (setjmp(*jump.Set()) == 0) {
     const intptr_t length = program_->library_count();
+    // Sub-programs of a concatenated dill can import each other's libraries,
+    // and reload needs every library, so only whole programs are pruned.
+    BitVector* reachable_libs = NULL;
+#if defined(PRODUCT)
+    const bool has_attempted_reload = false;
+#else
+    const bool has_attempted_reload = I->HasAttemptedReload();
+#endif  // !defined(PRODUCT)
+    if (!FLAG_load_unreachable_libraries && process_pending_classes &&
+        (program_->main_method() != -1) && !has_attempted_reload) {
+      reachable_libs = new (Z) BitVector(Z, length);
+      ComputeReachableLibraries(reachable_libs);
+    }
     for (intptr_t i = 0; i < length; i++) {
-      LoadLibrary(i);
+      if ((reachable_libs == NULL) || reachable_libs->Contains(i)) {
+        LoadLibrary(i);
+      }
     }
 
     if (process_pending_classes) {
@@ -669,6 +700,63 @@ void KernelLoader::walk_incremental_kernel(BitVector* modified_libs) {
   }
 }
 
+// Marks the libraries reachable from the main library and the dart:
+// libraries through imports and exports. The others can never be resolved
+// by the program, so there is no need to create their classes and members.
+void KernelLoader::ComputeReachableLibraries(BitVector* reachable_libs) {
+  const intptr_t length = program_->library_count();
+  IntMap<intptr_t> library_indices;
+  GrowableArray<intptr_t> worklist(length);
+  for (intptr_t i = 0; i < length; i++) {
+    const NameIndex name = library_canonical_name(i);
+    library_indices.Insert(name, i + 1);
+    if (LibraryUri(i).StartsWith(Symbols::DartScheme())) {
+      reachable_libs->Add(i);
+      worklist.Add(i);
+    }
+  }
+
+  const intptr_t main_index =
+      library_indices.Lookup(H.EnclosingName(program_->main_method())) - 1;
+  if (main_index < 0) {
+    reachable_libs->SetAll();
+    return;
+  }
+  if (!reachable_libs->Contains(main_index)) {
+    reachable_libs->Add(main_index);
+    worklist.Add(main_index);
+  }
+
+  while (!worklist.is_empty()) {
+    const intptr_t index = worklist.RemoveLast();
+    builder_.SetOffset(library_offset(index));
+    LibraryHelper library_helper(&builder_);
+    library_helper.ReadUntilExcluding(LibraryHelper::kDependencies);
+    const intptr_t deps_count = builder_.ReadListLength();
+    for (intptr_t dep = 0; dep < deps_count; ++dep) {
+      LibraryDependencyHelper dependency_helper(&builder_);
+      dependency_helper.ReadUntilExcluding(
+          LibraryDependencyHelper::kCombinators);
+      const intptr_t combinator_count = builder_.ReadListLength();
+      for (intptr_t c = 0; c < combinator_count; ++c) {
+        builder_.SkipLibraryCombinator();
+      }
+      if (dependency_helper.target_library_canonical_name_ < 0) {
+        continue;
+      }
+      // Libraries outside this program are already loaded.
+      const intptr_t target_index =
+          library_indices.Lookup(
+              dependency_helper.target_library_canonical_name_) -
+          1;
+      if ((target_index >= 0) && !reachable_libs->Contains(target_index)) {
+        reachable_libs->Add(target_index);
+        worklist.Add(target_index);
+      }
+    }
+  }
+}
+
 void KernelLoader::CheckForInitializer(const Field& field) {
   if (builder_.PeekTag() == kSomething) {
     SimpleExpressionConverter converter(&H, &builder_);
@@ -186,6 +186,7 @@ class KernelLoader {
   static void index_programs(kernel::Reader* reader,
                              GrowableArray<intptr_t>* subprogram_file_starts);
   void walk_incremental_kernel(BitVector* modified_libs);
+  void ComputeReachableLibraries(BitVector* reachable_libs);
 
   void LoadPreliminaryClass(ClassHelper* class_helper,
                             intptr_t type_parameter_count);
@@ -104,6 +104,8 @@ void MegamorphicCacheTable::PrintSizes(Isolate* isolate) {
 
   intptr_t* probe_counts = new intptr_t[max_size];
   intptr_t entry_count = 0;
+  intptr_t bucket_count = 0;
+  intptr_t total_probe_count = 0;
   intptr_t max_probe_count = 0;
   for (intptr_t i = 0; i < max_size; i++) {
     probe_counts[i] = 0;
@@ -113,6 +115,7 @@ void MegamorphicCacheTable::PrintSizes(Isolate* isolate) {
     buckets = cache.buckets();
     intptr_t mask = cache.mask();
     intptr_t capacity = mask + 1;
+    bucket_count += capacity;
     for (intptr_t j = 0; j < capacity; j++) {
       intptr_t class_id =
           Smi::Value(Smi::RawCast(cache.GetClassId(buckets, j)));
@@ -131,6 +134,7 @@ void MegamorphicCacheTable::PrintSizes(Isolate* isolate) {
           probe_index = (probe_index + 1) & mask;
         }
         probe_counts[probe_count]++;
+        total_probe_count += probe_count;
         if (probe_count > max_probe_count) {
           max_probe_count = probe_count;
         }
@@ -138,6 +142,19 @@ void MegamorphicCacheTable::PrintSizes(Isolate* isolate) {
       }
     }
   }
+  if (entry_count == 0) {
+    delete[] probe_counts;
+    return;
+  }
+  // Every entry was inserted by a miss of the cache or of the ICData of a
+  // call site that switched to it.
+  OS::Print("Megamorphic entries: %" Pd " in %" Pd
+            " buckets (load %lf), mean probe %lf\n",
+            entry_count, bucket_count,
+            static_cast<double>(entry_count) /
+                static_cast<double>(bucket_count),
+            static_cast<double>(total_probe_count) /
+                static_cast<double>(entry_count));
   intptr_t cumulative_entries = 0;
   for (intptr_t i = 0; i <= max_probe_count; i++) {
     cumulative_entries += probe_counts[i];
@@ -27,7 +27,10 @@ class JSONStream;
   V(MetricHeapUsed, HeapGlobalUsed, "heap.global.used", kByte)                 \
   V(MaxMetric, HeapGlobalUsedMax, "heap.global.used.max", kByte)               \
   V(Metric, RunnableLatency, "isolate.runnable.latency", kMicrosecond)         \
-  V(Metric, RunnableHeapSize, "isolate.runnable.heap", kByte)
+  V(Metric, RunnableHeapSize, "isolate.runnable.heap", kByte)                  \
+  V(MaxMetric, GCNewPauseMax, "gc.new.pause.max", kMicrosecond)                \
+  V(MaxMetric, GCOldPauseMax, "gc.old.pause.max", kMicrosecond)                \
+  V(MaxMetric, SafepointWaitMax, "isolate.safepoint.wait.max", kMicrosecond)
 
 #define VM_METRIC_LIST(V)                                                      \
   V(MetricIsolateCount, IsolateCount, "vm.isolate.count", kCounter)            \
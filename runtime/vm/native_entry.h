@@ -88,6 +88,27 @@ typedef void (*NativeFunctionWrapper)(Dart_NativeArguments args,
   static RawObject* DN_Helper##name(Isolate* isolate, Thread* thread,          \
                                     Zone* zone, NativeArguments* arguments)
 
+// Leaf bootstrap natives stay in the generated-code state: there is no
+// transition to the VM and no StackZone. They must not allocate (not even
+// handles), throw, call into Dart or reach a safepoint, and may only operate
+// on raw objects. Only use them for trivial natives that are called often.
+#define DEFINE_LEAF_NATIVE_ENTRY(name, argument_count)                         \
+  static RawObject* DN_LeafHelper##name(NativeArguments* arguments);           \
+  void NATIVE_ENTRY_FUNCTION(name)(Dart_NativeArguments args) {                \
+    CHECK_STACK_ALIGNMENT;                                                     \
+    NativeArguments* arguments = reinterpret_cast<NativeArguments*>(args);     \
+    /* Tell MemorySanitizer 'arguments' is initialized by generated code. */   \
+    MSAN_UNPOISON(arguments, sizeof(*arguments));                              \
+    ASSERT(arguments->NativeArgCount() == argument_count);                     \
+    ASSERT(arguments->thread() == Thread::Current());                          \
+    TRACE_NATIVE_CALL("%s", "" #name);                                         \
+    {                                                                          \
+      NoSafepointScope no_safepoint;                                           \
+      SET_NATIVE_RETVAL(arguments, DN_LeafHelper##name(arguments));            \
+    }                                                                          \
+  }                                                                            \
+  static RawObject* DN_LeafHelper##name(NativeArguments* arguments)
+
 // Helper that throws an argument exception.
 void DartNativeThrowArgumentException(const Instance& instance);
 
@@ -33,10 +33,11 @@ MessageHandler::MessageStatus NativeMessageHandler::HandleMessage(
   }
   // We create a native scope for handling the message.
   // All allocation of objects for decoding the message is done in the
-  // zone associated with this scope.
+  // zone associated with this scope. The message is only deleted after the
+  // handler returns, so byte-sized typed data can be borrowed from it.
   ApiNativeScope scope;
   Dart_CObject* object;
-  ApiMessageReader reader(message);
+  ApiMessageReader reader(message, /* borrow_message_data = */ true);
   object = reader.ReadMessage();
   (*func())(message->dest_port(), object);
   delete message;
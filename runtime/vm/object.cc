@@ -34,6 +34,7 @@
 #include "vm/isolate_reload.h"
 #include "vm/kernel.h"
 #include "vm/native_symbol.h"
+#include "vm/object_graph.h"
 #include "vm/object_store.h"
 #include "vm/parser.h"
 #include "vm/profiler.h"
@@ -1960,6 +1961,7 @@ RawObject* Object::Allocate(intptr_t cls_id, intptr_t size, Heap::Space space) {
 
   uword address = heap->Allocate(size, space);
   if (address == 0) {
+    ObjectGraph::SerializeAtOOM(thread);
     // Use the preallocated out of memory exception to avoid calling
     // into dart code or allocating any code.
     const Instance& exception =
@@ -2041,7 +2043,8 @@ RawObject* Object::Clone(const Object& orig, Heap::Space space) {
   if (!raw_clone->IsOldObject()) {
     // No need to remember an object in new space.
     return raw_clone;
-  } else if (orig.raw()->IsOldObject() && !orig.raw()->IsRemembered()) {
+  } else if (orig.raw()->IsOldObject() && !orig.raw()->IsRemembered() &&
+             !orig.raw()->IsCardRemembered()) {
     // Old original doesn't need to be remembered, so neither does the clone.
     return raw_clone;
   }
@@ -12204,6 +12207,12 @@ RawKernelProgramInfo* KernelProgramInfo::New(const TypedData& string_offsets,
   info.StorePointer(&info.raw_ptr()->metadata_mappings_,
                     metadata_mappings.raw());
   info.StorePointer(&info.raw_ptr()->scripts_, scripts.raw());
+  // Canonical names are pairs of 4-byte parent and string indexes.
+  const intptr_t name_count = canonical_names.LengthInBytes() / 8;
+  const Array& name_lookup_cache =
+      Array::Handle(Array::New(name_count, Heap::kOld));
+  info.StorePointer(&info.raw_ptr()->name_lookup_cache_,
+                    name_lookup_cache.raw());
   return info.raw();
 }
 
@@ -13047,6 +13056,40 @@ bool ExceptionHandlers::HasCatchAll(intptr_t try_index) const {
   return raw_ptr()->data()[try_index].has_catch_all;
 }
 
+bool ExceptionHandlers::Equals(const ExceptionHandlers& other) const {
+  const intptr_t length = num_entries();
+  if (length != other.num_entries()) {
+    return false;
+  }
+  {
+    NoSafepointScope no_safepoint;
+    if (memcmp(raw_ptr()->data(), other.raw_ptr()->data(),
+               length * sizeof(ExceptionHandlerInfo)) != 0) {
+      return false;
+    }
+  }
+  // Handled types are canonical, so they can be compared by identity.
+  Array& types = Array::Handle();
+  Array& other_types = Array::Handle();
+  for (intptr_t i = 0; i < length; i++) {
+    types = GetHandledTypes(i);
+    other_types = other.GetHandledTypes(i);
+    if (types.raw() == other_types.raw()) {
+      continue;
+    }
+    if (types.IsNull() || other_types.IsNull() ||
+        (types.Length() != other_types.Length())) {
+      return false;
+    }
+    for (intptr_t j = 0; j < types.Length(); j++) {
+      if (types.At(j) != other_types.At(j)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 void ExceptionHandlers::SetHandledTypes(intptr_t try_index,
                                         const Array& handled_types) const {
   ASSERT((try_index >= 0) && (try_index < num_entries()));
@@ -14362,14 +14405,22 @@ RawTypedData* Code::GetDeoptInfoAtPc(uword pc,
     ASSERT(Dart::vm_snapshot_kind() == Snapshot::kFullAOT);
     return TypedData::null();
   }
-  // Linear search for the PC offset matching the target PC.
-  intptr_t length = DeoptTable::GetLength(table);
+  // The table is sorted by PC offset (see
+  // FlowGraphCompiler::CreateDeoptInfo), binary search for the target PC.
   Smi& offset = Smi::Handle();
   Smi& reason_and_flags = Smi::Handle();
   TypedData& info = TypedData::Handle();
-  for (intptr_t i = 0; i < length; ++i) {
-    DeoptTable::GetEntry(table, i, &offset, &info, &reason_and_flags);
-    if (pc == (code_entry + offset.Value())) {
+  intptr_t imin = 0;
+  intptr_t imax = DeoptTable::GetLength(table) - 1;
+  while (imax >= imin) {
+    const intptr_t imid = ((imax - imin) / 2) + imin;
+    DeoptTable::GetEntry(table, imid, &offset, &info, &reason_and_flags);
+    const uword entry_pc = code_entry + offset.Value();
+    if (entry_pc < pc) {
+      imin = imid + 1;
+    } else if (entry_pc > pc) {
+      imax = imid - 1;
+    } else {
       ASSERT(!info.IsNull());
       *deopt_reason = DeoptTable::ReasonField::decode(reason_and_flags.Value());
       *deopt_flags = DeoptTable::FlagsField::decode(reason_and_flags.Value());
@@ -15203,12 +15254,21 @@ RawMegamorphicCache* MegamorphicCache::New(const String& target_name,
   return result.raw();
 }
 
-void MegamorphicCache::EnsureCapacity() const {
+void MegamorphicCache::EnsureCapacity(intptr_t additional_entries) const {
   intptr_t old_capacity = mask() + 1;
+  const double needed =
+      static_cast<double>(filled_entry_count() + additional_entries);
   double load_limit = kLoadFactor * static_cast<double>(old_capacity);
-  if (static_cast<double>(filled_entry_count() + 1) > load_limit) {
+  if (needed > load_limit) {
     const Array& old_buckets = Array::Handle(buckets());
-    intptr_t new_capacity = old_capacity * 2;
+    // Caches emptied by ProgramVisitor::ShareMegamorphicBuckets restart at
+    // the initial capacity instead of doubling up from a single bucket.
+    intptr_t new_capacity = (old_capacity * 2 < kInitialCapacity)
+                                ? kInitialCapacity
+                                : old_capacity * 2;
+    while (needed > kLoadFactor * static_cast<double>(new_capacity)) {
+      new_capacity *= 2;
+    }
     const Array& new_buckets =
         Array::Handle(Array::New(kEntryLength * new_capacity));
 
@@ -15252,6 +15312,25 @@ void MegamorphicCache::Insert(const Smi& class_id,
   UNREACHABLE();
 }
 
+RawFunction* MegamorphicCache::Lookup(const Smi& class_id) const {
+  const Array& backing_array = Array::Handle(buckets());
+  intptr_t id_mask = mask();
+  intptr_t index = (class_id.Value() * kSpreadFactor) & id_mask;
+  intptr_t i = index;
+  do {
+    const intptr_t current_cid =
+        Smi::Value(Smi::RawCast(GetClassId(backing_array, i)));
+    if (current_cid == class_id.Value()) {
+      return Function::RawCast(GetTargetFunction(backing_array, i));
+    }
+    if (current_cid == kIllegalCid) {
+      return Function::null();
+    }
+    i = (i + 1) & id_mask;
+  } while (i != index);
+  return Function::null();
+}
+
 const char* MegamorphicCache::ToCString() const {
   const String& name = String::Handle(target_name());
   return OS::SCreate(Thread::Current()->zone(), "MegamorphicCache(%s)",
@@ -20943,12 +21022,24 @@ RawString* String::Transform(int32_t (*mapping)(int32_t ch),
 }
 
 RawString* String::ToUpperCase(const String& str, Heap::Space space) {
-  // TODO(cshapiro): create a fast-path for OneByteString instances.
+  if (str.IsOneByteString()) {
+    const String& result = String::Handle(
+        OneByteString::TransformAsciiCase(str, 'a', 'z', space));
+    if (!result.IsNull()) {
+      return result.raw();
+    }
+  }
   return Transform(CaseMapping::ToUpper, str, space);
 }
 
 RawString* String::ToLowerCase(const String& str, Heap::Space space) {
-  // TODO(cshapiro): create a fast-path for OneByteString instances.
+  if (str.IsOneByteString()) {
+    const String& result = String::Handle(
+        OneByteString::TransformAsciiCase(str, 'A', 'Z', space));
+    if (!result.IsNull()) {
+      return result.raw();
+    }
+  }
   return Transform(CaseMapping::ToLower, str, space);
 }
 
@@ -21315,6 +21406,41 @@ RawOneByteString* OneByteString::Transform(int32_t (*mapping)(int32_t ch),
   return OneByteString::raw(result);
 }
 
+RawString* OneByteString::TransformAsciiCase(const String& str,
+                                             uint8_t first,
+                                             uint8_t last,
+                                             Heap::Space space) {
+  ASSERT(str.IsOneByteString());
+  const intptr_t len = str.Length();
+  if (len == 0) {
+    return str.raw();
+  }
+  bool has_mapping = false;
+  {
+    NoSafepointScope no_safepoint;
+    const uint8_t* chars = CharAddr(str, 0);
+    for (intptr_t i = 0; i < len; ++i) {
+      const uint8_t ch = chars[i];
+      if (ch >= 0x80) {
+        return String::null();
+      }
+      has_mapping = has_mapping || ((ch >= first) && (ch <= last));
+    }
+  }
+  if (!has_mapping) {
+    return str.raw();
+  }
+  const String& result = String::Handle(OneByteString::New(len, space));
+  NoSafepointScope no_safepoint;
+  const uint8_t* src = CharAddr(str, 0);
+  uint8_t* dst = CharAddr(result, 0);
+  for (intptr_t i = 0; i < len; ++i) {
+    const uint8_t ch = src[i];
+    dst[i] = ((ch >= first) && (ch <= last)) ? (ch ^ 0x20) : ch;
+  }
+  return result.raw();
+}
+
 RawOneByteString* OneByteString::SubStringUnchecked(const String& str,
                                                     intptr_t begin_index,
                                                     intptr_t length,
@@ -21336,6 +21462,41 @@ RawOneByteString* OneByteString::SubStringUnchecked(const String& str,
   return result;
 }
 
+intptr_t OneByteString::IndexOf(const String& str,
+                                const String& pattern,
+                                intptr_t start) {
+  ASSERT(!str.IsNull() && str.IsOneByteString());
+  ASSERT(!pattern.IsNull() && pattern.IsOneByteString());
+  ASSERT((start >= 0) && (start <= str.Length()));
+  const intptr_t pattern_length = pattern.Length();
+  if (pattern_length == 0) {
+    return start;
+  }
+  const intptr_t last = str.Length() - pattern_length;
+  if (start > last) {
+    return -1;
+  }
+  NoSafepointScope no_safepoint;
+  const uint8_t* data = &raw_ptr(str)->data()[0];
+  const uint8_t* needle = &raw_ptr(pattern)->data()[0];
+  const uint8_t first = needle[0];
+  // Let memchr skip to the candidate positions and only compare the rest of
+  // the pattern there.
+  intptr_t index = start;
+  while (index <= last) {
+    const void* found = memchr(data + index, first, last - index + 1);
+    if (found == NULL) {
+      return -1;
+    }
+    index = reinterpret_cast<const uint8_t*>(found) - data;
+    if (memcmp(data + index + 1, needle + 1, pattern_length - 1) == 0) {
+      return index;
+    }
+    index++;
+  }
+  return -1;
+}
+
 void OneByteString::SetPeer(const String& str,
                             intptr_t external_size,
                             void* peer,
@@ -21727,6 +21888,11 @@ RawArray* Array::New(intptr_t class_id, intptr_t len, Heap::Space space) {
         Object::Allocate(class_id, Array::InstanceSize(len), space));
     NoSafepointScope no_safepoint;
     raw->StoreSmi(&(raw->ptr()->length_), Smi::New(len));
+    // Arrays on large pages remember stores by card, so that a single store
+    // does not make the next scavenge visit every element.
+    if (raw->IsOldObject() && (HeapPage::Of(raw)->card_table() != NULL)) {
+      raw->SetCardRememberedBitUnsynchronized();
+    }
     return raw;
   }
 }
@@ -21747,6 +21913,16 @@ RawArray* Array::Slice(intptr_t start,
   return dest.raw();
 }
 
+void Array::CopyFrom(intptr_t dst_start,
+                     const Array& src,
+                     intptr_t src_start,
+                     intptr_t count) const {
+  ASSERT(count > 0);
+  ASSERT((dst_start >= 0) && (dst_start + count <= Length()));
+  ASSERT((src_start >= 0) && (src_start + count <= src.Length()));
+  StorePointers(ObjectAddr(dst_start), src.ObjectAddr(src_start), count);
+}
+
 void Array::MakeImmutable() const {
   if (IsImmutable()) return;
   ASSERT(!IsCanonical());
@@ -22824,6 +23000,10 @@ void RegExp::set_pattern(const String& pattern) const {
   StorePointer(&raw_ptr()->pattern_, pattern.raw());
 }
 
+void RegExp::set_literal_prefix(const String& prefix) const {
+  StorePointer(&raw_ptr()->literal_prefix_, prefix.raw());
+}
+
 void RegExp::set_function(intptr_t cid,
                           bool sticky,
                           const Function& value) const {
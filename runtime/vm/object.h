@@ -648,16 +648,32 @@ class Object {
   }
 
   // Store a range of pointers [from, from + count) into [to, to + count).
+  // The ranges may overlap. The generational write barrier is applied once
+  // for the whole range: the object is added to the store buffer at most
+  // once, or only the cards holding new-space values are dirtied.
   // TODO(koda): Use this to fix Object::Clone's broken store buffer logic.
   void StorePointers(RawObject* const* to,
                      RawObject* const* from,
-                     intptr_t count) {
+                     intptr_t count) const {
     ASSERT(Contains(reinterpret_cast<uword>(to)));
-    if (raw()->IsNewObject()) {
-      memmove(const_cast<RawObject**>(to), from, count * kWordSize);
-    } else {
+    memmove(const_cast<RawObject**>(to), from, count * kWordSize);
+    RawObject* obj = raw();
+    if (obj->IsNewObject()) {
+      return;
+    }
+    if (obj->IsCardRemembered()) {
+      for (intptr_t i = 0; i < count; ++i) {
+        if (!to[i]->IsSmiOrOldObject()) {
+          obj->RememberCard(&to[i]);
+        }
+      }
+    } else if (!obj->IsRemembered()) {
       for (intptr_t i = 0; i < count; ++i) {
-        StorePointer(&to[i], from[i]);
+        if (!to[i]->IsSmiOrOldObject()) {
+          obj->SetRememberedBit();
+          Thread::Current()->StoreBufferAddObject(obj);
+          return;
+        }
       }
     }
   }
@@ -4024,6 +4040,10 @@ class KernelProgramInfo : public Object {
   RawArray* constants() const { return raw_ptr()->constants_; }
   void set_constants(const Array& constants) const;
 
+  // Libraries and classes resolved from canonical names, indexed by the
+  // canonical name index.
+  RawArray* name_lookup_cache() const { return raw_ptr()->name_lookup_cache_; }
+
   // If we load a kernel blob with evaluated constants, then we delay setting
   // the native names of [Function] objects until we've read the constant table
   // (since native names are encoded as constants).
@@ -4570,6 +4590,8 @@ class ExceptionHandlers : public Object {
   void SetHandledTypes(intptr_t try_index, const Array& handled_types) const;
   bool HasCatchAll(intptr_t try_index) const;
 
+  bool Equals(const ExceptionHandlers& other) const;
+
   static intptr_t InstanceSize() {
     ASSERT(sizeof(RawExceptionHandlers) ==
            OFFSET_OF_RETURNED_VALUE(RawExceptionHandlers, data));
@@ -5189,10 +5211,15 @@ class MegamorphicCache : public Object {
   static RawMegamorphicCache* New(const String& target_name,
                                   const Array& arguments_descriptor);
 
-  void EnsureCapacity() const;
+  // Grows the buckets so that the given number of entries can be inserted
+  // without exceeding the load factor.
+  void EnsureCapacity(intptr_t additional_entries = 1) const;
 
   void Insert(const Smi& class_id, const Function& target) const;
 
+  // Returns the cached target for the class id, or null if there is none.
+  RawFunction* Lookup(const Smi& class_id) const;
+
   static intptr_t InstanceSize() {
     return RoundedAllocationSize(sizeof(RawMegamorphicCache));
   }
@@ -7382,6 +7409,13 @@ class OneByteString : public AllStatic {
                                      const String& str,
                                      Heap::Space space);
 
+  // Flips the case of the ASCII letters in [first, last]. Returns |str| if
+  // nothing changes, or null if |str| contains non-ASCII characters.
+  static RawString* TransformAsciiCase(const String& str,
+                                       uint8_t first,
+                                       uint8_t last,
+                                       Heap::Space space);
+
   // High performance version of substring for one-byte strings.
   // "str" must be OneByteString.
   static RawOneByteString* SubStringUnchecked(const String& str,
@@ -7389,6 +7423,12 @@ class OneByteString : public AllStatic {
                                               intptr_t length,
                                               Heap::Space space);
 
+  // Returns the index of the first occurrence of "pattern" in "str" at or
+  // after "start", or -1. Both strings must be OneByteStrings.
+  static intptr_t IndexOf(const String& str,
+                          const String& pattern,
+                          intptr_t start);
+
   static void SetPeer(const String& str,
                       intptr_t external_size,
                       void* peer,
@@ -7867,6 +7907,14 @@ class Array : public Instance {
                   intptr_t count,
                   bool with_type_argument) const;
 
+  // Copies 'count' elements of 'src' starting at 'src_start' into this array
+  // starting at 'dst_start'. The ranges may overlap, e.g. when 'src' is this
+  // array.
+  void CopyFrom(intptr_t dst_start,
+                const Array& src,
+                intptr_t src_start,
+                intptr_t count) const;
+
  protected:
   static RawArray* New(intptr_t class_id,
                        intptr_t len,
@@ -8249,6 +8297,39 @@ class TypedData : public Instance {
     }
   }
 
+  // Replicates the element of 'element_size_in_bytes' bytes at
+  // 'offset_in_bytes' over the following 'length_in_bytes' bytes. The range
+  // is filled by doubling copies, so that the bulk of the work is done by
+  // memcpy.
+  template <typename DstType>
+  static void Fill(const DstType& dst,
+                   intptr_t offset_in_bytes,
+                   intptr_t length_in_bytes,
+                   intptr_t element_size_in_bytes) {
+    ASSERT(Utils::RangeCheck(offset_in_bytes, length_in_bytes,
+                             dst.LengthInBytes()));
+    ASSERT((element_size_in_bytes > 0) &&
+           ((length_in_bytes % element_size_in_bytes) == 0));
+    {
+      NoSafepointScope no_safepoint;
+      if (length_in_bytes > element_size_in_bytes) {
+        uint8_t* data =
+            reinterpret_cast<uint8_t*>(dst.DataAddr(offset_in_bytes));
+        if (element_size_in_bytes == 1) {
+          memset(data + 1, data[0], length_in_bytes - 1);
+          return;
+        }
+        intptr_t filled = element_size_in_bytes;
+        while (filled < length_in_bytes) {
+          const intptr_t chunk =
+              Utils::Minimum(filled, length_in_bytes - filled);
+          memcpy(data + filled, data, chunk);
+          filled += chunk;
+        }
+      }
+    }
+  }
+
   template <typename DstType, typename SrcType>
   static void ClampedCopy(const DstType& dst,
                           intptr_t dst_offset_in_bytes,
@@ -8826,6 +8907,7 @@ class RegExp : public Instance {
   intptr_t num_registers() const { return raw_ptr()->num_registers_; }
 
   RawString* pattern() const { return raw_ptr()->pattern_; }
+  RawString* literal_prefix() const { return raw_ptr()->literal_prefix_; }
   RawSmi* num_bracket_expressions() const {
     return raw_ptr()->num_bracket_expressions_;
   }
@@ -8879,6 +8961,7 @@ class RegExp : public Instance {
   }
 
   void set_pattern(const String& pattern) const;
+  void set_literal_prefix(const String& prefix) const;
   void set_function(intptr_t cid, bool sticky, const Function& value) const;
   void set_bytecode(bool is_one_byte,
                     bool sticky,
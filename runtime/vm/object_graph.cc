@@ -4,18 +4,31 @@
 
 #include "vm/object_graph.h"
 
+#include "vm/atomic.h"
 #include "vm/dart.h"
 #include "vm/dart_api_state.h"
+#include "vm/datastream.h"
+#include "vm/flags.h"
 #include "vm/growable_array.h"
 #include "vm/isolate.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
+#include "vm/os.h"
 #include "vm/raw_object.h"
 #include "vm/reusable_handles.h"
+#include "vm/thread_barrier.h"
+#include "vm/thread_pool.h"
+#include "vm/timeline.h"
 #include "vm/visitor.h"
 
 namespace dart {
 
+DEFINE_FLAG(charp,
+            snapshot_heap_at_oom,
+            NULL,
+            "Write a heap snapshot into this directory the first time an "
+            "isolate runs out of memory.");
+
 // The state of a pre-order, depth-first traversal of an object graph.
 // When a node is visited, *all* its children are pushed to the stack at once.
 // We insert a sentinel between the node and its children on the stack, to
@@ -155,8 +168,17 @@ class Unmarker : public ObjectVisitor {
   }
 
   static void UnmarkAll(Isolate* isolate) {
-    Unmarker unmarker;
-    isolate->heap()->VisitObjectsNoImagePages(&unmarker);
+    const intptr_t num_visitors = FLAG_heap_iteration_tasks;
+    RELEASE_ASSERT(num_visitors >= 1);
+    ObjectVisitor** unmarkers = new ObjectVisitor*[num_visitors];
+    for (intptr_t i = 0; i < num_visitors; i++) {
+      unmarkers[i] = new Unmarker();
+    }
+    isolate->heap()->VisitObjectsNoImagePagesParallel(unmarkers, num_visitors);
+    for (intptr_t i = 0; i < num_visitors; i++) {
+      delete unmarkers[i];
+    }
+    delete[] unmarkers;
   }
 
  private:
@@ -506,9 +528,10 @@ intptr_t ObjectGraph::InboundReferences(Object* obj, const Array& references) {
   return visitor.length();
 }
 
-static void WritePtr(RawObject* raw, WriteStream* stream) {
+static void WritePtr(RawObject* raw, ObjectGraph::ChunkedWriter* stream) {
   ASSERT(raw->IsHeapObject());
-  ASSERT(raw->IsOldObject());
+  // New-space objects do not move while the graph is written under a
+  // HeapIterationScope, so their addresses are stable ids too.
   uword addr = RawObject::ToAddr(raw);
   ASSERT(Utils::IsAligned(addr, kObjectAlignment));
   // Using units of kObjectAlignment makes the ids fit into Smis when parsed
@@ -520,7 +543,7 @@ static void WritePtr(RawObject* raw, WriteStream* stream) {
 class WritePointerVisitor : public ObjectPointerVisitor {
  public:
   WritePointerVisitor(Isolate* isolate,
-                      WriteStream* stream,
+                      ObjectGraph::ChunkedWriter* stream,
                       bool only_instances)
       : ObjectPointerVisitor(isolate),
         stream_(stream),
@@ -547,7 +570,7 @@ class WritePointerVisitor : public ObjectPointerVisitor {
   intptr_t count() const { return count_; }
 
  private:
-  WriteStream* stream_;
+  ObjectGraph::ChunkedWriter* stream_;
   bool only_instances_;
   intptr_t count_;
 };
@@ -555,7 +578,7 @@ class WritePointerVisitor : public ObjectPointerVisitor {
 static void WriteHeader(RawObject* raw,
                         intptr_t size,
                         intptr_t cid,
-                        WriteStream* stream) {
+                        ObjectGraph::ChunkedWriter* stream) {
   WritePtr(raw, stream);
   ASSERT(Utils::IsAligned(size, kObjectAlignment));
   stream->WriteUnsigned(size);
@@ -565,7 +588,7 @@ static void WriteHeader(RawObject* raw,
 class WriteGraphVisitor : public ObjectGraph::Visitor {
  public:
   WriteGraphVisitor(Isolate* isolate,
-                    WriteStream* stream,
+                    ObjectGraph::ChunkedWriter* stream,
                     ObjectGraph::SnapshotRoots roots)
       : stream_(stream),
         ptr_writer_(isolate, stream, roots == ObjectGraph::kUser),
@@ -592,7 +615,7 @@ class WriteGraphVisitor : public ObjectGraph::Visitor {
   intptr_t count() const { return count_; }
 
  private:
-  WriteStream* stream_;
+  ObjectGraph::ChunkedWriter* stream_;
   WritePointerVisitor ptr_writer_;
   ObjectGraph::SnapshotRoots roots_;
   intptr_t count_;
@@ -600,7 +623,8 @@ class WriteGraphVisitor : public ObjectGraph::Visitor {
 
 class WriteGraphExternalSizesVisitor : public HandleVisitor {
  public:
-  WriteGraphExternalSizesVisitor(Thread* thread, WriteStream* stream)
+  WriteGraphExternalSizesVisitor(Thread* thread,
+                                 ObjectGraph::ChunkedWriter* stream)
       : HandleVisitor(thread), stream_(stream) {}
 
   void VisitHandle(uword addr) {
@@ -615,19 +639,10 @@ class WriteGraphExternalSizesVisitor : public HandleVisitor {
   }
 
  private:
-  WriteStream* stream_;
+  ObjectGraph::ChunkedWriter* stream_;
 };
 
-intptr_t ObjectGraph::Serialize(WriteStream* stream,
-                                SnapshotRoots roots,
-                                bool collect_garbage) {
-  if (collect_garbage) {
-    isolate()->heap()->CollectAllGarbage();
-  }
-  // Current encoding assumes objects do not move, so promote everything to old.
-  isolate()->heap()->new_space()->Evacuate();
-  HeapIterationScope iteration_scope(Thread::Current(), true);
-
+intptr_t ObjectGraph::WriteGraph(ChunkedWriter* stream, SnapshotRoots roots) {
   RawObject* kRootAddress = reinterpret_cast<RawObject*>(kHeapObjectTag);
   const intptr_t kRootCid = kIllegalCid;
   RawObject* kStackAddress =
@@ -680,4 +695,677 @@ intptr_t ObjectGraph::Serialize(WriteStream* stream,
   return object_count;
 }
 
+// The objects reachable from the isolate's roots as a graph in compressed
+// sparse row form, and its dominator tree. Node 0 is the root and node i > 0
+// is objects_[i - 1]. The objects are sorted by address, so the node of a
+// pointer target is found by binary search instead of in a side table. The
+// successors of node i are succs_[succ_starts_[i]] to
+// succs_[succ_starts_[i + 1] - 1]; predecessors are stored alike.
+//
+// Dominators are computed with the iterative algorithm of Cooper, Harvey and
+// Kennedy ("A Simple, Fast Dominance Algorithm"), starting from the
+// depth-first spanning tree. Every dominator of a node is one of its
+// ancestors in that tree, and each update only moves an immediate dominator
+// further up, so the workers can update slices of the nodes concurrently
+// while reading each other's results. The iteration ends after a round in
+// which no worker changed any dominator.
+class DominatorGraph : public ValueObject {
+ public:
+  DominatorGraph(HeapIterationScope* scope,
+                 Isolate* isolate,
+                 intptr_t num_workers)
+      : scope_(scope),
+        isolate_(isolate),
+        num_workers_(num_workers),
+        barrier_(NULL),
+        num_nodes_(0),
+        num_reachable_(0),
+        succ_starts_(NULL),
+        succs_(NULL),
+        pred_starts_(NULL),
+        preds_(NULL),
+        postorder_numbers_(NULL),
+        postorder_(NULL),
+        idoms_(NULL),
+        retained_sizes_(NULL) {
+    for (intptr_t i = 0; i < kNumChangedFlags; i++) {
+      changed_[i] = false;
+    }
+  }
+
+  ~DominatorGraph() {
+    delete[] succ_starts_;
+    delete[] succs_;
+    delete[] pred_starts_;
+    delete[] preds_;
+    delete[] postorder_numbers_;
+    delete[] postorder_;
+    delete[] idoms_;
+    delete[] retained_sizes_;
+  }
+
+  void AddObject(RawObject* obj) { objects_.Add(obj); }
+
+  // Must be called after all objects were added, and before Work.
+  void Prepare(ThreadBarrier* barrier);
+
+  // Runs the part of worker 'worker' in building the graph and computing
+  // the dominators. Worker 0 runs the serial phases and must be the thread
+  // holding the HeapIterationScope.
+  void Work(intptr_t worker);
+
+  void Summarize(Zone* zone,
+                 intptr_t top,
+                 intptr_t path_limit,
+                 ObjectGraph::RetainedSizes* result);
+
+  // Returns 0 if 'obj' is not the object of a node.
+  intptr_t NodeOf(RawObject* obj) const {
+    if (!obj->IsHeapObject()) {
+      return 0;
+    }
+    intptr_t low = 0;
+    intptr_t high = objects_.length() - 1;
+    while (low <= high) {
+      intptr_t mid = low + ((high - low) / 2);
+      RawObject* current = objects_[mid];
+      if (current == obj) {
+        return mid + 1;
+      } else if (current < obj) {
+        low = mid + 1;
+      } else {
+        high = mid - 1;
+      }
+    }
+    return 0;
+  }
+
+ private:
+  static const uint32_t kNoNode = kMaxUint32;
+  // See Work for how the flags are cleared.
+  static const intptr_t kNumChangedFlags = 3;
+
+  struct Frame {
+    uint32_t node;
+    intptr_t next;  // The next successor or child to visit.
+  };
+
+  static int CompareAddresses(RawObject* const* a, RawObject* const* b) {
+    if (*a < *b) {
+      return -1;
+    }
+    return (*a == *b) ? 0 : 1;
+  }
+
+  // The nodes of worker 'worker' are [*start, *end[ of [0, count[.
+  void Slice(intptr_t worker,
+             intptr_t count,
+             intptr_t* start,
+             intptr_t* end) const {
+    *start = (count * worker) / num_workers_;
+    *end = (count * (worker + 1)) / num_workers_;
+  }
+
+  void VisitSuccessors(intptr_t node, ObjectPointerVisitor* visitor) const;
+  void CountEdges(intptr_t worker);
+  void AllocateEdges();
+  void FillEdges(intptr_t worker);
+  void BuildPredecessors();
+  void NumberNodes();
+  bool UpdateDominators(intptr_t worker);
+  uint32_t Intersect(uint32_t finger1, uint32_t finger2) const;
+
+  HeapIterationScope* scope_;
+  Isolate* isolate_;
+  const intptr_t num_workers_;
+  ThreadBarrier* barrier_;
+  MallocGrowableArray<RawObject*> objects_;
+  intptr_t num_nodes_;
+  intptr_t num_reachable_;
+  intptr_t* succ_starts_;
+  uint32_t* succs_;
+  intptr_t* pred_starts_;
+  uint32_t* preds_;
+  uint32_t* postorder_numbers_;
+  uint32_t* postorder_;
+  uint32_t* idoms_;
+  intptr_t* retained_sizes_;
+  bool changed_[kNumChangedFlags];
+
+  DISALLOW_COPY_AND_ASSIGN(DominatorGraph);
+};
+
+// Records the nodes of the pointer targets that are objects of the graph. If
+// no edge array is given, they are only counted.
+class DominatorEdgeVisitor : public ObjectPointerVisitor {
+ public:
+  DominatorEdgeVisitor(Isolate* isolate,
+                       const DominatorGraph* graph,
+                       uint32_t* edges)
+      : ObjectPointerVisitor(isolate),
+        graph_(graph),
+        edges_(edges),
+        count_(0) {}
+
+  virtual void VisitPointers(RawObject** first, RawObject** last) {
+    for (RawObject** current = first; current <= last; ++current) {
+      intptr_t node = graph_->NodeOf(*current);
+      if (node == 0) {
+        continue;
+      }
+      if (edges_ != NULL) {
+        edges_[count_] = node;
+      }
+      ++count_;
+    }
+  }
+
+  intptr_t count() const { return count_; }
+
+ private:
+  const DominatorGraph* graph_;
+  uint32_t* edges_;
+  intptr_t count_;
+
+  DISALLOW_COPY_AND_ASSIGN(DominatorEdgeVisitor);
+};
+
+void DominatorGraph::Prepare(ThreadBarrier* barrier) {
+  barrier_ = barrier;
+  objects_.Sort(CompareAddresses);
+  num_nodes_ = objects_.length() + 1;
+  RELEASE_ASSERT(num_nodes_ < kNoNode);
+  succ_starts_ = new intptr_t[num_nodes_ + 1];
+  succ_starts_[0] = 0;
+  retained_sizes_ = new intptr_t[num_nodes_];
+}
+
+void DominatorGraph::VisitSuccessors(intptr_t node,
+                                     ObjectPointerVisitor* visitor) const {
+  if (node == 0) {
+    scope_->IterateObjectPointers(visitor, false);
+  } else {
+    objects_[node - 1]->VisitPointers(visitor);
+  }
+}
+
+void DominatorGraph::CountEdges(intptr_t worker) {
+  intptr_t start, end;
+  Slice(worker, num_nodes_, &start, &end);
+  for (intptr_t i = start; i < end; i++) {
+    DominatorEdgeVisitor visitor(isolate_, this, NULL);
+    VisitSuccessors(i, &visitor);
+    succ_starts_[i + 1] = visitor.count();
+    retained_sizes_[i] = (i == 0) ? 0 : objects_[i - 1]->Size();
+  }
+}
+
+void DominatorGraph::AllocateEdges() {
+  for (intptr_t i = 0; i < num_nodes_; i++) {
+    succ_starts_[i + 1] += succ_starts_[i];
+  }
+  succs_ = new uint32_t[succ_starts_[num_nodes_]];
+}
+
+void DominatorGraph::FillEdges(intptr_t worker) {
+  intptr_t start, end;
+  Slice(worker, num_nodes_, &start, &end);
+  for (intptr_t i = start; i < end; i++) {
+    DominatorEdgeVisitor visitor(isolate_, this, &succs_[succ_starts_[i]]);
+    VisitSuccessors(i, &visitor);
+    ASSERT(visitor.count() == succ_starts_[i + 1] - succ_starts_[i]);
+  }
+}
+
+void DominatorGraph::BuildPredecessors() {
+  const intptr_t num_edges = succ_starts_[num_nodes_];
+  pred_starts_ = new intptr_t[num_nodes_ + 1];
+  for (intptr_t i = 0; i <= num_nodes_; i++) {
+    pred_starts_[i] = 0;
+  }
+  for (intptr_t e = 0; e < num_edges; e++) {
+    pred_starts_[succs_[e] + 1]++;
+  }
+  for (intptr_t i = 0; i < num_nodes_; i++) {
+    pred_starts_[i + 1] += pred_starts_[i];
+  }
+  preds_ = new uint32_t[num_edges];
+  // Filling advances each start to the start of the next node; shift them
+  // back afterwards.
+  for (intptr_t i = 0; i < num_nodes_; i++) {
+    for (intptr_t e = succ_starts_[i]; e < succ_starts_[i + 1]; e++) {
+      preds_[pred_starts_[succs_[e]]++] = i;
+    }
+  }
+  for (intptr_t i = num_nodes_; i > 0; i--) {
+    pred_starts_[i] = pred_starts_[i - 1];
+  }
+  pred_starts_[0] = 0;
+}
+
+void DominatorGraph::NumberNodes() {
+  postorder_numbers_ = new uint32_t[num_nodes_];
+  postorder_ = new uint32_t[num_nodes_];
+  idoms_ = new uint32_t[num_nodes_];
+  for (intptr_t i = 0; i < num_nodes_; i++) {
+    postorder_numbers_[i] = kNoNode;
+    idoms_[i] = kNoNode;
+  }
+  // Each node starts out dominated by its parent in the spanning tree.
+  MallocGrowableArray<Frame> stack;
+  idoms_[0] = 0;
+  Frame root = {0, succ_starts_[0]};
+  stack.Add(root);
+  while (!stack.is_empty()) {
+    const intptr_t top = stack.length() - 1;
+    const uint32_t node = stack[top].node;
+    if (stack[top].next < succ_starts_[node + 1]) {
+      const uint32_t succ = succs_[stack[top].next++];
+      if (idoms_[succ] == kNoNode) {
+        idoms_[succ] = node;
+        Frame frame = {succ, succ_starts_[succ]};
+        stack.Add(frame);
+      }
+    } else {
+      stack.RemoveLast();
+      postorder_numbers_[node] = num_reachable_;
+      postorder_[num_reachable_++] = node;
+    }
+  }
+}
+
+uint32_t DominatorGraph::Intersect(uint32_t finger1, uint32_t finger2) const {
+  while (finger1 != finger2) {
+    while (postorder_numbers_[finger1] < postorder_numbers_[finger2]) {
+      finger1 = AtomicOperations::LoadRelaxed(&idoms_[finger1]);
+    }
+    while (postorder_numbers_[finger2] < postorder_numbers_[finger1]) {
+      finger2 = AtomicOperations::LoadRelaxed(&idoms_[finger2]);
+    }
+  }
+  return finger1;
+}
+
+bool DominatorGraph::UpdateDominators(intptr_t worker) {
+  // Visit the nodes other than the root in reverse postorder.
+  intptr_t start, end;
+  Slice(worker, num_reachable_ - 1, &start, &end);
+  bool changed = false;
+  for (intptr_t i = start; i < end; i++) {
+    const uint32_t node = postorder_[num_reachable_ - 2 - i];
+    uint32_t new_idom = kNoNode;
+    for (intptr_t e = pred_starts_[node]; e < pred_starts_[node + 1]; e++) {
+      const uint32_t pred = preds_[e];
+      if (postorder_numbers_[pred] == kNoNode) {
+        continue;  // Not reachable.
+      }
+      new_idom = (new_idom == kNoNode) ? pred : Intersect(pred, new_idom);
+    }
+    ASSERT(new_idom != kNoNode);
+    if (new_idom != AtomicOperations::LoadRelaxed(&idoms_[node])) {
+      idoms_[node] = new_idom;
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+void DominatorGraph::Work(intptr_t worker) {
+  CountEdges(worker);
+  barrier_->Sync();
+  if (worker == 0) {
+    AllocateEdges();
+  }
+  barrier_->Sync();
+  FillEdges(worker);
+  barrier_->Sync();
+  if (worker == 0) {
+    BuildPredecessors();
+    NumberNodes();
+  }
+  barrier_->Sync();
+  // The flag of round r is read by all workers between the barriers of
+  // rounds r and r + 1, and cleared by worker 0 before the barrier of round
+  // r + 2, when it is next set.
+  for (intptr_t round = 0;; round++) {
+    if (worker == 0) {
+      changed_[(round + 1) % kNumChangedFlags] = false;
+    }
+    if (UpdateDominators(worker)) {
+      changed_[round % kNumChangedFlags] = true;
+    }
+    barrier_->Sync();
+    if (!AtomicOperations::LoadRelaxed(&changed_[round % kNumChangedFlags])) {
+      break;
+    }
+  }
+}
+
+void DominatorGraph::Summarize(Zone* zone,
+                               intptr_t top,
+                               intptr_t path_limit,
+                               ObjectGraph::RetainedSizes* result) {
+  result->node_count = num_reachable_;
+  result->edge_count = succ_starts_[num_nodes_];
+
+  // Dominators have higher postorder numbers than the nodes they dominate.
+  for (intptr_t i = 0; i < num_reachable_ - 1; i++) {
+    const uint32_t node = postorder_[i];
+    retained_sizes_[idoms_[node]] += retained_sizes_[node];
+  }
+
+  // Reuse the predecessor arrays for the children in the dominator tree.
+  intptr_t* child_starts = pred_starts_;
+  uint32_t* children = preds_;
+  for (intptr_t i = 0; i <= num_nodes_; i++) {
+    child_starts[i] = 0;
+  }
+  for (intptr_t i = 0; i < num_reachable_ - 1; i++) {
+    child_starts[idoms_[postorder_[i]] + 1]++;
+  }
+  for (intptr_t i = 0; i < num_nodes_; i++) {
+    child_starts[i + 1] += child_starts[i];
+  }
+  for (intptr_t i = 0; i < num_reachable_ - 1; i++) {
+    const uint32_t node = postorder_[i];
+    children[child_starts[idoms_[node]]++] = node;
+  }
+  for (intptr_t i = num_nodes_; i > 0; i--) {
+    child_starts[i] = child_starts[i - 1];
+  }
+  child_starts[0] = 0;
+
+  // An instance counts towards its class unless one of its dominators is
+  // of the same class.
+  const intptr_t num_cids = isolate_->class_table()->NumCids();
+  ZoneGrowableArray<intptr_t>* class_sizes =
+      new (zone) ZoneGrowableArray<intptr_t>(zone, num_cids);
+  ZoneGrowableArray<intptr_t>* class_counts =
+      new (zone) ZoneGrowableArray<intptr_t>(zone, num_cids);
+  MallocGrowableArray<intptr_t> cid_depths(num_cids);
+  for (intptr_t i = 0; i < num_cids; i++) {
+    class_sizes->Add(0);
+    class_counts->Add(0);
+    cid_depths.Add(0);
+  }
+  result->class_retained_sizes = class_sizes;
+  result->class_instance_counts = class_counts;
+  MallocGrowableArray<Frame> stack;
+  Frame root = {0, child_starts[0]};
+  stack.Add(root);
+  while (!stack.is_empty()) {
+    const intptr_t top_index = stack.length() - 1;
+    const uint32_t node = stack[top_index].node;
+    if (stack[top_index].next < child_starts[node + 1]) {
+      const uint32_t child = children[stack[top_index].next++];
+      const intptr_t cid = objects_[child - 1]->GetClassIdMayBeSmi();
+      if (cid_depths[cid] == 0) {
+        (*class_sizes)[cid] += retained_sizes_[child];
+      }
+      cid_depths[cid]++;
+      (*class_counts)[cid]++;
+      Frame frame = {child, child_starts[child]};
+      stack.Add(frame);
+    } else {
+      stack.RemoveLast();
+      if (node != 0) {
+        cid_depths[objects_[node - 1]->GetClassIdMayBeSmi()]--;
+      }
+    }
+  }
+
+  // Select the 'top' nodes with the largest retained sizes.
+  MallocGrowableArray<uint32_t> top_nodes(top + 1);
+  for (intptr_t i = 0; (top > 0) && (i < num_reachable_ - 1); i++) {
+    const uint32_t node = postorder_[i];
+    const intptr_t size = retained_sizes_[node];
+    intptr_t j = top_nodes.length();
+    if ((j == top) && (size <= retained_sizes_[top_nodes[j - 1]])) {
+      continue;
+    }
+    top_nodes.Add(node);
+    while ((j > 0) && (retained_sizes_[top_nodes[j - 1]] < size)) {
+      top_nodes[j] = top_nodes[j - 1];
+      j--;
+    }
+    top_nodes[j] = node;
+    if (top_nodes.length() > top) {
+      top_nodes.RemoveLast();
+    }
+  }
+  ZoneGrowableArray<const Object*>* path_objects =
+      new (zone) ZoneGrowableArray<const Object*>(zone, 0);
+  ZoneGrowableArray<intptr_t>* path_sizes =
+      new (zone) ZoneGrowableArray<intptr_t>(zone, 0);
+  ZoneGrowableArray<intptr_t>* path_starts =
+      new (zone) ZoneGrowableArray<intptr_t>(zone, top_nodes.length() + 1);
+  for (intptr_t i = 0; i < top_nodes.length(); i++) {
+    path_starts->Add(path_objects->length());
+    uint32_t node = top_nodes[i];
+    for (intptr_t j = 0; (j < path_limit) && (node != 0); j++) {
+      path_objects->Add(&Object::Handle(zone, objects_[node - 1]));
+      path_sizes->Add(retained_sizes_[node]);
+      node = idoms_[node];
+    }
+  }
+  path_starts->Add(path_objects->length());
+  result->path_objects = path_objects;
+  result->path_retained_sizes = path_sizes;
+  result->path_starts = path_starts;
+}
+
+class CollectObjectsVisitor : public ObjectGraph::Visitor {
+ public:
+  explicit CollectObjectsVisitor(DominatorGraph* graph) : graph_(graph) {}
+
+  virtual Direction VisitObject(ObjectGraph::StackIterator* it) {
+    graph_->AddObject(it->Get());
+    return kProceed;
+  }
+
+ private:
+  DominatorGraph* graph_;
+
+  DISALLOW_COPY_AND_ASSIGN(CollectObjectsVisitor);
+};
+
+class DominatorTask : public ThreadPool::Task {
+ public:
+  DominatorTask(Isolate* isolate,
+                ThreadBarrier* barrier,
+                DominatorGraph* graph,
+                intptr_t worker)
+      : isolate_(isolate), barrier_(barrier), graph_(graph), worker_(worker) {}
+
+  virtual void Run() {
+    bool result = Thread::EnterIsolateAsHelper(
+        isolate_, Thread::kHeapIterationTask, true);
+    ASSERT(result);
+    {
+      Thread* thread = Thread::Current();
+      TIMELINE_FUNCTION_GC_DURATION(thread, "DominatorTask");
+      graph_->Work(worker_);
+    }
+    Thread::ExitIsolateAsHelper(true);
+    barrier_->Exit();
+  }
+
+ private:
+  Isolate* isolate_;
+  ThreadBarrier* barrier_;
+  DominatorGraph* graph_;
+  const intptr_t worker_;
+
+  DISALLOW_COPY_AND_ASSIGN(DominatorTask);
+};
+
+void ObjectGraph::ComputeRetainedSizes(intptr_t top,
+                                       intptr_t path_limit,
+                                       bool collect_garbage,
+                                       RetainedSizes* result) {
+  ASSERT(path_limit > 0);
+  Thread* thread = Thread::Current();
+  Heap* heap = isolate()->heap();
+  if (collect_garbage) {
+    heap->CollectAllGarbage();
+  }
+  HeapIterationScope iteration_scope(thread, true);
+  DominatorGraph graph(&iteration_scope, isolate(),
+                       FLAG_heap_iteration_tasks);
+  CollectObjectsVisitor collector(&graph);
+  IterateObjects(&collector);
+  {
+    const intptr_t num_workers = FLAG_heap_iteration_tasks;
+    RELEASE_ASSERT(num_workers >= 1);
+    ThreadBarrier barrier(num_workers, heap->barrier(), heap->barrier_done());
+    graph.Prepare(&barrier);
+    for (intptr_t i = 1; i < num_workers; i++) {
+      Dart::thread_pool()->Run(
+          new DominatorTask(isolate(), &barrier, &graph, i));
+    }
+    graph.Work(0);
+    barrier.Exit();
+  }
+  graph.Summarize(thread->zone(), top, path_limit, result);
+}
+
+// Only measures the size of the serialized graph.
+class CountingChunkedWriter : public ObjectGraph::ChunkedWriter {
+ public:
+  CountingChunkedWriter() : ObjectGraph::ChunkedWriter(4 * KB) {}
+
+ protected:
+  virtual void WriteChunk(const uint8_t* chunk, intptr_t size) {}
+};
+
+intptr_t ObjectGraph::Serialize(ChunkedWriter* writer,
+                                SnapshotRoots roots,
+                                bool collect_garbage) {
+  if (collect_garbage) {
+    isolate()->heap()->CollectAllGarbage();
+  }
+  // Promote everything to old space so that ids do not depend on which
+  // objects happened to survive in new space.
+  isolate()->heap()->new_space()->Evacuate();
+  return WriteGraphUnmoved(writer, roots);
+}
+
+intptr_t ObjectGraph::WriteGraphUnmoved(ChunkedWriter* writer,
+                                        SnapshotRoots roots) {
+  // The heap does not change while this scope is held, so measuring and
+  // writing produce the same bytes.
+  HeapIterationScope iteration_scope(Thread::Current(), true);
+
+  if (writer->NeedsMeasure()) {
+    CountingChunkedWriter counter;
+    intptr_t node_count = WriteGraph(&counter, roots);
+    counter.Flush();
+    writer->Begin(counter.bytes_written(), node_count);
+  }
+  intptr_t node_count = WriteGraph(writer, roots);
+  writer->Flush();
+  return node_count;
+}
+
+ObjectGraph::ChunkedWriter::ChunkedWriter(intptr_t chunk_size)
+    : buffer_(reinterpret_cast<uint8_t*>(malloc(chunk_size))),
+      current_(buffer_),
+      end_(buffer_ + chunk_size),
+      bytes_flushed_(0) {
+  if (buffer_ == NULL) {
+    OUT_OF_MEMORY();
+  }
+}
+
+ObjectGraph::ChunkedWriter::~ChunkedWriter() {
+  ASSERT(current_ == buffer_);  // Guard against discarding unflushed bytes.
+  free(buffer_);
+}
+
+void ObjectGraph::ChunkedWriter::WriteUnsigned(intptr_t value) {
+  ASSERT((value >= 0) && (value <= kIntptrMax));
+  while (value > kMaxUnsignedDataPerByte) {
+    WriteByte(static_cast<uint8_t>(value & kByteMask));
+    value = value >> kDataBitsPerByte;
+  }
+  WriteByte(static_cast<uint8_t>(value + kEndUnsignedByteMarker));
+}
+
+void ObjectGraph::ChunkedWriter::Flush() {
+  const intptr_t size = current_ - buffer_;
+  if (size == 0) {
+    return;
+  }
+  WriteChunk(buffer_, size);
+  bytes_flushed_ += size;
+  current_ = buffer_;
+}
+
+// Writes the node count and the serialized graph to a file opened with the
+// embedder's callbacks.
+class FileChunkedWriter : public ObjectGraph::ChunkedWriter {
+ public:
+  explicit FileChunkedWriter(void* file)
+      : ObjectGraph::ChunkedWriter(kChunkSize), file_(file) {}
+
+  // Readers need the node count up front.
+  virtual bool NeedsMeasure() const { return true; }
+  virtual void Begin(intptr_t total_bytes, intptr_t node_count) {
+    WriteUnsigned(node_count);
+  }
+
+ protected:
+  virtual void WriteChunk(const uint8_t* chunk, intptr_t size) {
+    Dart_FileWriteCallback file_write = Dart::file_write_callback();
+    (*file_write)(chunk, size, file_);
+  }
+
+ private:
+  static const intptr_t kChunkSize = 64 * KB;
+
+  void* file_;
+
+  DISALLOW_COPY_AND_ASSIGN(FileChunkedWriter);
+};
+
+bool ObjectGraph::SerializeToFile(const char* filename, SnapshotRoots roots) {
+  Dart_FileOpenCallback file_open = Dart::file_open_callback();
+  Dart_FileWriteCallback file_write = Dart::file_write_callback();
+  Dart_FileCloseCallback file_close = Dart::file_close_callback();
+  if ((file_open == NULL) || (file_write == NULL) || (file_close == NULL)) {
+    return false;
+  }
+  void* file = (*file_open)(filename, true);
+  if (file == NULL) {
+    return false;
+  }
+  {
+    FileChunkedWriter writer(file);
+    WriteGraphUnmoved(&writer, roots);
+  }
+  (*file_close)(file);
+  return true;
+}
+
+static uint32_t heap_snapshot_at_oom_written = 0;
+
+void ObjectGraph::SerializeAtOOM(Thread* thread) {
+  if ((FLAG_snapshot_heap_at_oom == NULL) || !thread->IsMutatorThread()) {
+    return;
+  }
+  if (AtomicOperations::CompareAndSwapUint32(&heap_snapshot_at_oom_written,
+                                             0, 1) != 0) {
+    return;
+  }
+  char* filename = OS::SCreate(NULL, "%s/dart-heap-%" Pd ".graph",
+                               FLAG_snapshot_heap_at_oom, OS::ProcessId());
+  ObjectGraph graph(thread);
+  if (graph.SerializeToFile(filename, kVM)) {
+    OS::PrintErr("Wrote heap snapshot to %s\n", filename);
+  } else {
+    OS::PrintErr("Failed to write heap snapshot: %s\n", filename);
+  }
+  free(filename);
+}
+
 }  // namespace dart
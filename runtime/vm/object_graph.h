@@ -13,7 +13,8 @@ class Array;
 class Isolate;
 class Object;
 class RawObject;
-class WriteStream;
+template <typename T>
+class ZoneGrowableArray;
 
 // Utility to traverse the object graph in an ordered fashion.
 // Example uses:
@@ -57,6 +58,52 @@ class ObjectGraph : public StackResource {
     virtual Direction VisitObject(StackIterator* it) = 0;
   };
 
+  // Receives a serialized object graph in chunks of at most 'chunk_size'
+  // bytes while the heap is being walked, so that the snapshot of a large
+  // heap is never held in memory as a whole.
+  class ChunkedWriter {
+   public:
+    explicit ChunkedWriter(intptr_t chunk_size);
+    virtual ~ChunkedWriter();
+
+    // Uses the same variable-length encoding as WriteStream::WriteUnsigned.
+    void WriteUnsigned(intptr_t value);
+
+    // Passes the buffered bytes, if any, to WriteChunk.
+    void Flush();
+
+    intptr_t bytes_written() const {
+      return bytes_flushed_ + (current_ - buffer_);
+    }
+
+    // If true, Serialize first measures the snapshot and calls Begin with
+    // its size and node count before writing anything.
+    virtual bool NeedsMeasure() const { return false; }
+    virtual void Begin(intptr_t total_bytes, intptr_t node_count) {}
+
+   protected:
+    intptr_t chunk_size() const { return end_ - buffer_; }
+
+    // Consumes the next 'size' bytes of the snapshot. All chunks but the
+    // last one are exactly chunk_size() bytes long.
+    virtual void WriteChunk(const uint8_t* chunk, intptr_t size) = 0;
+
+   private:
+    void WriteByte(uint8_t value) {
+      if (current_ == end_) {
+        Flush();
+      }
+      *current_++ = value;
+    }
+
+    uint8_t* buffer_;
+    uint8_t* current_;
+    uint8_t* end_;
+    intptr_t bytes_flushed_;
+
+    DISALLOW_COPY_AND_ASSIGN(ChunkedWriter);
+  };
+
   explicit ObjectGraph(Thread* thread);
   ~ObjectGraph();
 
@@ -99,16 +146,69 @@ class ObjectGraph : public StackResource {
 
   enum SnapshotRoots { kVM, kUser };
 
-  // Write the isolate's object graph to 'stream'. Smis and nulls are omitted.
+  // Write the isolate's object graph to 'writer'. Smis and nulls are omitted.
   // Returns the number of nodes in the stream, including the root.
   // If collect_garbage is false, the graph will include weakly-reachable
   // objects.
-  // TODO(koda): Document format; support streaming/chunking.
-  intptr_t Serialize(WriteStream* stream,
+  // TODO(koda): Document format.
+  intptr_t Serialize(ChunkedWriter* writer,
                      SnapshotRoots roots,
                      bool collect_garbage);
 
+  // Writes the node count followed by the object graph to 'filename' with
+  // the embedder's file callbacks. Returns false if the file could not be
+  // opened. Neither collects garbage nor evacuates new space, so it is safe
+  // to use when the heap is full.
+  bool SerializeToFile(const char* filename, SnapshotRoots roots);
+
+  // The result of ComputeRetainedSizes.
+  struct RetainedSizes {
+    RetainedSizes()
+        : node_count(0),
+          edge_count(0),
+          class_retained_sizes(NULL),
+          class_instance_counts(NULL),
+          path_objects(NULL),
+          path_retained_sizes(NULL),
+          path_starts(NULL) {}
+
+    intptr_t node_count;
+    intptr_t edge_count;
+    // Indexed by class id. The retained size of a class is the sum of the
+    // sizes retained by its instances that are not themselves retained by
+    // another instance of the class.
+    ZoneGrowableArray<intptr_t>* class_retained_sizes;
+    ZoneGrowableArray<intptr_t>* class_instance_counts;
+    // The objects retaining the most memory, largest first. The path of the
+    // i-th object starts with the object itself, followed by its chain of
+    // dominators up to, but excluding, the roots; the path occupies
+    // path_objects[path_starts[i]] to path_objects[path_starts[i + 1] - 1].
+    ZoneGrowableArray<const Object*>* path_objects;
+    ZoneGrowableArray<intptr_t>* path_retained_sizes;
+    ZoneGrowableArray<intptr_t>* path_starts;
+  };
+
+  // Computes the dominator tree of the objects reachable from the isolate's
+  // roots, using --heap_iteration_tasks threads, and summarizes it into
+  // 'result': the retained size of each class and the retaining paths of the
+  // 'top' objects with the largest retained sizes, each limited to
+  // 'path_limit' > 0 objects. The handles and arrays in 'result' are zone
+  // allocated.
+  void ComputeRetainedSizes(intptr_t top,
+                            intptr_t path_limit,
+                            bool collect_garbage,
+                            RetainedSizes* result);
+
+  // Writes a snapshot into the directory given by --snapshot_heap_at_oom
+  // the first time a mutator runs out of memory.
+  static void SerializeAtOOM(Thread* thread);
+
  private:
+  intptr_t WriteGraph(ChunkedWriter* writer, SnapshotRoots roots);
+  // Measures the graph if the writer needs it, then writes it, without
+  // moving any objects.
+  intptr_t WriteGraphUnmoved(ChunkedWriter* writer, SnapshotRoots roots);
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(ObjectGraph);
 };
 
@@ -138,4 +138,97 @@ ISOLATE_UNIT_TEST_CASE(ObjectGraph) {
   }
 }
 
+// Checks that the snapshot arrives in chunks of the promised sizes.
+class CheckChunksWriter : public ObjectGraph::ChunkedWriter {
+ public:
+  static const intptr_t kChunkSize = 256;
+
+  CheckChunksWriter()
+      : ObjectGraph::ChunkedWriter(kChunkSize),
+        total_bytes_(-1),
+        node_count_(-1),
+        received_bytes_(0),
+        short_chunks_(0) {}
+
+  virtual bool NeedsMeasure() const { return true; }
+  virtual void Begin(intptr_t total_bytes, intptr_t node_count) {
+    EXPECT_EQ(0, bytes_written());
+    total_bytes_ = total_bytes;
+    node_count_ = node_count;
+  }
+
+  intptr_t total_bytes() const { return total_bytes_; }
+  intptr_t node_count() const { return node_count_; }
+  intptr_t received_bytes() const { return received_bytes_; }
+  intptr_t short_chunks() const { return short_chunks_; }
+
+ protected:
+  virtual void WriteChunk(const uint8_t* chunk, intptr_t size) {
+    EXPECT_LE(size, kChunkSize);
+    if (size < kChunkSize) {
+      short_chunks_++;
+    }
+    received_bytes_ += size;
+  }
+
+ private:
+  intptr_t total_bytes_;
+  intptr_t node_count_;
+  intptr_t received_bytes_;
+  intptr_t short_chunks_;
+};
+
+ISOLATE_UNIT_TEST_CASE(ObjectGraphSerializeChunked) {
+  Array& list = Array::Handle(Array::New(1000, Heap::kOld));
+  for (intptr_t i = 0; i < list.Length(); i++) {
+    list.SetAt(i, Array::Handle(Array::New(1, Heap::kNew)));
+  }
+  CheckChunksWriter writer;
+  {
+    ObjectGraph graph(thread);
+    intptr_t node_count = graph.Serialize(&writer, ObjectGraph::kVM, false);
+    EXPECT_EQ(writer.node_count(), node_count);
+    EXPECT_LE(list.Length(), node_count);
+  }
+  EXPECT_EQ(writer.total_bytes(), writer.received_bytes());
+  EXPECT_EQ(writer.total_bytes(), writer.bytes_written());
+  EXPECT_LE(CheckChunksWriter::kChunkSize, writer.total_bytes());
+  EXPECT_LE(writer.short_chunks(), 1);
+}
+
+ISOLATE_UNIT_TEST_CASE(ObjectGraphRetainedSizes) {
+  // Only the handle refers to 'a', and only 'a' to its elements, so 'a'
+  // retains them all.
+  const intptr_t kLength = 200000;
+  Array& a = Array::Handle(Array::New(kLength, Heap::kOld));
+  Array& element = Array::Handle();
+  for (intptr_t i = 0; i < kLength; i++) {
+    element = Array::New(1, Heap::kOld);
+    a.SetAt(i, element);
+  }
+  element = Array::null();
+  const intptr_t expected_size =
+      Array::InstanceSize(kLength) + (kLength * Array::InstanceSize(1));
+  ObjectGraph::RetainedSizes sizes;
+  {
+    ObjectGraph graph(thread);
+    graph.ComputeRetainedSizes(50, 4, false, &sizes);
+  }
+  EXPECT_LE(kLength + 1, sizes.node_count);
+  EXPECT_LE(sizes.node_count - 1, sizes.edge_count);
+  EXPECT_LE(kLength + 1, sizes.class_instance_counts->At(kArrayCid));
+  EXPECT_LE(expected_size, sizes.class_retained_sizes->At(kArrayCid));
+  bool found = false;
+  for (intptr_t i = 0; i < sizes.path_starts->length() - 1; i++) {
+    const intptr_t start = sizes.path_starts->At(i);
+    if (sizes.path_objects->At(start)->raw() == a.raw()) {
+      EXPECT_EQ(expected_size, sizes.path_retained_sizes->At(start));
+      // 'a' is dominated by the roots only.
+      EXPECT_EQ(start + 1, sizes.path_starts->At(i + 1));
+      found = true;
+    }
+  }
+  EXPECT(found);
+}
+
 }  // namespace dart
@@ -44,7 +44,8 @@ int32_t ObjectIdRing::GetIdForObject(RawObject* object, IdPolicy policy) {
 }
 
 int32_t ObjectIdRing::FindExistingIdForObject(RawObject* raw_obj) {
-  for (int32_t i = 0; i < capacity_; i++) {
+  const int32_t used = UsedEntries();
+  for (int32_t i = 0; i < used; i++) {
     if (table_[i] == raw_obj) {
       return IdOfIndex(i);
     }
@@ -71,7 +72,12 @@ RawObject* ObjectIdRing::GetObjectForId(int32_t id, LookupResult* kind) {
 
 void ObjectIdRing::VisitPointers(ObjectPointerVisitor* visitor) {
   ASSERT(table_ != NULL);
-  visitor->VisitPointers(table_, capacity_);
+  // Avoid visiting the never used part of the ring on every GC, which is all
+  // of it for isolates that were never inspected through the service.
+  const int32_t used = UsedEntries();
+  if (used > 0) {
+    visitor->VisitPointers(table_, used);
+  }
 }
 
 void ObjectIdRing::PrintJSON(JSONStream* js) {
@@ -120,6 +126,15 @@ void ObjectIdRing::SetCapacityAndMaxSerial(int32_t capacity,
   max_serial_ = max_serial - (max_serial % capacity_);
 }
 
+int32_t ObjectIdRing::UsedEntries() const {
+  // Until the serial numbers have reached the capacity, entries are handed out
+  // sequentially from the start of the table.
+  if (wrapped_ || (serial_num_ >= capacity_)) {
+    return capacity_;
+  }
+  return serial_num_;
+}
+
 int32_t ObjectIdRing::NextSerial() {
   int32_t r = serial_num_;
   serial_num_++;
@@ -72,6 +72,9 @@ class ObjectIdRing {
   RawObject** table() { return table_; }
   int32_t table_size() { return capacity_; }
 
+  // Number of entries at the start of table_ that may hold an object.
+  int32_t UsedEntries() const;
+
   int32_t NextSerial();
   int32_t AllocateNewId(RawObject* object);
   int32_t IndexOfId(int32_t id);
@@ -67,6 +67,8 @@ class ObjectSet : public ZoneAllocated {
     return false;
   }
 
+  // Not synchronized, but objects in different regions can be added
+  // concurrently since each region has its own bit vector.
   void Add(RawObject* raw_obj) {
     uword raw_addr = RawObject::ToAddr(raw_obj);
     for (ObjectSetRegion* region = head_; region != NULL;
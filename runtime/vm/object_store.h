@@ -126,6 +126,8 @@ class ObjectPointerVisitor;
   R_(Function, megamorphic_miss_function)                                      \
   RW(Array, obfuscation_map)                                                   \
   RW(GrowableObjectArray, changed_in_last_reload)                              \
+  RW(GrowableObjectArray, osr_code_cache)                                      \
+  RW(TypedData, type_feedback)                                                 \
 // Please remember the last entry must be referred in the 'to' function below.
 
 // The object store is a per isolate instance which stores references to
@@ -218,7 +220,7 @@ class ObjectStore {
                           DECLARE_OBJECT_STORE_FIELD)
 #undef DECLARE_OBJECT_STORE_FIELD
   RawObject** to() {
-    return reinterpret_cast<RawObject**>(&changed_in_last_reload_);
+    return reinterpret_cast<RawObject**>(&type_feedback_);
   }
   RawObject** to_snapshot(Snapshot::Kind kind) {
     switch (kind) {
@@ -13,6 +13,7 @@
 #include "vm/debugger_api_impl_test.h"
 #include "vm/isolate.h"
 #include "vm/malloc_hooks.h"
+#include "vm/megamorphic_cache_table.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/simulator.h"
@@ -1660,6 +1661,46 @@ ISOLATE_UNIT_TEST_CASE(ExternalOneByteString) {
   EXPECT(substr.Equals("\xC3\xB1"));
 }
 
+ISOLATE_UNIT_TEST_CASE(OneByteStringIndexOf) {
+  const String& str = String::Handle(String::New("abcabdabc"));
+  const String& abc = String::Handle(String::New("abc"));
+  const String& abd = String::Handle(String::New("abd"));
+  const String& cab = String::Handle(String::New("cabx"));
+  EXPECT(str.IsOneByteString());
+  EXPECT_EQ(0, OneByteString::IndexOf(str, abc, 0));
+  EXPECT_EQ(6, OneByteString::IndexOf(str, abc, 1));
+  EXPECT_EQ(6, OneByteString::IndexOf(str, abc, 6));
+  EXPECT_EQ(-1, OneByteString::IndexOf(str, abc, 7));
+  EXPECT_EQ(3, OneByteString::IndexOf(str, abd, 0));
+  EXPECT_EQ(-1, OneByteString::IndexOf(str, cab, 0));
+  EXPECT_EQ(9, OneByteString::IndexOf(str, Symbols::Empty(), 9));
+  EXPECT_EQ(-1, OneByteString::IndexOf(abc, str, 0));
+}
+
+ISOLATE_UNIT_TEST_CASE(OneByteStringCaseConversion) {
+  const String& mixed = String::Handle(String::New("Content-Type: 42"));
+  EXPECT(mixed.IsOneByteString());
+  const String& lower = String::Handle(String::ToLowerCase(mixed));
+  EXPECT(lower.IsOneByteString());
+  EXPECT(lower.Equals("content-type: 42"));
+  const String& upper = String::Handle(String::ToUpperCase(mixed));
+  EXPECT(upper.IsOneByteString());
+  EXPECT(upper.Equals("CONTENT-TYPE: 42"));
+
+  // Strings that need no conversion are returned unchanged.
+  EXPECT(String::ToLowerCase(lower) == lower.raw());
+  EXPECT(String::ToUpperCase(upper) == upper.raw());
+
+  // Latin-1 characters take the full Unicode case mapping.
+  const uint8_t latin1[] = {'a', 0xE9, 0xFF};
+  const String& wide_upper = String::Handle(
+      String::ToUpperCase(String::Handle(String::FromLatin1(latin1, 3))));
+  EXPECT(wide_upper.IsTwoByteString());
+  EXPECT_EQ('A', wide_upper.CharAt(0));
+  EXPECT_EQ(0xC9, wide_upper.CharAt(1));
+  EXPECT_EQ(0x178, wide_upper.CharAt(2));
+}
+
 ISOLATE_UNIT_TEST_CASE(EscapeSpecialCharactersOneByteString) {
   uint8_t characters[] = {'a',  '\n', '\f', '\b', '\t',
                           '\v', '\r', '\\', '$',  'z'};
@@ -1909,6 +1950,33 @@ ISOLATE_UNIT_TEST_CASE(Array) {
   EXPECT(obj.IsArray());
 }
 
+ISOLATE_UNIT_TEST_CASE(ArrayCopyFrom) {
+  const intptr_t kArrayLen = 8;
+  const Array& array = Array::Handle(Array::New(kArrayLen, Heap::kOld));
+  for (intptr_t i = 0; i < kArrayLen; i++) {
+    array.SetAt(i, Smi::Handle(Smi::New(i)));
+  }
+  // Overlapping copies in both directions.
+  array.CopyFrom(2, array, 0, 4);
+  EXPECT_EQ(0, Smi::Value(Smi::RawCast(array.At(2))));
+  EXPECT_EQ(3, Smi::Value(Smi::RawCast(array.At(5))));
+  EXPECT_EQ(6, Smi::Value(Smi::RawCast(array.At(6))));
+  array.CopyFrom(0, array, 3, 4);
+  EXPECT_EQ(1, Smi::Value(Smi::RawCast(array.At(0))));
+  EXPECT_EQ(3, Smi::Value(Smi::RawCast(array.At(2))));
+  EXPECT_EQ(6, Smi::Value(Smi::RawCast(array.At(3))));
+  EXPECT(!array.raw()->IsRemembered());
+
+  // Copying new-space values into an old-space array must remember it.
+  const Array& young = Array::Handle(Array::New(2, Heap::kNew));
+  const String& str = String::Handle(String::New("young", Heap::kNew));
+  young.SetAt(1, str);
+  array.CopyFrom(6, young, 0, 2);
+  EXPECT(array.At(6) == Object::null());
+  EXPECT_EQ(str.raw(), array.At(7));
+  EXPECT(array.raw()->IsRemembered());
+}
+
 static void TestIllegalArrayLength(intptr_t length) {
   char buffer[1024];
   OS::SNPrint(buffer, sizeof(buffer),
@@ -3054,6 +3122,42 @@ ISOLATE_UNIT_TEST_CASE(ICData) {
   EXPECT_EQ(target1.raw(), scall_icdata.GetTargetAt(0));
 }
 
+ISOLATE_UNIT_TEST_CASE(MegamorphicCache) {
+  const String& name = String::Handle(Symbols::New(thread, "Thun"));
+  const intptr_t kTypeArgsLen = 0;
+  const intptr_t kNumArgs = 1;
+  const Array& args_descriptor = Array::Handle(
+      ArgumentsDescriptor::New(kTypeArgsLen, kNumArgs, Object::null_array()));
+  const MegamorphicCache& cache = MegamorphicCache::Handle(
+      MegamorphicCacheTable::Lookup(thread->isolate(), name, args_descriptor));
+  EXPECT_EQ(0, cache.filled_entry_count());
+
+  const Function& even = Function::Handle(GetDummyTarget("Thun"));
+  const Function& odd = Function::Handle(GetDummyTarget("Thun"));
+  const intptr_t kNumEntries = 4 * MegamorphicCache::kInitialCapacity;
+  Smi& cid = Smi::Handle();
+  for (intptr_t i = 0; i < kNumEntries; i++) {
+    cid = Smi::New(kNumPredefinedCids + 16 * i);
+    EXPECT_EQ(Function::null(), cache.Lookup(cid));
+    cache.EnsureCapacity();
+    cache.Insert(cid, ((i & 1) == 0) ? even : odd);
+  }
+  EXPECT_EQ(kNumEntries, cache.filled_entry_count());
+  for (intptr_t i = 0; i < kNumEntries; i++) {
+    cid = Smi::New(kNumPredefinedCids + 16 * i);
+    EXPECT_EQ(((i & 1) == 0) ? even.raw() : odd.raw(), cache.Lookup(cid));
+  }
+  cid = Smi::New(kNumPredefinedCids + 1);
+  EXPECT_EQ(Function::null(), cache.Lookup(cid));
+
+  // Reserving room for many entries grows the buckets in one step.
+  cache.EnsureCapacity(kNumEntries);
+  EXPECT_LE(4 * kNumEntries, cache.mask() + 1);
+  EXPECT_EQ(kNumEntries, cache.filled_entry_count());
+  cid = Smi::New(kNumPredefinedCids + 16);
+  EXPECT_EQ(odd.raw(), cache.Lookup(cid));
+}
+
 ISOLATE_UNIT_TEST_CASE(SubtypeTestCache) {
   String& class_name = String::Handle(Symbols::New(thread, "EmptyClass"));
   Script& script = Script::Handle();
@@ -53,6 +53,17 @@ DEFINE_FLAG(bool,
             false,
             "Always try to drop code if the function's usage counter is >= 0");
 DEFINE_FLAG(bool, log_growth, false, "Log PageSpace growth policy decisions.");
+DEFINE_FLAG(int,
+            evacuation_budget_kb,
+            0,
+            "When positive, each mark-sweep also compacts the most fragmented "
+            "pages, moving at most this many KB of live objects.");
+DEFINE_FLAG(int,
+            idle_memory_release_delay_ms,
+            10000,
+            "Return free old-space memory to the OS once it has stayed "
+            "unused this long after a mark-sweep and the isolate is idle. "
+            "Negative values disable this.");
 
 HeapPage* HeapPage::Allocate(intptr_t size_in_words,
                              PageType type,
@@ -60,7 +71,7 @@ HeapPage* HeapPage::Allocate(intptr_t size_in_words,
   bool is_executable = (type == kExecutable);
   // Create the new page executable (RWX) only if we're not in W^X mode
   bool create_executable = !FLAG_write_protect_code && is_executable;
-  VirtualMemory* memory = VirtualMemory::AllocateAligned(
+  VirtualMemory* memory = VirtualMemory::AllocateHeap(
       size_in_words << kWordSizeLog2, kPageSize, create_executable, name);
   if (memory == NULL) {
     return NULL;
@@ -72,6 +83,7 @@ HeapPage* HeapPage::Allocate(intptr_t size_in_words,
   result->next_ = NULL;
   result->used_in_bytes_ = 0;
   result->forwarding_page_ = NULL;
+  result->card_table_ = NULL;
   result->type_ = type;
 
   LSAN_REGISTER_ROOT_REGION(result, sizeof(*result));
@@ -81,6 +93,8 @@ HeapPage* HeapPage::Allocate(intptr_t size_in_words,
 
 void HeapPage::Deallocate() {
   ASSERT(forwarding_page_ == NULL);
+  free(card_table_);
+  card_table_ = NULL;
 
   bool image_page = is_image_page();
 
@@ -99,8 +113,38 @@ void HeapPage::Deallocate() {
   }
 }
 
+void HeapPage::VisitRememberedCards(ObjectPointerVisitor* visitor) {
+  ASSERT(card_table_ != NULL);
+  RawObject* raw_obj = RawObject::FromAddr(object_start());
+  if (!raw_obj->IsCardRemembered()) {
+    return;
+  }
+  RawArray* raw_array = reinterpret_cast<RawArray*>(raw_obj);
+  // The type arguments share the first card with the leading elements.
+  RawObject** first =
+      reinterpret_cast<RawObject**>(&raw_array->ptr()->type_arguments_);
+  RawObject** end =
+      raw_array->ptr()->data() + Smi::Value(raw_array->ptr()->length_);
+  RawObject** page_start = reinterpret_cast<RawObject**>(this);
+  const intptr_t num_cards = card_table_size();
+  for (intptr_t i = 0; i < num_cards; i++) {
+    if (card_table_[i] == 0) {
+      continue;
+    }
+    card_table_[i] = 0;
+    RawObject** card_start = page_start + (i * kSlotsPerCard);
+    RawObject** card_end = card_start + kSlotsPerCard;
+    if (card_start < first) card_start = first;
+    if (card_end > end) card_end = end;
+    if (card_start < card_end) {
+      visitor->VisitPointers(card_start, card_end - 1);
+    }
+  }
+}
+
 void HeapPage::VisitObjects(ObjectVisitor* visitor) const {
-  ASSERT(Thread::Current()->IsAtSafepoint());
+  ASSERT(Thread::Current()->IsAtSafepoint() ||
+         (Thread::Current()->task_kind() == Thread::kHeapIterationTask));
   NoSafepointScope no_safepoint;
   uword obj_addr = object_start();
   uword end_addr = object_end();
@@ -165,6 +209,20 @@ void HeapPage::WriteProtect(bool read_only) {
 // based on the device's actual speed.
 static const intptr_t kConservativeInitialMarkSpeed = 20;
 
+// Until measured, sweeping (capacity / sweep time) and compaction (live words
+// / compaction time) are assumed to be as slow as marking.
+static const intptr_t kConservativeInitialSweepSpeed =
+    kConservativeInitialMarkSpeed;
+static const intptr_t kConservativeInitialCompactSpeed =
+    kConservativeInitialMarkSpeed;
+
+static intptr_t WordsPerMicro(intptr_t words, int64_t micros) {
+  if (micros == 0) {
+    micros = 1;  // Prevent division by zero.
+  }
+  return Utils::Maximum<intptr_t>(1, words / micros);
+}
+
 PageSpace::PageSpace(Heap* heap,
                      intptr_t max_capacity_in_words,
                      intptr_t max_external_in_words)
@@ -192,7 +250,11 @@ PageSpace::PageSpace(Heap* heap,
                              FLAG_old_gen_growth_time_ratio),
       gc_time_micros_(0),
       collections_(0),
-      mark_words_per_micro_(kConservativeInitialMarkSpeed) {
+      mark_words_per_micro_(kConservativeInitialMarkSpeed),
+      sweep_words_per_micro_(kConservativeInitialSweepSpeed),
+      compact_words_per_micro_(kConservativeInitialCompactSpeed),
+      last_collection_end_micros_(0),
+      idle_memory_released_(true) {
   // We aren't holding the lock but no one can reference us yet.
   UpdateMaxCapacityLocked();
   UpdateMaxUsed();
@@ -273,6 +335,12 @@ HeapPage* PageSpace::AllocateLargePage(intptr_t size, HeapPage::PageType type) {
   if (page == NULL) {
     return NULL;
   }
+  if (!is_exec) {
+    // Only arrays use the card table (see Array::New). If it cannot be
+    // allocated, stores fall back to remembering the whole object.
+    page->card_table_ = reinterpret_cast<uint8_t*>(
+        calloc(page->card_table_size(), sizeof(uint8_t)));
+  }
   page->set_next(large_pages_);
   large_pages_ = page;
   IncreaseCapacityInWords(page_size_in_words);
@@ -330,6 +398,11 @@ void PageSpace::FreePage(HeapPage* page, HeapPage* previous_page) {
 }
 
 void PageSpace::FreeLargePage(HeapPage* page, HeapPage* previous_page) {
+  UnlinkLargePage(page, previous_page);
+  page->Deallocate();
+}
+
+void PageSpace::UnlinkLargePage(HeapPage* page, HeapPage* previous_page) {
   IncreaseCapacityInWords(-(page->memory_->size() >> kWordSizeLog2));
   // Remove the page from the list.
   if (previous_page != NULL) {
@@ -337,7 +410,6 @@ void PageSpace::FreeLargePage(HeapPage* page, HeapPage* previous_page) {
   } else {
     large_pages_ = page->next();
   }
-  page->Deallocate();
 }
 
 void PageSpace::FreePages(HeapPage* pages) {
@@ -558,6 +630,47 @@ void PageSpace::MakeIterable() const {
   }
 }
 
+uword PageSpace::TryAllocateInTLAB(Thread* thread, intptr_t size) {
+  ASSERT(size >= kObjectAlignment);
+  ASSERT(Utils::IsAligned(size, kObjectAlignment));
+  ASSERT(thread->heap() == heap_);
+  uword top = thread->old_tlab_top();
+  uword end = thread->old_tlab_end();
+  if (static_cast<intptr_t>(end - top) < size) {
+    if (size > kMaxTLABObjectSize) {
+      return 0;
+    }
+    AbandonTLAB(thread);
+    // usage_ is updated for the whole buffer; AbandonTLAB returns the rest.
+    top = TryAllocate(kTLABSize, HeapPage::kData);
+    if (top == 0) {
+      return 0;
+    }
+    end = top + kTLABSize;
+    thread->set_old_tlab_end(end);
+  }
+  uword result = top;
+  top += size;
+  thread->set_old_tlab_top(top);
+  if (top < end) {
+    // Keep the page walkable, e.g., for heap iteration at a safepoint.
+    FreeListElement::AsElement(top, end - top);
+  }
+  return result;
+}
+
+void PageSpace::AbandonTLAB(Thread* thread) {
+  uword top = thread->old_tlab_top();
+  uword end = thread->old_tlab_end();
+  thread->set_old_tlab_top(0);
+  thread->set_old_tlab_end(0);
+  if (top < end) {
+    freelist_[HeapPage::kData].Free(top, end - top);
+    AtomicOperations::DecrementBy(&(usage_.used_in_words),
+                                  ((end - top) >> kWordSizeLog2));
+  }
+}
+
 void PageSpace::AbandonBumpAllocation() {
   if (bump_top_ < bump_end_) {
     freelist_[HeapPage::kData].Free(bump_top_, bump_end_ - bump_top_);
@@ -665,6 +778,15 @@ void PageSpace::VisitObjectsImagePages(ObjectVisitor* visitor) const {
   }
 }
 
+void PageSpace::CollectPages(MallocGrowableArray<HeapPage*>* pages,
+                             bool include_image_pages) const {
+  for (ExclusivePageIterator it(this); !it.Done(); it.Advance()) {
+    if (include_image_pages || !it.page()->is_image_page()) {
+      pages->Add(it.page());
+    }
+  }
+}
+
 void PageSpace::VisitObjectPointers(ObjectPointerVisitor* visitor) const {
   for (ExclusivePageIterator it(this); !it.Done(); it.Advance()) {
     it.page()->VisitObjectPointers(visitor);
@@ -716,6 +838,16 @@ void PageSpace::WriteProtect(bool read_only) {
   }
 }
 
+intptr_t PageSpace::HugePageBytes() const {
+  // Regular pages are smaller than a huge page.
+  MutexLocker ml(pages_lock_);
+  intptr_t huge_page_bytes = 0;
+  for (HeapPage* page = large_pages_; page != NULL; page = page->next()) {
+    huge_page_bytes += page->huge_page_bytes();
+  }
+  return huge_page_bytes;
+}
+
 #ifndef PRODUCT
 void PageSpace::PrintToJSONObject(JSONObject* object) const {
   if (!FLAG_support_service) {
@@ -731,6 +863,10 @@ void PageSpace::PrintToJSONObject(JSONObject* object) const {
   space.AddProperty64("used", UsedInWords() * kWordSize);
   space.AddProperty64("capacity", CapacityInWords() * kWordSize);
   space.AddProperty64("external", ExternalInWords() * kWordSize);
+  space.AddProperty64(
+      "externalGCThreshold",
+      page_space_controller_.external_gc_threshold_in_words() * kWordSize);
+  space.AddProperty64("hugePages", HugePageBytes());
   space.AddProperty("time", MicrosecondsToSeconds(gc_time_micros()));
   if (collections() > 0) {
     int64_t run_time = isolate->UptimeMicros();
@@ -817,21 +953,61 @@ bool PageSpace::ShouldCollectCode() {
   return false;
 }
 
+// Coalesces protection changes of pages that are adjacent in memory into a
+// single VirtualMemory::Protect call per contiguous range.
+class ProtectionBatch : public ValueObject {
+ public:
+  explicit ProtectionBatch(VirtualMemory::Protection mode)
+      : mode_(mode), start_(0), end_(0) {}
+  ~ProtectionBatch() { Flush(); }
+
+  void Add(uword start, uword end) {
+    if (start == end_) {
+      end_ = end;
+    } else if (end == start_) {
+      start_ = start;
+    } else {
+      Flush();
+      start_ = start;
+      end_ = end;
+    }
+  }
+
+ private:
+  void Flush() {
+    if (start_ != end_) {
+      VirtualMemory::Protect(reinterpret_cast<void*>(start_), end_ - start_,
+                             mode_);
+    }
+    start_ = end_ = 0;
+  }
+
+  const VirtualMemory::Protection mode_;
+  uword start_;
+  uword end_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProtectionBatch);
+};
+
 void PageSpace::WriteProtectCode(bool read_only) {
   if (FLAG_write_protect_code) {
     MutexLocker ml(pages_lock_);
     NoSafepointScope no_safepoint;
+    ProtectionBatch batch(read_only ? VirtualMemory::kReadExecute
+                                    : VirtualMemory::kReadWrite);
     // No need to go through all of the data pages first.
     HeapPage* page = exec_pages_;
     while (page != NULL) {
       ASSERT(page->type() == HeapPage::kExecutable);
-      page->WriteProtect(read_only);
+      ASSERT(!page->is_image_page());
+      batch.Add(page->memory_->start(), page->memory_->end());
       page = page->next();
     }
     page = large_pages_;
     while (page != NULL) {
       if (page->type() == HeapPage::kExecutable) {
-        page->WriteProtect(read_only);
+        ASSERT(!page->is_image_page());
+        batch.Add(page->memory_->start(), page->memory_->end());
       }
       page = page->next();
     }
@@ -858,10 +1034,61 @@ bool PageSpace::ShouldPerformIdleMarkSweep(int64_t deadline) {
   }
 
   int64_t estimated_mark_completion =
-      OS::GetCurrentMonotonicMicros() + UsedInWords() / mark_words_per_micro_;
+      OS::GetCurrentMonotonicMicros() + EstimateIdleGCMicros(false);
   return estimated_mark_completion <= deadline;
 }
 
+bool PageSpace::ShouldPerformBackgroundIdleMarkSweep() {
+  // To make a consistent decision, we should not yield for a safepoint in the
+  // middle of deciding whether to perform an idle GC.
+  NoSafepointScope no_safepoint;
+
+  if (!page_space_controller_.NeedsIdleGarbageCollection(usage_)) {
+    return false;
+  }
+
+  // A concurrent sweeper is running. Let it finish first; the next idle
+  // notification will reconsider.
+  MonitorLocker locker(tasks_lock());
+  return tasks() == 0;
+}
+
+void PageSpace::ReleaseIdleMemory(bool force, int64_t deadline) {
+  if (idle_memory_released_) {
+    return;
+  }
+  if (!force) {
+    if (FLAG_idle_memory_release_delay_ms < 0) {
+      return;
+    }
+    const int64_t delay_micros =
+        static_cast<int64_t>(FLAG_idle_memory_release_delay_ms) *
+        kMicrosecondsPerMillisecond;
+    if (OS::GetCurrentMonotonicMicros() <
+        last_collection_end_micros_ + delay_micros) {
+      return;
+    }
+  }
+  {
+    // The concurrent sweeper may still be adding to the freelist. Unless
+    // forced, try again at the next idle notification.
+    MonitorLocker locker(tasks_lock());
+    if (!force && (tasks() > 0)) {
+      return;
+    }
+    while (tasks() > 0) {
+      locker.WaitWithSafepointCheck(Thread::Current());
+    }
+  }
+  intptr_t released_in_bytes = 0;
+  idle_memory_released_ = freelist_[HeapPage::kData].ReleaseUnusedMemory(
+      force ? kMaxInt64 : deadline, &released_in_bytes);
+  if (FLAG_log_growth) {
+    OS::PrintErr("%s: release %" Pd " KB\n", heap_->isolate()->name(),
+                 released_in_bytes / KB);
+  }
+}
+
 bool PageSpace::ShouldPerformIdleMarkCompact(int64_t deadline) {
   // To make a consistent decision, we should not yield for a safepoint in the
   // middle of deciding whether to perform an idle GC.
@@ -890,18 +1117,22 @@ bool PageSpace::ShouldPerformIdleMarkCompact(int64_t deadline) {
     }
   }
 
-  // Assuming compaction takes as long as marking.
-  intptr_t mark_compact_words_per_micro = mark_words_per_micro_ / 2;
-  if (mark_compact_words_per_micro == 0) {
-    mark_compact_words_per_micro = 1;  // Prevent division by zero.
-  }
-
   int64_t estimated_mark_compact_completion =
-      OS::GetCurrentMonotonicMicros() +
-      UsedInWords() / mark_compact_words_per_micro;
+      OS::GetCurrentMonotonicMicros() + EstimateIdleGCMicros(true);
   return estimated_mark_compact_completion <= deadline;
 }
 
+int64_t PageSpace::EstimateIdleGCMicros(bool compact) const {
+  // Sweeping of large and code pages is included in the marking speed.
+  int64_t micros = UsedInWords() / mark_words_per_micro_;
+  if (compact) {
+    micros += UsedInWords() / compact_words_per_micro_;
+  } else if (!FLAG_concurrent_sweep) {
+    micros += usage_.capacity_in_words / sweep_words_per_micro_;
+  }
+  return micros;
+}
+
 void PageSpace::CollectGarbage(bool compact) {
   Thread* thread = Thread::Current();
   Isolate* isolate = heap_->isolate();
@@ -919,6 +1150,7 @@ void PageSpace::CollectGarbage(bool compact) {
   }
 
   const int64_t pre_safe_point = OS::GetCurrentMonotonicMicros();
+  bool evacuated = false;
 
   // Ensure that all threads for this isolate are at a safepoint (either
   // stopped or in native code). We have guards around Newgen GC and oldgen GC
@@ -975,6 +1207,8 @@ void PageSpace::CollectGarbage(bool compact) {
 
     int64_t mid2 = OS::GetCurrentMonotonicMicros();
     int64_t mid3 = 0;
+    HeapPage* dead_large_pages = NULL;
+    HeapPage* exec_sweep_last = NULL;
 
     {
       if (FLAG_verify_before_gc) {
@@ -989,14 +1223,22 @@ void PageSpace::CollectGarbage(bool compact) {
       MutexLocker mld(freelist_[HeapPage::kData].mutex());
       MutexLocker mle(freelist_[HeapPage::kExecutable].mutex());
 
-      // Large and executable pages are always swept immediately.
+      // Large pages are always swept immediately, since the scavenger walks
+      // their card tables. Only unmapping the unreachable ones is left to
+      // the concurrent sweeper.
       HeapPage* prev_page = NULL;
       HeapPage* page = large_pages_;
       while (page != NULL) {
         HeapPage* next_page = page->next();
         const intptr_t words_to_end = sweeper.SweepLargePage(page);
         if (words_to_end == 0) {
-          FreeLargePage(page, prev_page);
+          if (FLAG_concurrent_sweep) {
+            UnlinkLargePage(page, prev_page);
+            page->set_next(dead_large_pages);
+            dead_large_pages = page;
+          } else {
+            FreeLargePage(page, prev_page);
+          }
         } else {
           TruncateLargePage(page, words_to_end << kWordSizeLog2);
           prev_page = page;
@@ -1005,8 +1247,14 @@ void PageSpace::CollectGarbage(bool compact) {
         page = next_page;
       }
 
+      // Executable pages can only be swept concurrently if the sweeper does
+      // not need to change their protection. Compaction verifies that no
+      // marked objects remain, so they are swept right away then.
+      if (FLAG_concurrent_sweep && !FLAG_write_protect_code && !compact) {
+        exec_sweep_last = exec_pages_tail_;
+      }
       prev_page = NULL;
-      page = exec_pages_;
+      page = (exec_sweep_last == NULL) ? exec_pages_ : NULL;
       FreeList* freelist = &freelist_[HeapPage::kExecutable];
       while (page != NULL) {
         HeapPage* next_page = page->next();
@@ -1023,12 +1271,29 @@ void PageSpace::CollectGarbage(bool compact) {
       mid3 = OS::GetCurrentMonotonicMicros();
     }
 
+    HeapPage* sweep_last = NULL;
     if (compact) {
+      const int64_t compact_start = OS::GetCurrentMonotonicMicros();
+      const intptr_t live_in_words = usage_.used_in_words;
       Compact(thread);
-    } else if (FLAG_concurrent_sweep) {
-      ConcurrentSweep(isolate);
+      compact_words_per_micro_ = WordsPerMicro(
+          live_in_words, OS::GetCurrentMonotonicMicros() - compact_start);
     } else {
-      BlockingSweep();
+      sweep_last = pages_tail_;
+      if (FLAG_evacuation_budget_kb > 0) {
+        // Sets sweep_last to NULL if every data page was compacted.
+        evacuated = EvacuateFragmentedPages(thread, &sweep_last);
+      }
+      if ((sweep_last != NULL) && !FLAG_concurrent_sweep) {
+        const int64_t sweep_start = OS::GetCurrentMonotonicMicros();
+        const intptr_t capacity_in_words = usage_.capacity_in_words;
+        BlockingSweep(sweep_last);
+        sweep_words_per_micro_ = WordsPerMicro(
+            capacity_in_words, OS::GetCurrentMonotonicMicros() - sweep_start);
+      }
+    }
+    if (FLAG_concurrent_sweep) {
+      ConcurrentSweep(isolate, sweep_last, exec_sweep_last, dead_large_pages);
     }
 
     // Make code pages read-only.
@@ -1036,10 +1301,6 @@ void PageSpace::CollectGarbage(bool compact) {
 
     int64_t end = OS::GetCurrentMonotonicMicros();
 
-    // Record signals for growth control. Include size of external allocations.
-    page_space_controller_.EvaluateGarbageCollection(
-        usage_before, GetCurrentUsage(), start, end);
-
     int64_t mark_micros = mid3 - start;
     if (mark_micros == 0) {
       mark_micros = 1;  // Prevent division by zero.
@@ -1049,6 +1310,12 @@ void PageSpace::CollectGarbage(bool compact) {
       mark_words_per_micro_ = 1;  // Prevent division by zero.
     }
 
+    // Record signals for growth control. Include size of external allocations.
+    page_space_controller_.EvaluateGarbageCollection(
+        usage_before, GetCurrentUsage(), start, end, mark_words_per_micro_);
+    last_collection_end_micros_ = end;
+    idle_memory_released_ = false;
+
     heap_->RecordTime(kConcurrentSweep, pre_safe_point - pre_wait_for_sweepers);
     heap_->RecordTime(kSafePoint, start - pre_safe_point);
     heap_->RecordTime(kMarkObjects, mid1 - start);
@@ -1076,7 +1343,7 @@ void PageSpace::CollectGarbage(bool compact) {
     ml.NotifyAll();
   }
 
-  if (compact) {
+  if (compact || evacuated) {
     // Const object tables are hashed by address: rehash.
     SafepointOperationScope safepoint(thread);
     StackZone zone(thread);
@@ -1085,7 +1352,7 @@ void PageSpace::CollectGarbage(bool compact) {
   }
 }
 
-void PageSpace::BlockingSweep() {
+void PageSpace::BlockingSweep(HeapPage* last) {
   MutexLocker mld(freelist_[HeapPage::kData].mutex());
   MutexLocker mle(freelist_[HeapPage::kExecutable].mutex());
 
@@ -1101,6 +1368,7 @@ void PageSpace::BlockingSweep() {
     } else {
       FreePage(page, prev_page);
     }
+    if (page == last) break;
     // Advance to the next page.
     page = next_page;
   }
@@ -1112,10 +1380,17 @@ void PageSpace::BlockingSweep() {
   }
 }
 
-void PageSpace::ConcurrentSweep(Isolate* isolate) {
+void PageSpace::ConcurrentSweep(Isolate* isolate,
+                                HeapPage* last,
+                                HeapPage* exec_last,
+                                HeapPage* dead_large_pages) {
+  if ((last == NULL) && (exec_last == NULL) && (dead_large_pages == NULL)) {
+    return;
+  }
   // Start the concurrent sweeper task now.
-  GCSweeper::SweepConcurrent(isolate, pages_, pages_tail_,
-                             &freelist_[HeapPage::kData]);
+  GCSweeper::SweepConcurrent(isolate, (last != NULL) ? pages_ : NULL, last,
+                             (exec_last != NULL) ? exec_pages_ : NULL,
+                             exec_last, dead_large_pages);
 }
 
 void PageSpace::Compact(Thread* thread) {
@@ -1131,6 +1406,143 @@ void PageSpace::Compact(Thread* thread) {
   }
 }
 
+struct PageLiveness {
+  HeapPage* page;
+  intptr_t index;
+  intptr_t live_bytes;
+};
+
+static int CompareLiveBytes(const PageLiveness* a, const PageLiveness* b) {
+  if (a->live_bytes < b->live_bytes) {
+    return -1;
+  } else if (a->live_bytes > b->live_bytes) {
+    return 1;
+  }
+  return 0;
+}
+
+static intptr_t MarkedBytes(HeapPage* page) {
+  intptr_t marked_bytes = 0;
+  uword current = page->object_start();
+  uword end = page->object_end();
+  while (current < end) {
+    RawObject* raw_obj = RawObject::FromAddr(current);
+    intptr_t size = raw_obj->Size();
+    if (raw_obj->IsMarked()) {
+      marked_bytes += size;
+    }
+    current += size;
+  }
+  return marked_bytes;
+}
+
+bool PageSpace::EvacuateFragmentedPages(Thread* thread, HeapPage** sweep_last) {
+  TIMELINE_FUNCTION_GC_DURATION(thread, "EvacuateFragmentedPages");
+  // Pages that are at least half live are not worth moving: there is not
+  // enough free space to gain from them.
+  MallocGrowableArray<PageLiveness> candidates;
+  intptr_t num_pages = 0;
+  for (HeapPage* page = pages_; page != NULL; page = page->next()) {
+    const intptr_t marked_bytes = MarkedBytes(page);
+    if ((marked_bytes * 2) < (page->object_end() - page->object_start())) {
+      PageLiveness candidate;
+      candidate.page = page;
+      candidate.index = num_pages;
+      candidate.live_bytes = marked_bytes;
+      candidates.Add(candidate);
+    }
+    num_pages++;
+  }
+
+  // Pick the emptiest pages first, until the budget is used up.
+  candidates.Sort(CompareLiveBytes);
+  const intptr_t budget = FLAG_evacuation_budget_kb * KB;
+  intptr_t budget_used = 0;
+  intptr_t num_evacuees = 0;
+  bool* evacuate = new bool[num_pages]();
+  for (intptr_t i = 0; i < candidates.length(); i++) {
+    if (budget_used + candidates[i].live_bytes > budget) {
+      break;
+    }
+    budget_used += candidates[i].live_bytes;
+    evacuate[candidates[i].index] = true;
+    num_evacuees++;
+  }
+  if (num_evacuees < 2) {
+    // Sliding a single page into itself frees nothing.
+    delete[] evacuate;
+    return false;
+  }
+
+  // Split the page list into the pages to compact and the pages to sweep,
+  // keeping the relative order of each (required for class pinning).
+  HeapPage* evacuees = NULL;
+  HeapPage* evacuees_tail = NULL;
+  HeapPage* unmoved = NULL;
+  HeapPage* unmoved_tail = NULL;
+  const intptr_t num_unmoved = num_pages - num_evacuees;
+  HeapPage** unmoved_pages = new HeapPage*[num_unmoved];
+  {
+    MutexLocker ml(pages_lock_);
+    intptr_t index = 0;
+    intptr_t unmoved_index = 0;
+    HeapPage* page = pages_;
+    while (page != NULL) {
+      HeapPage* next = page->next();
+      page->set_next(NULL);
+      if (evacuate[index]) {
+        if (evacuees_tail == NULL) {
+          evacuees = page;
+        } else {
+          evacuees_tail->set_next(page);
+        }
+        evacuees_tail = page;
+      } else {
+        if (unmoved_tail == NULL) {
+          unmoved = page;
+        } else {
+          unmoved_tail->set_next(page);
+        }
+        unmoved_tail = page;
+        unmoved_pages[unmoved_index++] = page;
+      }
+      index++;
+      page = next;
+    }
+    ASSERT(unmoved_index == num_unmoved);
+    pages_ = unmoved;
+    pages_tail_ = unmoved_tail;
+  }
+  delete[] evacuate;
+
+  thread->isolate()->set_compaction_in_progress(true);
+  GCCompactor compactor(thread, heap_);
+  HeapPage* survivors_tail =
+      compactor.CompactPages(evacuees, unmoved_pages, num_unmoved,
+                             &freelist_[HeapPage::kData], pages_lock_);
+  thread->isolate()->set_compaction_in_progress(false);
+  delete[] unmoved_pages;
+
+  // Put the compacted pages behind the ones left for the sweeper.
+  {
+    MutexLocker ml(pages_lock_);
+    if (unmoved_tail == NULL) {
+      pages_ = evacuees;
+    } else {
+      unmoved_tail->set_next(evacuees);
+    }
+    pages_tail_ = survivors_tail;
+  }
+
+  if (FLAG_verify_after_gc) {
+    OS::PrintErr("Verifying after evacuating...");
+    heap_->VerifyGC(kAllowMarked);
+    OS::PrintErr(" done.\n");
+  }
+  *sweep_last = unmoved_tail;
+  return true;
+}
+
 uword PageSpace::TryAllocateDataBumpInternal(intptr_t size,
                                              GrowthPolicy growth_policy,
                                              bool is_locked) {
@@ -1206,6 +1618,16 @@ uword PageSpace::TryAllocatePromoLocked(intptr_t size,
   return TryAllocateDataLocked(size, growth_policy);
 }
 
+void PageSpace::AbandonPromoBufferLocked(uword addr, intptr_t size) {
+  ASSERT(Utils::IsAligned(size, kObjectAlignment));
+  if (size == 0) {
+    return;
+  }
+  freelist_[HeapPage::kData].FreeLocked(addr, size);
+  AtomicOperations::DecrementBy(&(usage_.used_in_words),
+                                (size >> kWordSizeLog2));
+}
+
 void PageSpace::SetupImagePage(void* pointer, uword size, bool is_executable) {
   // Setup a HeapPage so precompiled Instructions can be traversed.
   // Instructions are contiguous at [pointer, pointer + size). HeapPage
@@ -1223,6 +1645,7 @@ void PageSpace::SetupImagePage(void* pointer, uword size, bool is_executable) {
   page->object_end_ = memory->end();
   page->used_in_bytes_ = page->object_end_ - page->object_start();
   page->forwarding_page_ = NULL;
+  page->card_table_ = NULL;
   if (is_executable) {
     ASSERT(Utils::IsAligned(pointer, OS::PreferredCodeAlignment()));
     page->type_ = HeapPage::kExecutable;
@@ -1246,11 +1669,24 @@ PageSpaceController::PageSpaceController(Heap* heap,
       desired_utilization_((100.0 - heap_growth_ratio) / 100.0),
       heap_growth_max_(heap_growth_max),
       garbage_collection_time_ratio_(garbage_collection_time_ratio),
+      default_garbage_collection_time_ratio_(garbage_collection_time_ratio),
+      max_pause_micros_(0),
       last_code_collection_in_us_(OS::GetCurrentMonotonicMicros()),
-      idle_gc_threshold_in_words_(0) {}
+      idle_gc_threshold_in_words_(0),
+      external_gc_threshold_in_words_((heap_growth_max / 2) *
+                                      kPageSizeInWords),
+      idle_external_threshold_in_words_(0) {}
 
 PageSpaceController::~PageSpaceController() {}
 
+void PageSpaceController::SetGoals(int64_t max_pause_micros,
+                                   int max_gc_time_percent) {
+  max_pause_micros_ = max_pause_micros;
+  garbage_collection_time_ratio_ = (max_gc_time_percent > 0)
+                                       ? max_gc_time_percent
+                                       : default_garbage_collection_time_ratio_;
+}
+
 bool PageSpaceController::NeedsGarbageCollection(SpaceUsage after) const {
   if (!is_enabled_) {
     return false;
@@ -1273,6 +1709,15 @@ bool PageSpaceController::NeedsGarbageCollection(SpaceUsage after) const {
                  heap_->isolate()->name(), needs_gc ? "collect" : "grow",
                  capacity_increase_in_pages, needs_gc ? ">" : "<=", grow_heap_);
   }
+  if (!needs_gc &&
+      (after.external_in_words > external_gc_threshold_in_words_)) {
+    needs_gc = true;
+    if (FLAG_log_growth) {
+      OS::PrintErr("%s: external %" Pd " > %" Pd "\n",
+                   heap_->isolate()->name(), after.external_in_words,
+                   external_gc_threshold_in_words_);
+    }
+  }
   return needs_gc;
 }
 
@@ -1283,7 +1728,9 @@ bool PageSpaceController::NeedsIdleGarbageCollection(SpaceUsage current) const {
   if (heap_growth_ratio_ == 100) {
     return false;
   }
-  bool needs_gc = current.used_in_words > idle_gc_threshold_in_words_;
+  bool needs_gc =
+      (current.used_in_words > idle_gc_threshold_in_words_) ||
+      (current.external_in_words > idle_external_threshold_in_words_);
   if (FLAG_log_growth) {
     OS::PrintErr("%s: idle %s %" Pd " %s %" Pd "\n", heap_->isolate()->name(),
                  needs_gc ? "collect" : "grow", current.used_in_words,
@@ -1292,10 +1739,12 @@ bool PageSpaceController::NeedsIdleGarbageCollection(SpaceUsage current) const {
   return needs_gc;
 }
 
-void PageSpaceController::EvaluateGarbageCollection(SpaceUsage before,
-                                                    SpaceUsage after,
-                                                    int64_t start,
-                                                    int64_t end) {
+void PageSpaceController::EvaluateGarbageCollection(
+    SpaceUsage before,
+    SpaceUsage after,
+    int64_t start,
+    int64_t end,
+    intptr_t mark_words_per_micro) {
   ASSERT(end >= start);
   history_.AddGarbageCollectionTime(start, end);
   const int gc_time_fraction = history_.GarbageCollectionTimeFraction();
@@ -1362,6 +1811,22 @@ void PageSpaceController::EvaluateGarbageCollection(SpaceUsage before,
         grow_heap_ = Utils::Maximum(grow_pages, grow_heap_);
       }
     }
+
+    if ((max_pause_micros_ > 0) && (k < 1.0)) {
+      // Marking time is proportional to the live data, of which we expect
+      // (1 - k) of each word allocated until the next GC to add.
+      const intptr_t max_live_in_words =
+          max_pause_micros_ * mark_words_per_micro;
+      const intptr_t max_allocated_in_words = static_cast<intptr_t>(
+          Utils::Maximum<intptr_t>(0, max_live_in_words - after.used_in_words) /
+          (1.0 - k));
+      const intptr_t max_grow_pages =
+          (after.used_in_words + max_allocated_in_words -
+           after.capacity_in_words) /
+          kPageSizeInWords;
+      grow_heap_ = Utils::Minimum(
+          grow_heap_, Utils::Maximum<intptr_t>(0, max_grow_pages));
+    }
   } else {
     heap_->RecordData(PageSpace::kGarbageRatio, 100);
     grow_heap_ = 0;
@@ -1381,6 +1846,16 @@ void PageSpaceController::EvaluateGarbageCollection(SpaceUsage before,
       after.capacity_in_words + (kPageSizeInWords * grow_heap_);
   idle_gc_threshold_in_words_ =
       (after.used_in_words + gc_threshold_in_words) / 2;
+
+  const intptr_t external_in_words = after.external_in_words;
+  const intptr_t external_growth_in_words = Utils::Maximum(
+      kPageSizeInWords * grow_heap_,
+      static_cast<intptr_t>(external_in_words / desired_utilization_) -
+          external_in_words);
+  external_gc_threshold_in_words_ =
+      external_in_words + external_growth_in_words;
+  idle_external_threshold_in_words_ =
+      external_in_words + (external_growth_in_words / 2);
 }
 
 void PageSpaceGarbageCollectionHistory::AddGarbageCollectionTime(int64_t start,
@@ -7,6 +7,7 @@
 
 #include "vm/freelist.h"
 #include "vm/globals.h"
+#include "vm/growable_array.h"
 #include "vm/lockers.h"
 #include "vm/ring_buffer.h"
 #include "vm/spaces.h"
@@ -56,10 +57,39 @@ class HeapPage {
   PageType type() const { return type_; }
 
   bool is_image_page() const { return !memory_->vm_owns_region(); }
+  intptr_t huge_page_bytes() const { return memory_->huge_page_bytes(); }
 
   void VisitObjects(ObjectVisitor* visitor) const;
   void VisitObjectPointers(ObjectPointerVisitor* visitor) const;
 
+  // Large data pages carry a card table with one byte per card of
+  // 2^kBytesPerCardLog2 bytes of the page. Generated code dirties the card of
+  // the slot written when storing a new-space object into a card remembered
+  // array, so a scavenge only visits the dirty parts of the array.
+  static const intptr_t kBytesPerCardLog2 = 9;
+  static const intptr_t kSlotsPerCard = (1 << kBytesPerCardLog2) / kWordSize;
+
+  static intptr_t card_table_offset() {
+    return OFFSET_OF(HeapPage, card_table_);
+  }
+  uint8_t* card_table() const { return card_table_; }
+  intptr_t card_table_size() const {
+    return memory_->size() >> kBytesPerCardLog2;
+  }
+
+  void RememberCard(RawObject* const* slot) {
+    ASSERT(card_table_ != NULL);
+    ASSERT(Contains(reinterpret_cast<uword>(slot)));
+    intptr_t offset =
+        reinterpret_cast<uword>(slot) - reinterpret_cast<uword>(this);
+    card_table_[offset >> kBytesPerCardLog2] = 1;
+  }
+
+  // Clears the dirty cards of the large array on this page and visits the
+  // slots they cover. The visitor is expected to dirty the cards of slots
+  // that still refer to new-space objects afterwards.
+  void VisitRememberedCards(ObjectPointerVisitor* visitor);
+
   RawObject* FindObject(FindObjectVisitor* visitor) const;
 
   void WriteProtect(bool read_only);
@@ -97,6 +127,7 @@ class HeapPage {
   uword object_end_;
   uword used_in_bytes_;
   ForwardingPage* forwarding_page_;
+  uint8_t* card_table_;
   PageType type_;
 
   friend class PageSpace;
@@ -150,11 +181,28 @@ class PageSpaceController {
   // Returns whether an idle GC is worthwhile.
   bool NeedsIdleGarbageCollection(SpaceUsage current) const;
 
+  // External size that triggers the next GC. External data may grow by as
+  // much as the heap itself before the next GC, or by the growth ratio if
+  // there is more external data than heap. It is only recomputed after a GC,
+  // so externals that survive a collection do not trigger another one.
+  intptr_t external_gc_threshold_in_words() const {
+    return external_gc_threshold_in_words_;
+  }
+
   // Should be called after each collection to update the controller state.
+  // 'mark_words_per_micro' is the current estimate of the marking speed.
   void EvaluateGarbageCollection(SpaceUsage before,
                                  SpaceUsage after,
                                  int64_t start,
-                                 int64_t end);
+                                 int64_t end,
+                                 intptr_t mark_words_per_micro);
+
+  // Goals set by the embedder; zero means no goal. Growth is limited so that
+  // marking the live data expected at the next collection should not take
+  // longer than 'max_pause_micros'. A positive 'max_gc_time_percent'
+  // replaces the garbage collection time ratio. When the two conflict, the
+  // pause goal wins.
+  void SetGoals(int64_t max_pause_micros, int max_gc_time_percent);
 
   int64_t last_code_collection_in_us() { return last_code_collection_in_us_; }
   void set_last_code_collection_in_us(int64_t t) {
@@ -192,6 +240,11 @@ class PageSpaceController {
   // If the relative GC time goes above garbage_collection_time_ratio_ %,
   // we grow the heap more aggressively.
   int garbage_collection_time_ratio_;
+  // The ratio given at construction, used when no time goal is set.
+  int default_garbage_collection_time_ratio_;
+
+  // Longest mark-sweep pause to aim for, or zero.
+  int64_t max_pause_micros_;
 
   // The time in microseconds of the last time we tried to collect unused
   // code.
@@ -200,6 +253,10 @@ class PageSpaceController {
   // We start considering idle mark-sweeps when old space crosses this size.
   intptr_t idle_gc_threshold_in_words_;
 
+  intptr_t external_gc_threshold_in_words_;
+  // Idle mark-sweeps are also considered when externals cross this size.
+  intptr_t idle_external_threshold_in_words_;
+
   PageSpaceGarbageCollectionHistory history_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(PageSpaceController);
@@ -248,6 +305,8 @@ class PageSpace {
   void UpdateMaxUsed();
 
   int64_t ExternalInWords() const { return usage_.external_in_words; }
+  // The part of the heap the OS was asked to back with huge pages.
+  intptr_t HugePageBytes() const;
   SpaceUsage GetCurrentUsage() const {
     MutexLocker ml(pages_lock_);
     return usage_;
@@ -263,6 +322,27 @@ class PageSpace {
   void VisitObjectsImagePages(ObjectVisitor* visitor) const;
   void VisitObjectPointers(ObjectPointerVisitor* visitor) const;
 
+  // Appends all pages, optionally without the image pages, to 'pages' so
+  // that they can be shared out among the tasks of a parallel visit.
+  void CollectPages(MallocGrowableArray<HeapPage*>* pages,
+                    bool include_image_pages) const;
+
+  // Visits the slots under the dirty cards of card remembered large arrays.
+  // The visitor's VisitingOldObject is told about each array so that it can
+  // dirty the cards of slots still holding new-space objects.
+  template <typename Visitor>
+  void VisitRememberedCards(Visitor* visitor) const {
+    // Promotions may prepend fresh large pages during a scavenge, which does
+    // not disturb this walk; those pages hold no dirty cards yet.
+    for (HeapPage* page = large_pages_; page != NULL; page = page->next()) {
+      if (page->card_table() != NULL) {
+        visitor->VisitingOldObject(RawObject::FromAddr(page->object_start()));
+        page->VisitRememberedCards(visitor);
+      }
+    }
+    visitor->VisitingOldObject(NULL);
+  }
+
   RawObject* FindObject(FindObjectVisitor* visitor,
                         HeapPage::PageType type) const;
 
@@ -302,6 +382,18 @@ class PageSpace {
 
   bool ShouldPerformIdleMarkSweep(int64_t deadline);
   bool ShouldPerformIdleMarkCompact(int64_t deadline);
+  // The expected length of a mark-sweep or mark-compact, from the speeds of
+  // marking, sweeping and compaction measured by previous collections.
+  int64_t EstimateIdleGCMicros(bool compact) const;
+  // Like ShouldPerformIdleMarkSweep, but for a mark-sweep that is not bound by
+  // the idle deadline because it runs while the mutator is descheduled.
+  bool ShouldPerformBackgroundIdleMarkSweep();
+
+  // Returns the memory of large free blocks in data pages to the OS if they
+  // have stayed unused since a mark-sweep that ended at least
+  // FLAG_idle_memory_release_delay_ms ago, or right away if 'force'. Work
+  // left at 'deadline' is resumed by the next call.
+  void ReleaseIdleMemory(bool force, int64_t deadline = kMaxInt64);
 
   void AddGCTime(int64_t micros) { gc_time_micros_ += micros; }
 
@@ -319,6 +411,15 @@ class PageSpace {
   void AllocateExternal(intptr_t cid, intptr_t size);
   void FreeExternal(intptr_t size);
 
+  void SetGoals(int64_t max_pause_micros, int max_gc_time_percent) {
+    page_space_controller_.SetGoals(max_pause_micros, max_gc_time_percent);
+  }
+  // Zero means unlimited. Lowering the limit below the current capacity
+  // only prevents further growth.
+  void SetMaxCapacityInWords(intptr_t max_capacity_in_words) {
+    max_capacity_in_words_ = max_capacity_in_words;
+  }
+
   // Bulk data allocation.
   void AcquireDataLock();
   void ReleaseDataLock();
@@ -338,10 +439,21 @@ class PageSpace {
   }
 
   // Attempt to allocate from bump block rather than normal freelist.
+  // Bump allocates small data objects from a buffer owned by 'thread', which
+  // is refilled from the freelist in bulk to avoid taking the freelist lock
+  // for every allocation. Returns 0 if the object is too large for a buffer
+  // or no memory is available without growing.
+  uword TryAllocateInTLAB(Thread* thread, intptr_t size);
+  // Returns the unused part of 'thread's buffer to the freelist.
+  void AbandonTLAB(Thread* thread);
+
   uword TryAllocateDataBump(intptr_t size, GrowthPolicy growth_policy);
   uword TryAllocateDataBumpLocked(intptr_t size, GrowthPolicy growth_policy);
   // Prefer small freelist blocks, then chip away at the bump block.
   uword TryAllocatePromoLocked(intptr_t size, GrowthPolicy growth_policy);
+  // Returns the unused tail of a block obtained from TryAllocatePromoLocked,
+  // e.g., the remainder of a parallel scavenger worker's promotion buffer.
+  void AbandonPromoBufferLocked(uword addr, intptr_t size);
 
   void SetupImagePage(void* pointer, uword size, bool is_executable);
 
@@ -367,6 +479,11 @@ class PageSpace {
 
   static const intptr_t kAllocatablePageSize = 64 * KB;
 
+  // Thread-local allocation buffers are carved out of the freelist in chunks
+  // of this size. Larger objects would waste too much of a chunk.
+  static const intptr_t kTLABSize = 8 * KB;
+  static const intptr_t kMaxTLABObjectSize = kTLABSize / 8;
+
   uword TryAllocateInternal(intptr_t size,
                             HeapPage::PageType type,
                             GrowthPolicy growth_policy,
@@ -386,11 +503,23 @@ class PageSpace {
   HeapPage* AllocateLargePage(intptr_t size, HeapPage::PageType type);
   void TruncateLargePage(HeapPage* page, intptr_t new_object_size_in_bytes);
   void FreeLargePage(HeapPage* page, HeapPage* previous_page);
+  // Removes the page from the space without returning its memory.
+  void UnlinkLargePage(HeapPage* page, HeapPage* previous_page);
   void FreePages(HeapPage* pages);
 
-  void BlockingSweep();
-  void ConcurrentSweep(Isolate* isolate);
+  // Sweep the data pages up to and including 'last'.
+  void BlockingSweep(HeapPage* last);
+  // Sweep the data and executable pages up to and including 'last' and
+  // 'exec_last', and release 'dead_large_pages', on a helper thread.
+  void ConcurrentSweep(Isolate* isolate,
+                       HeapPage* last,
+                       HeapPage* exec_last,
+                       HeapPage* dead_large_pages);
   void Compact(Thread* thread);
+  // Compacts the least occupied data pages within the evacuation budget.
+  // Returns false if no pages were worth moving. Otherwise, sets 'sweep_last'
+  // to the last data page that still needs sweeping, or NULL if none does.
+  bool EvacuateFragmentedPages(Thread* thread, HeapPage** sweep_last);
 
   static intptr_t LargePageSizeInWordsFor(intptr_t size);
 
@@ -444,6 +573,15 @@ class PageSpace {
   int64_t gc_time_micros_;
   intptr_t collections_;
   intptr_t mark_words_per_micro_;
+  // Speed of sweeping data pages in the pause, if not done concurrently, and
+  // of compaction. Used to size idle-time collections.
+  intptr_t sweep_words_per_micro_;
+  intptr_t compact_words_per_micro_;
+
+  // When the last mark-sweep ended, and whether the free memory it left has
+  // already been returned to the OS.
+  int64_t last_collection_end_micros_;
+  bool idle_memory_released_;
 
   friend class ExclusivePageIterator;
   friend class ExclusiveCodePageIterator;
@@ -31,4 +31,19 @@ TEST_CASE(Pages) {
   delete space;
 }
 
+ISOLATE_UNIT_TEST_CASE(PagesTLAB) {
+  // Small old-space objects are bump allocated from the thread's buffer.
+  const Array& first = Array::Handle(Array::New(2, Heap::kOld));
+  uword end = RawObject::ToAddr(first.raw()) + first.raw()->Size();
+  EXPECT_EQ(end, thread->old_tlab_top());
+  const Array& second = Array::Handle(Array::New(2, Heap::kOld));
+  if (end < thread->old_tlab_end()) {
+    EXPECT_EQ(end, RawObject::ToAddr(second.raw()));
+  }
+  // The rest of the buffer is returned before collecting.
+  thread->isolate()->heap()->CollectAllGarbage();
+  EXPECT(first.Length() == 2);
+  EXPECT(second.Length() == 2);
+}
+
 }  // namespace dart
@@ -14,15 +14,10 @@
 
 namespace dart {
 
-Mutex* PortMap::mutex_ = NULL;
-PortMap::Entry* PortMap::map_ = NULL;
+PortMap::Shard PortMap::shards_[PortMap::kNumShards];
 MessageHandler* PortMap::deleted_entry_ = reinterpret_cast<MessageHandler*>(1);
-intptr_t PortMap::capacity_ = 0;
-intptr_t PortMap::used_ = 0;
-intptr_t PortMap::deleted_ = 0;
-Random* PortMap::prng_ = NULL;
 
-intptr_t PortMap::FindPort(Dart_Port port) {
+intptr_t PortMap::FindPort(Shard* shard, Dart_Port port) {
   // ILLEGAL_PORT (0) is used as a sentinel value in Entry.port. The loop below
   // could return the index to a deleted port when we are searching for
   // port id ILLEGAL_PORT. Return -1 immediately to indicate the port
@@ -31,40 +26,50 @@ intptr_t PortMap::FindPort(Dart_Port port) {
     return -1;
   }
   ASSERT(port != ILLEGAL_PORT);
-  intptr_t index = port % capacity_;
+  ASSERT(shard == ShardForPort(port));
+  intptr_t index = IndexForPort(port, shard->capacity);
   intptr_t start_index = index;
-  Entry entry = map_[index];
+  Entry entry = shard->map[index];
   while (entry.handler != NULL) {
     if (entry.port == port) {
       return index;
     }
-    index = (index + 1) % capacity_;
+    index = (index + 1) % shard->capacity;
     // Prevent endless loops.
     ASSERT(index != start_index);
-    entry = map_[index];
+    entry = shard->map[index];
   }
   return -1;
 }
 
-void PortMap::Rehash(intptr_t new_capacity) {
+void PortMap::Rehash(Shard* shard, intptr_t new_capacity) {
   Entry* new_ports = new Entry[new_capacity];
   memset(new_ports, 0, new_capacity * sizeof(Entry));
 
-  for (intptr_t i = 0; i < capacity_; i++) {
-    Entry entry = map_[i];
+  for (intptr_t i = 0; i < shard->capacity; i++) {
+    Entry entry = shard->map[i];
     // Skip free and deleted entries.
     if (entry.port != 0) {
-      intptr_t new_index = entry.port % new_capacity;
+      intptr_t new_index = IndexForPort(entry.port, new_capacity);
       while (new_ports[new_index].port != 0) {
         new_index = (new_index + 1) % new_capacity;
       }
       new_ports[new_index] = entry;
     }
   }
-  delete[] map_;
-  map_ = new_ports;
-  capacity_ = new_capacity;
-  deleted_ = 0;
+  delete[] shard->map;
+  shard->map = new_ports;
+  shard->capacity = new_capacity;
+  shard->deleted = 0;
+}
+
+intptr_t PortMap::ShardIndexForHandler(MessageHandler* handler) {
+  // Fibonacci hashing of the handler address spreads handlers evenly over
+  // the shards.
+  uint32_t hash = static_cast<uint32_t>(reinterpret_cast<uword>(handler) >>
+                                        kObjectAlignmentLog2);
+  hash *= 0x9E3779B1u;
+  return hash >> (32 - kNumShardsLog2);
 }
 
 const char* PortMap::PortStateString(PortState kind) {
@@ -81,30 +86,33 @@ const char* PortMap::PortStateString(PortState kind) {
   }
 }
 
-Dart_Port PortMap::AllocatePort() {
-  const Dart_Port kMASK = 0x3fffffff;
-  Dart_Port result = prng_->NextUInt32() & kMASK;
+Dart_Port PortMap::AllocatePort(Shard* shard, intptr_t shard_index) {
+  const Dart_Port kMASK = 0x3fffffff & ~(kNumShards - 1);
+  Dart_Port result = (shard->prng->NextUInt32() & kMASK) | shard_index;
 
   // Keep getting new values while we have an illegal port number or the port
   // number is already in use.
-  while ((result == 0) || (FindPort(result) >= 0)) {
-    result = prng_->NextUInt32() & kMASK;
+  while ((result == 0) || (FindPort(shard, result) >= 0)) {
+    result = (shard->prng->NextUInt32() & kMASK) | shard_index;
   }
 
   ASSERT(result != 0);
-  ASSERT(FindPort(result) < 0);
+  ASSERT(ShardForPort(result) == shard);
+  ASSERT(FindPort(shard, result) < 0);
   return result;
 }
 
 void PortMap::SetPortState(Dart_Port port, PortState state) {
-  MutexLocker ml(mutex_);
-  intptr_t index = FindPort(port);
+  Shard* shard = ShardForPort(port);
+  MutexLocker ml(shard->mutex);
+  intptr_t index = FindPort(shard, port);
   ASSERT(index >= 0);
-  PortState old_state = map_[index].state;
+  Entry* entry = &shard->map[index];
+  PortState old_state = entry->state;
   ASSERT(old_state == kNewPort);
-  map_[index].state = state;
+  entry->state = state;
   if (state == kLivePort) {
-    map_[index].handler->increment_live_ports();
+    entry->handler->increment_live_ports();
   }
   if (FLAG_trace_isolates) {
     OS::Print(
@@ -112,60 +120,63 @@ void PortMap::SetPortState(Dart_Port port, PortState state) {
         "\thandler:    %s\n"
         "\tport:       %" Pd64 "\n",
         PortStateString(old_state), PortStateString(state),
-        map_[index].handler->name(), port);
+        entry->handler->name(), port);
   }
 }
 
-void PortMap::MaintainInvariants() {
-  intptr_t empty = capacity_ - used_ - deleted_;
-  if (used_ > ((capacity_ / 4) * 3)) {
+void PortMap::MaintainInvariants(Shard* shard) {
+  intptr_t empty = shard->capacity - shard->used - shard->deleted;
+  if (shard->used > ((shard->capacity / 4) * 3)) {
     // Grow the port map.
-    Rehash(capacity_ * 2);
-  } else if (empty < deleted_) {
+    Rehash(shard, shard->capacity * 2);
+  } else if (empty < shard->deleted) {
     // Rehash without growing the table to flush the deleted slots out of the
     // map.
-    Rehash(capacity_);
+    Rehash(shard, shard->capacity);
   }
 }
 
 Dart_Port PortMap::CreatePort(MessageHandler* handler) {
   ASSERT(handler != NULL);
-  MutexLocker ml(mutex_);
+  intptr_t shard_index = ShardIndexForHandler(handler);
+  Shard* shard = &shards_[shard_index];
+  MutexLocker ml(shard->mutex);
 #if defined(DEBUG)
   handler->CheckAccess();
 #endif
 
   Entry entry;
-  entry.port = AllocatePort();
+  entry.port = AllocatePort(shard, shard_index);
   entry.handler = handler;
   entry.state = kNewPort;
 
   // Search for the first unused slot. Make use of the knowledge that here is
   // currently no port with this id in the port map.
-  ASSERT(FindPort(entry.port) < 0);
-  intptr_t index = entry.port % capacity_;
-  Entry cur = map_[index];
+  ASSERT(FindPort(shard, entry.port) < 0);
+  Entry* map = shard->map;
+  intptr_t index = IndexForPort(entry.port, shard->capacity);
+  Entry cur = map[index];
   // Stop the search at the first found unused (free or deleted) slot.
   while (cur.port != 0) {
-    index = (index + 1) % capacity_;
-    cur = map_[index];
+    index = (index + 1) % shard->capacity;
+    cur = map[index];
   }
 
   // Insert the newly created port at the index.
   ASSERT(index >= 0);
-  ASSERT(index < capacity_);
-  ASSERT(map_[index].port == 0);
-  ASSERT((map_[index].handler == NULL) ||
-         (map_[index].handler == deleted_entry_));
-  if (map_[index].handler == deleted_entry_) {
+  ASSERT(index < shard->capacity);
+  ASSERT(map[index].port == 0);
+  ASSERT((map[index].handler == NULL) ||
+         (map[index].handler == deleted_entry_));
+  if (map[index].handler == deleted_entry_) {
     // Consuming a deleted entry.
-    deleted_--;
+    shard->deleted--;
   }
-  map_[index] = entry;
+  map[index] = entry;
 
   // Increment number of used slots and grow if necessary.
-  used_++;
-  MaintainInvariants();
+  shard->used++;
+  MaintainInvariants(shard);
 
   if (FLAG_trace_isolates) {
     OS::Print(
@@ -181,32 +192,34 @@ Dart_Port PortMap::CreatePort(MessageHandler* handler) {
 bool PortMap::ClosePort(Dart_Port port) {
   MessageHandler* handler = NULL;
   {
-    MutexLocker ml(mutex_);
-    intptr_t index = FindPort(port);
+    Shard* shard = ShardForPort(port);
+    MutexLocker ml(shard->mutex);
+    intptr_t index = FindPort(shard, port);
     if (index < 0) {
       return false;
     }
-    ASSERT(index < capacity_);
-    ASSERT(map_[index].port != 0);
-    ASSERT(map_[index].handler != deleted_entry_);
-    ASSERT(map_[index].handler != NULL);
+    ASSERT(index < shard->capacity);
+    Entry* entry = &shard->map[index];
+    ASSERT(entry->port != 0);
+    ASSERT(entry->handler != deleted_entry_);
+    ASSERT(entry->handler != NULL);
 
-    handler = map_[index].handler;
+    handler = entry->handler;
 #if defined(DEBUG)
     handler->CheckAccess();
 #endif
     // Before releasing the lock mark the slot in the map as deleted. This makes
     // it possible to release the port map lock before flushing all of its
     // pending messages below.
-    map_[index].port = 0;
-    map_[index].handler = deleted_entry_;
-    if (map_[index].state == kLivePort) {
+    entry->port = 0;
+    entry->handler = deleted_entry_;
+    if (entry->state == kLivePort) {
       handler->decrement_live_ports();
     }
 
-    used_--;
-    deleted_++;
-    MaintainInvariants();
+    shard->used--;
+    shard->deleted++;
+    MaintainInvariants(shard);
   }
   handler->ClosePort(port);
   if (!handler->HasLivePorts() && handler->OwnedByPortMap()) {
@@ -218,76 +231,83 @@ bool PortMap::ClosePort(Dart_Port port) {
 
 void PortMap::ClosePorts(MessageHandler* handler) {
   {
-    MutexLocker ml(mutex_);
-    for (intptr_t i = 0; i < capacity_; i++) {
-      if (map_[i].handler == handler) {
+    Shard* shard = &shards_[ShardIndexForHandler(handler)];
+    MutexLocker ml(shard->mutex);
+    Entry* map = shard->map;
+    for (intptr_t i = 0; i < shard->capacity; i++) {
+      if (map[i].handler == handler) {
         // Mark the slot as deleted.
-        map_[i].port = 0;
-        map_[i].handler = deleted_entry_;
-        if (map_[i].state == kLivePort) {
+        map[i].port = 0;
+        map[i].handler = deleted_entry_;
+        if (map[i].state == kLivePort) {
           handler->decrement_live_ports();
         }
-        used_--;
-        deleted_++;
+        shard->used--;
+        shard->deleted++;
       }
     }
-    MaintainInvariants();
+    MaintainInvariants(shard);
   }
   handler->CloseAllPorts();
 }
 
 bool PortMap::PostMessage(Message* message) {
-  MutexLocker ml(mutex_);
-  intptr_t index = FindPort(message->dest_port());
+  Shard* shard = ShardForPort(message->dest_port());
+  MutexLocker ml(shard->mutex);
+  intptr_t index = FindPort(shard, message->dest_port());
   if (index < 0) {
     delete message;
     return false;
   }
   ASSERT(index >= 0);
-  ASSERT(index < capacity_);
-  MessageHandler* handler = map_[index].handler;
-  ASSERT(map_[index].port != 0);
+  ASSERT(index < shard->capacity);
+  MessageHandler* handler = shard->map[index].handler;
+  ASSERT(shard->map[index].port != 0);
   ASSERT((handler != NULL) && (handler != deleted_entry_));
   handler->PostMessage(message);
   return true;
 }
 
 bool PortMap::IsLocalPort(Dart_Port id) {
-  MutexLocker ml(mutex_);
-  intptr_t index = FindPort(id);
+  Shard* shard = ShardForPort(id);
+  MutexLocker ml(shard->mutex);
+  intptr_t index = FindPort(shard, id);
   if (index < 0) {
     // Port does not exist.
     return false;
   }
 
-  MessageHandler* handler = map_[index].handler;
+  MessageHandler* handler = shard->map[index].handler;
   return handler->IsCurrentIsolate();
 }
 
 Isolate* PortMap::GetIsolate(Dart_Port id) {
-  MutexLocker ml(mutex_);
-  intptr_t index = FindPort(id);
+  Shard* shard = ShardForPort(id);
+  MutexLocker ml(shard->mutex);
+  intptr_t index = FindPort(shard, id);
   if (index < 0) {
     // Port does not exist.
     return NULL;
   }
 
-  MessageHandler* handler = map_[index].handler;
+  MessageHandler* handler = shard->map[index].handler;
   return handler->isolate();
 }
 
 void PortMap::InitOnce() {
-  mutex_ = new Mutex();
-  prng_ = new Random();
-
   static const intptr_t kInitialCapacity = 8;
   // TODO(iposva): Verify whether we want to keep exponentially growing.
   ASSERT(Utils::IsPowerOfTwo(kInitialCapacity));
-  map_ = new Entry[kInitialCapacity];
-  memset(map_, 0, kInitialCapacity * sizeof(Entry));
-  capacity_ = kInitialCapacity;
-  used_ = 0;
-  deleted_ = 0;
+  for (intptr_t i = 0; i < kNumShards; i++) {
+    Shard* shard = &shards_[i];
+    shard->mutex = new Mutex();
+    shard->prng = new Random();
+    shard->map = new Entry[kInitialCapacity];
+    memset(shard->map, 0, kInitialCapacity * sizeof(Entry));
+    shard->capacity = kInitialCapacity;
+    shard->used = 0;
+    shard->deleted = 0;
+  }
 }
 
 void PortMap::PrintPortsForMessageHandler(MessageHandler* handler,
@@ -301,14 +321,16 @@ void PortMap::PrintPortsForMessageHandler(MessageHandler* handler,
   Object& msg_handler = Object::Handle();
   {
     JSONArray ports(&jsobj, "ports");
-    SafepointMutexLocker ml(mutex_);
-    for (intptr_t i = 0; i < capacity_; i++) {
-      if (map_[i].handler == handler) {
-        if (map_[i].state == kLivePort) {
+    Shard* shard = &shards_[ShardIndexForHandler(handler)];
+    SafepointMutexLocker ml(shard->mutex);
+    Entry* map = shard->map;
+    for (intptr_t i = 0; i < shard->capacity; i++) {
+      if (map[i].handler == handler) {
+        if (map[i].state == kLivePort) {
           JSONObject port(&ports);
           port.AddProperty("type", "_Port");
-          port.AddPropertyF("name", "Isolate Port (%" Pd64 ")", map_[i].port);
-          msg_handler = DartLibraryCalls::LookupHandler(map_[i].port);
+          port.AddPropertyF("name", "Isolate Port (%" Pd64 ")", map[i].port);
+          msg_handler = DartLibraryCalls::LookupHandler(map[i].port);
           port.AddProperty("handler", msg_handler);
         }
       }
@@ -318,13 +340,15 @@ void PortMap::PrintPortsForMessageHandler(MessageHandler* handler,
 }
 
 void PortMap::DebugDumpForMessageHandler(MessageHandler* handler) {
-  SafepointMutexLocker ml(mutex_);
+  Shard* shard = &shards_[ShardIndexForHandler(handler)];
+  SafepointMutexLocker ml(shard->mutex);
   Object& msg_handler = Object::Handle();
-  for (intptr_t i = 0; i < capacity_; i++) {
-    if (map_[i].handler == handler) {
-      if (map_[i].state == kLivePort) {
-        OS::Print("Live Port = %" Pd64 "\n", map_[i].port);
-        msg_handler = DartLibraryCalls::LookupHandler(map_[i].port);
+  Entry* map = shard->map;
+  for (intptr_t i = 0; i < shard->capacity; i++) {
+    if (map[i].handler == handler) {
+      if (map[i].state == kLivePort) {
+        OS::Print("Live Port = %" Pd64 "\n", map[i].port);
+        msg_handler = DartLibraryCalls::LookupHandler(map[i].port);
         OS::Print("Handler = %s\n", msg_handler.ToCString());
       }
     }
@@ -74,30 +74,52 @@ class PortMap : public AllStatic {
     PortState state;
   } Entry;
 
+  // The port map is split into shards, each with its own lock and hashmap,
+  // so that posting to ports of different handlers does not contend on a
+  // single lock. All ports of a handler live in the same shard, and the
+  // shard index is encoded in the low bits of the port id.
+  typedef struct {
+    // Lock protecting access to this shard.
+    Mutex* mutex;
+
+    // Hashmap of ports.
+    Entry* map;
+    intptr_t capacity;
+    intptr_t used;
+    intptr_t deleted;
+
+    Random* prng;
+  } Shard;
+
+  static const intptr_t kNumShardsLog2 = 4;
+  static const intptr_t kNumShards = 1 << kNumShardsLog2;
+
   static const char* PortStateString(PortState state);
 
-  // Allocate a new unique port.
-  static Dart_Port AllocatePort();
+  static Shard* ShardForPort(Dart_Port port) {
+    return &shards_[port & (kNumShards - 1)];
+  }
+  static intptr_t ShardIndexForHandler(MessageHandler* handler);
+
+  // The low bits of a port select its shard, so index the shard's hashmap by
+  // the remaining bits.
+  static intptr_t IndexForPort(Dart_Port port, intptr_t capacity) {
+    return (port >> kNumShardsLog2) % capacity;
+  }
+
+  // Allocate a new unique port in the given shard.
+  static Dart_Port AllocatePort(Shard* shard, intptr_t shard_index);
 
   static bool IsActivePort(Dart_Port id);
   static bool IsLivePort(Dart_Port id);
 
-  static intptr_t FindPort(Dart_Port port);
-  static void Rehash(intptr_t new_capacity);
+  static intptr_t FindPort(Shard* shard, Dart_Port port);
+  static void Rehash(Shard* shard, intptr_t new_capacity);
 
-  static void MaintainInvariants();
+  static void MaintainInvariants(Shard* shard);
 
-  // Lock protecting access to the port map.
-  static Mutex* mutex_;
-
-  // Hashmap of ports.
-  static Entry* map_;
+  static Shard shards_[kNumShards];
   static MessageHandler* deleted_entry_;
-  static intptr_t capacity_;
-  static intptr_t used_;
-  static intptr_t deleted_;
-
-  static Random* prng_;
 };
 
 }  // namespace dart
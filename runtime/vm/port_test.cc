@@ -15,17 +15,19 @@ namespace dart {
 class PortMapTestPeer {
  public:
   static bool IsActivePort(Dart_Port port) {
-    MutexLocker ml(PortMap::mutex_);
-    return (PortMap::FindPort(port) >= 0);
+    PortMap::Shard* shard = PortMap::ShardForPort(port);
+    MutexLocker ml(shard->mutex);
+    return (PortMap::FindPort(shard, port) >= 0);
   }
 
   static bool IsLivePort(Dart_Port port) {
-    MutexLocker ml(PortMap::mutex_);
-    intptr_t index = PortMap::FindPort(port);
+    PortMap::Shard* shard = PortMap::ShardForPort(port);
+    MutexLocker ml(shard->mutex);
+    intptr_t index = PortMap::FindPort(shard, port);
     if (index < 0) {
       return false;
     }
-    return PortMap::map_[index].state == PortMap::kLivePort;
+    return shard->map[index].state == PortMap::kLivePort;
   }
 };
 
@@ -82,6 +84,28 @@ TEST_CASE(PortMap_ClosePorts) {
   EXPECT(!PortMapTestPeer::IsActivePort(port2));
 }
 
+TEST_CASE(PortMap_ClosePortsManyHandlers) {
+  const intptr_t kNumHandlers = 64;
+  PortTestMessageHandler handlers[kNumHandlers];
+  Dart_Port ports[kNumHandlers];
+  for (intptr_t i = 0; i < kNumHandlers; i++) {
+    ports[i] = PortMap::CreatePort(&handlers[i]);
+    EXPECT(PortMapTestPeer::IsActivePort(ports[i]));
+  }
+
+  // Closing the ports of one handler leaves the other handlers' ports alone.
+  for (intptr_t i = 0; i < kNumHandlers; i += 2) {
+    PortMap::ClosePorts(&handlers[i]);
+  }
+  for (intptr_t i = 0; i < kNumHandlers; i++) {
+    EXPECT_EQ((i % 2) != 0, PortMapTestPeer::IsActivePort(ports[i]));
+  }
+  for (intptr_t i = 1; i < kNumHandlers; i += 2) {
+    PortMap::ClosePorts(&handlers[i]);
+    EXPECT(!PortMapTestPeer::IsActivePort(ports[i]));
+  }
+}
+
 TEST_CASE(PortMap_CreateManyPorts) {
   PortTestMessageHandler handler;
   for (int i = 0; i < 32; i++) {
@@ -300,6 +300,75 @@ void ProgramVisitor::DedupPcDescriptors() {
   ProgramVisitor::VisitFunctions(&visitor);
 }
 
+class ExceptionHandlersKeyValueTrait {
+ public:
+  // Typedefs needed for the DirectChainedHashMap template.
+  typedef const ExceptionHandlers* Key;
+  typedef const ExceptionHandlers* Value;
+  typedef const ExceptionHandlers* Pair;
+
+  static Key KeyOf(Pair kv) { return kv; }
+
+  static Value ValueOf(Pair kv) { return kv; }
+
+  static inline intptr_t Hashcode(Key key) {
+    const intptr_t length = key->num_entries();
+    return (length == 0) ? 0 : (length ^ key->HandlerPCOffset(length - 1));
+  }
+
+  static inline bool IsKeyEqual(Pair pair, Key key) {
+    return pair->Equals(*key);
+  }
+};
+
+typedef DirectChainedHashMap<ExceptionHandlersKeyValueTrait>
+    ExceptionHandlersSet;
+
+void ProgramVisitor::DedupExceptionHandlers() {
+  class DedupExceptionHandlersVisitor : public FunctionVisitor {
+   public:
+    explicit DedupExceptionHandlersVisitor(Zone* zone)
+        : zone_(zone),
+          canonical_handlers_(),
+          code_(Code::Handle(zone)),
+          handlers_(ExceptionHandlers::Handle(zone)) {}
+
+    void Visit(const Function& function) {
+      if (!function.HasCode()) {
+        return;
+      }
+      code_ = function.CurrentCode();
+      handlers_ = code_.exception_handlers();
+      // Empty tables are already shared.
+      if (handlers_.IsNull() || (handlers_.num_entries() == 0)) return;
+      handlers_ = DedupExceptionHandler(handlers_);
+      code_.set_exception_handlers(handlers_);
+    }
+
+    RawExceptionHandlers* DedupExceptionHandler(
+        const ExceptionHandlers& handlers) {
+      const ExceptionHandlers* canonical_handlers =
+          canonical_handlers_.LookupValue(&handlers);
+      if (canonical_handlers == NULL) {
+        canonical_handlers_.Insert(
+            &ExceptionHandlers::ZoneHandle(zone_, handlers.raw()));
+        return handlers.raw();
+      } else {
+        return canonical_handlers->raw();
+      }
+    }
+
+   private:
+    Zone* zone_;
+    ExceptionHandlersSet canonical_handlers_;
+    Code& code_;
+    ExceptionHandlers& handlers_;
+  };
+
+  DedupExceptionHandlersVisitor visitor(Thread::Current()->zone());
+  ProgramVisitor::VisitFunctions(&visitor);
+}
+
 class TypedDataKeyValueTrait {
  public:
   // Typedefs needed for the DirectChainedHashMap template.
@@ -720,6 +789,7 @@ void ProgramVisitor::Dedup() {
   ShareMegamorphicBuckets();
   DedupStackMaps();
   DedupPcDescriptors();
+  DedupExceptionHandlers();
   NOT_IN_PRECOMPILED(DedupDeoptEntries());
 #if defined(DART_PRECOMPILER)
   DedupCatchEntryStateMaps();
@@ -33,6 +33,7 @@ class ProgramVisitor : public AllStatic {
   static void ShareMegamorphicBuckets();
   static void DedupStackMaps();
   static void DedupPcDescriptors();
+  static void DedupExceptionHandlers();
   NOT_IN_PRECOMPILED(static void DedupDeoptEntries());
 #if defined(DART_PRECOMPILER)
   static void DedupCatchEntryStateMaps();
@@ -10,6 +10,7 @@
 #include "vm/freelist.h"
 #include "vm/isolate.h"
 #include "vm/object.h"
+#include "vm/pages.h"
 #include "vm/visitor.h"
 
 namespace dart {
@@ -49,11 +50,11 @@ void RawObject::Validate(Isolate* isolate) const {
   }
 }
 
-intptr_t RawObject::SizeFromClass() const {
+intptr_t RawObject::HeapSizeFromClass(uint32_t tags) const {
   // Only reasonable to be called on heap objects.
   ASSERT(IsHeapObject());
 
-  intptr_t class_id = GetClassId();
+  intptr_t class_id = ClassIdTag::decode(tags);
   intptr_t instance_size = 0;
   switch (class_id) {
     case kCodeCid: {
@@ -115,9 +116,9 @@ intptr_t RawObject::SizeFromClass() const {
       CLASS_LIST_TYPED_DATA(SIZE_FROM_CLASS) {
         const RawTypedData* raw_obj =
             reinterpret_cast<const RawTypedData*>(this);
-        intptr_t cid = raw_obj->GetClassId();
         intptr_t array_len = Smi::Value(raw_obj->ptr()->length_);
-        intptr_t lengthInBytes = array_len * TypedData::ElementSizeInBytes(cid);
+        intptr_t lengthInBytes =
+            array_len * TypedData::ElementSizeInBytes(class_id);
         instance_size = TypedData::InstanceSize(lengthInBytes);
         break;
       }
@@ -183,8 +184,7 @@ intptr_t RawObject::SizeFromClass() const {
       ClassTable* class_table = isolate->class_table();
       if (!class_table->IsValidIndex(class_id) ||
           !class_table->HasValidClassAt(class_id)) {
-        FATAL2("Invalid class id: %" Pd " from tags %x\n", class_id,
-               ptr()->tags_);
+        FATAL2("Invalid class id: %" Pd " from tags %x\n", class_id, tags);
       }
 #endif  // DEBUG
       RawClass* raw_class = isolate->GetClassForHeapWalkAt(class_id);
@@ -194,7 +194,6 @@ intptr_t RawObject::SizeFromClass() const {
   }
   ASSERT(instance_size != 0);
 #if defined(DEBUG)
-  uint32_t tags = ptr()->tags_;
   intptr_t tags_size = SizeTag::decode(tags);
   if ((class_id == kArrayCid) && (instance_size > tags_size && tags_size > 0)) {
     // TODO(22501): Array::MakeFixedLength could be in the process of shrinking
@@ -290,6 +289,11 @@ bool RawObject::FindObject(FindObjectVisitor* visitor) {
   return visitor->FindObject(this);
 }
 
+void RawObject::RememberCard(RawObject* const* slot) {
+  ASSERT(IsCardRemembered());
+  HeapPage::Of(this)->RememberCard(slot);
+}
+
 // Most objects are visited with this function. It calls the from() and to()
 // methods on the raw object to get the first and last cells that need
 // visiting.
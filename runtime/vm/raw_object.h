@@ -292,8 +292,9 @@ class RawObject {
     kCanonicalBit = 1,
     kVMHeapObjectBit = 2,
     kRememberedBit = 3,
-    kReservedTagPos = 4,  // kReservedBit{10K,100K,1M,10M}
-    kReservedTagSize = 4,
+    kCardRememberedBit = 4,
+    kReservedTagPos = 5,  // kReservedBit{100K,1M,10M}
+    kReservedTagSize = 3,
     kSizeTagPos = kReservedTagPos + kReservedTagSize,  // = 8
     kSizeTagSize = 8,
     kClassIdTagPos = kSizeTagPos + kSizeTagSize,  // = 16
@@ -428,6 +429,18 @@ class RawObject {
   // TODO(koda): Add "must use result" annotation here, after we add support.
   bool TryAcquireRememberedBit() { return TryAcquireTagBit<RememberedBit>(); }
 
+  // Support for card marking. Stores into card remembered objects dirty the
+  // card covering the slot instead of adding the object to the store buffer.
+  bool IsCardRemembered() const {
+    return CardRememberedBit::decode(ptr()->tags_);
+  }
+  void SetCardRememberedBitUnsynchronized() {
+    ASSERT(!IsCardRemembered());
+    uint32_t tags = ptr()->tags_;
+    ptr()->tags_ = CardRememberedBit::update(true, tags);
+  }
+  void RememberCard(RawObject* const* slot);
+
 #define DEFINE_IS_CID(clazz)                                                   \
   bool Is##clazz() const { return ((GetClassId() == k##clazz##Cid)); }
   CLASS_LIST(DEFINE_IS_CID)
@@ -489,6 +502,19 @@ class RawObject {
     return result;
   }
 
+  // Like Size(), but decodes the given tags instead of reading the header.
+  // Used by the parallel scavenger, where another worker may overwrite the
+  // header with a forwarding pointer at any time.
+  intptr_t HeapSize(uint32_t tags) const {
+    intptr_t result = SizeTag::decode(tags);
+    if (result != 0) {
+      return result;
+    }
+    result = HeapSizeFromClass(tags);
+    ASSERT(result > SizeTag::kMaxSizeTag);
+    return result;
+  }
+
   bool Contains(uword addr) const {
     intptr_t this_size = Size();
     uword this_addr = RawObject::ToAddr(this);
@@ -586,6 +612,9 @@ class RawObject {
 
   class RememberedBit : public BitField<uint32_t, bool, kRememberedBit, 1> {};
 
+  class CardRememberedBit
+      : public BitField<uint32_t, bool, kCardRememberedBit, 1> {};
+
   class CanonicalObjectTag : public BitField<uint32_t, bool, kCanonicalBit, 1> {
   };
 
@@ -606,7 +635,8 @@ class RawObject {
   intptr_t VisitPointersPredefined(ObjectPointerVisitor* visitor,
                                    intptr_t class_id);
 
-  intptr_t SizeFromClass() const;
+  intptr_t SizeFromClass() const { return HeapSizeFromClass(ptr()->tags_); }
+  intptr_t HeapSizeFromClass(uint32_t tags) const;
 
   intptr_t GetClassId() const {
     uint32_t tags = ptr()->tags_;
@@ -653,9 +683,13 @@ class RawObject {
     *const_cast<type*>(addr) = value;
     // Filter stores based on source and target.
     if (!value->IsHeapObject()) return;
-    if (value->IsNewObject() && this->IsOldObject() && !this->IsRemembered()) {
-      this->SetRememberedBit();
-      Thread::Current()->StoreBufferAddObject(this);
+    if (value->IsNewObject() && this->IsOldObject()) {
+      if (this->IsCardRemembered()) {
+        RememberCard(reinterpret_cast<RawObject* const*>(addr));
+      } else if (!this->IsRemembered()) {
+        this->SetRememberedBit();
+        Thread::Current()->StoreBufferAddObject(this);
+      }
     }
   }
 
@@ -700,6 +734,7 @@ class RawObject {
   friend class RawInstance;
   friend class RawString;
   friend class RawTypedData;
+  friend class ParallelScavengerVisitor;  // GetClassId
   friend class Scavenger;
   friend class ScavengerVisitor;
   friend class SizeExcludingClassVisitor;  // GetClassId
@@ -1206,6 +1241,7 @@ class RawKernelProgramInfo : public RawObject {
   RawTypedData* metadata_mappings_;
   RawArray* scripts_;
   RawArray* constants_;
+  RawArray* name_lookup_cache_;
   RawGrowableObjectArray* potential_natives_;
   VISIT_TO(RawObject*, potential_natives_);
 };
@@ -1923,6 +1959,7 @@ class RawDouble : public RawNumber {
   ALIGN8 double value_;
 
   friend class Api;
+  friend class RODataSerializationCluster;
   friend class SnapshotReader;
 };
 COMPILE_ASSERT(sizeof(RawDouble) == 16);
@@ -2047,6 +2084,7 @@ class RawArray : public RawInstance {
   friend class RawImmutableArray;
   friend class SnapshotReader;
   friend class GrowableObjectArray;
+  friend class HeapPage;  // VisitRememberedCards
   friend class LinkedHashMap;
   friend class RawLinkedHashMap;
   friend class Object;
@@ -2248,7 +2286,10 @@ class RawRegExp : public RawInstance {
   } two_byte_sticky_;
   RawFunction* external_one_byte_sticky_function_;
   RawFunction* external_two_byte_sticky_function_;
-  VISIT_TO(RawObject*, external_two_byte_sticky_function_)
+  // Literal every match starts with, or null if there is none.
+  // Computed together with the bytecode.
+  RawString* literal_prefix_;
+  VISIT_TO(RawObject*, literal_prefix_)
 
   intptr_t num_registers_;
 
@@ -2273,6 +2314,7 @@ class RawWeakProperty : public RawInstance {
   friend class GCMarker;
   template <bool>
   friend class MarkingVisitorBase;
+  friend class ParallelScavengerVisitor;
   friend class Scavenger;
   friend class ScavengerVisitor;
 };
@@ -2032,9 +2032,8 @@ void String::ReadFromImpl(SnapshotReader* reader,
     // Set up canonical string object.
     ASSERT(reader != NULL);
     CharacterType* ptr = reader->zone()->Alloc<CharacterType>(len);
-    for (intptr_t i = 0; i < len; i++) {
-      ptr[i] = reader->Read<CharacterType>();
-    }
+    reader->ReadBytes(reinterpret_cast<uint8_t*>(ptr),
+                      len * sizeof(CharacterType));
     *str_obj ^= (*new_symbol)(reader->thread(), ptr, len);
   } else {
     // Set up the string object.
@@ -2045,10 +2044,8 @@ void String::ReadFromImpl(SnapshotReader* reader,
     }
     NoSafepointScope no_safepoint;
     CharacterType* str_addr = StringType::DataStart(*str_obj);
-    for (intptr_t i = 0; i < len; i++) {
-      *str_addr = reader->Read<CharacterType>();
-      str_addr++;
-    }
+    reader->ReadBytes(reinterpret_cast<uint8_t*>(str_addr),
+                      len * sizeof(CharacterType));
   }
 }
 
@@ -2084,6 +2081,19 @@ RawTwoByteString* TwoByteString::ReadFrom(SnapshotReader* reader,
   return raw(str_obj);
 }
 
+// This function's name can appear in Observatory.
+static void IsolateMessageStringFinalizer(void* isolate_callback_data,
+                                          Dart_WeakPersistentHandle handle,
+                                          void* buffer) {
+  free(buffer);
+}
+
+static void IsolateMessageExternalStringFinalizer(void* peer) {
+  free(peer);
+}
+
+static const intptr_t kExternalizeStringThreshold = 4 * KB;
+
 template <typename T>
 static void StringWriteTo(SnapshotWriter* writer,
                           intptr_t object_id,
@@ -2094,10 +2104,34 @@ static void StringWriteTo(SnapshotWriter* writer,
                           T* data) {
   ASSERT(writer != NULL);
   intptr_t len = Smi::Value(length);
+  intptr_t bytes = len * sizeof(T);
 
   // Write out the serialization header value for this object.
   writer->WriteInlinedObjectHeader(object_id);
 
+  // Large non-canonical strings in messages are handed to the receiver as
+  // external strings instead of being copied through the message buffer
+  // and again into the receiving heap.
+  if ((kind == Snapshot::kMessage) && !RawObject::IsCanonical(tags) &&
+      (bytes >= kExternalizeStringThreshold)) {
+    writer->WriteIndexedObject(class_id == kOneByteStringCid
+                                   ? kExternalOneByteStringCid
+                                   : kExternalTwoByteStringCid);
+    writer->WriteTags(tags);
+    writer->Write<RawObject*>(length);
+    void* passed_data = malloc(bytes);
+    if (passed_data == NULL) {
+      OUT_OF_MEMORY();
+    }
+    memmove(passed_data, data, bytes);
+    static_cast<MessageWriter*>(writer)->finalizable_data()->Put(
+        bytes,
+        passed_data,  // data
+        passed_data,  // peer,
+        IsolateMessageStringFinalizer);
+    return;
+  }
+
   // Write out the class and tags information.
   writer->WriteIndexedObject(class_id);
   writer->WriteTags(tags);
@@ -2107,13 +2141,7 @@ static void StringWriteTo(SnapshotWriter* writer,
 
   // Write out the string.
   if (len > 0) {
-    if (class_id == kOneByteStringCid) {
-      writer->WriteBytes(reinterpret_cast<const uint8_t*>(data), len);
-    } else {
-      for (intptr_t i = 0; i < len; i++) {
-        writer->Write(data[i]);
-      }
-    }
+    writer->WriteBytes(reinterpret_cast<const uint8_t*>(data), bytes);
   }
 }
 
@@ -2139,8 +2167,19 @@ RawExternalOneByteString* ExternalOneByteString::ReadFrom(
     intptr_t tags,
     Snapshot::Kind kind,
     bool as_reference) {
-  UNREACHABLE();
-  return ExternalOneByteString::null();
+  // Only written by StringWriteTo for large strings in messages.
+  ASSERT(kind == Snapshot::kMessage);
+  intptr_t len = reader->ReadSmiValue();
+  FinalizableData finalizable_data =
+      static_cast<MessageSnapshotReader*>(reader)->finalizable_data()->Take();
+  const uint8_t* data = reinterpret_cast<uint8_t*>(finalizable_data.data);
+  String& str_obj = String::ZoneHandle(
+      reader->zone(),
+      ExternalOneByteString::New(data, len, finalizable_data.peer,
+                                 IsolateMessageExternalStringFinalizer,
+                                 HEAP_SPACE(kind)));
+  reader->AddBackRef(object_id, &str_obj, kIsDeserialized);
+  return raw(str_obj);
 }
 
 RawExternalTwoByteString* ExternalTwoByteString::ReadFrom(
@@ -2149,8 +2188,19 @@ RawExternalTwoByteString* ExternalTwoByteString::ReadFrom(
     intptr_t tags,
     Snapshot::Kind kind,
     bool as_reference) {
-  UNREACHABLE();
-  return ExternalTwoByteString::null();
+  // Only written by StringWriteTo for large strings in messages.
+  ASSERT(kind == Snapshot::kMessage);
+  intptr_t len = reader->ReadSmiValue();
+  FinalizableData finalizable_data =
+      static_cast<MessageSnapshotReader*>(reader)->finalizable_data()->Take();
+  const uint16_t* data = reinterpret_cast<uint16_t*>(finalizable_data.data);
+  String& str_obj = String::ZoneHandle(
+      reader->zone(),
+      ExternalTwoByteString::New(data, len, finalizable_data.peer,
+                                 IsolateMessageExternalStringFinalizer,
+                                 HEAP_SPACE(kind)));
+  reader->AddBackRef(object_id, &str_obj, kIsDeserialized);
+  return raw(str_obj);
 }
 
 void RawExternalOneByteString::WriteTo(SnapshotWriter* writer,
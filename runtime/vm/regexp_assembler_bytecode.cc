@@ -5,10 +5,12 @@
 #include "vm/regexp_assembler_bytecode.h"
 
 #include "vm/exceptions.h"
+#include "vm/lockers.h"
 #include "vm/object_store.h"
 #include "vm/regexp.h"
 #include "vm/regexp_assembler.h"
 #include "vm/regexp_assembler_bytecode_inl.h"
+#include "vm/regexp_ast.h"
 #include "vm/regexp_bytecodes.h"
 #include "vm/regexp_interpreter.h"
 #include "vm/regexp_parser.h"
@@ -410,6 +412,182 @@ void BytecodeRegExpMacroAssembler::Expand() {
     buffer_->Add(0);
 }
 
+struct RegExpBytecodeCache::Entry {
+  Entry* next;
+
+  // Key.
+  uint16_t* pattern;
+  intptr_t pattern_length;
+  intptr_t pattern_hash;
+  bool ignore_case;
+  bool multiline;
+  bool is_one_byte;
+  bool sticky;
+
+  // Compilation results.
+  intptr_t capture_count;
+  bool is_simple;
+  intptr_t num_registers;
+  uint16_t* literal_prefix;
+  intptr_t literal_prefix_length;
+  uint8_t* bytecode;
+  intptr_t bytecode_length;
+};
+
+Mutex* RegExpBytecodeCache::mutex_ = NULL;
+RegExpBytecodeCache::Entry* RegExpBytecodeCache::entries_ = NULL;
+intptr_t RegExpBytecodeCache::length_ = 0;
+intptr_t RegExpBytecodeCache::hit_count_ = 0;
+
+void RegExpBytecodeCache::InitOnce() {
+  ASSERT(mutex_ == NULL);
+  mutex_ = new Mutex();
+}
+
+void RegExpBytecodeCache::Cleanup() {
+  Entry* entry = entries_;
+  while (entry != NULL) {
+    Entry* next = entry->next;
+    free(entry->pattern);
+    free(entry->literal_prefix);
+    free(entry->bytecode);
+    delete entry;
+    entry = next;
+  }
+  entries_ = NULL;
+  length_ = 0;
+  hit_count_ = 0;
+  delete mutex_;
+  mutex_ = NULL;
+}
+
+static uint16_t* CopyChars(const String& str) {
+  const intptr_t length = str.Length();
+  uint16_t* chars =
+      reinterpret_cast<uint16_t*>(malloc((length + 1) * sizeof(uint16_t)));
+  for (intptr_t i = 0; i < length; i++) {
+    chars[i] = str.CharAt(i);
+  }
+  return chars;
+}
+
+RegExpBytecodeCache::Entry* RegExpBytecodeCache::Find(const RegExp& regexp,
+                                                      const String& pattern,
+                                                      bool is_one_byte,
+                                                      bool sticky) {
+  ASSERT(mutex_->IsOwnedByCurrentThread());
+  const intptr_t length = pattern.Length();
+  const intptr_t hash = pattern.Hash();
+  for (Entry* entry = entries_; entry != NULL; entry = entry->next) {
+    if ((entry->pattern_hash != hash) || (entry->pattern_length != length) ||
+        (entry->ignore_case != regexp.is_ignore_case()) ||
+        (entry->multiline != regexp.is_multi_line()) ||
+        (entry->is_one_byte != is_one_byte) || (entry->sticky != sticky)) {
+      continue;
+    }
+    intptr_t i = 0;
+    while ((i < length) && (entry->pattern[i] == pattern.CharAt(i))) {
+      i++;
+    }
+    if (i == length) return entry;
+  }
+  return NULL;
+}
+
+bool RegExpBytecodeCache::Lookup(const RegExp& regexp,
+                                 bool is_one_byte,
+                                 bool sticky,
+                                 Zone* zone) {
+  const String& pattern = String::Handle(zone, regexp.pattern());
+  Entry* entry;
+  {
+    MutexLocker ml(mutex_);
+    entry = Find(regexp, pattern, is_one_byte, sticky);
+    if (entry != NULL) {
+      hit_count_++;
+    }
+  }
+  if (entry == NULL) return false;
+
+  // Entries are immutable and only freed at VM shutdown, so they can be read
+  // without holding the lock.
+  regexp.set_num_bracket_expressions(entry->capture_count);
+  if (entry->is_simple) {
+    regexp.set_is_simple();
+  } else {
+    regexp.set_is_complex();
+  }
+  if ((entry->literal_prefix != NULL) &&
+      (regexp.literal_prefix() == String::null())) {
+    regexp.set_literal_prefix(String::Handle(
+        zone, String::FromUTF16(entry->literal_prefix,
+                                entry->literal_prefix_length, Heap::kOld)));
+  }
+  ASSERT((regexp.num_registers() == -1) ||
+         (regexp.num_registers() == entry->num_registers));
+  regexp.set_num_registers(entry->num_registers);
+
+  const TypedData& bytecode = TypedData::Handle(
+      zone, TypedData::New(kTypedDataUint8ArrayCid, entry->bytecode_length,
+                           Heap::kOld));
+  {
+    NoSafepointScope no_safepoint;
+    memmove(bytecode.DataAddr(0), entry->bytecode, entry->bytecode_length);
+  }
+  regexp.set_bytecode(is_one_byte, sticky, bytecode);
+  return true;
+}
+
+intptr_t RegExpBytecodeCache::hit_count() {
+  MutexLocker ml(mutex_);
+  return hit_count_;
+}
+
+void RegExpBytecodeCache::Insert(const RegExp& regexp,
+                                 bool is_one_byte,
+                                 bool sticky) {
+  Zone* zone = Thread::Current()->zone();
+  const String& pattern = String::Handle(zone, regexp.pattern());
+  const String& prefix = String::Handle(zone, regexp.literal_prefix());
+  const TypedData& bytecode =
+      TypedData::Handle(zone, regexp.bytecode(is_one_byte, sticky));
+  ASSERT(!bytecode.IsNull());
+
+  MutexLocker ml(mutex_);
+  if ((length_ >= kMaxEntries) ||
+      (Find(regexp, pattern, is_one_byte, sticky) != NULL)) {
+    return;
+  }
+
+  Entry* entry = new Entry();
+  entry->pattern = CopyChars(pattern);
+  entry->pattern_length = pattern.Length();
+  entry->pattern_hash = pattern.Hash();
+  entry->ignore_case = regexp.is_ignore_case();
+  entry->multiline = regexp.is_multi_line();
+  entry->is_one_byte = is_one_byte;
+  entry->sticky = sticky;
+  entry->capture_count = Smi::Value(regexp.num_bracket_expressions());
+  entry->is_simple = regexp.is_simple();
+  entry->num_registers = regexp.num_registers();
+  if (prefix.IsNull()) {
+    entry->literal_prefix = NULL;
+    entry->literal_prefix_length = 0;
+  } else {
+    entry->literal_prefix = CopyChars(prefix);
+    entry->literal_prefix_length = prefix.Length();
+  }
+  entry->bytecode_length = bytecode.LengthInBytes();
+  entry->bytecode = reinterpret_cast<uint8_t*>(malloc(entry->bytecode_length));
+  {
+    NoSafepointScope no_safepoint;
+    memmove(entry->bytecode, bytecode.DataAddr(0), entry->bytecode_length);
+  }
+  entry->next = entries_;
+  entries_ = entry;
+  length_++;
+}
+
 static intptr_t Prepare(const RegExp& regexp,
                         const String& subject,
                         bool sticky,
@@ -417,7 +595,8 @@ static intptr_t Prepare(const RegExp& regexp,
   bool is_one_byte =
       subject.IsOneByteString() || subject.IsExternalOneByteString();
 
-  if (regexp.bytecode(is_one_byte, sticky) == TypedData::null()) {
+  if ((regexp.bytecode(is_one_byte, sticky) == TypedData::null()) &&
+      !RegExpBytecodeCache::Lookup(regexp, is_one_byte, sticky, zone)) {
     const String& pattern = String::Handle(zone, regexp.pattern());
 #if !defined(PRODUCT)
     TimelineDurationScope tds(Thread::Current(), Timeline::GetCompilerStream(),
@@ -436,6 +615,16 @@ static intptr_t Prepare(const RegExp& regexp,
     }
 
     regexp.set_num_bracket_expressions(compile_data->capture_count);
+    if (!regexp.is_ignore_case() && regexp.literal_prefix() == String::null()) {
+      ZoneGrowableArray<uint16_t>* prefix =
+          new (zone) ZoneGrowableArray<uint16_t>(4);
+      compile_data->tree->AppendLiteralPrefix(prefix);
+      if (prefix->length() > 0) {
+        regexp.set_literal_prefix(String::Handle(
+            zone, String::FromUTF16(prefix->data(), prefix->length(),
+                                    Heap::kOld)));
+      }
+    }
     if (compile_data->simple) {
       regexp.set_is_simple();
     } else {
@@ -449,6 +638,7 @@ static intptr_t Prepare(const RegExp& regexp,
            (regexp.num_registers() == result.num_registers));
     regexp.set_num_registers(result.num_registers);
     regexp.set_bytecode(is_one_byte, sticky, *(result.bytecode));
+    RegExpBytecodeCache::Insert(regexp, is_one_byte, sticky);
   }
 
   ASSERT(regexp.num_registers() != -1);
@@ -457,6 +647,44 @@ static intptr_t Prepare(const RegExp& regexp,
          (Smi::Value(regexp.num_bracket_expressions()) + 1) * 2;
 }
 
+// Returns the first position at or after start where prefix occurs in
+// subject, or -1 if there is none. StringType is the representation class
+// of subject, so that each character access is a direct load.
+template <typename StringType>
+static intptr_t FindLiteralPrefix(const String& subject,
+                                  const String& prefix,
+                                  intptr_t start) {
+  const intptr_t prefix_length = prefix.Length();
+  const intptr_t end = subject.Length() - prefix_length + 1;
+  const uint16_t first = prefix.CharAt(0);
+  for (intptr_t i = start; i < end; i++) {
+    if (StringType::CharAt(subject, i) != first) continue;
+    intptr_t j = 1;
+    while ((j < prefix_length) &&
+           (StringType::CharAt(subject, i + j) == prefix.CharAt(j))) {
+      j++;
+    }
+    if (j == prefix_length) return i;
+  }
+  return -1;
+}
+
+static intptr_t FindLiteralPrefix(const String& subject,
+                                  const String& prefix,
+                                  intptr_t start) {
+  NoSafepointScope no_safepoint;
+  if (subject.IsOneByteString()) {
+    return FindLiteralPrefix<OneByteString>(subject, prefix, start);
+  } else if (subject.IsExternalOneByteString()) {
+    return FindLiteralPrefix<ExternalOneByteString>(subject, prefix, start);
+  } else if (subject.IsTwoByteString()) {
+    return FindLiteralPrefix<TwoByteString>(subject, prefix, start);
+  } else {
+    ASSERT(subject.IsExternalTwoByteString());
+    return FindLiteralPrefix<ExternalTwoByteString>(subject, prefix, start);
+  }
+}
+
 static IrregexpInterpreter::IrregexpResult ExecRaw(const RegExp& regexp,
                                                    const String& subject,
                                                    intptr_t index,
@@ -482,6 +710,17 @@ static IrregexpInterpreter::IrregexpResult ExecRaw(const RegExp& regexp,
     raw_output[i] = -1;
   }
 
+  // No match can start before the first occurrence of the literal prefix, so
+  // skip straight to it instead of stepping through the bytecode at every
+  // position in between.
+  const String& prefix = String::Handle(zone, regexp.literal_prefix());
+  if (!sticky && !prefix.IsNull()) {
+    index = FindLiteralPrefix(subject, prefix, index);
+    if (index < 0) {
+      return IrregexpInterpreter::RE_FAILURE;
+    }
+  }
+
   const TypedData& bytecode =
       TypedData::Handle(zone, regexp.bytecode(is_one_byte, sticky));
   ASSERT(!bytecode.IsNull());
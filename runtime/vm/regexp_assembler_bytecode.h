@@ -138,6 +138,44 @@ class BytecodeRegExpMacroAssembler : public RegExpMacroAssembler {
   DISALLOW_IMPLICIT_CONSTRUCTORS(BytecodeRegExpMacroAssembler);
 };
 
+// Process-wide cache of regexp bytecode, shared by all isolates. Bytecode
+// holds no references into the heap, so an isolate that compiles a pattern
+// another isolate already compiled gets a copy of the bytes instead of
+// parsing and compiling it again.
+class RegExpBytecodeCache : public AllStatic {
+ public:
+  static void InitOnce();
+  static void Cleanup();
+
+  // Installs the cached bytecode and compilation results into regexp.
+  // Returns false if the pattern and flags have not been compiled yet.
+  static bool Lookup(const RegExp& regexp,
+                     bool is_one_byte,
+                     bool sticky,
+                     Zone* zone);
+
+  // Records the bytecode just compiled for regexp.
+  static void Insert(const RegExp& regexp, bool is_one_byte, bool sticky);
+
+  // Number of successful lookups since the VM started.
+  static intptr_t hit_count();
+
+ private:
+  struct Entry;
+
+  static const intptr_t kMaxEntries = 512;
+
+  static Entry* Find(const RegExp& regexp,
+                     const String& pattern,
+                     bool is_one_byte,
+                     bool sticky);
+
+  static Mutex* mutex_;
+  static Entry* entries_;
+  static intptr_t length_;
+  static intptr_t hit_count_;
+};
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_REGEXP_ASSEMBLER_BYTECODE_H_
@@ -120,6 +120,50 @@ bool RegExpCapture::IsAnchoredAtEnd() const {
   return body()->IsAnchoredAtEnd();
 }
 
+bool RegExpAssertion::AppendLiteralPrefix(
+    ZoneGrowableArray<uint16_t>* prefix) {
+  // Assertions consume no input, so the literal that follows still starts
+  // at the match position.
+  return true;
+}
+
+bool RegExpEmpty::AppendLiteralPrefix(
+    ZoneGrowableArray<uint16_t>* prefix) {
+  return true;
+}
+
+bool RegExpAtom::AppendLiteralPrefix(
+    ZoneGrowableArray<uint16_t>* prefix) {
+  for (intptr_t i = 0; i < data_->length(); i++) {
+    prefix->Add(data_->At(i));
+  }
+  return true;
+}
+
+bool RegExpText::AppendLiteralPrefix(
+    ZoneGrowableArray<uint16_t>* prefix) {
+  for (intptr_t i = 0; i < elements_.length(); i++) {
+    TextElement elm = elements_[i];
+    if (elm.text_type() != TextElement::ATOM) return false;
+    elm.atom()->AppendLiteralPrefix(prefix);
+  }
+  return true;
+}
+
+bool RegExpAlternative::AppendLiteralPrefix(
+    ZoneGrowableArray<uint16_t>* prefix) {
+  ZoneGrowableArray<RegExpTree*>* nodes = this->nodes();
+  for (intptr_t i = 0; i < nodes->length(); i++) {
+    if (!nodes->At(i)->AppendLiteralPrefix(prefix)) return false;
+  }
+  return true;
+}
+
+bool RegExpCapture::AppendLiteralPrefix(
+    ZoneGrowableArray<uint16_t>* prefix) {
+  return body()->AppendLiteralPrefix(prefix);
+}
+
 // Convert regular expression trees to a simple sexp representation.
 // This representation should be different from the input grammar
 // in as many cases as possible, to make it more difficult for incorrect
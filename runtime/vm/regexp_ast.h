@@ -50,6 +50,12 @@ class RegExpTree : public ZoneAllocated {
   // expression.
   virtual Interval CaptureRegisters() const { return Interval::Empty(); }
   virtual void AppendToText(RegExpText* text);
+  // Appends to prefix the characters every match of this expression starts
+  // with. Returns false if the expression is not a plain literal, in which
+  // case nothing that follows it can extend the prefix.
+  virtual bool AppendLiteralPrefix(ZoneGrowableArray<uint16_t>* prefix) {
+    return false;
+  }
   void Print();
 #define MAKE_ASTYPE(Name)                                                      \
   virtual RegExp##Name* As##Name();                                            \
@@ -90,6 +96,7 @@ class RegExpAlternative : public RegExpTree {
   virtual bool IsAnchoredAtEnd() const;
   virtual intptr_t min_match() const { return min_match_; }
   virtual intptr_t max_match() const { return max_match_; }
+  virtual bool AppendLiteralPrefix(ZoneGrowableArray<uint16_t>* prefix);
   ZoneGrowableArray<RegExpTree*>* nodes() const { return nodes_; }
 
  private:
@@ -117,6 +124,7 @@ class RegExpAssertion : public RegExpTree {
   virtual bool IsAnchoredAtEnd() const;
   virtual intptr_t min_match() const { return 0; }
   virtual intptr_t max_match() const { return 0; }
+  virtual bool AppendLiteralPrefix(ZoneGrowableArray<uint16_t>* prefix);
   AssertionType assertion_type() const { return assertion_type_; }
 
  private:
@@ -197,6 +205,7 @@ class RegExpAtom : public RegExpTree {
   virtual bool IsTextElement() const { return true; }
   virtual intptr_t min_match() const { return data_->length(); }
   virtual intptr_t max_match() const { return data_->length(); }
+  virtual bool AppendLiteralPrefix(ZoneGrowableArray<uint16_t>* prefix);
   virtual void AppendToText(RegExpText* text);
   ZoneGrowableArray<uint16_t>* data() const { return data_; }
   intptr_t length() const { return data_->length(); }
@@ -215,6 +224,7 @@ class RegExpText : public RegExpTree {
   virtual bool IsTextElement() const { return true; }
   virtual intptr_t min_match() const { return length_; }
   virtual intptr_t max_match() const { return length_; }
+  virtual bool AppendLiteralPrefix(ZoneGrowableArray<uint16_t>* prefix);
   virtual void AppendToText(RegExpText* text);
   void AddElement(TextElement elm) {
     elements_.Add(elm);
@@ -292,6 +302,7 @@ class RegExpCapture : public RegExpTree {
   virtual bool IsCapture() const;
   virtual intptr_t min_match() const { return body_->min_match(); }
   virtual intptr_t max_match() const { return body_->max_match(); }
+  virtual bool AppendLiteralPrefix(ZoneGrowableArray<uint16_t>* prefix);
   RegExpTree* body() const { return body_; }
   intptr_t index() const { return index_; }
   static intptr_t StartRegister(intptr_t index) { return index * 2; }
@@ -358,6 +369,7 @@ class RegExpEmpty : public RegExpTree {
   virtual bool IsEmpty() const;
   virtual intptr_t min_match() const { return 0; }
   virtual intptr_t max_match() const { return 0; }
+  virtual bool AppendLiteralPrefix(ZoneGrowableArray<uint16_t>* prefix);
   static RegExpEmpty* GetInstance() {
     static RegExpEmpty* instance = ::new RegExpEmpty();
     return instance;
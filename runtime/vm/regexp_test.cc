@@ -7,11 +7,14 @@
 #include "vm/isolate.h"
 #include "vm/object.h"
 #include "vm/regexp.h"
+#include "vm/regexp_assembler_bytecode.h"
 #include "vm/regexp_assembler_ir.h"
 #include "vm/unit_test.h"
 
 namespace dart {
 
+DECLARE_FLAG(bool, interpret_irregexp);
+
 static RawArray* Match(const String& pat, const String& str) {
   Thread* thread = Thread::Current();
   Zone* zone = thread->zone();
@@ -106,4 +109,77 @@ TEST_CASE(RegExp_ExternalTwoByteString) {
   EXPECT_EQ(3, smi_2.Value());
 }
 
+static RawInstance* Interpret(const char* pat, const char* str) {
+  Thread* thread = Thread::Current();
+  Zone* zone = thread->zone();
+  const String& pattern = String::Handle(String::New(pat));
+  const RegExp& regexp = RegExp::Handle(
+      RegExpEngine::CreateRegExp(thread, pattern, false, false));
+  const String& subject = String::Handle(String::New(str));
+  const Smi& idx = Smi::Handle(Smi::New(0));
+  return BytecodeRegExpMacroAssembler::Interpret(regexp, subject, idx,
+                                                 /*sticky=*/false, zone);
+}
+
+TEST_CASE(RegExp_BytecodeLiteralPrefix) {
+  SetFlagScope<bool> sfs(&FLAG_interpret_irregexp, true);
+
+  TypedData& res = TypedData::Handle();
+  res ^= Interpret("b(c)d", "abcbcda");
+  EXPECT(!res.IsNull());
+  EXPECT_EQ(3, res.GetInt32(0 * sizeof(int32_t)));
+  EXPECT_EQ(6, res.GetInt32(1 * sizeof(int32_t)));
+  EXPECT_EQ(4, res.GetInt32(2 * sizeof(int32_t)));
+  EXPECT_EQ(5, res.GetInt32(3 * sizeof(int32_t)));
+
+  res ^= Interpret("\\bbc", "abcd bcd");
+  EXPECT(!res.IsNull());
+  EXPECT_EQ(5, res.GetInt32(0 * sizeof(int32_t)));
+
+  EXPECT(Interpret("bcx", "abcbcda") == Instance::null());
+  EXPECT(Interpret("^bc", "abc") == Instance::null());
+}
+
+TEST_CASE(RegExp_BytecodeCache) {
+  SetFlagScope<bool> sfs(&FLAG_interpret_irregexp, true);
+
+  // The cache is process-wide, so use a pattern no other test compiles.
+  const String& pattern = String::Handle(String::New("a(b+)c(?=d)"));
+  const String& subject = String::Handle(String::New("xxabbbcd"));
+  const Smi& idx = Smi::Handle(Smi::New(0));
+  const bool kOneByte = true;
+  const bool kSticky = false;
+  RegExp& regexp = RegExp::Handle();
+  TypedData& bytecode = TypedData::Handle();
+  TypedData& res = TypedData::Handle();
+  const intptr_t hits_before = RegExpBytecodeCache::hit_count();
+  for (intptr_t i = 0; i < 2; i++) {
+    regexp = RegExpEngine::CreateRegExp(thread, pattern, false, false);
+    EXPECT(regexp.bytecode(kOneByte, kSticky) == TypedData::null());
+    res ^= BytecodeRegExpMacroAssembler::Interpret(regexp, subject, idx,
+                                                   kSticky, thread->zone());
+    EXPECT(!res.IsNull());
+    EXPECT_EQ(2, res.GetInt32(0 * sizeof(int32_t)));
+    EXPECT_EQ(7, res.GetInt32(1 * sizeof(int32_t)));
+    EXPECT_EQ(3, res.GetInt32(2 * sizeof(int32_t)));
+    EXPECT_EQ(6, res.GetInt32(3 * sizeof(int32_t)));
+
+    // The first regexp compiles the pattern, the second one installs a copy
+    // of the cached bytecode.
+    EXPECT_EQ(hits_before + i, RegExpBytecodeCache::hit_count());
+    const TypedData& installed =
+        TypedData::Handle(regexp.bytecode(kOneByte, kSticky));
+    EXPECT(!installed.IsNull());
+    if (i == 0) {
+      bytecode = installed.raw();
+    } else {
+      EXPECT(installed.raw() != bytecode.raw());
+      EXPECT_EQ(bytecode.LengthInBytes(), installed.LengthInBytes());
+      NoSafepointScope no_safepoint;
+      EXPECT(memcmp(bytecode.DataAddr(0), installed.DataAddr(0),
+                    bytecode.LengthInBytes()) == 0);
+    }
+  }
+}
+
 }  // namespace dart
@@ -256,6 +256,13 @@ DEFINE_RUNTIME_ENTRY(AllocateObject, 2) {
   }
 #endif
   Heap::Space space = Heap::kNew;
+#ifndef PRODUCT
+  // Classes whose instances almost always survive scavenges are allocated
+  // directly in old space to avoid copying them on their way there.
+  if (isolate->class_table()->ShouldPretenureFor(cls.id())) {
+    space = Heap::kOld;
+  }
+#endif  // !PRODUCT
   const Instance& instance = Instance::Handle(Instance::New(cls, space));
 
   arguments.SetReturn(instance);
@@ -1456,6 +1463,25 @@ DEFINE_RUNTIME_ENTRY(MegamorphicCacheMissHandler, 3) {
         // Switch to megamorphic call.
         const MegamorphicCache& cache = MegamorphicCache::Handle(
             zone, MegamorphicCacheTable::Lookup(isolate, name, descriptor));
+        // Seed the cache with the receivers already seen at this call site,
+        // so that the switch does not cost another miss for each of them.
+        Smi& check_cid = Smi::Handle(zone);
+        Object& target_or_code = Object::Handle(zone);
+        Function& check_target = Function::Handle(zone);
+        cache.EnsureCapacity(ic_data.NumberOfChecks());
+        for (intptr_t i = 0; i < ic_data.NumberOfChecks(); i++) {
+          check_cid = Smi::New(ic_data.GetReceiverClassIdAt(i));
+          if (cache.Lookup(check_cid) != Function::null()) {
+            continue;
+          }
+          target_or_code = ic_data.GetTargetOrCodeAt(i);
+          if (target_or_code.IsCode()) {
+            check_target ^= Code::Cast(target_or_code).owner();
+          } else {
+            check_target ^= target_or_code.raw();
+          }
+          cache.Insert(check_cid, check_target);
+        }
         DartFrameIterator iterator(thread,
                                    StackFrameIterator::kNoCrossThreadIteration);
         StackFrame* miss_function_frame = iterator.NextFrame();
@@ -1730,6 +1756,72 @@ static void HandleStackOverflowTestCases(Thread* thread) {
 #endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
+// OSR code is not installed on the function, so without a cache every call
+// that runs a long loop before the function gets optimized would compile
+// the same OSR code again. The cache holds (function, OSR id, unoptimized
+// code, deoptimization counter, OSR code) tuples. The unoptimized code is
+// part of the key because the OSR code deoptimizes into it. Deoptimizing OSR
+// code does not disable it, so the deoptimization counter is part of the key
+// to recompile with fresh feedback after a deoptimization.
+static const intptr_t kOsrCodeCacheEntrySize = 5;
+static const intptr_t kMaxOsrCodeCacheEntries = 32;
+
+static RawCode* LookupOsrCode(Zone* zone,
+                              const Function& function,
+                              const Code& unoptimized_code,
+                              intptr_t osr_id) {
+  const GrowableObjectArray& cache = GrowableObjectArray::Handle(
+      zone, Isolate::Current()->object_store()->osr_code_cache());
+  if (cache.IsNull()) return Code::null();
+  for (intptr_t i = 0; i < cache.Length(); i += kOsrCodeCacheEntrySize) {
+    if ((cache.At(i) == function.raw()) &&
+        (Smi::Value(Smi::RawCast(cache.At(i + 1))) == osr_id) &&
+        (cache.At(i + 2) == unoptimized_code.raw()) &&
+        (Smi::Value(Smi::RawCast(cache.At(i + 3))) ==
+         function.deoptimization_counter())) {
+      const Code& code = Code::Handle(zone, Code::RawCast(cache.At(i + 4)));
+      // Code whose assumptions were invalidated is disabled, but not removed
+      // from here.
+      return code.IsDisabled() ? Code::null() : code.raw();
+    }
+  }
+  return Code::null();
+}
+
+static void AddOsrCode(Zone* zone,
+                       const Function& function,
+                       const Code& unoptimized_code,
+                       intptr_t osr_id,
+                       const Code& code) {
+  ObjectStore* object_store = Isolate::Current()->object_store();
+  GrowableObjectArray& cache =
+      GrowableObjectArray::Handle(zone, object_store->osr_code_cache());
+  if (cache.IsNull()) {
+    cache = GrowableObjectArray::New(kOsrCodeCacheEntrySize, Heap::kOld);
+    object_store->set_osr_code_cache(cache);
+  }
+  const Smi& deopt_counter =
+      Smi::Handle(zone, Smi::New(function.deoptimization_counter()));
+  // Replace a stale entry for the same loop.
+  for (intptr_t i = 0; i < cache.Length(); i += kOsrCodeCacheEntrySize) {
+    if ((cache.At(i) == function.raw()) &&
+        (Smi::Value(Smi::RawCast(cache.At(i + 1))) == osr_id)) {
+      cache.SetAt(i + 2, unoptimized_code);
+      cache.SetAt(i + 3, deopt_counter);
+      cache.SetAt(i + 4, code);
+      return;
+    }
+  }
+  if (cache.Length() >= kMaxOsrCodeCacheEntries * kOsrCodeCacheEntrySize) {
+    cache.SetLength(0);
+  }
+  cache.Add(function, Heap::kOld);
+  cache.Add(Smi::Handle(zone, Smi::New(osr_id)), Heap::kOld);
+  cache.Add(unoptimized_code, Heap::kOld);
+  cache.Add(deopt_counter, Heap::kOld);
+  cache.Add(code, Heap::kOld);
+}
+
 static void HandleOSRRequest(Thread* thread) {
   Isolate* isolate = thread->isolate();
   ASSERT(isolate->use_osr());
@@ -1762,21 +1854,29 @@ static void HandleOSRRequest(Thread* thread) {
   // The unoptimized code is on the stack and should never be detached from
   // the function at this point.
   ASSERT(function.unoptimized_code() != Object::null());
-  intptr_t osr_id =
-      Code::Handle(function.unoptimized_code()).GetDeoptIdForOsr(frame->pc());
+  intptr_t osr_id = code.GetDeoptIdForOsr(frame->pc());
   ASSERT(osr_id != Compiler::kNoOSRDeoptId);
+
+  Zone* zone = thread->zone();
+  Object& result =
+      Object::Handle(zone, LookupOsrCode(zone, function, code, osr_id));
   if (FLAG_trace_osr) {
-    OS::Print("Attempting OSR for %s at id=%" Pd ", count=%" Pd "\n",
+    OS::Print("%s OSR for %s at id=%" Pd ", count=%" Pd "\n",
+              result.IsNull() ? "Attempting" : "Reusing",
               function.ToFullyQualifiedCString(), osr_id,
               function.usage_counter());
   }
 
-  // Since the code is referenced from the frame and the ZoneHandle,
-  // it cannot have been removed from the function.
-  const Object& result = Object::Handle(
-      Compiler::CompileOptimizedFunction(thread, function, osr_id));
-  if (result.IsError()) {
-    Exceptions::PropagateError(Error::Cast(result));
+  if (result.IsNull()) {
+    // Since the code is referenced from the frame and the ZoneHandle,
+    // it cannot have been removed from the function.
+    result = Compiler::CompileOptimizedFunction(thread, function, osr_id);
+    if (result.IsError()) {
+      Exceptions::PropagateError(Error::Cast(result));
+    }
+    if (!result.IsNull()) {
+      AddOsrCode(zone, function, code, osr_id, Code::Cast(result));
+    }
   }
 
   if (!result.IsNull()) {
@@ -6,6 +6,7 @@
 
 #include "vm/thread.h"
 #include "vm/thread_registry.h"
+#include "vm/timeline.h"
 
 namespace dart {
 
@@ -101,7 +102,18 @@ void SafepointHandler::SafepointThreads(Thread* T) {
   }
   // Now wait for all threads that are not already at a safepoint to check-in.
   {
+    NOT_IN_PRODUCT(TimelineDurationScope tds(T, Timeline::GetIsolateStream(),
+                                             "WaitForSafepoint"));
     MonitorLocker sl(safepoint_lock_);
+#if !defined(PRODUCT)
+    if (tds.enabled()) {
+      tds.SetNumArguments(1);
+      tds.FormatArgument(0, "threadsNotAtSafepoint", "%d",
+                         number_threads_not_at_safepoint_);
+    }
+    const int64_t start = OS::GetCurrentMonotonicMicros();
+    const bool must_wait = (number_threads_not_at_safepoint_ > 0);
+#endif  // !defined(PRODUCT)
     intptr_t num_attempts = 0;
     while (number_threads_not_at_safepoint_ > 0) {
       Monitor::WaitResult retval = sl.Wait(1000);
@@ -115,6 +127,12 @@ void SafepointHandler::SafepointThreads(Thread* T) {
         }
       }
     }
+#if !defined(PRODUCT)
+    if (must_wait) {
+      isolate()->GetSafepointWaitMaxMetric()->SetValue(
+          OS::GetCurrentMonotonicMicros() - start);
+    }
+#endif  // !defined(PRODUCT)
   }
 }
 
@@ -157,7 +175,10 @@ void SafepointHandler::EnterSafepointUsingLock(Thread* T) {
     MonitorLocker sl(safepoint_lock_);
     ASSERT(number_threads_not_at_safepoint_ > 0);
     number_threads_not_at_safepoint_ -= 1;
-    sl.Notify();
+    // Only the last thread to check in needs to wake up the requester.
+    if (number_threads_not_at_safepoint_ == 0) {
+      sl.Notify();
+    }
   }
 }
 
@@ -180,7 +201,9 @@ void SafepointHandler::BlockForSafepoint(Thread* T) {
       MonitorLocker sl(safepoint_lock_);
       ASSERT(number_threads_not_at_safepoint_ > 0);
       number_threads_not_at_safepoint_ -= 1;
-      sl.Notify();
+      if (number_threads_not_at_safepoint_ == 0) {
+        sl.Notify();
+      }
     }
     while (T->IsSafepointRequested()) {
       T->SetBlockedForSafepoint(true);
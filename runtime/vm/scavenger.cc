@@ -14,6 +14,8 @@
 #include "vm/safepoint.h"
 #include "vm/stack_frame.h"
 #include "vm/store_buffer.h"
+#include "vm/thread_barrier.h"
+#include "vm/thread_pool.h"
 #include "vm/thread_registry.h"
 #include "vm/timeline.h"
 #include "vm/verifier.h"
@@ -102,7 +104,14 @@ class ScavengerVisitor : public ObjectPointerVisitor {
       ASSERT(heap_->DataContains(ptr));
     }
     // If the newly written object is not a new object, drop it immediately.
-    if (!obj->IsNewObject() || visiting_old_object_->IsRemembered()) {
+    if (!obj->IsNewObject()) {
+      return;
+    }
+    if (visiting_old_object_->IsCardRemembered()) {
+      visiting_old_object_->RememberCard(p);
+      return;
+    }
+    if (visiting_old_object_->IsRemembered()) {
       return;
     }
     visiting_old_object_->SetRememberedBit();
@@ -191,6 +200,598 @@ class ScavengerVisitor : public ObjectPointerVisitor {
   DISALLOW_COPY_AND_ASSIGN(ScavengerVisitor);
 };
 
+// Objects copied or promoted by a parallel scavenger worker whose pointers
+// have not yet been scavenged. Full blocks are handed to the worker's stash
+// of the shared MarkingStack, from which idle workers steal them.
+class ScavengerWorkList : public ValueObject {
+ public:
+  ScavengerWorkList(MarkingStack* work_stack, intptr_t stash)
+      : work_stack_(work_stack), stash_(stash) {
+    work_ = work_stack_->PopEmptyBlock();
+  }
+
+  ~ScavengerWorkList() {
+    ASSERT(work_ == NULL);
+    ASSERT(work_stack_ == NULL);
+  }
+
+  // Returns NULL if no more work was found.
+  RawObject* Pop() {
+    ASSERT(work_ != NULL);
+    if (work_->IsEmpty()) {
+      MarkingStack::Block* new_work = work_stack_->PopNonEmptyBlock(stash_);
+      if (new_work == NULL) {
+        return NULL;
+      }
+      work_stack_->PushBlock(work_, stash_);
+      work_ = new_work;
+    }
+    return work_->Pop();
+  }
+
+  void Push(RawObject* raw_obj) {
+    if (work_->IsFull()) {
+      work_stack_->PushBlock(work_, stash_);
+      work_ = work_stack_->PopEmptyBlock();
+    }
+    work_->Push(raw_obj);
+  }
+
+  void Finalize() {
+    ASSERT(work_->IsEmpty());
+    work_stack_->PushBlock(work_);
+    work_ = NULL;
+    // Fail fast on attempts to scavenge after finalizing.
+    work_stack_ = NULL;
+  }
+
+ private:
+  MarkingStack::Block* work_;
+  MarkingStack* work_stack_;
+  const intptr_t stash_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScavengerWorkList);
+};
+
+// The store buffer blocks pending at the start of a parallel scavenge. Each
+// block is claimed and processed by exactly one worker.
+class ScavengerStoreBufferWork : public ValueObject {
+ public:
+  explicit ScavengerStoreBufferWork(StoreBufferBlock* blocks)
+      : blocks_(blocks), entries_(0) {}
+
+  StoreBufferBlock* Pop() {
+    MutexLocker ml(&mutex_);
+    StoreBufferBlock* block = blocks_;
+    if (block != NULL) {
+      blocks_ = block->next();
+    }
+    return block;
+  }
+
+  void AddEntries(intptr_t count) {
+    AtomicOperations::IncrementBy(&entries_, count);
+  }
+
+  intptr_t entries() const { return entries_; }
+
+ private:
+  Mutex mutex_;
+  StoreBufferBlock* blocks_;
+  intptr_t entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScavengerStoreBufferWork);
+};
+
+// Visitor used by the helper tasks of a parallel scavenge. Unlike the serial
+// ScavengerVisitor, which relies on a Cheney scan of the single to-space
+// allocation region, each worker bump allocates from its own chunks of
+// to-space and old space and queues the copied objects on a work list.
+// Several workers may race to copy the same object; the winner is decided by
+// a compare-and-swap of the forwarding pointer into the object header.
+class ParallelScavengerVisitor : public ObjectPointerVisitor {
+ public:
+  ParallelScavengerVisitor(Isolate* isolate,
+                           Scavenger* scavenger,
+                           SemiSpace* from,
+                           MarkingStack* work_stack,
+                           intptr_t stash)
+      : ObjectPointerVisitor(isolate),
+        thread_(Thread::Current()),
+        scavenger_(scavenger),
+        from_(from),
+        page_space_(scavenger->heap_->old_space()),
+        work_list_(work_stack, stash),
+        copy_top_(0),
+        copy_end_(0),
+        promo_top_(0),
+        promo_end_(0),
+        bytes_promoted_(0),
+        delayed_weak_properties_(NULL),
+        visiting_old_object_(NULL) {
+#ifndef PRODUCT
+    // Class heap stats are gathered per worker and merged in Finalize, so
+    // that workers do not contend on the shared ClassTable counters. Scavenger
+    // tasks have no zone, hence the malloc-backed arrays.
+    const intptr_t num_cids = isolate->class_table()->NumCids();
+    promoted_count_.SetLength(num_cids);
+    promoted_size_.SetLength(num_cids);
+    live_new_count_.SetLength(num_cids);
+    live_new_size_.SetLength(num_cids);
+    for (intptr_t i = 0; i < num_cids; ++i) {
+      promoted_count_[i] = 0;
+      promoted_size_[i] = 0;
+      live_new_count_[i] = 0;
+      live_new_size_[i] = 0;
+    }
+#endif  // !PRODUCT
+  }
+
+  void VisitPointers(RawObject** first, RawObject** last) {
+    ASSERT(Utils::IsAligned(first, sizeof(*first)));
+    ASSERT(Utils::IsAligned(last, sizeof(*last)));
+    for (RawObject** current = first; current <= last; current++) {
+      ScavengePointer(current);
+    }
+  }
+
+  void VisitingOldObject(RawObject* obj) {
+    ASSERT((obj == NULL) || obj->IsOldObject());
+    visiting_old_object_ = obj;
+  }
+
+  intptr_t bytes_promoted() const { return bytes_promoted_; }
+
+  void ProcessStoreBuffer(ScavengerStoreBufferWork* work) {
+    StoreBufferBlock* block = work->Pop();
+    while (block != NULL) {
+      // Generated code appends to store buffers; tell MemorySanitizer.
+      MSAN_UNPOISON(block, sizeof(*block));
+      work->AddEntries(block->Count());
+      while (!block->IsEmpty()) {
+        RawObject* raw_object = block->Pop();
+        ASSERT(!raw_object->IsForwardingCorpse());
+        ASSERT(raw_object->IsRemembered());
+        raw_object->ClearRememberedBit();
+        VisitingOldObject(raw_object);
+        raw_object->VisitPointersNonvirtual(this);
+      }
+      block->Reset();
+      // Return the emptied block for recycling (no need to check threshold).
+      isolate()->store_buffer()->PushBlock(block,
+                                           StoreBuffer::kIgnoreThreshold);
+      block = work->Pop();
+    }
+    VisitingOldObject(NULL);
+  }
+
+  // Scavenges the objects on the work list, including any stolen from other
+  // workers, until no more work is found.
+  void DrainWorkList() {
+    do {
+      RawObject* raw_obj = work_list_.Pop();
+      while (raw_obj != NULL) {
+        ProcessCopiedObject(raw_obj);
+        raw_obj = work_list_.Pop();
+      }
+    } while (ProcessPendingWeakProperties());
+  }
+
+  // Returns true if the key of any pending weak property has been forwarded
+  // (possibly by another worker), in which case more work may have appeared.
+  bool ProcessPendingWeakProperties() {
+    bool processed = false;
+    RawWeakProperty* cur_weak = delayed_weak_properties_;
+    delayed_weak_properties_ = NULL;
+    while (cur_weak != NULL) {
+      uword next_weak = cur_weak->ptr()->next_;
+      // Reset the next pointer in the weak property.
+      cur_weak->ptr()->next_ = 0;
+      if (IsForwarding(LoadHeader(cur_weak->ptr()->key_))) {
+        cur_weak->VisitPointersNonvirtual(this);
+        processed = true;
+      } else {
+        EnqueueWeakProperty(cur_weak);
+      }
+      // Advance to next weak property in the queue.
+      cur_weak = reinterpret_cast<RawWeakProperty*>(next_weak);
+    }
+    return processed;
+  }
+
+  // Called when all workers are done scavenging.
+  void Finalize() {
+    work_list_.Finalize();
+    // Keep to-space walkable.
+    if (copy_top_ < copy_end_) {
+      FreeListElement::AsElement(copy_top_, copy_end_ - copy_top_);
+    }
+    copy_top_ = copy_end_ = 0;
+    if (promo_top_ < promo_end_) {
+      page_space_->AcquireDataLock();
+      page_space_->AbandonPromoBufferLocked(promo_top_,
+                                            promo_end_ - promo_top_);
+      page_space_->ReleaseDataLock();
+    }
+    promo_top_ = promo_end_ = 0;
+    // Hand the weak properties with unreachable keys to the scavenger, which
+    // clears them in ProcessWeakReferences.
+    if (delayed_weak_properties_ != NULL) {
+      RawWeakProperty* last = delayed_weak_properties_;
+      while (last->ptr()->next_ != 0) {
+        last = reinterpret_cast<RawWeakProperty*>(last->ptr()->next_);
+      }
+      MutexLocker ml(&scavenger_->delayed_weak_properties_mutex_);
+      last->ptr()->next_ =
+          reinterpret_cast<uword>(scavenger_->delayed_weak_properties_);
+      scavenger_->delayed_weak_properties_ = delayed_weak_properties_;
+      delayed_weak_properties_ = NULL;
+    }
+#ifndef PRODUCT
+    ClassTable* class_table = isolate()->class_table();
+    for (intptr_t i = 0; i < promoted_count_.length(); ++i) {
+      if (promoted_count_[i] > 0) {
+        class_table->UpdateAllocatedOld(i, promoted_size_[i],
+                                        promoted_count_[i]);
+      }
+      if (live_new_count_[i] > 0) {
+        class_table->UpdateLiveNew(i, live_new_size_[i], live_new_count_[i]);
+      }
+    }
+#endif  // !PRODUCT
+  }
+
+ private:
+  // Size of the chunks each worker carves out of to-space and old space.
+  static const intptr_t kCopyBufferSize = 32 * KB;
+  static const intptr_t kPromoBufferSize = 16 * KB;
+
+  static uword LoadHeader(RawObject* raw_obj) {
+    return AtomicOperations::LoadRelaxed(
+        reinterpret_cast<uword*>(RawObject::ToAddr(raw_obj)));
+  }
+
+  void UpdateStoreBuffer(RawObject** p, RawObject* obj) {
+    ASSERT(obj->IsHeapObject());
+    // If the newly written object is not a new object, drop it immediately.
+    if (!obj->IsNewObject()) {
+      return;
+    }
+    if (visiting_old_object_->IsCardRemembered()) {
+      visiting_old_object_->RememberCard(p);
+      return;
+    }
+    if (visiting_old_object_->IsRemembered()) {
+      return;
+    }
+    visiting_old_object_->SetRememberedBit();
+    thread_->StoreBufferAddObjectGC(visiting_old_object_);
+  }
+
+  void ScavengePointer(RawObject** p) {
+    RawObject* raw_obj = *p;
+
+    if (raw_obj->IsSmiOrOldObject()) {
+      return;
+    }
+
+    uword raw_addr = RawObject::ToAddr(raw_obj);
+    // The scavenger only expects objects located in the from space.
+    ASSERT(from_->Contains(raw_addr));
+    uword header = LoadHeader(raw_obj);
+    uword new_addr = IsForwarding(header)
+                         ? ForwardedAddr(header)
+                         : CopyObject(raw_obj, raw_addr, header);
+    // Update the reference.
+    RawObject* new_obj = RawObject::FromAddr(new_addr);
+    *p = new_obj;
+    // Update the store buffer as needed.
+    if (visiting_old_object_ != NULL) {
+      UpdateStoreBuffer(p, new_obj);
+    }
+  }
+
+  uword CopyObject(RawObject* raw_obj, uword raw_addr, uword header) {
+    // The header may be replaced by another worker's forwarding pointer at any
+    // moment, so only the tags read above are used to size the object.
+    const uint32_t tags = static_cast<uint32_t>(header);
+    const intptr_t size = raw_obj->HeapSize(tags);
+    NOT_IN_PRODUCT(intptr_t cid = RawObject::ClassIdTag::decode(tags));
+    uword new_addr = 0;
+    bool promoted = false;
+    if (raw_addr < scavenger_->survivor_end_) {
+      // This object is a survivor of a previous scavenge. Attempt to promote
+      // the object.
+      new_addr = TryAllocatePromo(size);
+      promoted = (new_addr != 0);
+      if (!promoted) {
+        scavenger_->failed_to_promote_ = true;
+      }
+    }
+    if (new_addr == 0) {
+      new_addr = TryAllocateCopy(size);
+    }
+    if (new_addr == 0) {
+      // The unused tails of other workers' chunks can exhaust to-space even
+      // though the survivors would fit. Fall back to promotion.
+      new_addr = TryAllocatePromo(size);
+      promoted = (new_addr != 0);
+      if (!promoted) {
+        OUT_OF_MEMORY();
+      }
+    }
+    memmove(reinterpret_cast<void*>(new_addr),
+            reinterpret_cast<void*>(raw_addr), size);
+    // The copied header may already be another worker's forwarding pointer.
+    *reinterpret_cast<uword*>(new_addr) = header;
+    ASSERT((new_addr & kForwardingMask) == 0);
+    uword winner = AtomicOperations::CompareAndSwapWord(
+        reinterpret_cast<uword*>(raw_addr), header, new_addr | kForwarded);
+    if (winner != header) {
+      // Lost the race: discard our copy and use the other worker's.
+      UndoAllocation(new_addr, size, promoted);
+      return ForwardedAddr(winner);
+    }
+    if (promoted) {
+      bytes_promoted_ += size;
+#ifndef PRODUCT
+      promoted_count_[cid] += 1;
+      promoted_size_[cid] += size;
+#endif  // !PRODUCT
+    } else {
+#ifndef PRODUCT
+      live_new_count_[cid] += 1;
+      live_new_size_[cid] += size;
+#endif  // !PRODUCT
+    }
+    work_list_.Push(RawObject::FromAddr(new_addr));
+    return new_addr;
+  }
+
+  void ProcessCopiedObject(RawObject* raw_obj) {
+    if (raw_obj->IsOldObject()) {
+      // Promoted objects are scanned like store buffer entries, so that any
+      // remaining new-space references are remembered.
+      ASSERT(!raw_obj->IsRemembered());
+      VisitingOldObject(raw_obj);
+      raw_obj->VisitPointersNonvirtual(this);
+      VisitingOldObject(NULL);
+    } else if (raw_obj->GetClassId() == kWeakPropertyCid) {
+      ProcessWeakProperty(reinterpret_cast<RawWeakProperty*>(raw_obj));
+    } else {
+      raw_obj->VisitPointersNonvirtual(this);
+    }
+  }
+
+  void ProcessWeakProperty(RawWeakProperty* raw_weak) {
+    // The fate of the weak property is determined by its key.
+    RawObject* raw_key = raw_weak->ptr()->key_;
+    if (raw_key->IsHeapObject() && raw_key->IsNewObject() &&
+        !IsForwarding(LoadHeader(raw_key))) {
+      // Key is white.  Enqueue the weak property.
+      EnqueueWeakProperty(raw_weak);
+      return;
+    }
+    // Key is gray or black.  Make the weak property black.
+    raw_weak->VisitPointersNonvirtual(this);
+  }
+
+  void EnqueueWeakProperty(RawWeakProperty* raw_weak) {
+    ASSERT(raw_weak->IsNewObject());
+    ASSERT(raw_weak->ptr()->next_ == 0);
+    raw_weak->ptr()->next_ = reinterpret_cast<uword>(delayed_weak_properties_);
+    delayed_weak_properties_ = raw_weak;
+  }
+
+  uword TryAllocateCopy(intptr_t size) {
+    if (static_cast<intptr_t>(copy_end_ - copy_top_) >= size) {
+      uword result = copy_top_;
+      copy_top_ += size;
+      return result;
+    }
+    if (size > (kCopyBufferSize / 4)) {
+      return scavenger_->TryAllocateGCChunk(size);
+    }
+    if (copy_top_ < copy_end_) {
+      FreeListElement::AsElement(copy_top_, copy_end_ - copy_top_);
+    }
+    copy_top_ = copy_end_ = 0;
+    uword chunk = scavenger_->TryAllocateGCChunk(kCopyBufferSize);
+    if (chunk == 0) {
+      return scavenger_->TryAllocateGCChunk(size);
+    }
+    copy_top_ = chunk + size;
+    copy_end_ = chunk + kCopyBufferSize;
+    return chunk;
+  }
+
+  uword TryAllocatePromo(intptr_t size) {
+    if (static_cast<intptr_t>(promo_end_ - promo_top_) >= size) {
+      uword result = promo_top_;
+      promo_top_ += size;
+      return result;
+    }
+    uword result = 0;
+    page_space_->AcquireDataLock();
+    if (size > (kPromoBufferSize / 4)) {
+      result =
+          page_space_->TryAllocatePromoLocked(size, PageSpace::kForceGrowth);
+    } else {
+      page_space_->AbandonPromoBufferLocked(promo_top_,
+                                            promo_end_ - promo_top_);
+      promo_top_ = promo_end_ = 0;
+      uword chunk = page_space_->TryAllocatePromoLocked(
+          kPromoBufferSize, PageSpace::kForceGrowth);
+      if (chunk != 0) {
+        promo_top_ = chunk + size;
+        promo_end_ = chunk + kPromoBufferSize;
+        result = chunk;
+      } else {
+        result = page_space_->TryAllocatePromoLocked(size,
+                                                     PageSpace::kForceGrowth);
+      }
+    }
+    page_space_->ReleaseDataLock();
+    return result;
+  }
+
+  void UndoAllocation(uword addr, intptr_t size, bool promoted) {
+    if (promoted) {
+      if (addr + size == promo_top_) {
+        promo_top_ = addr;
+        return;
+      }
+    } else if (addr + size == copy_top_) {
+      copy_top_ = addr;
+      return;
+    }
+    // Not the most recent allocation in our buffer; leave a filler so that
+    // the space stays walkable.
+    FreeListElement::AsElement(addr, size);
+  }
+
+  Thread* thread_;
+  Scavenger* scavenger_;
+  SemiSpace* from_;
+  PageSpace* page_space_;
+  ScavengerWorkList work_list_;
+  uword copy_top_;
+  uword copy_end_;
+  uword promo_top_;
+  uword promo_end_;
+  intptr_t bytes_promoted_;
+  RawWeakProperty* delayed_weak_properties_;
+  RawObject* visiting_old_object_;
+#ifndef PRODUCT
+  MallocGrowableArray<intptr_t> promoted_count_;
+  MallocGrowableArray<intptr_t> promoted_size_;
+  MallocGrowableArray<intptr_t> live_new_count_;
+  MallocGrowableArray<intptr_t> live_new_size_;
+#endif  // !PRODUCT
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelScavengerVisitor);
+};
+
+class ParallelScavengerTask : public ThreadPool::Task {
+ public:
+  ParallelScavengerTask(Scavenger* scavenger,
+                        Isolate* isolate,
+                        SemiSpace* from,
+                        MarkingStack* work_stack,
+                        ScavengerStoreBufferWork* store_buffer_work,
+                        ThreadBarrier* barrier,
+                        intptr_t task_index,
+                        intptr_t num_tasks,
+                        uintptr_t* num_busy,
+                        intptr_t* bytes_promoted)
+      : scavenger_(scavenger),
+        isolate_(isolate),
+        from_(from),
+        work_stack_(work_stack),
+        store_buffer_work_(store_buffer_work),
+        barrier_(barrier),
+        task_index_(task_index),
+        num_tasks_(num_tasks),
+        num_busy_(num_busy),
+        bytes_promoted_(bytes_promoted) {}
+
+  virtual void Run() {
+    bool result =
+        Thread::EnterIsolateAsHelper(isolate_, Thread::kScavengerTask, true);
+    ASSERT(result);
+    {
+      Thread* thread = Thread::Current();
+      TIMELINE_FUNCTION_GC_DURATION(thread, "ParallelScavengerTask");
+      ParallelScavengerVisitor visitor(isolate_, scavenger_, from_,
+                                       work_stack_, task_index_);
+      // Phase 1: Iterate over roots and store buffers, and drain the work
+      // lists, stealing from other tasks when ours runs dry.
+      if (task_index_ == 0) {
+        isolate_->VisitObjectPointers(&visitor,
+                                      StackFrameIterator::kDontValidateFrames);
+      }
+      if (task_index_ == (num_tasks_ - 1)) {
+        scavenger_->IterateObjectIdTable(isolate_, &visitor);
+        scavenger_->heap_->old_space()->VisitRememberedCards(&visitor);
+      }
+      visitor.ProcessStoreBuffer(store_buffer_work_);
+
+      bool more_to_scavenge = false;
+      do {
+        do {
+          visitor.DrainWorkList();
+
+          // I can't find more work right now. If no other task is busy,
+          // then there will never be more work (NB: 1 is *before* decrement).
+          if (AtomicOperations::FetchAndDecrement(num_busy_) == 1) break;
+
+          // Wait for some work to appear.
+          while (work_stack_->IsEmpty() &&
+                 AtomicOperations::LoadRelaxed(num_busy_) > 0) {
+          }
+
+          // If no tasks are busy, there will never be more work.
+          if (AtomicOperations::LoadRelaxed(num_busy_) == 0) break;
+
+          // I saw some work; get busy and compete for it.
+          AtomicOperations::FetchAndIncrement(num_busy_);
+        } while (true);
+        // Wait for all workers to stop.
+        barrier_->Sync();
+#if defined(DEBUG)
+        ASSERT(AtomicOperations::LoadRelaxed(num_busy_) == 0);
+        // Caveat: must not allow any worker to continue past the barrier
+        // before we checked num_busy, otherwise one of them might rush
+        // ahead and increment it.
+        barrier_->Sync();
+#endif
+        // Check if we have any pending weak properties whose keys have been
+        // forwarded by another worker.
+        more_to_scavenge = visitor.ProcessPendingWeakProperties();
+        if (more_to_scavenge) {
+          // We have more work to do. Notify others.
+          AtomicOperations::FetchAndIncrement(num_busy_);
+        }
+
+        // Wait for all other workers to finish processing their pending
+        // weak properties and decide if they need to continue scavenging.
+        barrier_->Sync();
+        if (!more_to_scavenge &&
+            (AtomicOperations::LoadRelaxed(num_busy_) > 0)) {
+          // All workers continue as long as any single worker has some work
+          // to do.
+          AtomicOperations::FetchAndIncrement(num_busy_);
+          more_to_scavenge = true;
+        }
+        barrier_->Sync();
+      } while (more_to_scavenge);
+
+      // Phase 2: Finalize results from all workers.
+      barrier_->Sync();
+      visitor.Finalize();
+      AtomicOperations::IncrementBy(bytes_promoted_, visitor.bytes_promoted());
+    }
+    Thread::ExitIsolateAsHelper(true);
+
+    // This task is done. Notify the original thread.
+    barrier_->Exit();
+  }
+
+ private:
+  Scavenger* scavenger_;
+  Isolate* isolate_;
+  SemiSpace* from_;
+  MarkingStack* work_stack_;
+  ScavengerStoreBufferWork* store_buffer_work_;
+  ThreadBarrier* barrier_;
+  const intptr_t task_index_;
+  const intptr_t num_tasks_;
+  uintptr_t* num_busy_;
+  intptr_t* bytes_promoted_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelScavengerTask);
+};
+
 class ScavengerWeakVisitor : public HandleVisitor {
  public:
   ScavengerWeakVisitor(Thread* thread, Scavenger* scavenger)
@@ -205,7 +806,11 @@ class ScavengerWeakVisitor : public HandleVisitor {
         reinterpret_cast<FinalizablePersistentHandle*>(addr);
     RawObject** p = handle->raw_addr();
     if (scavenger_->IsUnreachable(p)) {
-      handle->UpdateUnreachable(thread()->isolate());
+      if (FLAG_background_finalizers) {
+        handle->UpdateUnreachableInBackground(thread()->isolate());
+      } else {
+        handle->UpdateUnreachable(thread()->isolate());
+      }
     } else {
       handle->UpdateRelocated(thread()->isolate());
 #ifndef PRODUCT
@@ -290,8 +895,8 @@ SemiSpace* SemiSpace::New(intptr_t size_in_words, const char* name) {
   } else {
     intptr_t size_in_bytes = size_in_words << kWordSizeLog2;
     const bool kExecutable = false;
-    VirtualMemory* memory =
-        VirtualMemory::Allocate(size_in_bytes, kExecutable, name);
+    VirtualMemory* memory = VirtualMemory::AllocateHeap(
+        size_in_bytes, VirtualMemory::PageSize(), kExecutable, name);
     if (memory == NULL) {
       // TODO(koda): If cache_ is not empty, we could try to delete it.
       return NULL;
@@ -337,6 +942,9 @@ Scavenger::Scavenger(Heap* heap,
                      uword object_alignment)
     : heap_(heap),
       max_semi_capacity_in_words_(max_semi_capacity_in_words),
+      min_semi_capacity_in_words_(0),
+      max_pause_micros_(0),
+      max_gc_time_percent_(0),
       object_alignment_(object_alignment),
       scavenging_(false),
       delayed_weak_properties_(NULL),
@@ -345,6 +953,7 @@ Scavenger::Scavenger(Heap* heap,
       scavenge_words_per_micro_(kConservativeInitialScavengeSpeed),
       idle_scavenge_threshold_in_words_(0),
       external_size_(0),
+      external_gc_threshold_in_words_(FLAG_new_gen_ext_limit * MBInWords),
       failed_to_promote_(false) {
   // Verify assumptions about the first word in objects which the scavenger is
   // going to use for forwarding pointers.
@@ -369,6 +978,7 @@ Scavenger::Scavenger(Heap* heap,
 
   survivor_end_ = FirstObjectStart();
   idle_scavenge_threshold_in_words_ = initial_semi_capacity_in_words;
+  min_semi_capacity_in_words_ = initial_semi_capacity_in_words;
 
   UpdateMaxHeapCapacity();
   UpdateMaxHeapUsage();
@@ -379,17 +989,51 @@ Scavenger::~Scavenger() {
   to_->Delete();
 }
 
-intptr_t Scavenger::NewSizeInWords(intptr_t old_size_in_words) const {
+intptr_t Scavenger::NewSizeInWords(intptr_t old_size_in_words,
+                                   intptr_t used_in_words) const {
   if (stats_history_.Size() == 0) {
     return old_size_in_words;
   }
+  intptr_t new_size_in_words = old_size_in_words;
   double garbage = stats_history_.Get(0).ExpectedGarbageFraction();
-  if (garbage < (FLAG_new_gen_garbage_threshold / 100.0)) {
-    return Utils::Minimum(max_semi_capacity_in_words_,
-                          old_size_in_words * FLAG_new_gen_growth_factor);
-  } else {
+  if ((garbage < (FLAG_new_gen_garbage_threshold / 100.0)) ||
+      ((max_gc_time_percent_ > 0) &&
+       (GCTimePercent() > max_gc_time_percent_))) {
+    new_size_in_words = old_size_in_words * FLAG_new_gen_growth_factor;
+  }
+  if (max_pause_micros_ > 0) {
+    // A scavenge takes time proportional to the used part of the semi-space
+    // (see scavenge_words_per_micro_). Step down the growth ladder until the
+    // expected pause meets the goal.
+    const intptr_t pause_limit_in_words =
+        max_pause_micros_ * scavenge_words_per_micro_;
+    while ((new_size_in_words > pause_limit_in_words) &&
+           (new_size_in_words > min_semi_capacity_in_words_)) {
+      new_size_in_words /= FLAG_new_gen_growth_factor;
+    }
+  }
+  new_size_in_words =
+      Utils::Minimum(max_semi_capacity_in_words_, new_size_in_words);
+  if (new_size_in_words < used_in_words) {
+    // Every object in the current semi-space might survive.
     return old_size_in_words;
   }
+  return new_size_in_words;
+}
+
+intptr_t Scavenger::GCTimePercent() const {
+  int64_t gc_time = 0;
+  int64_t total_time = 0;
+  for (intptr_t i = 0; i < stats_history_.Size() - 1; i++) {
+    const ScavengeStats& current = stats_history_.Get(i);
+    const ScavengeStats& previous = stats_history_.Get(i + 1);
+    gc_time += current.DurationMicros();
+    total_time += current.EndMicros() - previous.EndMicros();
+  }
+  if (total_time == 0) {
+    return 0;
+  }
+  return static_cast<intptr_t>((gc_time * 100) / total_time);
 }
 
 SemiSpace* Scavenger::Prologue(Isolate* isolate) {
@@ -404,7 +1048,8 @@ SemiSpace* Scavenger::Prologue(Isolate* isolate) {
   const intptr_t kVmNameSize = 128;
   char vm_name[kVmNameSize];
   Heap::RegionName(heap_, Heap::kNew, vm_name, kVmNameSize);
-  to_ = SemiSpace::New(NewSizeInWords(from->size_in_words()), vm_name);
+  to_ = SemiSpace::New(NewSizeInWords(from->size_in_words(), UsedInWords()),
+                       vm_name);
   if (to_ == NULL) {
     // TODO(koda): We could try to recover (collect old space, wait for another
     // isolate to finish scavenge, etc.).
@@ -561,7 +1206,7 @@ void Scavenger::IterateStoreBuffers(Isolate* isolate,
 }
 
 void Scavenger::IterateObjectIdTable(Isolate* isolate,
-                                     ScavengerVisitor* visitor) {
+                                     ObjectPointerVisitor* visitor) {
 #ifndef PRODUCT
   if (!FLAG_support_service) {
     return;
@@ -582,6 +1227,7 @@ void Scavenger::IterateRoots(Isolate* isolate, ScavengerVisitor* visitor) {
                                StackFrameIterator::kDontValidateFrames);
   int64_t middle = OS::GetCurrentMonotonicMicros();
   IterateStoreBuffers(isolate, visitor);
+  heap_->old_space()->VisitRememberedCards(visitor);
   IterateObjectIdTable(isolate, visitor);
   int64_t end = OS::GetCurrentMonotonicMicros();
   heap_->RecordData(kToKBAfterStoreBuffer, RoundWordsToKB(UsedInWords()));
@@ -676,6 +1322,86 @@ void Scavenger::ProcessToSpace(ScavengerVisitor* visitor) {
   }
 }
 
+uword Scavenger::TryAllocateGCChunk(intptr_t size) {
+  ASSERT(Utils::IsAligned(size, kObjectAlignment));
+  ASSERT(scavenging_);
+  uword top = AtomicOperations::LoadRelaxed(&top_);
+  while (true) {
+    if (static_cast<intptr_t>(end_ - top) < size) {
+      return 0;
+    }
+    uword old_top =
+        AtomicOperations::CompareAndSwapWord(&top_, top, top + size);
+    if (old_top == top) {
+      ASSERT(to_->Contains(top));
+      ASSERT((top & kObjectAlignmentMask) == object_alignment_);
+      return top;
+    }
+    top = old_top;
+  }
+}
+
+intptr_t Scavenger::ParallelScavenge(Isolate* isolate, SemiSpace* from) {
+  Thread* thread = Thread::Current();
+  TIMELINE_FUNCTION_GC_DURATION(thread, "ParallelScavenge");
+  int64_t start = OS::GetCurrentMonotonicMicros();
+  const intptr_t num_tasks = FLAG_scavenger_tasks;
+  intptr_t bytes_promoted = 0;
+  MarkingStack work_stack(num_tasks);
+  // Detach the pending store buffer blocks up front: blocks filled by the
+  // workers themselves must not be scanned again in this scavenge.
+  ScavengerStoreBufferWork store_buffer_work(
+      isolate->store_buffer()->Blocks());
+  {
+    ThreadBarrier barrier(num_tasks + 1, heap_->barrier(),
+                          heap_->barrier_done());
+    // Used to coordinate draining among tasks; all start out as 'busy'.
+    uintptr_t num_busy = num_tasks;
+    // Phase 1: Iterate over roots and drain the work lists in tasks.
+    for (intptr_t i = 0; i < num_tasks; ++i) {
+      ParallelScavengerTask* task = new ParallelScavengerTask(
+          this, isolate, from, &work_stack, &store_buffer_work, &barrier, i,
+          num_tasks, &num_busy, &bytes_promoted);
+      Dart::thread_pool()->Run(task);
+    }
+    bool more_to_scavenge = false;
+    do {
+      // Wait for all workers to stop.
+      barrier.Sync();
+#if defined(DEBUG)
+      ASSERT(AtomicOperations::LoadRelaxed(&num_busy) == 0);
+      // Caveat: must not allow any worker to continue past the barrier
+      // before we checked num_busy, otherwise one of them might rush
+      // ahead and increment it.
+      barrier.Sync();
+#endif
+      // Wait for all workers to go through weak properties and verify
+      // that there is no more work.
+      // Note: we need to have two barriers here because we want all workers
+      // and main thread to make decisions in lock step.
+      barrier.Sync();
+      more_to_scavenge = AtomicOperations::LoadRelaxed(&num_busy) > 0;
+      barrier.Sync();
+    } while (more_to_scavenge);
+
+    // Phase 2: Finalize results from all workers (flush buffers, etc.).
+    barrier.Sync();
+    barrier.Exit();
+    // The barrier's destructor waits for all workers to exit.
+  }
+  ASSERT(work_stack.IsEmpty());
+  int64_t end = OS::GetCurrentMonotonicMicros();
+  heap_->RecordData(kStoreBufferEntries, store_buffer_work.entries());
+  heap_->RecordData(kDataUnused1, num_tasks);
+  heap_->RecordData(kDataUnused2, 0);
+  heap_->RecordData(kToKBAfterStoreBuffer, RoundWordsToKB(UsedInWords()));
+  heap_->RecordTime(kVisitIsolateRoots, 0);
+  heap_->RecordTime(kIterateStoreBuffers, 0);
+  heap_->RecordTime(kDummyScavengeTime, 0);
+  heap_->RecordTime(kProcessToSpace, end - start);
+  return bytes_promoted;
+}
+
 void Scavenger::UpdateMaxHeapCapacity() {
 #if !defined(PRODUCT)
   if (heap_ == NULL) {
@@ -886,13 +1612,25 @@ void Scavenger::Scavenge() {
   // depend on zone allocations surviving beyond the epilogue callback.
   {
     StackZone zone(thread);
-    // Setup the visitor and run the scavenge.
-    ScavengerVisitor visitor(isolate, this, from);
-    page_space->AcquireDataLock();
-    IterateRoots(isolate, &visitor);
-    int64_t iterate_roots = OS::GetCurrentMonotonicMicros();
-    ProcessToSpace(&visitor);
-    int64_t process_to_space = OS::GetCurrentMonotonicMicros();
+    intptr_t bytes_promoted = 0;
+    int64_t process_to_space = 0;
+    if (FLAG_scavenger_tasks > 0) {
+      // The workers take the data lock themselves whenever they need a new
+      // promotion buffer.
+      bytes_promoted = ParallelScavenge(isolate, from);
+      process_to_space = OS::GetCurrentMonotonicMicros();
+      page_space->AcquireDataLock();
+    } else {
+      // Setup the visitor and run the scavenge.
+      ScavengerVisitor visitor(isolate, this, from);
+      page_space->AcquireDataLock();
+      IterateRoots(isolate, &visitor);
+      int64_t iterate_roots = OS::GetCurrentMonotonicMicros();
+      ProcessToSpace(&visitor);
+      process_to_space = OS::GetCurrentMonotonicMicros();
+      heap_->RecordTime(kProcessToSpace, process_to_space - iterate_roots);
+      bytes_promoted = visitor.bytes_promoted();
+    }
     {
       TIMELINE_FUNCTION_GC_DURATION(thread, "WeakHandleProcessing");
       ScavengerWeakVisitor weak_visitor(thread, this);
@@ -901,13 +1639,18 @@ void Scavenger::Scavenge() {
     ProcessWeakReferences();
     page_space->ReleaseDataLock();
 
+    // Externals of the survivors have been promoted along with them or stay
+    // in new space; only new external allocation counts towards the next
+    // scavenge.
+    external_gc_threshold_in_words_ =
+        ExternalInWords() + (FLAG_new_gen_ext_limit * MBInWords);
+
     // Scavenge finished. Run accounting.
     int64_t end = OS::GetCurrentMonotonicMicros();
-    heap_->RecordTime(kProcessToSpace, process_to_space - iterate_roots);
     heap_->RecordTime(kIterateWeaks, end - process_to_space);
-    stats_history_.Add(ScavengeStats(
-        start, end, usage_before, GetCurrentUsage(), promo_candidate_words,
-        visitor.bytes_promoted() >> kWordSizeLog2));
+    stats_history_.Add(ScavengeStats(start, end, usage_before,
+                                     GetCurrentUsage(), promo_candidate_words,
+                                     bytes_promoted >> kWordSizeLog2));
   }
   Epilogue(isolate, from);
 
@@ -954,6 +1697,9 @@ void Scavenger::PrintToJSONObject(JSONObject* object) const {
   space.AddProperty64("used", UsedInWords() * kWordSize);
   space.AddProperty64("capacity", CapacityInWords() * kWordSize);
   space.AddProperty64("external", ExternalInWords() * kWordSize);
+  space.AddProperty64("externalGCThreshold",
+                      ExternalGCThresholdInWords() * kWordSize);
+  space.AddProperty64("hugePages", to_->huge_page_bytes());
   space.AddProperty("time", MicrosecondsToSeconds(gc_time_micros()));
 }
 #endif  // !PRODUCT
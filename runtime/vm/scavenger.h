@@ -10,6 +10,7 @@
 #include "vm/dart.h"
 #include "vm/flags.h"
 #include "vm/globals.h"
+#include "vm/os_thread.h"
 #include "vm/raw_object.h"
 #include "vm/ring_buffer.h"
 #include "vm/spaces.h"
@@ -23,6 +24,7 @@ class Heap;
 class Isolate;
 class JSONObject;
 class ObjectSet;
+class ParallelScavengerVisitor;
 class ScavengerVisitor;
 
 // Wrapper around VirtualMemory that adds caching and handles the empty case.
@@ -46,6 +48,9 @@ class SemiSpace {
     return static_cast<intptr_t>(region_.size()) >> kWordSizeLog2;
   }
   bool Contains(uword address) const { return region_.Contains(address); }
+  intptr_t huge_page_bytes() const {
+    return (reserved_ == NULL) ? 0 : reserved_->huge_page_bytes();
+  }
 
   // Set write protection mode for this space. The space must not be protected
   // when Delete is called.
@@ -100,6 +105,7 @@ class ScavengeStats {
   intptr_t UsedBeforeInWords() const { return before_.used_in_words; }
 
   int64_t DurationMicros() const { return end_micros_ - start_micros_; }
+  int64_t EndMicros() const { return end_micros_; }
 
  private:
   int64_t start_micros_;
@@ -205,6 +211,19 @@ class Scavenger {
 
   bool ShouldPerformIdleScavenge(int64_t deadline);
 
+  // Goals for sizing the semi-spaces; zero means no goal. Growth stops
+  // short of semi-spaces whose scavenge would be expected to exceed
+  // 'max_pause_micros', and continues beyond the garbage threshold if
+  // scavenging takes more than 'max_gc_time_percent' of the time.
+  void SetGoals(int64_t max_pause_micros, intptr_t max_gc_time_percent) {
+    max_pause_micros_ = max_pause_micros;
+    max_gc_time_percent_ = max_gc_time_percent;
+  }
+  // Takes effect at the next scavenge.
+  void SetMaxSemiCapacityInWords(intptr_t max_semi_capacity_in_words) {
+    max_semi_capacity_in_words_ = max_semi_capacity_in_words;
+  }
+
   void AddGCTime(int64_t micros) { gc_time_micros_ += micros; }
 
   int64_t gc_time_micros() const { return gc_time_micros_; }
@@ -220,6 +239,16 @@ class Scavenger {
   void AllocateExternal(intptr_t cid, intptr_t size);
   void FreeExternal(intptr_t size);
 
+  // Whether the external size has grown by --new_gen_ext_limit since the
+  // last scavenge. External data that survives a scavenge without being
+  // promoted does not count, so it cannot trigger a scavenge per allocation.
+  bool NeedsExternalGC() const {
+    return ExternalInWords() > external_gc_threshold_in_words_;
+  }
+  int64_t ExternalGCThresholdInWords() const {
+    return external_gc_threshold_in_words_;
+  }
+
   void FlushTLS() const;
 
  private:
@@ -242,12 +271,18 @@ class Scavenger {
   uword FirstObjectStart() const { return to_->start() | object_alignment_; }
   SemiSpace* Prologue(Isolate* isolate);
   void IterateStoreBuffers(Isolate* isolate, ScavengerVisitor* visitor);
-  void IterateObjectIdTable(Isolate* isolate, ScavengerVisitor* visitor);
+  void IterateObjectIdTable(Isolate* isolate, ObjectPointerVisitor* visitor);
   void IterateRoots(Isolate* isolate, ScavengerVisitor* visitor);
   void IterateWeakProperties(Isolate* isolate, ScavengerVisitor* visitor);
   void IterateWeakReferences(Isolate* isolate, ScavengerVisitor* visitor);
   void IterateWeakRoots(Isolate* isolate, HandleVisitor* visitor);
   void ProcessToSpace(ScavengerVisitor* visitor);
+  // Copies and promotes all live objects using FLAG_scavenger_tasks helper
+  // tasks. Returns the number of bytes promoted.
+  intptr_t ParallelScavenge(Isolate* isolate, SemiSpace* from);
+  // Bump allocates a chunk of to-space on behalf of a parallel scavenger
+  // worker. Returns 0 if to-space is exhausted.
+  uword TryAllocateGCChunk(intptr_t size);
   void EnqueueWeakProperty(RawWeakProperty* raw_weak);
   uword ProcessWeakProperty(RawWeakProperty* raw_weak,
                             ScavengerVisitor* visitor);
@@ -282,7 +317,12 @@ class Scavenger {
 
   void ProcessWeakReferences();
 
-  intptr_t NewSizeInWords(intptr_t old_size_in_words) const;
+  // Returns the size of the next to-space, which must hold at least
+  // 'used_in_words' of the current one.
+  intptr_t NewSizeInWords(intptr_t old_size_in_words,
+                          intptr_t used_in_words) const;
+  // Percentage of recent wall time spent scavenging.
+  intptr_t GCTimePercent() const;
 
   uword top_;
   uword end_;
@@ -299,6 +339,10 @@ class Scavenger {
   uword survivor_end_;
 
   intptr_t max_semi_capacity_in_words_;
+  intptr_t min_semi_capacity_in_words_;
+
+  int64_t max_pause_micros_;
+  intptr_t max_gc_time_percent_;
 
   // All object are aligned to this value.
   uword object_alignment_;
@@ -308,6 +352,9 @@ class Scavenger {
 
   // Keep track of pending weak properties discovered while scagenging.
   RawWeakProperty* delayed_weak_properties_;
+  // Protects delayed_weak_properties_ while parallel workers hand off their
+  // unresolved weak properties.
+  Mutex delayed_weak_properties_mutex_;
 
   int64_t gc_time_micros_;
   intptr_t collections_;
@@ -319,9 +366,13 @@ class Scavenger {
 
   // The total size of external data associated with objects in this scavenger.
   intptr_t external_size_;
+  // External size at which the next scavenge is triggered.
+  intptr_t external_gc_threshold_in_words_;
 
   bool failed_to_promote_;
 
+  friend class ParallelScavengerTask;
+  friend class ParallelScavengerVisitor;
   friend class ScavengerVisitor;
   friend class ScavengerWeakVisitor;
 
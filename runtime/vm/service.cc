@@ -201,14 +201,6 @@ RawObject* Service::RequestAssets() {
   return Api::UnwrapHandle(handle);
 }
 
-static uint8_t* allocator(uint8_t* ptr, intptr_t old_size, intptr_t new_size) {
-  void* new_ptr = realloc(reinterpret_cast<void*>(ptr), new_size);
-  if (new_ptr == NULL) {
-    OUT_OF_MEMORY();
-  }
-  return reinterpret_cast<uint8_t*>(new_ptr);
-}
-
 static void PrintMissingParamError(JSONStream* js, const char* param) {
   js->PrintError(kInvalidParams, "%s expects the '%s' parameter", js->method(),
                  param);
@@ -781,7 +773,7 @@ RawError* Service::InvokeMethod(Isolate* I,
   ASSERT(msg.Length() == 6);
 
   {
-    StackZone zone(T);
+    StackZone zone(T, Zone::kServiceOwner);
     HANDLESCOPE(T);
 
     Instance& reply_port = Instance::Handle(Z);
@@ -2232,6 +2224,73 @@ static bool GetReachableSize(Thread* thread, JSONStream* js) {
   return true;
 }
 
+static const MethodParameter* get_retained_sizes_params[] = {
+    RUNNABLE_ISOLATE_PARAMETER,
+    new UIntParameter("top", false),
+    new UIntParameter("limit", false),
+    new BoolParameter("collectGarbage", false),
+    NULL,
+};
+
+static bool GetRetainedSizes(Thread* thread, JSONStream* js) {
+  const intptr_t kDefaultTop = 10;
+  const intptr_t kDefaultLimit = 16;
+  intptr_t top = UIntParameter::Parse(js->LookupParam("top"));
+  if (top < 0) {
+    top = kDefaultTop;
+  }
+  intptr_t limit = UIntParameter::Parse(js->LookupParam("limit"));
+  if (limit <= 0) {
+    limit = kDefaultLimit;
+  }
+  const bool collect_garbage =
+      BoolParameter::Parse(js->LookupParam("collectGarbage"), true);
+
+  ObjectGraph::RetainedSizes sizes;
+  {
+    ObjectGraph graph(thread);
+    graph.ComputeRetainedSizes(top, limit, collect_garbage, &sizes);
+  }
+
+  ClassTable* table = thread->isolate()->class_table();
+  JSONObject jsobj(js);
+  jsobj.AddProperty("type", "_RetainedSizes");
+  jsobj.AddProperty("nodeCount", sizes.node_count);
+  jsobj.AddProperty("edgeCount", sizes.edge_count);
+  {
+    JSONArray members(&jsobj, "members");
+    Class& cls = Class::Handle(thread->zone());
+    for (intptr_t i = 0; i < sizes.class_instance_counts->length(); i++) {
+      const intptr_t count = sizes.class_instance_counts->At(i);
+      if ((count == 0) || !table->HasValidClassAt(i)) {
+        continue;
+      }
+      cls = table->At(i);
+      JSONObject member(&members);
+      member.AddProperty("class", cls);
+      member.AddProperty("instances", count);
+      member.AddProperty("retainedSize", sizes.class_retained_sizes->At(i));
+    }
+  }
+  {
+    JSONArray retainers(&jsobj, "topRetainers");
+    for (intptr_t i = 0; i < sizes.path_starts->length() - 1; i++) {
+      const intptr_t start = sizes.path_starts->At(i);
+      const intptr_t end = sizes.path_starts->At(i + 1);
+      JSONObject retainer(&retainers);
+      retainer.AddProperty("retainedSize",
+                           sizes.path_retained_sizes->At(start));
+      JSONArray path(&retainer, "path");
+      for (intptr_t j = start; j < end; j++) {
+        JSONObject element(&path);
+        element.AddProperty("value", *sizes.path_objects->At(j));
+        element.AddProperty("retainedSize", sizes.path_retained_sizes->At(j));
+      }
+    }
+  }
+  return true;
+}
+
 static const MethodParameter* evaluate_params[] = {
     RUNNABLE_ISOLATE_PARAMETER, NULL,
 };
@@ -3485,20 +3544,30 @@ static bool RequestHeapSnapshot(Thread* thread, JSONStream* js) {
   return true;
 }
 
-void Service::SendGraphEvent(Thread* thread,
-                             ObjectGraph::SnapshotRoots roots,
-                             bool collect_garbage) {
-  uint8_t* buffer = NULL;
-  WriteStream stream(&buffer, &allocator, 1 * MB);
-  ObjectGraph graph(thread);
-  intptr_t node_count = graph.Serialize(&stream, roots, collect_garbage);
-
-  // Chrome crashes receiving a single tens-of-megabytes blob, so send the
-  // snapshot in megabyte-sized chunks instead.
-  const intptr_t kChunkSize = 1 * MB;
-  intptr_t num_chunks =
-      (stream.bytes_written() + (kChunkSize - 1)) / kChunkSize;
-  for (intptr_t i = 0; i < num_chunks; i++) {
+// Sends a heap snapshot as a series of _Graph events while it is being
+// serialized. Chrome crashes receiving a single tens-of-megabytes blob, so
+// the snapshot is sent in megabyte-sized chunks.
+class Service::GraphEventWriter : public ObjectGraph::ChunkedWriter {
+ public:
+  explicit GraphEventWriter(Thread* thread)
+      : ObjectGraph::ChunkedWriter(kChunkSize),
+        thread_(thread),
+        chunk_index_(0),
+        num_chunks_(0),
+        node_count_(0) {}
+
+  ~GraphEventWriter() { ASSERT(chunk_index_ == num_chunks_); }
+
+  // Every event carries the chunk count and node count.
+  virtual bool NeedsMeasure() const { return true; }
+  virtual void Begin(intptr_t total_bytes, intptr_t node_count) {
+    num_chunks_ = (total_bytes + (kChunkSize - 1)) / kChunkSize;
+    node_count_ = node_count;
+  }
+
+ protected:
+  virtual void WriteChunk(const uint8_t* chunk, intptr_t size) {
+    ASSERT(chunk_index_ < num_chunks_);
     JSONStream js;
     {
       JSONObject jsobj(&js);
@@ -3511,24 +3580,37 @@ void Service::SendGraphEvent(Thread* thread,
           JSONObject event(&params, "event");
           event.AddProperty("type", "Event");
           event.AddProperty("kind", "_Graph");
-          event.AddProperty("isolate", thread->isolate());
+          event.AddProperty("isolate", thread_->isolate());
           event.AddPropertyTimeMillis("timestamp", OS::GetCurrentTimeMillis());
 
-          event.AddProperty("chunkIndex", i);
-          event.AddProperty("chunkCount", num_chunks);
-          event.AddProperty("nodeCount", node_count);
+          event.AddProperty("chunkIndex", chunk_index_);
+          event.AddProperty("chunkCount", num_chunks_);
+          event.AddProperty("nodeCount", node_count_);
         }
       }
     }
-
-    uint8_t* chunk_start = buffer + (i * kChunkSize);
-    intptr_t chunk_size = (i + 1 == num_chunks)
-                              ? stream.bytes_written() - (i * kChunkSize)
-                              : kChunkSize;
-
     SendEventWithData(graph_stream.id(), "_Graph", js.buffer()->buf(),
-                      js.buffer()->length(), chunk_start, chunk_size);
+                      js.buffer()->length(), chunk, size);
+    chunk_index_++;
   }
+
+ private:
+  static const intptr_t kChunkSize = 1 * MB;
+
+  Thread* thread_;
+  intptr_t chunk_index_;
+  intptr_t num_chunks_;
+  intptr_t node_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(GraphEventWriter);
+};
+
+void Service::SendGraphEvent(Thread* thread,
+                             ObjectGraph::SnapshotRoots roots,
+                             bool collect_garbage) {
+  GraphEventWriter writer(thread);
+  ObjectGraph graph(thread);
+  graph.Serialize(&writer, roots, collect_garbage);
 }
 
 void Service::SendInspectEvent(Isolate* isolate, const Object& inspectee) {
@@ -3971,6 +4053,17 @@ void Service::PrintJSONForVM(JSONStream* js, bool ref) {
   jsobj.AddProperty("_profilerMode", FLAG_profile_vm ? "VM" : "Dart");
   jsobj.AddProperty64("_nativeZoneMemoryUsage",
                       ApiNativeScope::current_memory_usage());
+  {
+    JSONObject zones(&jsobj, "_zoneCapacityByOwner");
+    zones.AddProperty64(
+        "compiler", Zone::CapacityInBytesForOwner(Zone::kCompilerOwner));
+    zones.AddProperty64(
+        "apiScope", Zone::CapacityInBytesForOwner(Zone::kApiScopeOwner));
+    zones.AddProperty64(
+        "service", Zone::CapacityInBytesForOwner(Zone::kServiceOwner));
+    zones.AddProperty64("other",
+                        Zone::CapacityInBytesForOwner(Zone::kOtherOwner));
+  }
   jsobj.AddProperty64("pid", OS::ProcessId());
   jsobj.AddPropertyTimeMillis(
       "startTime", OS::GetCurrentTimeMillis() - Dart::UptimeMillis());
@@ -4292,6 +4385,8 @@ static const ServiceMethodDescriptor service_methods_[] = {
     get_reachable_size_params },
   { "_getRetainedSize", GetRetainedSize,
     get_retained_size_params },
+  { "_getRetainedSizes", GetRetainedSizes,
+    get_retained_sizes_params },
   { "_getRetainingPath", GetRetainingPath,
     get_retaining_path_params },
   { "getSourceReport", GetSourceReport,
@@ -176,6 +176,8 @@ class Service : public AllStatic {
   static int64_t MaxRSS();
 
  private:
+  class GraphEventWriter;
+
   static RawError* InvokeMethod(Isolate* isolate,
                                 const Array& message,
                                 bool parameters_are_dart_objects = false);
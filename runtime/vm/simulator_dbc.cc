@@ -40,6 +40,13 @@ DEFINE_FLAG(uint64_t,
             stop_sim_at,
             ULLONG_MAX,
             "Instruction address or instruction count to stop simulator at.");
+#if !defined(PRODUCT)
+DEFINE_FLAG(bool,
+            dbc_bytecode_stats,
+            false,
+            "Count executed bytecodes and bytecode pairs, and print the most "
+            "frequent ones when the isolate shuts down.");
+#endif  // !defined(PRODUCT)
 
 #define LIKELY(cond) __builtin_expect((cond), 1)
 #define UNLIKELY(cond) __builtin_expect((cond), 0)
@@ -570,9 +577,21 @@ Simulator::Simulator() : stack_(NULL), fp_(NULL), pp_(NULL), argdesc_(NULL) {
   top_exit_frame_info_ = 0;
 
   DEBUG_ONLY(icount_ = 0);
+#if !defined(PRODUCT)
+  bytecode_counts_ = NULL;
+  bytecode_pair_counts_ = NULL;
+  last_bytecode_ = 0;
+#endif  // !defined(PRODUCT)
 }
 
 Simulator::~Simulator() {
+#if !defined(PRODUCT)
+  if (bytecode_counts_ != NULL) {
+    PrintBytecodeStats();
+    delete[] bytecode_counts_;
+    delete[] bytecode_pair_counts_;
+  }
+#endif  // !defined(PRODUCT)
   delete[] stack_;
   Isolate* isolate = Isolate::Current();
   if (isolate != NULL) {
@@ -590,6 +609,72 @@ Simulator* Simulator::Current() {
   return simulator;
 }
 
+#if !defined(PRODUCT)
+DART_FORCE_INLINE void Simulator::RecordBytecode(uint32_t op) {
+  if (UNLIKELY(bytecode_counts_ == NULL)) {
+    bytecode_counts_ = new uint64_t[kNumOpcodes]();
+    bytecode_pair_counts_ = new uint64_t[kNumOpcodes * kNumOpcodes]();
+  }
+  const uint8_t bytecode = Bytecode::DecodeOpcode(op);
+  bytecode_counts_[bytecode]++;
+  bytecode_pair_counts_[last_bytecode_ * kNumOpcodes + bytecode]++;
+  last_bytecode_ = bytecode;
+}
+
+struct BytecodeStat {
+  uint64_t count;
+  intptr_t index;
+};
+
+static int CompareBytecodeStats(const void* a, const void* b) {
+  const uint64_t count_a = reinterpret_cast<const BytecodeStat*>(a)->count;
+  const uint64_t count_b = reinterpret_cast<const BytecodeStat*>(b)->count;
+  if (count_a == count_b) return 0;
+  return (count_a > count_b) ? -1 : 1;
+}
+
+static BytecodeStat* SortBytecodeStats(const uint64_t* counts,
+                                       intptr_t length) {
+  BytecodeStat* stats = new BytecodeStat[length];
+  for (intptr_t i = 0; i < length; i++) {
+    stats[i].count = counts[i];
+    stats[i].index = i;
+  }
+  qsort(stats, length, sizeof(BytecodeStat), CompareBytecodeStats);
+  return stats;
+}
+
+void Simulator::PrintBytecodeStats() const {
+  const intptr_t kTop = 30;
+  uint64_t total = 0;
+  for (intptr_t i = 0; i < kNumOpcodes; i++) {
+    total += bytecode_counts_[i];
+  }
+  if (total == 0) return;
+
+  OS::PrintErr("DBC bytecode stats: %" Pu64 " bytecodes executed\n", total);
+  BytecodeStat* stats = SortBytecodeStats(bytecode_counts_, kNumOpcodes);
+  for (intptr_t i = 0; (i < kTop) && (stats[i].count > 0); i++) {
+    OS::PrintErr("  %12" Pu64 " %5.2f%% %s\n", stats[i].count,
+                 100.0 * stats[i].count / total,
+                 Bytecode::NameOf(static_cast<Instr>(stats[i].index)));
+  }
+  delete[] stats;
+
+  OS::PrintErr("DBC bytecode pair stats:\n");
+  stats = SortBytecodeStats(bytecode_pair_counts_, kNumOpcodes * kNumOpcodes);
+  for (intptr_t i = 0; (i < kTop) && (stats[i].count > 0); i++) {
+    OS::PrintErr("  %12" Pu64 " %5.2f%% %s %s\n", stats[i].count,
+                 100.0 * stats[i].count / total,
+                 Bytecode::NameOf(
+                     static_cast<Instr>(stats[i].index / kNumOpcodes)),
+                 Bytecode::NameOf(
+                     static_cast<Instr>(stats[i].index % kNumOpcodes)));
+  }
+  delete[] stats;
+}
+#endif  // !defined(PRODUCT)
+
 #if defined(DEBUG)
 // Returns true if tracing of executed instructions is enabled.
 DART_FORCE_INLINE bool Simulator::IsTracingExecution() const {
@@ -996,6 +1081,16 @@ static DART_NOINLINE bool InvokeNative(Thread* thread,
 #define TRACE_INSTRUCTION
 #endif  // defined(DEBUG)
 
+// Counts executed bytecodes and pairs of consecutive bytecodes.
+#if !defined(PRODUCT)
+#define COUNT_BYTECODE(op)                                                     \
+  if (UNLIKELY(FLAG_dbc_bytecode_stats)) {                                     \
+    RecordBytecode(op);                                                        \
+  }
+#else
+#define COUNT_BYTECODE(op)
+#endif  // !defined(PRODUCT)
+
 // Decode opcode and A part of the given value and dispatch to the
 // corresponding bytecode handler.
 #define DISPATCH_OP(val)                                                       \
@@ -1003,12 +1098,24 @@ static DART_NOINLINE bool InvokeNative(Thread* thread,
     op = (val);                                                                \
     rA = ((op >> 8) & 0xFF);                                                   \
     TRACE_INSTRUCTION                                                          \
+    COUNT_BYTECODE(op)                                                         \
     goto* dispatch[op & 0xFF];                                                 \
   } while (0)
 
 // Fetch next operation from PC, increment program counter and dispatch.
 #define DISPATCH() DISPATCH_OP(*pc++)
 
+// Dispatch at the end of a comparison. The compiler emits comparisons as an
+// If bytecode followed by a Jump that the If skips when the condition fails,
+// so perform the Jump here instead of going through its handler.
+#define DISPATCH_BRANCH()                                                      \
+  do {                                                                         \
+    if (LIKELY(Bytecode::DecodeOpcode(*pc) == Bytecode::kJump)) {              \
+      pc += static_cast<int32_t>(*pc) >> 8;                                    \
+    }                                                                          \
+    DISPATCH();                                                                \
+  } while (0)
+
 // Define entry point that handles bytecode Name with the given operand format.
 #define BYTECODE(Name, Operands)                                               \
   BYTECODE_HEADER(Name, DECLARE_##Operands, DECODE_##Operands)
@@ -3273,7 +3380,7 @@ RawObject* Simulator::Call(const Code& code,
     if (SP[1] != SP[2]) {
       pc++;
     }
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3282,7 +3389,7 @@ RawObject* Simulator::Call(const Code& code,
     if (SP[1] == SP[2]) {
       pc++;
     }
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3297,7 +3404,7 @@ RawObject* Simulator::Call(const Code& code,
     if (!SimulatorHelpers::IsStrictEqualWithNumberCheck(SP[1], SP[2])) {
       pc++;
     }
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3312,7 +3419,7 @@ RawObject* Simulator::Call(const Code& code,
     if (SimulatorHelpers::IsStrictEqualWithNumberCheck(SP[1], SP[2])) {
       pc++;
     }
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3323,7 +3430,7 @@ RawObject* Simulator::Call(const Code& code,
       pc++;
     }
     SP -= 2;
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3334,7 +3441,7 @@ RawObject* Simulator::Call(const Code& code,
       pc++;
     }
     SP -= 2;
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3345,7 +3452,7 @@ RawObject* Simulator::Call(const Code& code,
       pc++;
     }
     SP -= 2;
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3356,7 +3463,7 @@ RawObject* Simulator::Call(const Code& code,
       pc++;
     }
     SP -= 2;
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3366,7 +3473,7 @@ RawObject* Simulator::Call(const Code& code,
     if (lhs != rhs) {
       pc++;
     }
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3376,7 +3483,7 @@ RawObject* Simulator::Call(const Code& code,
     if (lhs == rhs) {
       pc++;
     }
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3386,7 +3493,7 @@ RawObject* Simulator::Call(const Code& code,
     if (lhs > rhs) {
       pc++;
     }
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3396,7 +3503,7 @@ RawObject* Simulator::Call(const Code& code,
     if (lhs >= rhs) {
       pc++;
     }
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3406,7 +3513,7 @@ RawObject* Simulator::Call(const Code& code,
     if (lhs < rhs) {
       pc++;
     }
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3416,7 +3523,7 @@ RawObject* Simulator::Call(const Code& code,
     if (lhs <= rhs) {
       pc++;
     }
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3426,7 +3533,7 @@ RawObject* Simulator::Call(const Code& code,
     if (lhs > rhs) {
       pc++;
     }
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3436,7 +3543,7 @@ RawObject* Simulator::Call(const Code& code,
     if (lhs >= rhs) {
       pc++;
     }
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3446,7 +3553,7 @@ RawObject* Simulator::Call(const Code& code,
     if (lhs < rhs) {
       pc++;
     }
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3456,7 +3563,7 @@ RawObject* Simulator::Call(const Code& code,
     if (lhs <= rhs) {
       pc++;
     }
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
 #if defined(ARCH_IS_64_BIT)
@@ -3465,7 +3572,7 @@ RawObject* Simulator::Call(const Code& code,
     const double lhs = bit_cast<double, RawObject*>(FP[rA]);
     const double rhs = bit_cast<double, RawObject*>(FP[rD]);
     pc += (lhs == rhs) ? 0 : 1;
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3473,7 +3580,7 @@ RawObject* Simulator::Call(const Code& code,
     const double lhs = bit_cast<double, RawObject*>(FP[rA]);
     const double rhs = bit_cast<double, RawObject*>(FP[rD]);
     pc += (lhs != rhs) ? 0 : 1;
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3481,7 +3588,7 @@ RawObject* Simulator::Call(const Code& code,
     const double lhs = bit_cast<double, RawObject*>(FP[rA]);
     const double rhs = bit_cast<double, RawObject*>(FP[rD]);
     pc += (lhs <= rhs) ? 0 : 1;
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3489,7 +3596,7 @@ RawObject* Simulator::Call(const Code& code,
     const double lhs = bit_cast<double, RawObject*>(FP[rA]);
     const double rhs = bit_cast<double, RawObject*>(FP[rD]);
     pc += (lhs < rhs) ? 0 : 1;
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3497,7 +3604,7 @@ RawObject* Simulator::Call(const Code& code,
     const double lhs = bit_cast<double, RawObject*>(FP[rA]);
     const double rhs = bit_cast<double, RawObject*>(FP[rD]);
     pc += (lhs >= rhs) ? 0 : 1;
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3505,7 +3612,7 @@ RawObject* Simulator::Call(const Code& code,
     const double lhs = bit_cast<double, RawObject*>(FP[rA]);
     const double rhs = bit_cast<double, RawObject*>(FP[rD]);
     pc += (lhs > rhs) ? 0 : 1;
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 #else   // defined(ARCH_IS_64_BIT)
   {
@@ -3552,7 +3659,7 @@ RawObject* Simulator::Call(const Code& code,
     if (!SimulatorHelpers::IsStrictEqualWithNumberCheck(lhs, rhs)) {
       pc++;
     }
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3562,7 +3669,7 @@ RawObject* Simulator::Call(const Code& code,
     if (SimulatorHelpers::IsStrictEqualWithNumberCheck(lhs, rhs)) {
       pc++;
     }
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3570,7 +3677,7 @@ RawObject* Simulator::Call(const Code& code,
     if (FP[rA] != null_value) {
       pc++;
     }
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -3578,7 +3685,7 @@ RawObject* Simulator::Call(const Code& code,
     if (FP[rA] == null_value) {
       pc++;
     }
-    DISPATCH();
+    DISPATCH_BRANCH();
   }
 
   {
@@ -101,6 +101,15 @@ class Simulator {
   uword pc_;
   DEBUG_ONLY(uint64_t icount_;)
 
+#if !defined(PRODUCT)
+  // Bytecode histograms collected with --dbc_bytecode_stats. Opcodes are
+  // 8 bits wide.
+  static const intptr_t kNumOpcodes = 256;
+  uint64_t* bytecode_counts_;
+  uint64_t* bytecode_pair_counts_;
+  uint8_t last_bytecode_;
+#endif  // !defined(PRODUCT)
+
   SimulatorSetjmpBuffer* last_setjmp_buffer_;
   uword top_exit_frame_info_;
 
@@ -177,6 +186,9 @@ class Simulator {
 
   // Prints bytecode instruction at given pc for instruction tracing.
   void TraceInstruction(uint32_t* pc) const;
+
+  void RecordBytecode(uint32_t op);
+  void PrintBytecodeStats() const;
 #endif  // !defined(PRODUCT)
 
   // Longjmp support for exceptions.
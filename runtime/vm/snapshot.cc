@@ -1165,11 +1165,13 @@ bool SnapshotWriter::CheckAndWritePredefinedObject(RawObject* rawobj) {
   }
 
   // Now check it is a preinitialized type object.
-  RawType* raw_type = reinterpret_cast<RawType*>(rawobj);
-  intptr_t index = GetTypeIndex(object_store(), raw_type);
-  if (index != kInvalidIndex) {
-    WriteIndexedObject(index);
-    return true;
+  if (cid == kTypeCid) {
+    RawType* raw_type = reinterpret_cast<RawType*>(rawobj);
+    intptr_t index = GetTypeIndex(object_store(), raw_type);
+    if (index != kInvalidIndex) {
+      WriteIndexedObject(index);
+      return true;
+    }
   }
 
   return false;
@@ -1615,7 +1617,7 @@ MessageWriter::MessageWriter(bool can_send_any_object)
                      &forward_list_,
                      can_send_any_object),
       forward_list_(thread(), kMaxPredefinedObjectIds),
-      finalizable_data_(new MessageFinalizableData()) {}
+      finalizable_data_(NULL) {}
 
 MessageWriter::~MessageWriter() {
   delete finalizable_data_;
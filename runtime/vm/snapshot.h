@@ -804,7 +804,13 @@ class MessageWriter : public SnapshotWriter {
                         Dart_Port dest_port,
                         Message::Priority priority);
 
-  MessageFinalizableData* finalizable_data() const { return finalizable_data_; }
+  // Allocated on first use, as most messages carry no external data.
+  MessageFinalizableData* finalizable_data() {
+    if (finalizable_data_ == NULL) {
+      finalizable_data_ = new MessageFinalizableData();
+    }
+    return finalizable_data_;
+  }
 
  private:
   ForwardList forward_list_;
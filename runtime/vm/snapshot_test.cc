@@ -523,8 +523,14 @@ static void TestString(const char* cstr) {
   String& serialized_str = String::Handle();
   serialized_str ^= reader.ReadObject();
   EXPECT(str.Equals(serialized_str));
+  delete message;
 
-  // Read object back from the snapshot into a C structure.
+  // Large strings are passed out of line, and reading the message hands the
+  // out-of-line data to the reader, so write a second message to read back
+  // into a C structure.
+  MessageWriter api_writer(true);
+  message =
+      api_writer.WriteMessage(str, ILLEGAL_PORT, Message::kNormalPriority);
   ApiNativeScope scope;
   ApiMessageReader api_reader(message);
   Dart_CObject* root = api_reader.ReadMessage();
@@ -547,6 +553,25 @@ TEST_CASE(SerializeString) {
 
   TestString(data);
   // TODO(sgjesse): Add tests with non-BMP characters.
+
+  // Large strings are passed out of line as external strings.
+  Zone* zone = Thread::Current()->zone();
+  const intptr_t kLargeLength = 8 * KB;
+  char* latin1 = zone->Alloc<char>(2 * kLargeLength + 1);
+  for (intptr_t i = 0; i < kLargeLength; i++) {
+    latin1[2 * i] = '\xC3';  // U+00E6
+    latin1[2 * i + 1] = '\xA6';
+  }
+  latin1[2 * kLargeLength] = '\0';
+  TestString(latin1);
+  char* utf16 = zone->Alloc<char>(3 * kLargeLength + 1);
+  for (intptr_t i = 0; i < kLargeLength; i++) {
+    utf16[3 * i] = '\xE0';  // U+0800
+    utf16[3 * i + 1] = '\xA0';
+    utf16[3 * i + 2] = '\x80';
+  }
+  utf16[3 * kLargeLength] = '\0';
+  TestString(utf16);
 }
 
 TEST_CASE(SerializeArray) {
@@ -726,6 +751,35 @@ TEST_CASE(SerializeByteArray) {
   delete message;
 }
 
+TEST_CASE(SerializeByteArrayBorrowed) {
+  const int kTypedDataLength = 256;
+  TypedData& typed_data = TypedData::Handle(
+      TypedData::New(kTypedDataUint8ArrayCid, kTypedDataLength));
+  for (int i = 0; i < kTypedDataLength; i++) {
+    typed_data.SetUint8(i, i);
+  }
+  MessageWriter writer(true);
+  Message* message =
+      writer.WriteMessage(typed_data, ILLEGAL_PORT, Message::kNormalPriority);
+
+  // Read the message into a C structure without copying the bytes.
+  ApiNativeScope scope;
+  ApiMessageReader api_reader(message, /* borrow_message_data = */ true);
+  Dart_CObject* root = api_reader.ReadMessage();
+  EXPECT_EQ(Dart_CObject_kTypedData, root->type);
+  EXPECT_EQ(kTypedDataLength, root->value.as_typed_data.length);
+  const uint8_t* values = root->value.as_typed_data.values;
+  EXPECT(values > message->snapshot());
+  EXPECT(values + kTypedDataLength <=
+         message->snapshot() + message->snapshot_length());
+  for (int i = 0; i < kTypedDataLength; i++) {
+    EXPECT(values[i] == i);
+  }
+  CheckEncodeDecodeMessage(root);
+
+  delete message;
+}
+
 #define TEST_TYPED_ARRAY(darttype, ctype)                                      \
   {                                                                            \
     StackZone zone(thread);                                                    \
@@ -25,12 +25,15 @@ intptr_t StackTraceUtils::CountFrames(Thread* thread,
       if (skip_frames > 0) {
         skip_frames--;
       } else {
-        code = frame->LookupDartCode();
-        function = code.function();
         frame_count++;
-        if (!async_function_is_null &&
-            (async_function.raw() == function.parent_function())) {
-          return frame_count;
+        // Only the search for the async function needs the frame's code;
+        // plain counting must stay cheap as it runs on every throw.
+        if (!async_function_is_null) {
+          code = frame->LookupDartCode();
+          function = code.function();
+          if (async_function.raw() == function.parent_function()) {
+            return frame_count;
+          }
         }
       }
     }
@@ -52,7 +55,6 @@ intptr_t StackTraceUtils::CollectFrames(Thread* thread,
                             StackFrameIterator::kNoCrossThreadIteration);
   StackFrame* frame = frames.NextFrame();
   ASSERT(frame != NULL);  // We expect to find a dart invocation frame.
-  Function& function = Function::Handle(zone);
   Code& code = Code::Handle(zone);
   Smi& offset = Smi::Handle(zone);
   intptr_t collected_frames_count = 0;
@@ -62,7 +64,6 @@ intptr_t StackTraceUtils::CollectFrames(Thread* thread,
         skip_frames--;
       } else {
         code = frame->LookupDartCode();
-        function = code.function();
         offset = Smi::New(frame->pc() - code.PayloadStart());
         code_array.SetAt(array_offset, code);
         pc_offset_array.SetAt(array_offset, offset);
@@ -5,6 +5,7 @@
 #include "vm/store_buffer.h"
 
 #include "platform/assert.h"
+#include "vm/atomic.h"
 #include "vm/lockers.h"
 #include "vm/runtime_entry.h"
 
@@ -16,21 +17,55 @@ DEFINE_LEAF_RUNTIME_ENTRY(void, StoreBufferBlockProcess, 1, Thread* thread) {
 END_LEAF_RUNTIME_ENTRY
 
 template <int BlockSize>
-typename BlockStack<BlockSize>::List* BlockStack<BlockSize>::global_empty_ =
+typename BlockStack<BlockSize>::Block* BlockStack<BlockSize>::global_empty_ =
     NULL;
 template <int BlockSize>
-Mutex* BlockStack<BlockSize>::global_mutex_ = NULL;
+intptr_t BlockStack<BlockSize>::global_empty_length_ = 0;
+
+template <>
+StoreBufferBlock** BlockStack<kStoreBufferBlockSize>::ThreadEmpty(
+    Thread* thread,
+    intptr_t** length) {
+  *length = &thread->store_buffer_empty_length_;
+  return &thread->store_buffer_empty_blocks_;
+}
+
+template <>
+MarkingStack::Block** BlockStack<kMarkingStackBlockSize>::ThreadEmpty(
+    Thread* thread,
+    intptr_t** length) {
+  *length = &thread->marking_stack_empty_length_;
+  return &thread->marking_stack_empty_blocks_;
+}
 
 template <int BlockSize>
 void BlockStack<BlockSize>::InitOnce() {
-  global_empty_ = new List();
-  global_mutex_ = new Mutex();
+  ASSERT(global_empty_ == NULL);
+  global_empty_length_ = 0;
 }
 
 template <int BlockSize>
 void BlockStack<BlockSize>::ShutDown() {
-  delete global_empty_;
-  delete global_mutex_;
+  Block* block = PopAllGlobalEmpty();
+  while (block != NULL) {
+    Block* next = block->next_;
+    block->next_ = NULL;
+    delete block;
+    block = next;
+  }
+}
+
+template <int BlockSize>
+void BlockStack<BlockSize>::ReleaseThreadCache(Thread* thread) {
+  intptr_t* length;
+  Block** head = ThreadEmpty(thread, &length);
+  while (*head != NULL) {
+    Block* block = *head;
+    *head = block->next_;
+    block->next_ = NULL;
+    delete block;
+  }
+  *length = 0;
 }
 
 template <int BlockSize>
@@ -45,20 +80,16 @@ BlockStack<BlockSize>::~BlockStack() {
 template <int BlockSize>
 void BlockStack<BlockSize>::Reset() {
   MutexLocker local_mutex_locker(mutex_);
-  {
-    // Empty all blocks and move them to the global cache.
-    MutexLocker global_mutex_locker(global_mutex_);
-    while (!full_.IsEmpty()) {
-      Block* block = full_.Pop();
-      block->Reset();
-      global_empty_->Push(block);
-    }
-    while (!partial_.IsEmpty()) {
-      Block* block = partial_.Pop();
-      block->Reset();
-      global_empty_->Push(block);
-    }
-    TrimGlobalEmpty();
+  // Empty all blocks and move them to the empty block caches.
+  while (!full_.IsEmpty()) {
+    Block* block = full_.Pop();
+    block->Reset();
+    PushEmptyBlock(block);
+  }
+  while (!partial_.IsEmpty()) {
+    Block* block = partial_.Pop();
+    block->Reset();
+    PushEmptyBlock(block);
   }
 }
 
@@ -78,9 +109,7 @@ void BlockStack<BlockSize>::PushBlockImpl(Block* block) {
     MutexLocker ml(mutex_);
     full_.Push(block);
   } else if (block->IsEmpty()) {
-    MutexLocker ml(global_mutex_);
-    global_empty_->Push(block);
-    TrimGlobalEmpty();
+    PushEmptyBlock(block);
   } else {
     MutexLocker ml(mutex_);
     partial_.Push(block);
@@ -121,13 +150,107 @@ BlockStack<BlockSize>::PopNonFullBlock() {
 
 template <int BlockSize>
 typename BlockStack<BlockSize>::Block* BlockStack<BlockSize>::PopEmptyBlock() {
-  {
-    MutexLocker ml(global_mutex_);
-    if (!global_empty_->IsEmpty()) {
-      return global_empty_->Pop();
+  Thread* thread = Thread::Current();
+  Block** head = NULL;
+  intptr_t* length = NULL;
+  if (thread != NULL) {
+    head = ThreadEmpty(thread, &length);
+    if (*head != NULL) {
+      Block* block = *head;
+      *head = block->next_;
+      block->next_ = NULL;
+      --(*length);
+      return block;
     }
   }
-  return new Block();
+  Block* block = PopAllGlobalEmpty();
+  if (block == NULL) {
+    return new Block();
+  }
+  Block* rest = block->next_;
+  block->next_ = NULL;
+  if (head != NULL) {
+    // Refill the cache of this thread from the blocks taken.
+    while ((rest != NULL) && (*length < kMaxThreadEmpty)) {
+      Block* next = rest->next_;
+      rest->next_ = *head;
+      *head = rest;
+      ++(*length);
+      rest = next;
+    }
+  }
+  if (rest != NULL) {
+    // Give the remaining blocks back to other threads.
+    Block* tail = rest;
+    intptr_t count = 1;
+    while (tail->next_ != NULL) {
+      tail = tail->next_;
+      ++count;
+    }
+    PushGlobalEmpty(rest, tail, count);
+  }
+  return block;
+}
+
+template <int BlockSize>
+void BlockStack<BlockSize>::PushEmptyBlock(Block* block) {
+  ASSERT(block->IsEmpty());
+  ASSERT(block->next_ == NULL);
+  Thread* thread = Thread::Current();
+  if (thread != NULL) {
+    intptr_t* length;
+    Block** head = ThreadEmpty(thread, &length);
+    if (*length < kMaxThreadEmpty) {
+      block->next_ = *head;
+      *head = block;
+      ++(*length);
+      return;
+    }
+  }
+  if (AtomicOperations::LoadRelaxed(&global_empty_length_) >=
+      kMaxGlobalEmpty) {
+    delete block;
+    return;
+  }
+  PushGlobalEmpty(block, block, 1);
+}
+
+template <int BlockSize>
+void BlockStack<BlockSize>::PushGlobalEmpty(Block* head,
+                                            Block* tail,
+                                            intptr_t length) {
+  uword* global = reinterpret_cast<uword*>(&global_empty_);
+  uword old_head;
+  do {
+    old_head = AtomicOperations::LoadRelaxed(global);
+    tail->next_ = reinterpret_cast<Block*>(old_head);
+  } while (AtomicOperations::CompareAndSwapWord(
+               global, old_head, reinterpret_cast<uword>(head)) != old_head);
+  AtomicOperations::IncrementBy(&global_empty_length_, length);
+}
+
+template <int BlockSize>
+typename BlockStack<BlockSize>::Block*
+BlockStack<BlockSize>::PopAllGlobalEmpty() {
+  // Popping single blocks would need protection against ABA and against
+  // reading the next field of a block deleted by another thread. Taking
+  // the whole list at once needs neither.
+  uword* global = reinterpret_cast<uword*>(&global_empty_);
+  uword old_head;
+  do {
+    old_head = AtomicOperations::LoadRelaxed(global);
+    if (old_head == 0) {
+      return NULL;
+    }
+  } while (AtomicOperations::CompareAndSwapWord(global, old_head, 0) !=
+           old_head);
+  Block* result = reinterpret_cast<Block*>(old_head);
+  intptr_t count = 0;
+  for (Block* block = result; block != NULL; block = block->next_) {
+    ++count;
+  }
+  AtomicOperations::DecrementBy(&global_empty_length_, count);
+  return result;
 }
 
 template <int BlockSize>
@@ -195,15 +318,78 @@ void StoreBuffer::VisitObjectPointers(ObjectPointerVisitor* visitor) {
   }
 }
 
-template <int BlockSize>
-void BlockStack<BlockSize>::TrimGlobalEmpty() {
-  DEBUG_ASSERT(global_mutex_->IsOwnedByCurrentThread());
-  while (global_empty_->length() > kMaxGlobalEmpty) {
-    delete global_empty_->Pop();
+template class BlockStack<kStoreBufferBlockSize>;
+template class BlockStack<kMarkingStackBlockSize>;
+
+MarkingStack::MarkingStack(intptr_t num_stashes)
+    : num_stashes_(num_stashes), stashes_(NULL), num_stashed_(0) {
+  if (num_stashes_ > 0) {
+    stashes_ = new Stash[num_stashes_];
   }
 }
 
-template class BlockStack<kStoreBufferBlockSize>;
-template class BlockStack<kMarkingStackBlockSize>;
+MarkingStack::~MarkingStack() {
+  for (intptr_t i = 0; i < num_stashes_; i++) {
+    List* blocks = &stashes_[i].blocks;
+    while (!blocks->IsEmpty()) {
+      Block* block = blocks->Pop();
+      block->Reset();
+      PushEmptyBlock(block);
+    }
+  }
+  delete[] stashes_;
+}
+
+void MarkingStack::PushBlock(Block* block, intptr_t stash) {
+  if ((stash == kNoStash) || block->IsEmpty()) {
+    PushBlock(block);
+    return;
+  }
+  ASSERT((stash >= 0) && (stash < num_stashes_));
+  ASSERT(block->next() == NULL);  // Should be just a single block.
+  MutexLocker ml(&stashes_[stash].mutex);
+  stashes_[stash].blocks.Push(block);
+  AtomicOperations::FetchAndIncrement(&num_stashed_);
+}
+
+MarkingStack::Block* MarkingStack::PopFromStash(intptr_t stash) {
+  MutexLocker ml(&stashes_[stash].mutex);
+  if (stashes_[stash].blocks.IsEmpty()) {
+    return NULL;
+  }
+  AtomicOperations::FetchAndDecrement(&num_stashed_);
+  return stashes_[stash].blocks.Pop();
+}
+
+MarkingStack::Block* MarkingStack::PopNonEmptyBlock(intptr_t stash) {
+  if (stash == kNoStash) {
+    return PopNonEmptyBlock();
+  }
+  ASSERT((stash >= 0) && (stash < num_stashes_));
+  Block* block = PopFromStash(stash);
+  if (block != NULL) {
+    return block;
+  }
+  block = PopNonEmptyBlock();
+  if (block != NULL) {
+    return block;
+  }
+  // Steal from the other tasks, starting with the next one.
+  for (intptr_t i = 1; i < num_stashes_; i++) {
+    if (AtomicOperations::LoadRelaxed(&num_stashed_) == 0) {
+      break;
+    }
+    block = PopFromStash((stash + i) % num_stashes_);
+    if (block != NULL) {
+      return block;
+    }
+  }
+  return NULL;
+}
+
+bool MarkingStack::IsEmpty() {
+  return (AtomicOperations::LoadRelaxed(&num_stashed_) == 0) &&
+         BlockStack<Block::kSize>::IsEmpty();
+}
 
 }  // namespace dart
@@ -7,14 +7,15 @@
 
 #include "platform/assert.h"
 #include "vm/globals.h"
+#include "vm/os_thread.h"
 
 namespace dart {
 
 // Forward declarations.
 class Isolate;
-class Mutex;
 class RawObject;
 class ObjectPointerVisitor;
+class Thread;
 
 // A set of RawObject*. Must be emptied before destruction (using Pop/Reset).
 template <int Size>
@@ -79,7 +80,9 @@ class PointerBlock {
 
 // A synchronized collection of pointer blocks of a particular size.
 // This class is meant to be used as a base (note PushBlockImpl is protected).
-// The global list of cached empty blocks is currently per-size.
+// Empty blocks are cached per size: first in a small list owned by the
+// current Thread, which needs no synchronization, and then in a global
+// lock-free stack shared by all threads.
 template <int BlockSize>
 class BlockStack {
  public:
@@ -90,6 +93,9 @@ class BlockStack {
   static void InitOnce();
   static void ShutDown();
 
+  // Deletes the empty blocks cached by 'thread', which is being destroyed.
+  static void ReleaseThreadCache(Thread* thread);
+
   // Partially filled blocks can be reused, and there is an "inifite" supply
   // of empty blocks (reused or newly allocated). In any case, the caller
   // takes ownership of the returned block.
@@ -126,19 +132,27 @@ class BlockStack {
   // Adds and transfers ownership of the block to the buffer.
   void PushBlockImpl(Block* block);
 
-  // If needed, trims the global cache of empty blocks.
-  static void TrimGlobalEmpty();
+  // Caches an empty block for reuse, or deletes it if the caches are full.
+  static void PushEmptyBlock(Block* block);
 
   List full_;
   List partial_;
   Mutex* mutex_;
 
-  // Note: This is shared on the basis of block size.
+  // Note: These are shared on the basis of block size.
+  static const intptr_t kMaxThreadEmpty = 8;
   static const intptr_t kMaxGlobalEmpty = 100;
-  static List* global_empty_;
-  static Mutex* global_mutex_;
+  static Block* global_empty_;
+  // Approximate, as it is updated separately from global_empty_.
+  static intptr_t global_empty_length_;
 
  private:
+  // Returns the head and length of the empty block cache of 'thread'.
+  static Block** ThreadEmpty(Thread* thread, intptr_t** length);
+
+  static void PushGlobalEmpty(Block* head, Block* tail, intptr_t length);
+  static Block* PopAllGlobalEmpty();
+
   DISALLOW_COPY_AND_ASSIGN(BlockStack);
 };
 
@@ -167,10 +181,43 @@ typedef StoreBuffer::Block StoreBufferBlock;
 static const int kMarkingStackBlockSize = 64;
 class MarkingStack : public BlockStack<kMarkingStackBlockSize> {
  public:
+  static const intptr_t kNoStash = -1;
+
+  // Each parallel marker or scavenger task gets a stash of its own. Tasks
+  // push to and pop from their own stash, and only take a stash lock of
+  // another task when stealing work from it.
+  explicit MarkingStack(intptr_t num_stashes = 0);
+  ~MarkingStack();
+
   // Adds and transfers ownership of the block to the buffer.
   void PushBlock(Block* block) {
     BlockStack<Block::kSize>::PushBlockImpl(block);
   }
+
+  // Like PushBlock, but non-empty blocks go to the given stash.
+  void PushBlock(Block* block, intptr_t stash);
+
+  // Pops a block from the given stash, then from the shared lists, and
+  // finally steals one from the other stashes.
+  Block* PopNonEmptyBlock(intptr_t stash);
+  using BlockStack<Block::kSize>::PopNonEmptyBlock;
+
+  bool IsEmpty();
+
+ private:
+  struct Stash {
+    Mutex mutex;
+    List blocks;
+  };
+
+  Block* PopFromStash(intptr_t stash);
+
+  const intptr_t num_stashes_;
+  Stash* stashes_;
+  // Number of blocks in all stashes, read without taking the stash locks.
+  intptr_t num_stashed_;
+
+  DISALLOW_COPY_AND_ASSIGN(MarkingStack);
 };
 
 }  // namespace dart
@@ -1100,6 +1100,9 @@ void StubCode::GenerateAllocationStubForClass(Assembler* assembler,
     Label slow_case;
     // Allocate the object and update top to point to
     // next object start and initialize the allocated object.
+    // Pretenured classes are allocated in the runtime.
+    NOT_IN_PRODUCT(__ LoadAllocationStatsAddress(R9, cls.id()));
+    NOT_IN_PRODUCT(__ MaybeTraceAllocation(R9, &slow_case));
     NOT_IN_PRODUCT(Heap::Space space = Heap::kNew);
     __ ldr(R0, Address(THR, Thread::top_offset()));
     __ AddImmediate(R1, R0, instance_size);
@@ -1145,6 +1145,8 @@ void StubCode::GenerateAllocationStubForClass(Assembler* assembler,
     // Allocate the object and update top to point to
     // next object start and initialize the allocated object.
     // R1: instantiated type arguments (if is_cls_parameterized).
+    // Pretenured classes are allocated in the runtime.
+    NOT_IN_PRODUCT(__ MaybeTraceAllocation(cls.id(), R2, &slow_case));
     NOT_IN_PRODUCT(Heap::Space space = Heap::kNew);
     __ ldr(R2, Address(THR, Thread::top_offset()));
     __ AddImmediate(R3, R2, instance_size);
@@ -1029,6 +1029,9 @@ void StubCode::GenerateAllocationStubForClass(Assembler* assembler,
     // Allocate the object and update top to point to
     // next object start and initialize the allocated object.
     // EDX: instantiated type arguments (if is_cls_parameterized).
+    // Pretenured classes are allocated in the runtime.
+    NOT_IN_PRODUCT(__ MaybeTraceAllocation(cls.id(), ECX, &slow_case,
+                                           Assembler::kFarJump));
     NOT_IN_PRODUCT(Heap::Space space = Heap::kNew);
     __ movl(EAX, Address(THR, Thread::top_offset()));
     __ leal(EBX, Address(EAX, instance_size));
@@ -1086,6 +1086,9 @@ void StubCode::GenerateAllocationStubForClass(Assembler* assembler,
     // Allocate the object and update top to point to
     // next object start and initialize the allocated object.
     // RDX: instantiated type arguments (if is_cls_parameterized).
+    // Pretenured classes are allocated in the runtime.
+    NOT_IN_PRODUCT(
+        __ MaybeTraceAllocation(cls.id(), &slow_case, Assembler::kFarJump));
     NOT_IN_PRODUCT(Heap::Space space = Heap::kNew);
     __ movq(RAX, Address(THR, Thread::top_offset()));
     __ leaq(RBX, Address(RAX, instance_size));
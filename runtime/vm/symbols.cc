@@ -4,6 +4,7 @@
 
 #include "vm/symbols.h"
 
+#include "vm/atomic.h"
 #include "vm/handles.h"
 #include "vm/hash_table.h"
 #include "vm/isolate.h"
@@ -179,13 +180,22 @@ class SymbolTraits {
   static uword Hash(const ConcatString& concat) { return concat.Hash(); }
   template <typename CharType>
   static RawObject* NewKey(const CharArray<CharType>& array) {
-    return array.ToSymbol();
+    return Publish(array.ToSymbol());
   }
   static RawObject* NewKey(const StringSlice& slice) {
-    return slice.ToSymbol();
+    return Publish(slice.ToSymbol());
   }
   static RawObject* NewKey(const ConcatString& concat) {
-    return concat.ToSymbol();
+    return Publish(concat.ToSymbol());
+  }
+
+ private:
+  // The isolate symbol table is probed without holding the symbols mutex, so
+  // the new symbol's contents and hash must be visible to other threads
+  // before the table slot referring to it is.
+  static RawObject* Publish(RawObject* symbol) {
+    AtomicOperations::FullMemoryBarrier();
+    return symbol;
   }
 };
 typedef UnorderedHashSet<SymbolTraits> SymbolTable;
@@ -543,6 +553,24 @@ RawString* Symbols::FromConcatAll(
   }
 }
 
+// Probes the isolate symbol table without taking the symbols mutex. This is
+// safe because lookups never write to the table, inserts publish fully
+// initialized symbols, and growing the table copies it rather than rehashing
+// it in place. Compaction only happens at a safepoint. A concurrent insert
+// may be missed, so callers must retry under the mutex when this returns null.
+template <typename StringType>
+static RawObject* LookupUnlocked(Thread* thread,
+                                 const StringType& str,
+                                 dart::Object* key,
+                                 Smi* value,
+                                 Array* data) {
+  *data ^= thread->isolate()->object_store()->symbol_table();
+  SymbolTable table(key, value, data);
+  RawObject* symbol = table.GetOrNull(str);
+  table.Release();
+  return symbol;
+}
+
 // StringType can be StringSlice, ConcatString, or {Latin1,UTF16,UTF32}Array.
 template <typename StringType>
 RawString* Symbols::NewSymbol(Thread* thread, const StringType& str) {
@@ -560,12 +588,17 @@ RawString* Symbols::NewSymbol(Thread* thread, const StringType& str) {
     symbol ^= table.GetOrNull(str);
     table.Release();
   }
+  if (symbol.IsNull()) {
+    symbol ^= LookupUnlocked(thread, str, &key, &value, &data);
+  }
   if (symbol.IsNull()) {
     Isolate* isolate = thread->isolate();
     SafepointMutexLocker ml(isolate->symbols_mutex());
     data ^= isolate->object_store()->symbol_table();
     SymbolTable table(&key, &value, &data);
     symbol ^= table.InsertNewOrGet(str);
+    // A grown table is published below; its entries must be visible first.
+    AtomicOperations::FullMemoryBarrier();
     isolate->object_store()->set_symbol_table(table.Release());
   }
   ASSERT(symbol.IsSymbol());
@@ -589,6 +622,9 @@ RawString* Symbols::Lookup(Thread* thread, const StringType& str) {
     symbol ^= table.GetOrNull(str);
     table.Release();
   }
+  if (symbol.IsNull()) {
+    symbol ^= LookupUnlocked(thread, str, &key, &value, &data);
+  }
   if (symbol.IsNull()) {
     Isolate* isolate = thread->isolate();
     SafepointMutexLocker ml(isolate->symbols_mutex());
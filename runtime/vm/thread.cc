@@ -43,6 +43,9 @@ Thread::~Thread() {
     delete api_reusable_scope_;
     api_reusable_scope_ = NULL;
   }
+  Zone::ReleaseSegmentCache(this);
+  StoreBuffer::ReleaseThreadCache(this);
+  MarkingStack::ReleaseThreadCache(this);
   delete thread_lock_;
   thread_lock_ = NULL;
 }
@@ -75,6 +78,12 @@ Thread::Thread(Isolate* isolate)
       zone_(NULL),
       current_zone_capacity_(0),
       zone_high_watermark_(0),
+      zone_segment_cache_(NULL),
+      zone_segment_cache_length_(0),
+      store_buffer_empty_blocks_(NULL),
+      store_buffer_empty_length_(0),
+      marking_stack_empty_blocks_(NULL),
+      marking_stack_empty_length_(0),
       api_reusable_scope_(NULL),
       api_top_scope_(NULL),
       top_resource_(NULL),
@@ -91,6 +100,8 @@ Thread::Thread(Isolate* isolate)
       deferred_interrupts_mask_(0),
       deferred_interrupts_(0),
       stack_overflow_count_(0),
+      old_tlab_top_(0),
+      old_tlab_end_(0),
       cha_(NULL),
       hierarchy_info_(NULL),
       deopt_id_(0),
@@ -285,6 +296,10 @@ const char* Thread::TaskKindToCString(TaskKind kind) {
       return "kSweeperTask";
     case kMarkerTask:
       return "kMarkerTask";
+    case kScavengerTask:
+      return "kScavengerTask";
+    case kHeapIterationTask:
+      return "kHeapIterationTask";
     default:
       UNREACHABLE();
       return "";
@@ -331,6 +346,7 @@ void Thread::ExitIsolate() {
   // Clear since GC will not visit the thread once it is unscheduled.
   thread->ClearReusableHandles();
   thread->StoreBufferRelease();
+  thread->heap()->old_space()->AbandonTLAB(thread);
   if (isolate->is_runnable()) {
     thread->set_vm_tag(VMTag::kIdleTagId);
   } else {
@@ -370,6 +386,7 @@ void Thread::ExitIsolateAsHelper(bool bypass_safepoint) {
   // Clear since GC will not visit the thread once it is unscheduled.
   thread->ClearReusableHandles();
   thread->StoreBufferRelease();
+  thread->heap()->old_space()->AbandonTLAB(thread);
   Isolate* isolate = thread->isolate();
   ASSERT(isolate != NULL);
   const bool kIsNotMutatorThread = false;
@@ -385,6 +402,9 @@ void Thread::PrepareForGC() {
   // at GC time.
   // TODO(koda): Replace with an epilogue (PrepareAfterGC) that acquires.
   store_buffer_block_ = isolate()->store_buffer()->PopEmptyBlock();
+  // Return the unused part of the old-space allocation buffer, so that the
+  // collector sees it as free space.
+  heap()->old_space()->AbandonTLAB(this);
 }
 
 void Thread::SetStackLimitFromStackBase(uword stack_base) {
@@ -170,6 +170,8 @@ class Thread : public BaseThread {
     kMarkerTask = 0x4,
     kSweeperTask = 0x8,
     kCompactorTask = 0x10,
+    kScavengerTask = 0x20,
+    kHeapIterationTask = 0x40,
   };
   // Converts a TaskKind to its corresponding C-String name.
   static const char* TaskKindToCString(TaskKind kind);
@@ -405,6 +407,12 @@ class Thread : public BaseThread {
   static intptr_t top_offset() { return OFFSET_OF(Thread, top_); }
   static intptr_t end_offset() { return OFFSET_OF(Thread, end_); }
 
+  // Old-space allocation buffer, see PageSpace::TryAllocateInTLAB.
+  uword old_tlab_top() const { return old_tlab_top_; }
+  uword old_tlab_end() const { return old_tlab_end_; }
+  void set_old_tlab_top(uword value) { old_tlab_top_ = value; }
+  void set_old_tlab_end(uword value) { old_tlab_end_ = value; }
+
   int32_t no_handle_scope_depth() const {
 #if defined(DEBUG)
     return no_handle_scope_depth_;
@@ -768,6 +776,16 @@ class Thread : public BaseThread {
   Zone* zone_;
   uintptr_t current_zone_capacity_;
   uintptr_t zone_high_watermark_;
+  // Freed zone segments kept for reuse by the zones of this thread; the
+  // list is managed by Zone.
+  void* zone_segment_cache_;
+  intptr_t zone_segment_cache_length_;
+  // Empty pointer blocks kept for reuse by this thread; the lists are
+  // managed by BlockStack.
+  StoreBufferBlock* store_buffer_empty_blocks_;
+  intptr_t store_buffer_empty_length_;
+  PointerBlock<kMarkingStackBlockSize>* marking_stack_empty_blocks_;
+  intptr_t marking_stack_empty_length_;
   ApiLocalScope* api_reusable_scope_;
   ApiLocalScope* api_top_scope_;
   StackResource* top_resource_;
@@ -784,6 +802,8 @@ class Thread : public BaseThread {
   uint16_t deferred_interrupts_mask_;
   uint16_t deferred_interrupts_;
   int32_t stack_overflow_count_;
+  uword old_tlab_top_;
+  uword old_tlab_end_;
 
   // Compiler state:
   CHA* cha_;
@@ -857,6 +877,9 @@ class Thread : public BaseThread {
   friend class Simulator;
   friend class StackZone;
   friend class ThreadRegistry;
+  friend class Zone;
+  template <int>
+  friend class BlockStack;
   DISALLOW_COPY_AND_ASSIGN(Thread);
 };
 
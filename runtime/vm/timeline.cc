@@ -29,6 +29,10 @@ DEFINE_FLAG(
     systrace_timeline,
     false,
     "Record the timeline to the platform's tracing service if there is one");
+DEFINE_FLAG(bool,
+            timeline_thread_cpu_time,
+            true,
+            "Record thread CPU time for timeline duration events.");
 DEFINE_FLAG(bool, trace_timeline, false, "Trace timeline backend");
 DEFINE_FLAG(bool,
             trace_timeline_analysis,
@@ -306,6 +310,13 @@ void Timeline::Clear() {
   recorder->Clear();
 }
 
+int64_t Timeline::GetCurrentThreadCPUMicros() {
+  if (!FLAG_timeline_thread_cpu_time) {
+    return -1;
+  }
+  return OS::GetCurrentThreadCPUMicros();
+}
+
 void TimelineEventArguments::SetNumArguments(intptr_t length) {
   if (length == length_) {
     return;
@@ -854,7 +865,7 @@ TimelineDurationScope::TimelineDurationScope(TimelineStream* stream,
     return;
   }
   timestamp_ = OS::GetCurrentMonotonicMicros();
-  thread_timestamp_ = OS::GetCurrentThreadCPUMicros();
+  thread_timestamp_ = Timeline::GetCurrentThreadCPUMicros();
 }
 
 TimelineDurationScope::TimelineDurationScope(Thread* thread,
@@ -865,7 +876,7 @@ TimelineDurationScope::TimelineDurationScope(Thread* thread,
     return;
   }
   timestamp_ = OS::GetCurrentMonotonicMicros();
-  thread_timestamp_ = OS::GetCurrentThreadCPUMicros();
+  thread_timestamp_ = Timeline::GetCurrentThreadCPUMicros();
 }
 
 TimelineDurationScope::~TimelineDurationScope() {
@@ -883,7 +894,7 @@ TimelineDurationScope::~TimelineDurationScope() {
   ASSERT(event != NULL);
   // Emit a duration event.
   event->Duration(label(), timestamp_, OS::GetCurrentMonotonicMicros(),
-                  thread_timestamp_, OS::GetCurrentThreadCPUMicros());
+                  thread_timestamp_, Timeline::GetCurrentThreadCPUMicros());
   StealArguments(event);
   event->Complete();
 }
@@ -1633,7 +1644,7 @@ void DartTimelineEventHelpers::ReportCompleteEvent(Thread* thread,
                                                    char* name,
                                                    char* args) {
   const int64_t end = OS::GetCurrentMonotonicMicros();
-  const int64_t end_cpu = OS::GetCurrentThreadCPUMicros();
+  const int64_t end_cpu = Timeline::GetCurrentThreadCPUMicros();
   event->Duration(name, start, end, start_cpu, end_cpu);
   event->set_owns_label(true);
   event->CompleteWithPreSerializedArgs(args);
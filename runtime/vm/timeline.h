@@ -89,6 +89,10 @@ class Timeline : public AllStatic {
 
   static void Clear();
 
+  // Returns the current thread's CPU time in microseconds, or -1 if thread
+  // CPU time is not being recorded (--no-timeline_thread_cpu_time).
+  static int64_t GetCurrentThreadCPUMicros();
+
   // Print information about streams to JSON.
   static void PrintFlagsToJSON(JSONStream* json);
 
@@ -226,11 +230,13 @@ class TimelineEvent {
                 int64_t async_id,
                 int64_t micros = OS::GetCurrentMonotonicMicros());
 
-  void DurationBegin(const char* label,
-                     int64_t micros = OS::GetCurrentMonotonicMicros(),
-                     int64_t thread_micros = OS::GetCurrentThreadCPUMicros());
-  void DurationEnd(int64_t micros = OS::GetCurrentMonotonicMicros(),
-                   int64_t thread_micros = OS::GetCurrentThreadCPUMicros());
+  void DurationBegin(
+      const char* label,
+      int64_t micros = OS::GetCurrentMonotonicMicros(),
+      int64_t thread_micros = Timeline::GetCurrentThreadCPUMicros());
+  void DurationEnd(
+      int64_t micros = OS::GetCurrentMonotonicMicros(),
+      int64_t thread_micros = Timeline::GetCurrentThreadCPUMicros());
 
   void Instant(const char* label,
                int64_t micros = OS::GetCurrentMonotonicMicros());
@@ -243,11 +249,11 @@ class TimelineEvent {
 
   void Begin(const char* label,
              int64_t micros = OS::GetCurrentMonotonicMicros(),
-             int64_t thread_micros = OS::GetCurrentThreadCPUMicros());
+             int64_t thread_micros = Timeline::GetCurrentThreadCPUMicros());
 
   void End(const char* label,
            int64_t micros = OS::GetCurrentMonotonicMicros(),
-           int64_t thread_micros = OS::GetCurrentThreadCPUMicros());
+           int64_t thread_micros = Timeline::GetCurrentThreadCPUMicros());
 
   void Counter(const char* label,
                int64_t micros = OS::GetCurrentMonotonicMicros());
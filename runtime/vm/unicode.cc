@@ -40,6 +40,33 @@ const uint32_t Utf8::kOverlongMinimum[7] = {0,  // Padding.
                                             0x0,     0x80,       0x800,
                                             0x10000, 0xFFFFFFFF, 0xFFFFFFFF};
 
+// A constant mask that can be 'and'ed with a word of data to determine if it
+// is all ASCII (with no Latin1 characters).
+#if defined(ARCH_IS_64_BIT)
+static const uintptr_t kAsciiWordMask = DART_UINT64_C(0x8080808080808080);
+#else
+static const uintptr_t kAsciiWordMask = 0x80808080u;
+#endif
+
+// Returns the length of the run of ASCII bytes at the start of 'utf8_array'.
+// The input is scanned two words at a time, so typical mostly-ASCII text such
+// as JSON is skipped over without decoding it one byte at a time.
+static intptr_t AsciiPrefixLength(const uint8_t* utf8_array,
+                                  intptr_t array_len) {
+  const intptr_t kWordSize = sizeof(uintptr_t);
+  intptr_t i = 0;
+  for (; i + 2 * kWordSize <= array_len; i += 2 * kWordSize) {
+    const uintptr_t* p = reinterpret_cast<const uintptr_t*>(utf8_array + i);
+    if (((ReadUnaligned(p) | ReadUnaligned(p + 1)) & kAsciiWordMask) != 0) {
+      break;
+    }
+  }
+  while ((i < array_len) && (utf8_array[i] < 0x80)) {
+    i++;
+  }
+  return i;
+}
+
 // Returns the most restricted coding form in which the sequence of utf8
 // characters in 'utf8_array' can be represented in, and the number of
 // code units needed in that form.
@@ -50,6 +77,13 @@ intptr_t Utf8::CodeUnitCount(const uint8_t* utf8_array,
   Type char_type = kLatin1;
   for (intptr_t i = 0; i < array_len; i++) {
     uint8_t code_unit = utf8_array[i];
+    if (code_unit < 0x80) {
+      const intptr_t ascii_len =
+          AsciiPrefixLength(&utf8_array[i], array_len - i);
+      len += ascii_len;
+      i += ascii_len - 1;
+      continue;
+    }
     if (!IsTrailByte(code_unit)) {
       ++len;
       if (!IsLatin1SequenceStart(code_unit)) {          // > U+00FF
@@ -71,25 +105,27 @@ bool Utf8::IsValid(const uint8_t* utf8_array, intptr_t array_len) {
   intptr_t i = 0;
   while (i < array_len) {
     uint32_t ch = utf8_array[i] & 0xFF;
+    if (ch < 0x80) {
+      i += AsciiPrefixLength(&utf8_array[i], array_len - i);
+      continue;
+    }
     intptr_t j = 1;
-    if (ch >= 0x80) {
-      int8_t num_trail_bytes = kTrailBytes[ch];
-      bool is_malformed = false;
-      for (; j < num_trail_bytes; ++j) {
-        if ((i + j) < array_len) {
-          uint8_t code_unit = utf8_array[i + j];
-          is_malformed |= !IsTrailByte(code_unit);
-          ch = (ch << 6) + code_unit;
-        } else {
-          return false;
-        }
-      }
-      ch -= kMagicBits[num_trail_bytes];
-      if (!((is_malformed == false) && (j == num_trail_bytes) &&
-            !Utf::IsOutOfRange(ch) && !IsNonShortestForm(ch, j))) {
+    int8_t num_trail_bytes = kTrailBytes[ch];
+    bool is_malformed = false;
+    for (; j < num_trail_bytes; ++j) {
+      if ((i + j) < array_len) {
+        uint8_t code_unit = utf8_array[i + j];
+        is_malformed |= !IsTrailByte(code_unit);
+        ch = (ch << 6) + code_unit;
+      } else {
         return false;
       }
     }
+    ch -= kMagicBits[num_trail_bytes];
+    if (!((is_malformed == false) && (j == num_trail_bytes) &&
+          !Utf::IsOutOfRange(ch) && !IsNonShortestForm(ch, j))) {
+      return false;
+    }
     i += j;
   }
   return true;
@@ -107,14 +143,6 @@ intptr_t Utf8::Length(int32_t ch) {
   return 4;
 }
 
-// A constant mask that can be 'and'ed with a word of data to determine if it
-// is all ASCII (with no Latin1 characters).
-#if defined(ARCH_IS_64_BIT)
-static const uintptr_t kAsciiWordMask = DART_UINT64_C(0x8080808080808080);
-#else
-static const uintptr_t kAsciiWordMask = 0x80808080u;
-#endif
-
 intptr_t Utf8::Length(const String& str) {
   if (str.IsOneByteString() || str.IsExternalOneByteString()) {
     // For 1-byte strings, all code points < 0x80 have single-byte UTF-8
@@ -289,6 +317,15 @@ bool Utf8::DecodeToLatin1(const uint8_t* utf8_array,
   intptr_t j = 0;
   intptr_t num_bytes;
   for (; (i < array_len) && (j < len); i += num_bytes, ++j) {
+    if (utf8_array[i] < 0x80) {
+      const intptr_t ascii_len = Utils::Minimum(
+          AsciiPrefixLength(&utf8_array[i], array_len - i), len - j);
+      memmove(&dst[j], &utf8_array[i], ascii_len);
+      num_bytes = 1;
+      i += ascii_len - 1;
+      j += ascii_len - 1;
+      continue;
+    }
     int32_t ch;
     ASSERT(IsLatin1SequenceStart(utf8_array[i]));
     num_bytes = Utf8::Decode(&utf8_array[i], (array_len - i), &ch);
@@ -312,6 +349,17 @@ bool Utf8::DecodeToUTF16(const uint8_t* utf8_array,
   intptr_t j = 0;
   intptr_t num_bytes;
   for (; (i < array_len) && (j < len); i += num_bytes, ++j) {
+    if (utf8_array[i] < 0x80) {
+      const intptr_t ascii_len = Utils::Minimum(
+          AsciiPrefixLength(&utf8_array[i], array_len - i), len - j);
+      for (intptr_t k = 0; k < ascii_len; k++) {
+        dst[j + k] = utf8_array[i + k];
+      }
+      num_bytes = 1;
+      i += ascii_len - 1;
+      j += ascii_len - 1;
+      continue;
+    }
     int32_t ch;
     bool is_supplementary = IsSupplementarySequenceStart(utf8_array[i]);
     num_bytes = Utf8::Decode(&utf8_array[i], (array_len - i), &ch);
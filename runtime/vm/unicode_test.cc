@@ -1056,4 +1056,34 @@ TEST_CASE(Utf8Decode) {
   }
 }
 
+TEST_CASE(Utf8DecodeAsciiRuns) {
+  // Long ASCII runs are skipped a word at a time; make sure the characters
+  // around them are still counted and decoded.
+  const char* src =
+      "{\"name\": \"abcdefghijklmnopqrstuvwxyz\", \"city\": \"Z\xC3\xBCrich\"}";
+  const uint8_t* utf8 = reinterpret_cast<const uint8_t*>(src);
+  const intptr_t utf8_len = strlen(src);
+  EXPECT(Utf8::IsValid(utf8, utf8_len));
+  Utf8::Type type;
+  const intptr_t len = Utf8::CodeUnitCount(utf8, utf8_len, &type);
+  EXPECT_EQ(utf8_len - 1, len);
+  EXPECT_EQ(Utf8::kLatin1, type);
+  uint8_t latin1[64];
+  EXPECT(Utf8::DecodeToLatin1(utf8, utf8_len, latin1, len));
+  EXPECT_EQ('{', latin1[0]);
+  EXPECT_EQ('z', latin1[35]);
+  EXPECT_EQ(0xFC, latin1[len - 7]);
+  EXPECT_EQ('}', latin1[len - 1]);
+  uint16_t utf16[64];
+  EXPECT(Utf8::DecodeToUTF16(utf8, utf8_len, utf16, len));
+  for (intptr_t i = 0; i < len; i++) {
+    EXPECT_EQ(latin1[i], utf16[i]);
+  }
+
+  // A truncated sequence after an ASCII run is still rejected.
+  const char* invalid = "abcdefghijklmnopqrstuvwxyz\xC3";
+  EXPECT(!Utf8::IsValid(reinterpret_cast<const uint8_t*>(invalid),
+                        strlen(invalid)));
+}
+
 }  // namespace dart
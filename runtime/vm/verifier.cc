@@ -57,6 +57,10 @@ void VerifyPointersVisitor::VisitPointers(RawObject** first, RawObject** last) {
   }
 }
 
+void VerifyObjectPointersVisitor::VisitObject(RawObject* obj) {
+  obj->VisitPointers(&pointer_visitor_);
+}
+
 void VerifyWeakPointersVisitor::VisitHandle(uword addr) {
   FinalizablePersistentHandle* handle =
       reinterpret_cast<FinalizablePersistentHandle*>(addr);
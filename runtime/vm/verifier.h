@@ -55,6 +55,21 @@ class VerifyPointersVisitor : public ObjectPointerVisitor {
   DISALLOW_COPY_AND_ASSIGN(VerifyPointersVisitor);
 };
 
+// Verifies the pointers of each visited heap object, so that the heap can be
+// checked with one of these per task of Heap::VisitObjectsParallel.
+class VerifyObjectPointersVisitor : public ObjectVisitor {
+ public:
+  VerifyObjectPointersVisitor(Isolate* isolate, ObjectSet* allocated_set)
+      : pointer_visitor_(isolate, allocated_set) {}
+
+  virtual void VisitObject(RawObject* obj);
+
+ private:
+  VerifyPointersVisitor pointer_visitor_;
+
+  DISALLOW_COPY_AND_ASSIGN(VerifyObjectPointersVisitor);
+};
+
 class VerifyWeakPointersVisitor : public HandleVisitor {
  public:
   explicit VerifyWeakPointersVisitor(VerifyPointersVisitor* visitor)
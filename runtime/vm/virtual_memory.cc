@@ -6,9 +6,33 @@
 
 #include "platform/assert.h"
 #include "platform/utils.h"
+#include "vm/flags.h"
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            use_huge_pages,
+            false,
+            "Ask the OS to back new-space semi-spaces and large old-space "
+            "pages with transparent huge pages.");
+
+VirtualMemory* VirtualMemory::AllocateHeap(intptr_t size,
+                                           intptr_t alignment,
+                                           bool is_executable,
+                                           const char* name) {
+  if (FLAG_use_huge_pages && !is_executable && (size >= kHugePageSize)) {
+    VirtualMemory* memory = AllocateAligned(
+        size, Utils::Maximum(alignment, kHugePageSize), is_executable, name);
+    if (memory != NULL) {
+      memory->huge_page_bytes_ =
+          AdviseHugePages(memory->address(), memory->size());
+      return memory;
+    }
+    // Retry without the extra alignment.
+  }
+  return AllocateAligned(size, alignment, is_executable, name);
+}
+
 bool VirtualMemory::InSamePage(uword address0, uword address1) {
   return (Utils::RoundDown(address0, PageSize()) ==
           Utils::RoundDown(address1, PageSize()));
@@ -25,6 +49,8 @@ void VirtualMemory::Truncate(intptr_t new_size, bool try_unmap) {
     reserved_.set_size(new_size);
   }
   region_.Subregion(region_, 0, new_size);
+  huge_page_bytes_ = Utils::Minimum(
+      huge_page_bytes_, Utils::RoundDown(new_size, kHugePageSize));
 }
 
 VirtualMemory* VirtualMemory::ForImagePage(void* pointer, uword size) {
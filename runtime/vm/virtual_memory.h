@@ -47,6 +47,20 @@ class VirtualMemory {
                                         bool is_executable,
                                         const char* name);
 
+  // Like AllocateAligned, for the heap. With --use_huge_pages, a
+  // non-executable segment of at least kHugePageSize is aligned to it and
+  // the OS is asked to back it with transparent huge pages.
+  static VirtualMemory* AllocateHeap(intptr_t size,
+                                     intptr_t alignment,
+                                     bool is_executable,
+                                     const char* name);
+
+  static const intptr_t kHugePageSize = 2 * MB;
+
+  // The number of bytes of this segment that the OS was asked to back with
+  // huge pages.
+  intptr_t huge_page_bytes() const { return huge_page_bytes_; }
+
   static intptr_t PageSize() {
     ASSERT(page_size_ != 0);
     ASSERT(Utils::IsPowerOfTwo(page_size_));
@@ -55,6 +69,16 @@ class VirtualMemory {
 
   static bool InSamePage(uword address0, uword address1);
 
+  // Tells the OS that the contents of the page aligned range are no longer
+  // needed, so that the backing memory can be reclaimed. The range stays
+  // accessible, but its contents become unspecified.
+  static void DontNeed(void* address, intptr_t size);
+
+  // Asks the OS to back the kHugePageSize aligned part of the range with huge
+  // pages. Returns the number of bytes covered, which is zero where this is
+  // not supported.
+  static intptr_t AdviseHugePages(void* address, intptr_t size);
+
   // Truncate this virtual memory segment. If try_unmap is false, the
   // memory beyond the new end is still accessible, but will be returned
   // upon destruction.
@@ -76,7 +100,7 @@ class VirtualMemory {
   // It does not reserve any virtual address space on its own.
   VirtualMemory(const MemoryRegion& region,
                 const MemoryRegion& reserved)
-      : region_(region), reserved_(reserved) {}
+      : region_(region), reserved_(reserved), huge_page_bytes_(0) {}
 
   MemoryRegion region_;
 
@@ -85,6 +109,8 @@ class VirtualMemory {
   // Its size might disagree with region_ due to Truncate.
   MemoryRegion reserved_;
 
+  intptr_t huge_page_bytes_;
+
   static uword page_size_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(VirtualMemory);
@@ -155,6 +155,16 @@ bool VirtualMemory::FreeSubSegment(void* address, intptr_t size) {
   return true;
 }
 
+void VirtualMemory::DontNeed(void* address, intptr_t size) {
+  // Decommitting requires the VMO, whose handle is closed once it is mapped.
+  // The pages stay committed.
+}
+
+intptr_t VirtualMemory::AdviseHugePages(void* address, intptr_t size) {
+  // Not supported.
+  return 0;
+}
+
 void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
   ASSERT(Thread::Current()->IsMutatorThread() ||
          Isolate::Current()->mutator_thread()->IsAtSafepoint());
@@ -103,6 +103,31 @@ bool VirtualMemory::FreeSubSegment(void* address,
   return true;
 }
 
+void VirtualMemory::DontNeed(void* address, intptr_t size) {
+  ASSERT(Utils::IsAligned(reinterpret_cast<uword>(address), PageSize()));
+  ASSERT(Utils::IsAligned(size, PageSize()));
+  // This is only a hint, so failure is not an error.
+  madvise(address, size, MADV_DONTNEED);
+}
+
+intptr_t VirtualMemory::AdviseHugePages(void* address, intptr_t size) {
+#if defined(MADV_HUGEPAGE)
+  const uword start =
+      Utils::RoundUp(reinterpret_cast<uword>(address), kHugePageSize);
+  const uword end =
+      Utils::RoundDown(reinterpret_cast<uword>(address) + size, kHugePageSize);
+  if ((start >= end) ||
+      (madvise(reinterpret_cast<void*>(start), end - start, MADV_HUGEPAGE) !=
+       0)) {
+    // Not supported by this kernel; this is only a hint.
+    return 0;
+  }
+  return end - start;
+#else
+  return 0;
+#endif
+}
+
 void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
   ASSERT(Thread::Current()->IsMutatorThread() ||
          Isolate::Current()->mutator_thread()->IsAtSafepoint());
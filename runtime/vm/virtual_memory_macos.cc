@@ -103,6 +103,18 @@ bool VirtualMemory::FreeSubSegment(void* address,
   return true;
 }
 
+void VirtualMemory::DontNeed(void* address, intptr_t size) {
+  ASSERT(Utils::IsAligned(reinterpret_cast<uword>(address), PageSize()));
+  ASSERT(Utils::IsAligned(size, PageSize()));
+  // This is only a hint, so failure is not an error.
+  madvise(address, size, MADV_FREE);
+}
+
+intptr_t VirtualMemory::AdviseHugePages(void* address, intptr_t size) {
+  // There are no transparent huge pages to ask for.
+  return 0;
+}
+
 void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
   ASSERT(Thread::Current()->IsMutatorThread() ||
          Isolate::Current()->mutator_thread()->IsAtSafepoint());
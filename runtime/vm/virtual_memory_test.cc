@@ -9,6 +9,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, use_huge_pages);
+
 bool IsZero(char* begin, char* end) {
   for (char* current = begin; current < end; ++current) {
     if (*current != 0) {
@@ -100,4 +102,46 @@ VM_UNIT_TEST_CASE(FreeVirtualMemory) {
   }
 }
 
+VM_UNIT_TEST_CASE(DontNeedVirtualMemory) {
+  const intptr_t kVirtualMemoryBlockSize = 64 * KB;
+  VirtualMemory* vm =
+      VirtualMemory::Allocate(kVirtualMemoryBlockSize, false, NULL);
+  char* buf = reinterpret_cast<char*>(vm->address());
+  memset(buf, 'x', vm->size());
+  const intptr_t page_size = VirtualMemory::PageSize();
+  VirtualMemory::DontNeed(buf + page_size, vm->size() - 2 * page_size);
+  // The pages around the released range keep their contents, and the
+  // released range can be used again.
+  EXPECT_EQ('x', buf[page_size - 1]);
+  EXPECT_EQ('x', buf[vm->size() - page_size]);
+  buf[page_size] = 'y';
+  EXPECT_EQ('y', buf[page_size]);
+  delete vm;
+}
+
+VM_UNIT_TEST_CASE(AllocateHeapHugePages) {
+  const bool saved_use_huge_pages = FLAG_use_huge_pages;
+  FLAG_use_huge_pages = true;
+  const intptr_t kHugePageSize = VirtualMemory::kHugePageSize;
+  VirtualMemory* vm =
+      VirtualMemory::AllocateHeap(2 * kHugePageSize, 64 * KB, false, NULL);
+  EXPECT(vm != NULL);
+  EXPECT(Utils::IsAligned(vm->start(), kHugePageSize));
+  // Zero where the OS does not support huge pages.
+  const intptr_t huge_page_bytes = vm->huge_page_bytes();
+  EXPECT((huge_page_bytes == 0) || (huge_page_bytes == vm->size()));
+  char* buf = reinterpret_cast<char*>(vm->address());
+  buf[vm->size() - 1] = 'x';
+  EXPECT_EQ('x', buf[vm->size() - 1]);
+  vm->Truncate(kHugePageSize + 64 * KB);
+  EXPECT_LE(vm->huge_page_bytes(), kHugePageSize);
+  delete vm;
+
+  // Smaller segments are left alone.
+  vm = VirtualMemory::AllocateHeap(64 * KB, 64 * KB, false, NULL);
+  EXPECT_EQ(0, vm->huge_page_bytes());
+  delete vm;
+  FLAG_use_huge_pages = saved_use_huge_pages;
+}
+
 }  // namespace dart
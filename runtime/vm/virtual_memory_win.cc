@@ -78,6 +78,18 @@ bool VirtualMemory::FreeSubSegment(void* address,
   return false;
 }
 
+void VirtualMemory::DontNeed(void* address, intptr_t size) {
+  ASSERT(Utils::IsAligned(reinterpret_cast<uword>(address), PageSize()));
+  ASSERT(Utils::IsAligned(size, PageSize()));
+  // This is only a hint, so failure is not an error.
+  VirtualAlloc(address, size, MEM_RESET, PAGE_READWRITE);
+}
+
+intptr_t VirtualMemory::AdviseHugePages(void* address, intptr_t size) {
+  // Large pages need a privilege and must be committed at allocation.
+  return 0;
+}
+
 void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
   ASSERT(Thread::Current()->IsMutatorThread() ||
          Isolate::Current()->mutator_thread()->IsAtSafepoint());
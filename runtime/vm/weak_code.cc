@@ -72,14 +72,21 @@ void WeakCodeReferences::DisableCode() {
   // Disable all code on stack.
   Code& code = Code::Handle();
   {
+    // Deep recursion leaves runs of frames executing the same code. Only
+    // search the dependent code list once per run and report each
+    // invalidated code object once rather than once per frame.
+    Code& last_deoptimized = Code::Handle();
     DartFrameIterator iterator(thread,
                                StackFrameIterator::kNoCrossThreadIteration);
     StackFrame* frame = iterator.NextFrame();
     while (frame != NULL) {
       code = frame->LookupDartCode();
-      if (IsOptimizedCode(code_objects, code)) {
+      if (code.raw() == last_deoptimized.raw()) {
+        DeoptimizeAt(code, frame);
+      } else if (IsOptimizedCode(code_objects, code)) {
         ReportDeoptimization(code);
         DeoptimizeAt(code, frame);
+        last_deoptimized = code.raw();
       }
       frame = iterator.NextFrame();
     }
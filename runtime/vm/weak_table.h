@@ -8,6 +8,7 @@
 #include "vm/globals.h"
 
 #include "platform/assert.h"
+#include "vm/atomic.h"
 #include "vm/raw_object.h"
 
 namespace dart {
@@ -59,6 +60,19 @@ class WeakTable {
     SetValueAt(i, 0);
   }
 
+  // Like InvalidateAt, but leaves count() alone, so that disjoint ranges of
+  // the table can be processed by several threads at the same time. Each
+  // thread reports the number of entries it invalidated with DecrementCount.
+  void InvalidateAtConcurrently(intptr_t i) {
+    ASSERT(IsValidEntryAt(i));
+    data_[ObjectIndex(i)] = kDeletedEntry;
+    data_[ValueIndex(i)] = 0;
+  }
+
+  void DecrementCount(intptr_t delta) {
+    AtomicOperations::IncrementBy(&count_, -delta);
+  }
+
   RawObject* ObjectAt(intptr_t i) const {
     ASSERT(i >= 0);
     ASSERT(i < size());
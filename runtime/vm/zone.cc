@@ -11,12 +11,16 @@
 #include "vm/handles_impl.h"
 #include "vm/heap.h"
 #include "vm/os.h"
+#include "vm/virtual_memory.h"
 
 namespace dart {
 
 // Zone segments represent chunks of memory: They have starting
 // address encoded in the this pointer and a size in bytes. They are
 // chained together to form the backing storage for an expanding zone.
+// Segments of the default size are malloced and, when freed, kept in a
+// small per-thread cache for the next zone. Larger segments are mapped
+// directly from the OS.
 class Zone::Segment {
  public:
   Segment* next() const { return next_; }
@@ -26,28 +30,59 @@ class Zone::Segment {
   uword end() { return address(size_); }
 
   // Allocate or delete individual segments.
-  static Segment* New(intptr_t size, Segment* next);
-  static void DeleteSegmentList(Segment* segment);
+  static Segment* New(intptr_t size, Segment* next, Owner owner);
+  static void DeleteSegmentList(Segment* segment, Owner owner);
   static void IncrementMemoryCapacity(uintptr_t size);
   static void DecrementMemoryCapacity(uintptr_t size);
 
+  static void ReleaseCache(Thread* thread);
+
  private:
   Segment* next_;
   intptr_t size_;
+  // The mapping backing a large segment; NULL for malloced segments.
+  VirtualMemory* memory_;
+#if defined(ARCH_IS_32_BIT)
+  // Keeps start() aligned to kAlignment.
+  intptr_t padding_;
+#endif
 
   // Computes the address of the nth byte in this segment.
   uword address(int n) { return reinterpret_cast<uword>(this) + n; }
 
-  static void Delete(Segment* segment) { free(segment); }
+  static Segment* TryAllocateFromCache(Thread* thread);
+  static bool TryAddToCache(Thread* thread, Segment* segment);
+  static void Delete(Segment* segment);
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(Segment);
 };
 
-Zone::Segment* Zone::Segment::New(intptr_t size, Zone::Segment* next) {
+intptr_t Zone::owner_capacity_in_bytes_[Zone::kNumOwners] = {0};
+
+Zone::Segment* Zone::Segment::New(intptr_t size,
+                                  Zone::Segment* next,
+                                  Owner owner) {
+  COMPILE_ASSERT((sizeof(Segment) % kAlignment) == 0);
   ASSERT(size >= 0);
-  Segment* result = reinterpret_cast<Segment*>(malloc(size));
-  if (result == NULL) {
-    OUT_OF_MEMORY();
+  Segment* result = NULL;
+  VirtualMemory* memory = NULL;
+  if (size > kSegmentSize) {
+    size = Utils::RoundUp(size, VirtualMemory::PageSize());
+    memory = VirtualMemory::Allocate(size, false, "dart-zone");
+    if (memory == NULL) {
+      OUT_OF_MEMORY();
+    }
+    result = reinterpret_cast<Segment*>(memory->address());
+  } else {
+    if (size == kSegmentSize) {
+      result = TryAllocateFromCache(Thread::Current());
+    }
+    if (result == NULL) {
+      result = reinterpret_cast<Segment*>(malloc(size));
+      if (result == NULL) {
+        OUT_OF_MEMORY();
+      }
+    }
   }
   ASSERT(Utils::IsAligned(result->start(), Zone::kAlignment));
 #ifdef DEBUG
@@ -56,22 +91,75 @@ Zone::Segment* Zone::Segment::New(intptr_t size, Zone::Segment* next) {
 #endif
   result->next_ = next;
   result->size_ = size;
+  result->memory_ = memory;
   IncrementMemoryCapacity(size);
+  AtomicOperations::IncrementBy(&owner_capacity_in_bytes_[owner], size);
   return result;
 }
 
-void Zone::Segment::DeleteSegmentList(Segment* head) {
+void Zone::Segment::DeleteSegmentList(Segment* head, Owner owner) {
+  Thread* thread = Thread::Current();
   Segment* current = head;
   while (current != NULL) {
     DecrementMemoryCapacity(current->size());
+    AtomicOperations::DecrementBy(&owner_capacity_in_bytes_[owner],
+                                  current->size());
     Segment* next = current->next();
 #ifdef DEBUG
-    // Zap the entire current segment (including the header).
-    memset(current, kZapDeletedByte, current->size());
+    // Zap the contents of the current segment, but not the header, which
+    // TryAddToCache and Delete still read.
+    memset(reinterpret_cast<void*>(current->start()), kZapDeletedByte,
+           current->end() - current->start());
 #endif
+    if (!TryAddToCache(thread, current)) {
+      Segment::Delete(current);
+    }
+    current = next;
+  }
+}
+
+Zone::Segment* Zone::Segment::TryAllocateFromCache(Thread* thread) {
+  if ((thread == NULL) || (thread->zone_segment_cache_ == NULL)) {
+    return NULL;
+  }
+  Segment* result = reinterpret_cast<Segment*>(thread->zone_segment_cache_);
+  thread->zone_segment_cache_ = result->next_;
+  thread->zone_segment_cache_length_--;
+  ASSERT(thread->zone_segment_cache_length_ >= 0);
+  return result;
+}
+
+bool Zone::Segment::TryAddToCache(Thread* thread, Segment* segment) {
+  if ((thread == NULL) || (segment->memory_ != NULL) ||
+      (segment->size_ != kSegmentSize) ||
+      (thread->zone_segment_cache_length_ >= kMaxCachedSegments)) {
+    return false;
+  }
+  segment->next_ = reinterpret_cast<Segment*>(thread->zone_segment_cache_);
+  thread->zone_segment_cache_ = segment;
+  thread->zone_segment_cache_length_++;
+  return true;
+}
+
+void Zone::Segment::ReleaseCache(Thread* thread) {
+  Segment* current = reinterpret_cast<Segment*>(thread->zone_segment_cache_);
+  while (current != NULL) {
+    Segment* next = current->next_;
     Segment::Delete(current);
     current = next;
   }
+  thread->zone_segment_cache_ = NULL;
+  thread->zone_segment_cache_length_ = 0;
+}
+
+void Zone::Segment::Delete(Segment* segment) {
+  VirtualMemory* memory = segment->memory_;
+  if (memory != NULL) {
+    // Unmaps the segment itself.
+    delete memory;
+  } else {
+    free(segment);
+  }
 }
 
 void Zone::Segment::IncrementMemoryCapacity(uintptr_t size) {
@@ -97,14 +185,15 @@ void Zone::Segment::DecrementMemoryCapacity(uintptr_t size) {
 // TODO(bkonyi): We need to account for the initial chunk size when a new zone
 // is created within a new thread or ApiNativeScope when calculating high
 // watermarks or memory consumption.
-Zone::Zone()
+Zone::Zone(Owner owner)
     : initial_buffer_(buffer_, kInitialChunkSize),
       position_(initial_buffer_.start()),
       limit_(initial_buffer_.end()),
       head_(NULL),
       large_segments_(NULL),
       handles_(),
-      previous_(NULL) {
+      previous_(NULL),
+      owner_(owner) {
   ASSERT(Utils::IsAligned(position_, kAlignment));
   Segment::IncrementMemoryCapacity(kInitialChunkSize);
 #ifdef DEBUG
@@ -126,10 +215,10 @@ void Zone::DeleteAll() {
   // Traverse the chained list of segments, zapping (in debug mode)
   // and freeing every zone segment.
   if (head_ != NULL) {
-    Segment::DeleteSegmentList(head_);
+    Segment::DeleteSegmentList(head_, owner_);
   }
   if (large_segments_ != NULL) {
-    Segment::DeleteSegmentList(large_segments_);
+    Segment::DeleteSegmentList(large_segments_, owner_);
   }
 // Reset zone state.
 #ifdef DEBUG
@@ -143,6 +232,15 @@ void Zone::DeleteAll() {
   handles_.Reset();
 }
 
+intptr_t Zone::CapacityInBytesForOwner(Owner owner) {
+  ASSERT((owner >= 0) && (owner < kNumOwners));
+  return AtomicOperations::LoadRelaxed(&owner_capacity_in_bytes_[owner]);
+}
+
+void Zone::ReleaseSegmentCache(Thread* thread) {
+  Segment::ReleaseCache(thread);
+}
+
 uintptr_t Zone::SizeInBytes() const {
   uintptr_t size = 0;
   for (Segment* s = large_segments_; s != NULL; s = s->next()) {
@@ -195,7 +293,7 @@ uword Zone::AllocateExpand(intptr_t size) {
   }
 
   // Allocate another segment and chain it up.
-  head_ = Segment::New(kSegmentSize, head_);
+  head_ = Segment::New(kSegmentSize, head_, owner_);
 
   // Recompute 'position' and 'limit' based on the new head segment.
   uword result = Utils::RoundUp(head_->start(), kAlignment);
@@ -216,7 +314,7 @@ uword Zone::AllocateLargeSegment(intptr_t size) {
   // Create a new large segment and chain it up.
   ASSERT(Utils::IsAligned(sizeof(Segment), kAlignment));
   size += sizeof(Segment);  // Account for book keeping fields in size.
-  large_segments_ = Segment::New(size, large_segments_);
+  large_segments_ = Segment::New(size, large_segments_, owner_);
 
   uword result = Utils::RoundUp(large_segments_->start(), kAlignment);
   return result;
@@ -288,7 +386,8 @@ char* Zone::VPrint(const char* format, va_list args) {
   return OS::VSCreate(this, format, args);
 }
 
-StackZone::StackZone(Thread* thread) : StackResource(thread), zone_() {
+StackZone::StackZone(Thread* thread, Zone::Owner owner)
+    : StackResource(thread), zone_(owner) {
   if (FLAG_trace_zones) {
     OS::PrintErr("*** Starting a new Stack zone 0x%" Px "(0x%" Px ")\n",
                  reinterpret_cast<intptr_t>(this),
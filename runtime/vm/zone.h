@@ -20,6 +20,15 @@ namespace dart {
 
 class Zone {
  public:
+  // The subsystem a zone's memory is attributed to.
+  enum Owner {
+    kOtherOwner,
+    kCompilerOwner,
+    kApiScopeOwner,
+    kServiceOwner,
+    kNumOwners,
+  };
+
   // Allocate an array sized to hold 'len' elements of type
   // 'ElementType'.  Checks for integer overflow when performing the
   // size computation.
@@ -75,8 +84,16 @@ class Zone {
 
   Zone* previous() const { return previous_; }
 
+  Owner owner() const { return owner_; }
+
+  // The number of bytes held in segments by all zones of the given owner.
+  static intptr_t CapacityInBytesForOwner(Owner owner);
+
+  // Frees the segments cached for reuse by zones on 'thread'.
+  static void ReleaseSegmentCache(Thread* thread);
+
  private:
-  Zone();
+  explicit Zone(Owner owner = kOtherOwner);
   ~Zone();  // Delete all memory associated with the zone.
 
   // All pointers returned from AllocateUnsafe() and New() have this alignment.
@@ -88,6 +105,9 @@ class Zone {
   // Default segment size.
   static const intptr_t kSegmentSize = 64 * KB;
 
+  // Maximum number of freed default-sized segments kept per thread.
+  static const intptr_t kMaxCachedSegments = 4;
+
   // Zap value used to indicate deleted zone area (debug purposes).
   static const unsigned char kZapDeletedByte = 0x42;
 
@@ -155,6 +175,10 @@ class Zone {
   // Used for chaining zones in order to allow unwinding of stacks.
   Zone* previous_;
 
+  Owner owner_;
+
+  static intptr_t owner_capacity_in_bytes_[kNumOwners];
+
   friend class StackZone;
   friend class ApiZone;
   template <typename T, typename B, typename Allocator>
@@ -167,7 +191,7 @@ class Zone {
 class StackZone : public StackResource {
  public:
   // Create an empty zone and set is at the current zone for the Thread.
-  explicit StackZone(Thread* thread);
+  explicit StackZone(Thread* thread, Zone::Owner owner = Zone::kOtherOwner);
 
   // Delete all memory associated with the zone.
   ~StackZone();
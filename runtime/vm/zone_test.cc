@@ -155,6 +155,35 @@ VM_UNIT_TEST_CASE(ZoneAllocated) {
   Dart_ShutdownIsolate();
 }
 
+VM_UNIT_TEST_CASE(ZoneSegmentReuseAndOwnerCapacity) {
+  TestCase::CreateTestIsolate();
+  Thread* thread = Thread::Current();
+  const intptr_t kSegmentSize = 64 * KB;
+  const intptr_t before = Zone::CapacityInBytesForOwner(Zone::kCompilerOwner);
+  uword first = 0;
+  {
+    StackZone stack_zone(thread, Zone::kCompilerOwner);
+    Zone* zone = stack_zone.GetZone();
+    EXPECT_EQ(Zone::kCompilerOwner, zone->owner());
+    // Overflows the initial buffer into a new segment.
+    first = zone->AllocUnsafe(2 * KB);
+    EXPECT_EQ(before + kSegmentSize,
+              Zone::CapacityInBytesForOwner(Zone::kCompilerOwner));
+    // Large segments are attributed to the owner as well.
+    EXPECT(zone->AllocUnsafe(1 * MB) != 0);
+    EXPECT_LE(before + kSegmentSize + 1 * MB,
+              Zone::CapacityInBytesForOwner(Zone::kCompilerOwner));
+  }
+  EXPECT_EQ(before, Zone::CapacityInBytesForOwner(Zone::kCompilerOwner));
+  {
+    // The next zone on this thread reuses the cached segment.
+    StackZone stack_zone(thread);
+    EXPECT_EQ(first, stack_zone.GetZone()->AllocUnsafe(2 * KB));
+  }
+  Zone::ReleaseSegmentCache(thread);
+  Dart_ShutdownIsolate();
+}
+
 TEST_CASE(PrintToString) {
   StackZone zone(Thread::Current());
   const char* result = zone.GetZone()->PrintToString("Hello %s!", "World");
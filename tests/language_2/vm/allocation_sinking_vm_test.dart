@@ -271,6 +271,27 @@ testCompound4() {
       }));
 }
 
+testCapturedInContext() {
+  f(d, [sink = const NoopSink()]) {
+    var c = new CompoundC(d);
+    g() => c;
+    sink(g);
+    return c.d;
+  }
+
+  Expect.equals(0.1, f(0.1));
+  for (var i = 0; i < 100; i++) f(0.1);
+  Expect.equals(0.1, f(0.1));
+  Expect.equals(
+      0.1,
+      f(0.1, (val) {
+        Expect.isTrue(val is Function);
+        Expect.isTrue(val() is CompoundC);
+        Expect.identical(val(), val());
+        Expect.equals(0.1, val().d);
+      }));
+}
+
 main() {
   var c = new C(new Point(0.1, 0.2));
 
@@ -336,4 +357,5 @@ main() {
   testCompound2();
   testCompound3();
   testCompound4();
+  testCapturedInContext();
 }
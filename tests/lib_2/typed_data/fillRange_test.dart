@@ -0,0 +1,47 @@
+// Copyright (c) 2018, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import 'dart:typed_data';
+import 'package:expect/expect.dart';
+
+void checkFill(List list, int start, int end, fillValue, expected) {
+  final before = new List.from(list);
+  list.fillRange(start, end, fillValue);
+  for (int i = 0; i < list.length; i++) {
+    if (start <= i && i < end) {
+      Expect.equals(expected, list[i], "index $i");
+    } else {
+      Expect.equals(before[i], list[i], "index $i");
+    }
+  }
+}
+
+void testLengths(List makeList(int length), fillValue, expected) {
+  for (int length = 0; length < 40; length++) {
+    for (int start = 0; start <= length; start += 3) {
+      checkFill(makeList(length), start, length, fillValue, expected);
+      checkFill(makeList(length), 0, length - start, fillValue, expected);
+    }
+  }
+}
+
+main() {
+  testLengths((n) => new Uint8List(n), 0x1ff, 0xff);
+  testLengths((n) => new Uint8ClampedList(n), 300, 255);
+  testLengths((n) => new Int16List(n), -2, -2);
+  testLengths((n) => new Uint32List(n), 0x12345678, 0x12345678);
+  final float32 = new Float32List(1)..[0] = 0.1;
+  testLengths((n) => new Float32List(n), 0.1, float32[0]);
+  testLengths((n) => new Float64List(n), 1.5, 1.5);
+
+  // Views into the middle of a buffer must not write outside the view.
+  final buffer = new Uint8List(64);
+  final view = new Uint16List.view(buffer.buffer, 6, 20);
+  view.fillRange(0, 20, 0xabcd);
+  for (int i = 0; i < buffer.length; i++) {
+    Expect.equals(i < 6 || i >= 46 ? 0 : (i.isEven ? 0xcd : 0xab), buffer[i]);
+  }
+
+  Expect.throws(() => new Uint8List(20).fillRange(5, 21, 1));
+}